@@ -15,6 +15,7 @@
 extern "C" {
 #endif
 
+#include <stddef.h>
 #include <library/internal/module.h>
 
 
@@ -0,0 +1,141 @@
+/**
+ * @file asset_cache.h
+ * @author khalilhenoud@gmail.com
+ * @brief reference counted asset cache with background loading
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef LIB_ASSET_CACHE_H
+#define LIB_ASSET_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <library/internal/module.h>
+#include <library/allocator/allocator.h>
+#include <library/asset/asset_ref.h>
+#include <library/containers/chashmap.h>
+#include <library/threading/mutex.h>
+#include <library/threading/thread.h>
+
+#define ASSET_CACHE_MAX_WORKERS       16
+
+
+////////////////////////////////////////////////////////////////////////////////
+// NOTES:
+//  - assets are keyed by asset_ref_t, every acquire of the same ref returns the
+//    same handle and bumps its refcount, the asset is loaded once.
+//  - loading goes through the loader/deloader of the ref's type (see the
+//    fn_get_loader/fn_get_deloader vtable entries). once loaded, the refs the
+//    asset holds (fn_type_asset_count/fn_type_get_assets) are acquired by the
+//    cache and queued, they are released when the asset is evicted.
+//  - released assets are kept around in lru order and evicted, oldest first,
+//    once the resident bytes exceed the budget. referenced assets are never
+//    evicted, the budget can be overshot by live assets.
+//  - failed loads are not cached. while the handle is referenced every acquire
+//    of the ref gets it back in the failed state, its last release drops it
+//    and the next acquire loads again.
+//  - the refs an asset holds are pinned, assets that refer to each other in a
+//    cycle keep one another referenced and only go with the cache cleanup.
+//  - with workers, loads run on the cache threads and the loaders and the
+//    allocator must be thread safe. with no worker, loads run on the calling
+//    thread inside acquire.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef
+enum asset_state_t {
+  ASSET_STATE_QUEUED,
+  ASSET_STATE_LOADING,
+  ASSET_STATE_READY,
+  ASSET_STATE_FAILED                    // unknown type, no loader or NULL asset
+} asset_state_t;
+
+typedef struct asset_handle_t asset_handle_t;
+
+/** the cost of a loaded asset against the budget, in bytes. */
+typedef
+uint64_t (*asset_cache_size_fn_t)(const asset_ref_t *ref, const void *asset);
+
+typedef
+struct asset_cache_stats_t {
+  uint64_t hits;                        // acquires served by an existing handle
+  uint64_t loads;
+  uint64_t failures;
+  uint64_t evictions;
+  uint64_t resident;                    // bytes of loaded assets
+} asset_cache_stats_t;
+
+typedef
+struct asset_cache_t {
+  chashmap_t handles;                   // asset_ref_t -> asset_handle_t *
+  mutex_t mutex;
+  condvar_t pending;                    // signaled when a load is queued
+  condvar_t loaded;                     // broadcast when a load finishes
+  asset_handle_t *queue_head;
+  asset_handle_t *queue_tail;
+  asset_handle_t *lru_head;             // most recently released
+  asset_handle_t *lru_tail;
+  uint64_t budget;
+  asset_cache_size_fn_t fn_size;
+  asset_cache_stats_t stats;
+  thread_handle_t threads[ASSET_CACHE_MAX_WORKERS];
+  uint32_t worker_count;
+  uint32_t stop;
+  const allocator_t *allocator;
+} asset_cache_t;
+
+/**
+ * 'fn_size' can be NULL, the type size (fn_type_size) is charged instead.
+ * 'worker_count' is clamped to ASSET_CACHE_MAX_WORKERS, 0 loads inline.
+ */
+LIBRARY_API
+void
+asset_cache_setup(
+  asset_cache_t *cache,
+  uint64_t budget,
+  uint32_t worker_count,
+  asset_cache_size_fn_t fn_size,
+  const allocator_t *allocator);
+
+/** deloads every asset, referenced or not. */
+LIBRARY_API
+void
+asset_cache_cleanup(asset_cache_t *cache);
+
+/** returns immediately, the load is queued if the asset is not cached. */
+LIBRARY_API
+asset_handle_t *
+asset_cache_acquire(asset_cache_t *cache, const asset_ref_t *ref);
+
+LIBRARY_API
+void
+asset_cache_release(asset_cache_t *cache, asset_handle_t *handle);
+
+/** blocks until the load finishes, returns NULL if it failed. */
+LIBRARY_API
+void *
+asset_cache_wait(asset_cache_t *cache, asset_handle_t *handle);
+
+/** returns NULL until the asset is ready, never blocks. */
+LIBRARY_API
+void *
+asset_cache_get(const asset_handle_t *handle);
+
+LIBRARY_API
+asset_state_t
+asset_cache_state(const asset_handle_t *handle);
+
+LIBRARY_API
+void
+asset_cache_get_stats(asset_cache_t *cache, asset_cache_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
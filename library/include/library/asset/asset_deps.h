@@ -0,0 +1,70 @@
+/**
+ * @file asset_deps.h
+ * @author khalilhenoud@gmail.com
+ * @brief asset dependency discovery and prefetching
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef LIB_ASSET_DEPS_H
+#define LIB_ASSET_DEPS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <library/internal/module.h>
+#include <library/type_registry/type_registry.h>
+
+
+////////////////////////////////////////////////////////////////////////////////
+// NOTES:
+//  - an object's refs are the ones its type exposes (fn_type_asset_count and
+//    fn_type_get_assets) plus, for cvector_t/clist_t/chashmap_t, the refs of
+//    every element, found through the element type ids (fn_type_ids). an
+//    asset_ref_t is its own ref.
+//  - unregistered types have no refs.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct asset_cache_t asset_cache_t;
+typedef struct asset_ref_t asset_ref_t;
+typedef struct cvector_t cvector_t;
+
+typedef
+void (*asset_deps_fn_t)(const asset_ref_t *ref, void *user_data);
+
+/** calls 'fn' for every ref held by 'src', duplicates included. */
+LIBRARY_API
+void
+asset_deps_visit(
+  const void *src,
+  type_id_t type_id,
+  asset_deps_fn_t fn,
+  void *user_data);
+
+/**
+ * acquires from 'cache' every asset reachable from 'src': the refs it holds,
+ * the refs those assets hold once loaded and so on. at most 'max_inflight'
+ * acquires are waiting on a load at any time, the rest is issued as loads
+ * complete.
+ * 'handles' (a cvector_t of asset_handle_t *) receives one handle per asset,
+ * dependencies before their dependents. the caller releases them.
+ * returns the number of assets that failed to load.
+ */
+LIBRARY_API
+uint32_t
+asset_deps_prefetch(
+  asset_cache_t *cache,
+  const void *src,
+  type_id_t type_id,
+  uint32_t max_inflight,
+  cvector_t *handles);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,121 @@
+/**
+ * @file asset_index.h
+ * @author khalilhenoud@gmail.com
+ * @brief persistent path to metadata index of an asset tree
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef LIB_ASSET_INDEX_H
+#define LIB_ASSET_INDEX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <library/internal/module.h>
+#include <library/allocator/allocator.h>
+#include <library/containers/chashmap.h>
+
+#define ASSET_INDEX_MAGIC             0x58444941      // 'AIDX'
+#define ASSET_INDEX_VERSION           1
+
+
+////////////////////////////////////////////////////////////////////////////////
+// NOTES:
+//  - the index maps a path, relative to the asset root and '/' separated, to
+//    the metadata of the file. keys are cstring_t, values asset_index_entry_t.
+//  - the file is the serialized chashmap (bucket table included, nothing is
+//    rehashed on load) behind a header carrying a checksum of the payload. it
+//    is mapped read-only and deserialized straight out of the mapping.
+//  - refreshing walks the root, files whose size and mtime did not change keep
+//    their entry, the others are rehashed in parallel. entries with no file on
+//    disk anymore are dropped.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef
+struct asset_index_entry_t {
+  uint32_t type_id;
+  uint32_t reserved;
+  uint64_t size;
+  uint64_t mtime;                       // nanoseconds since the unix epoch
+  uint64_t hash;                        // fnv1a 64 of the content
+} asset_index_entry_t;
+
+typedef
+struct asset_index_t {
+  chashmap_t entries;
+  const allocator_t *allocator;
+} asset_index_t;
+
+/**
+ * returns the type id of the file at 'path' (relative to the root), 0 leaves
+ * the file out of the index. called concurrently by the walker threads.
+ */
+typedef
+uint32_t (*asset_index_classify_fn_t)(const char *path, void *user_data);
+
+typedef
+struct asset_index_stats_t {
+  uint64_t scanned;                     // files accepted by the classifier
+  uint64_t added;
+  uint64_t updated;                     // content changed
+  uint64_t removed;
+  uint64_t hashed;                      // new files and size/mtime mismatches
+} asset_index_stats_t;
+
+LIBRARY_API
+void
+asset_index_setup(asset_index_t *index, const allocator_t *allocator);
+
+LIBRARY_API
+void
+asset_index_cleanup(asset_index_t *index);
+
+/**
+ * replaces the content of the index with the one saved at 'path'. returns 0
+ * (leaving the index untouched) if the file is missing, from another version
+ * or corrupt.
+ */
+LIBRARY_API
+uint32_t
+asset_index_load(asset_index_t *index, const char *path);
+
+/** returns 0 if the file could not be written. */
+LIBRARY_API
+uint32_t
+asset_index_save(const asset_index_t *index, const char *path);
+
+/**
+ * brings the index in sync with the files under 'root'. a NULL 'classify'
+ * indexes every file with a type id of 0. 'stats' can be NULL.
+ * NOTE: with more than one worker the index allocator is called from several
+ * threads, it has to be thread safe.
+ */
+LIBRARY_API
+void
+asset_index_refresh(
+  asset_index_t *index,
+  const char *root,
+  asset_index_classify_fn_t classify,
+  void *user_data,
+  uint32_t worker_count,
+  asset_index_stats_t *stats);
+
+/** returns NULL if 'path' is not indexed. */
+LIBRARY_API
+const asset_index_entry_t *
+asset_index_find(const asset_index_t *index, const char *path);
+
+LIBRARY_API
+size_t
+asset_index_size(const asset_index_t *index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -36,6 +36,7 @@ extern "C" {
 //|    *_deserialize            | YES
 //|    *_hash                   | YES
 //|    *_is_equal               | YES
+//|    *_compare                |
 //|    *_type_size              | YES
 //|    *_type_alignment         |
 //|    *_type_id_count          |
@@ -62,7 +63,7 @@ struct asset_ref_t {
   uint32_t type_id;
 } asset_ref_t;
 
-inline
+LIBRARY_INLINE
 void
 asset_ref_def(void *ptr)
 {
@@ -74,7 +75,7 @@ asset_ref_def(void *ptr)
   }
 }
 
-inline
+LIBRARY_INLINE
 uint32_t
 asset_ref_is_def(const void *ptr)
 {
@@ -88,7 +89,7 @@ asset_ref_is_def(const void *ptr)
   }
 }
 
-inline
+LIBRARY_INLINE
 void
 asset_ref_replicate(
   const void *_src,
@@ -107,7 +108,7 @@ asset_ref_replicate(
   cstring_setup(&dst->path, src->path.str, allocator);
 }
 
-inline
+LIBRARY_INLINE
 void
 asset_ref_fullswap(void *_lhs, void *_rhs)
 {
@@ -136,7 +137,7 @@ asset_ref_deserialize(
   const allocator_t *allocator,
   binary_stream_t *stream);
 
-inline
+LIBRARY_INLINE
 uint32_t
 asset_ref_hash(const void *ptr)
 {
@@ -145,7 +146,7 @@ asset_ref_hash(const void *ptr)
   return cstring_hash(&ref->path);
 }
 
-inline
+LIBRARY_INLINE
 uint32_t
 asset_ref_is_equal(
   const void *_lhs,
@@ -158,7 +159,7 @@ asset_ref_is_equal(
     cstring_is_equal(&lhs->path, &rhs->path) && lhs->type_id == rhs->type_id;
 }
 
-inline
+LIBRARY_INLINE
 size_t
 asset_ref_type_size(void)
 {
@@ -169,7 +170,7 @@ LIBRARY_API
 void
 asset_ref_cleanup(void *ptr, const allocator_t *allocator);
 
-inline
+LIBRARY_INLINE
 void
 asset_ref_sanity_check(const asset_ref_t *asset_ref, uint32_t type_id)
 {
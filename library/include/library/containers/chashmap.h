@@ -1,7 +1,7 @@
 /**
  * @file chashmap.h
  * @author khalilhenoud@gmail.com
- * @brief hash table (linear probing)
+ * @brief hash table (robin hood linear probing)
  * @version 0.1
  * @date 2024-09-21
  *
@@ -19,6 +19,9 @@ extern "C" {
 #include <stdint.h>
 #include <library/allocator/allocator.h>
 #include <library/containers/cvector.h>
+#include <library/core/core.h>
+#include <library/internal/module.h>
+#include <library/profiler/profiler.h>
 #include <library/type_registry/type_registry.h>
 
 
@@ -35,6 +38,7 @@ extern "C" {
 //|    *_deserialize            | YES
 //|    *_hash                   |
 //|    *_is_equal               |
+//|    *_compare                |
 //|    *_type_size              | YES
 //|    *_type_alignment         |
 //|    *_type_id_count          | YES
@@ -50,7 +54,17 @@ extern "C" {
 //|    *_is_asset_type          |
 ////////////////////////////////////////////////////////////////////////////////
 // NOTES:
-// - the indices is a vector of uint32_t
+// - the indices is a vector of uint32_t, the slot in keys/values each bucket
+//   points at. distances is a vector of uint8_t, how far each bucket is from
+//   the bucket its key hashes to (saturates at CHASHMAP_DISTANCE_SATURATED,
+//   the true distance is then recomputed from the key).
+// - robin hood probing: an insert takes the bucket of any key closer to its
+//   own bucket than the insert is to its, the displaced key moves on. probe
+//   lengths stay short and even at high load factors (0.85-0.9 is fine), and a
+//   lookup stops at the first key that is closer to home than it is.
+// - an erase shifts the rest of the probe back one bucket (no tombstones), and
+//   moves the last key/value into the freed slot. the iteration order is the
+//   insertion order until the first erase.
 // - The hashmap will replicate the keys when a replicate function is
 //   provided.
 // - The values are inserted by copy only, there is no ownership taken(that
@@ -70,6 +84,7 @@ struct chashmap_t {
   cvector_t keys;
   cvector_t values;
   cvector_t indices;
+  cvector_t distances;
   float max_load_factor;
   const allocator_t* allocator;
 } chashmap_t;
@@ -80,7 +95,7 @@ struct chashmap_iterator_t {
   size_t index;
 } chashmap_iterator_t;
 
-inline
+LIBRARY_INLINE
 void
 chashmap_def(void *ptr)
 {
@@ -88,7 +103,7 @@ chashmap_def(void *ptr)
   memset(ptr, 0, sizeof(chashmap_t));
 }
 
-inline
+LIBRARY_INLINE
 uint32_t
 chashmap_is_def(const void *ptr)
 {
@@ -99,46 +114,51 @@ chashmap_is_def(const void *ptr)
     cvector_is_def(&(hashmap->keys)) &&
     cvector_is_def(&(hashmap->values)) &&
     cvector_is_def(&(hashmap->indices)) &&
+    cvector_is_def(&(hashmap->distances)) &&
     hashmap->max_load_factor == def.max_load_factor &&
     hashmap->allocator == def.allocator;
 }
 
 /** NOTE: follows the rules established by cvector in terms of assertion. */
+LIBRARY_INLINE
 void
 chashmap_replicate(
   const void *src,
   void *dst,
   const allocator_t *allocator);
 
+LIBRARY_INLINE
 void
 chashmap_fullswap(void* lhs, void* rhs);
 
+LIBRARY_INLINE
 void
 chashmap_serialize(
   const void *src,
   binary_stream_t* stream);
 
+LIBRARY_INLINE
 void
 chashmap_deserialize(
   void *dst,
   const allocator_t *allocator,
   binary_stream_t* stream);
 
-inline
+LIBRARY_INLINE
 size_t
 chashmap_type_size(void)
 {
   return sizeof(chashmap_t);
 }
 
-inline
+LIBRARY_INLINE
 uint32_t
 chashmap_type_id_count(void)
 {
   return 2;
 }
 
-inline
+LIBRARY_INLINE
 void
 chashmap_type_ids(const void *src, type_id_t *ids)
 {
@@ -150,14 +170,14 @@ chashmap_type_ids(const void *src, type_id_t *ids)
   }
 }
 
-inline
+LIBRARY_INLINE
 uint32_t
 chashmap_owns_alloc(void)
 {
   return 1;
 }
 
-inline
+LIBRARY_INLINE
 const allocator_t*
 chashmap_get_alloc(const void *ptr)
 {
@@ -169,6 +189,7 @@ chashmap_get_alloc(const void *ptr)
   }
 }
 
+LIBRARY_INLINE
 void
 chashmap_cleanup(
   void *hashmap,
@@ -176,6 +197,7 @@ chashmap_cleanup(
 
 ////////////////////////////////////////////////////////////////////////////////
 /** will not allocate until the first use. */
+LIBRARY_INLINE
 void
 chashmap_setup(
   chashmap_t* hashmap,
@@ -184,83 +206,138 @@ chashmap_setup(
   const allocator_t* allocator,
   const float max_load_factor);
 
+LIBRARY_INLINE
 size_t
 chashmap_key_size(const chashmap_t* hashmap);
 
+LIBRARY_INLINE
 size_t
 chashmap_value_size(const chashmap_t* hashmap);
 
 // returns the cleanup function of the key type
+LIBRARY_INLINE
 fn_cleanup_t
 chashmap_key_cleanup(const chashmap_t* hashmap);
 
 // returns the replicate function of the key type
+LIBRARY_INLINE
 fn_replicate_t
 chashmap_key_replicate(const chashmap_t* hashmap);
 
 // returns the equal function fo the key type
+LIBRARY_INLINE
 fn_is_equal_t
 chashmap_key_equal(const chashmap_t* hashmap);
 
 // returns the hashing function
+LIBRARY_INLINE
 fn_hash_t
 chashmap_hash_calc(const chashmap_t* hashmap);
 
 // 1 if empty, 0 otherwise
+LIBRARY_INLINE
 int32_t
 chashmap_empty(const chashmap_t* hashmap);
 
 // returns the size of the value vector
+LIBRARY_INLINE
 size_t
 chashmap_size(const chashmap_t* hashmap);
 
 // returns the capacity of the value vector
+LIBRARY_INLINE
 size_t
 chashmap_capacity(const chashmap_t* hashmap);
 
-// clears the contents, and resizes to default capacity.
+// clears the contents, the table keeps its capacity and only the slots reset.
+LIBRARY_INLINE
 void
 chashmap_clear(chashmap_t* hashmap);
 
 // retuns the current load factor.
+LIBRARY_INLINE
 float
 chashmap_load_factor(chashmap_t* hashmap);
 
 // retuns the current max load factor.
+LIBRARY_INLINE
 float
 chashmap_max_load_factor(chashmap_t* hashmap);
 
 // sets the max load factor, might trigger a rehash
+LIBRARY_INLINE
 void
 chashmap_set_max_load_factor(
   chashmap_t* hashmap,
   const float max_load_factor);
 
 // reserves a certain number of buckets and rehashes the table
+LIBRARY_INLINE
 void
 chashmap_rehash(chashmap_t* hashmap, size_t count);
 
 // reserve count number of elements, assumes table is emtpy.
+LIBRARY_INLINE
 void
 chashmap_reserve(chashmap_t* hashmap, size_t count);
 
 /** returns an iterator that can be used to iterate over the map. */
+LIBRARY_INLINE
 chashmap_iterator_t
 chashmap_begin(chashmap_t* map);
 
 /** returns an end iterator. */
+LIBRARY_INLINE
 chashmap_iterator_t
 chashmap_end(chashmap_t* map);
 
 /** advance the iterator. */
+LIBRARY_INLINE
 void
 chashmap_advance(chashmap_iterator_t* iter);
 
 // TODO: should I use const pointer ? or since it is inline it does not matter.
 /** 1 if equal, 0 otherwise */
+LIBRARY_INLINE
 int32_t
 chashmap_iter_equal(chashmap_iterator_t left, chashmap_iterator_t right);
 
+////////////////////////////////////////////////////////////////////////////////
+// batches:
+//  - a lookup is three dependent loads (the bucket, the key it points at, the
+//    value), each a likely cache miss on a large table. the batch functions
+//    work through CHASHMAP_BATCH_SIZE keys at a time: all are hashed and their
+//    buckets prefetched, then the keys the buckets point at are prefetched,
+//    then the probes are resolved, so the misses of a batch overlap.
+//  - 'keys' and 'values' are packed arrays, chashmap_key_size() and
+//    chashmap_value_size() bytes apart.
+//  - the results are the same as a loop over chashmap_at()/chashmap_insert(),
+//    a key repeated in a batch resolves in order (the last value wins).
+////////////////////////////////////////////////////////////////////////////////
+
+#define CHASHMAP_BATCH_SIZE 16
+
+/** sets values[i] to the address of the value of keys[i], or NULL. */
+LIBRARY_INLINE
+void
+chashmap_find_batch(
+  chashmap_t* hashmap,
+  const void* keys,
+  size_t count,
+  void** values);
+
+/**
+ * inserts or overwrites every key/value pair. the table is grown once, up
+ * front, to hold 'count' new keys.
+ */
+LIBRARY_INLINE
+void
+chashmap_insert_batch(
+  chashmap_t* hashmap,
+  const void* keys,
+  const void* values,
+  size_t count);
+
 ////////////////////////////////////////////////////////////////////////////////
 #define chashmap_setup2(map__, key_type__, elem_type__) \
   do {                                                  \
@@ -289,6 +366,30 @@ chashmap_iter_equal(chashmap_iterator_t left, chashmap_iterator_t right);
 #define chashmap_compute_next_grow(capacity) \
   ((capacity) >= CHASHTABLE_INIT_SIZE ? (capacity * 2) : CHASHTABLE_INIT_SIZE)
 
+#define CHASHMAP_DISTANCE_SATURATED 0xff
+
+/**
+ * returns the slot of 'key' (hash value 'hashed') or CHASHTABLE_INVALID_INDEX,
+ * 'bucket' (if not NULL) is set to the bucket that points at it.
+ */
+LIBRARY_INLINE
+uint32_t
+chashmap_find_slot(
+  const chashmap_t* hashmap,
+  const void* key,
+  uint32_t hashed,
+  size_t* bucket);
+
+/** seats the key/value pair at 'slot' (hash value 'hashed') in the table. */
+LIBRARY_INLINE
+void
+chashmap_place_slot(chashmap_t* hashmap, uint32_t slot, uint32_t hashed);
+
+/** removes 'key' and its value, returns 1 if it was found. */
+LIBRARY_INLINE
+uint32_t
+chashmap_erase_key(chashmap_t* hashmap, const void* key);
+
 #define chashmap_insert(hashmap, key, key_type, value, value_type)         \
   do {                                                                     \
     assert((hashmap) && !chashmap_is_def(hashmap));                        \
@@ -299,9 +400,10 @@ chashmap_iter_equal(chashmap_iterator_t left, chashmap_iterator_t right);
         chashmap_compute_next_grow(chashmap_capacity(hashmap)));           \
                                                                            \
     {                                                                      \
-      uint32_t index;                                                      \
       key_type scopy = (key);                                              \
-      chashmap_contains((hashmap), (key), key_type, index);                \
+      uint32_t hashed = chashmap_hash_calc(hashmap)(&scopy);               \
+      uint32_t index =                                                     \
+        chashmap_find_slot((hashmap), &scopy, hashed, NULL);               \
       if (index != CHASHTABLE_INVALID_INDEX) {                             \
         if (chashmap_key_replicate(hashmap)) {                             \
         cvector_cleanup_at(&(hashmap)->keys, index);                       \
@@ -312,12 +414,8 @@ chashmap_iter_equal(chashmap_iterator_t left, chashmap_iterator_t right);
         cvector_cleanup_at(&(hashmap)->values, index);                     \
         *cvector_as(&(hashmap)->values, index, value_type) = (value);      \
       } else {                                                             \
-        uint64_t count = cvector_size(&(hashmap)->indices);                \
-        key_type scopy = (key);                                            \
-        uint32_t hashed =                                                  \
-          (uint32_t)(chashmap_hash_calc(hashmap)(&scopy) % count);         \
+        uint32_t last_index = (uint32_t)cvector_size(&(hashmap)->keys);    \
         if (chashmap_key_replicate(hashmap)) {                             \
-          uint32_t last_index = cvector_size(&(hashmap)->keys);            \
           cvector_resize(                                                  \
             &(hashmap)->keys, last_index + 1);                             \
           chashmap_key_replicate(hashmap)(                                 \
@@ -326,12 +424,7 @@ chashmap_iter_equal(chashmap_iterator_t left, chashmap_iterator_t right);
         } else                                                             \
           cvector_push_back(&(hashmap)->keys, (key), key_type);            \
         cvector_push_back(&(hashmap)->values, (value), value_type);        \
-        while (                                                            \
-          *cvector_as(&(hashmap)->indices, hashed, uint32_t) !=            \
-          CHASHTABLE_INVALID_INDEX)                                        \
-          hashed = (hashed + 1) % count;                                   \
-        *cvector_as(&(hashmap)->indices, hashed, uint32_t) =               \
-          (uint32_t)cvector_size(&(hashmap)->keys) - 1;                    \
+        chashmap_place_slot((hashmap), last_index, hashed);                \
       }                                                                    \
     }                                                                      \
   } while (0)
@@ -342,20 +435,8 @@ chashmap_iter_equal(chashmap_iterator_t left, chashmap_iterator_t right);
     assert((hashmap) && !chashmap_is_def(hashmap));                        \
                                                                            \
     {                                                                      \
-      uint32_t* __val;                                                     \
-      uint32_t __index, __i, __count = cvector_size(&(hashmap)->indices);  \
-      chashmap_contains((hashmap), (key), key_type, __index);              \
-      if (__index != CHASHTABLE_INVALID_INDEX) {                           \
-        cvector_erase(&(hashmap)->keys, __index);                          \
-        cvector_erase(&(hashmap)->values, __index);                        \
-        for (__i = 0; __i < __count; ++__i) {                              \
-          __val = cvector_as(&(hashmap)->indices, __i, uint32_t);          \
-          *__val = (*__val == __index) ?                                   \
-            CHASHTABLE_INVALID_INDEX :                                     \
-            ((*__val > __index && *__val != CHASHTABLE_INVALID_INDEX) ?    \
-            (*__val - 1) : *__val);                                        \
-        }                                                                  \
-      }                                                                    \
+      key_type scopy = (key);                                              \
+      chashmap_erase_key((hashmap), &scopy);                               \
     }                                                                      \
   } while (0)
 
@@ -365,18 +446,9 @@ chashmap_iter_equal(chashmap_iterator_t left, chashmap_iterator_t right);
     assert((hashmap) && !chashmap_is_def(hashmap));                        \
                                                                            \
     {                                                                      \
-      uint64_t count = cvector_size(&(hashmap)->indices);                  \
       key_type scopy = (key);                                              \
-      uint32_t hashed =                                                    \
-        (uint32_t)(chashmap_hash_calc(hashmap)(&scopy) % count);           \
-      (index) = *cvector_as(&(hashmap)->indices, hashed, uint32_t);        \
-      while ((index) != CHASHTABLE_INVALID_INDEX) {                        \
-        if (chashmap_key_equal(hashmap)(                                   \
-          cvector_at(&(hashmap)->keys, (index)), &scopy))                  \
-          break;                                                           \
-        hashed = (hashed + 1) % count;                                     \
-        (index) = *cvector_as(&(hashmap)->indices, hashed, uint32_t);      \
-      }                                                                    \
+      (index) = chashmap_find_slot(                                        \
+        (hashmap), &scopy, chashmap_hash_calc(hashmap)(&scopy), NULL);     \
     }                                                                      \
   } while (0)
 
@@ -19,6 +19,7 @@ extern "C" {
 #include <stdint.h>
 #include <string.h>
 #include <library/allocator/allocator.h>
+#include <library/internal/module.h>
 #include <library/type_registry/type_registry.h>
 
 
@@ -35,6 +36,7 @@ extern "C" {
 //|    *_deserialize            | YES
 //|    *_hash                   |
 //|    *_is_equal               |
+//|    *_compare                |
 //|    *_type_size              | YES
 //|    *_type_alignment         |
 //|    *_type_id_count          | YES
@@ -79,7 +81,7 @@ struct clist_t {
   clist_node_t *nodes;
 } clist_t;
 
-inline
+LIBRARY_INLINE
 void
 clist_def(void *ptr)
 {
@@ -87,7 +89,7 @@ clist_def(void *ptr)
   memset(ptr, 0, sizeof(clist_t));
 }
 
-inline
+LIBRARY_INLINE
 uint32_t
 clist_is_def(const void *ptr)
 {
@@ -106,41 +108,45 @@ clist_is_def(const void *ptr)
  * with non-zero size.
  * NOTE: either 'dst' is def or 'allocator' is NULL, not both (we assert).
  */
+LIBRARY_INLINE
 void
 clist_replicate(
   const void *src,
   void *dst,
   const allocator_t *allocator);
 
+LIBRARY_INLINE
 void
 clist_fullswap(void* src, void* dst);
 
+LIBRARY_INLINE
 void
 clist_serialize(
   const void *src,
   binary_stream_t* stream);
 
+LIBRARY_INLINE
 void
 clist_deserialize(
   void *dst,
   const allocator_t *allocator,
   binary_stream_t* stream);
 
-inline
+LIBRARY_INLINE
 size_t
 clist_type_size(void)
 {
   return sizeof(clist_t);
 }
 
-inline
+LIBRARY_INLINE
 uint32_t
 clist_type_id_count(void)
 {
   return 1;
 }
 
-inline
+LIBRARY_INLINE
 void
 clist_type_ids(
   const void *src,
@@ -150,14 +156,14 @@ clist_type_ids(
   ids[0] = ((const clist_t *)src)->elem_data.type_id;
 }
 
-inline
+LIBRARY_INLINE
 uint32_t
 clist_owns_alloc(void)
 {
   return 1;
 }
 
-inline
+LIBRARY_INLINE
 const allocator_t*
 clist_get_alloc(const void *list)
 {
@@ -165,32 +171,40 @@ clist_get_alloc(const void *list)
   return ((const clist_t *)list)->allocator;
 }
 
+LIBRARY_INLINE
 void
 clist_cleanup(void *ptr, const allocator_t* allocator);
 
 ////////////////////////////////////////////////////////////////////////////////
+LIBRARY_INLINE
 void
 clist_setup(
   clist_t* list,
   type_data_t type_data,
   const allocator_t* allocator);
 
+LIBRARY_INLINE
 size_t
 clist_size(const clist_t* vec);
 
+LIBRARY_INLINE
 size_t
 clist_elem_size(const clist_t* vec);
 
+LIBRARY_INLINE
 int32_t
 clist_empty(const clist_t* vec);
 
 /** returns the node at index, internal use only. */
+LIBRARY_INLINE
 clist_node_t*
 clist_at(clist_t *list, size_t index);
+LIBRARY_INLINE
 const clist_node_t*
 clist_at_cst(const clist_t *list, size_t index);
 
 /** removes the node at index from the list. */
+LIBRARY_INLINE
 void
 clist_erase(clist_t* list, size_t index);
 
@@ -199,30 +213,37 @@ clist_erase(clist_t* list, size_t index);
  * NOTE: allocator and elem_cleanup are maintained, meaning the container is
  * still valid after clear is called.
  */
+LIBRARY_INLINE
 void
 clist_clear(clist_t* list);
 
 /** removes the last element from the list */
+LIBRARY_INLINE
 void
 clist_pop_back(clist_t* list);
 
 /** removes the first element from the list */
+LIBRARY_INLINE
 void
 clist_pop_front(clist_t* list);
 
 /** returns an iterator that can be used to iterate over the list. */
+LIBRARY_INLINE
 clist_iterator_t
 clist_begin(clist_t* list);
 
 /** returns an end iterator. */
+LIBRARY_INLINE
 clist_iterator_t
 clist_end(clist_t* list);
 
 /** advance the iterator. */
+LIBRARY_INLINE
 void
 clist_advance(clist_iterator_t* iter);
 
 /** 1 if equal, 0 otherwise */
+LIBRARY_INLINE
 int32_t
 clist_iter_equal(clist_iterator_t left, clist_iterator_t right);
 
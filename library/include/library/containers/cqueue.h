@@ -0,0 +1,180 @@
+/**
+ * @file cqueue.h
+ * @author khalilhenoud@gmail.com
+ * @brief bounded lock-free multi-producer multi-consumer queue
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef LIB_QUEUE_H
+#define LIB_QUEUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+#include <library/allocator/allocator.h>
+#include <library/internal/module.h>
+#include <library/threading/atomic.h>
+#include <library/type_registry/type_registry.h>
+
+#define CQUEUE_CACHE_LINE             64
+
+
+////////////////////////////////////////////////////////////////////////////////
+//| cqueue_t, * = cqueue
+//|=============================================================================
+//| OPERATION                   | SUPPORTED
+//|=============================================================================
+//|    *_def                    | YES
+//|    *_is_def                 | YES
+//|    *_replicate              |
+//|    *_fullswap               |
+//|    *_serialize              |
+//|    *_deserialize            |
+//|    *_hash                   |
+//|    *_is_equal               |
+//|    *_compare                |
+//|    *_type_size              | YES
+//|    *_type_alignment         |
+//|    *_type_id_count          | YES
+//|    *_type_ids               | YES
+//|    *_owns_alloc             | YES
+//|    *_get_alloc              | YES
+//|    *_cleanup                | YES
+//|    *_get_dir                |
+//|    *_get_loader             |
+//|    *_get_deloader           |
+//|    *_type_asset_count       |
+//|    *_type_get_assets        |
+//|    *_is_asset_type          |
+////////////////////////////////////////////////////////////////////////////////
+// NOTES:
+//  - vyukov's bounded queue: every cell carries a sequence number telling
+//    producers and consumers whose turn it is, a push or pop is one cas on the
+//    shared position and no lock.
+//  - elements are copied in and out as raw bytes, the queue owns what it
+//    holds until popped. cleanup releases whatever is left.
+//  - setup and cleanup are not thread safe, push and pop are.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef
+struct cqueue_t {
+  container_elem_data_t elem_data;
+  size_t capacity;                      // power of two
+  size_t stride;                        // sequence + element, 8 byte aligned
+  const allocator_t *allocator;
+  uint8_t *cells;
+  uint8_t pad0[CQUEUE_CACHE_LINE];
+  volatile uint64_t enqueue_pos;
+  uint8_t pad1[CQUEUE_CACHE_LINE - sizeof(uint64_t)];
+  volatile uint64_t dequeue_pos;
+  uint8_t pad2[CQUEUE_CACHE_LINE - sizeof(uint64_t)];
+} cqueue_t;
+
+LIBRARY_INLINE
+void
+cqueue_def(void *ptr)
+{
+  assert(ptr);
+  memset(ptr, 0, sizeof(cqueue_t));
+}
+
+LIBRARY_INLINE
+uint32_t
+cqueue_is_def(const void *ptr)
+{
+  const cqueue_t *queue = (const cqueue_t *)ptr;
+  cqueue_t def;
+  cqueue_def(&def);
+  return
+    elem_data_identical(&queue->elem_data, &def.elem_data) &&
+    queue->capacity == def.capacity &&
+    queue->allocator == def.allocator &&
+    queue->cells == def.cells;
+}
+
+LIBRARY_INLINE
+size_t
+cqueue_type_size(void)
+{
+  return sizeof(cqueue_t);
+}
+
+LIBRARY_INLINE
+uint32_t
+cqueue_type_id_count(void)
+{
+  return 1;
+}
+
+LIBRARY_INLINE
+void
+cqueue_type_ids(
+  const void *src,
+  type_id_t *ids)
+{
+  assert(src && ids);
+  ids[0] = ((const cqueue_t *)src)->elem_data.type_id;
+}
+
+LIBRARY_INLINE
+uint32_t
+cqueue_owns_alloc(void)
+{
+  return 1;
+}
+
+LIBRARY_INLINE
+const allocator_t*
+cqueue_get_alloc(const void *queue)
+{
+  assert(queue);
+  return ((const cqueue_t *)queue)->allocator;
+}
+
+LIBRARY_INLINE
+void
+cqueue_cleanup(void *ptr, const allocator_t* allocator);
+
+////////////////////////////////////////////////////////////////////////////////
+/** 'capacity' is rounded up to a power of two, at least 2. */
+LIBRARY_INLINE
+void
+cqueue_setup(
+  cqueue_t *queue,
+  type_data_t type_data,
+  size_t capacity,
+  const allocator_t* allocator);
+
+LIBRARY_INLINE
+size_t
+cqueue_capacity(const cqueue_t *queue);
+
+/** a snapshot, can be stale by the time it returns. */
+LIBRARY_INLINE
+size_t
+cqueue_size(const cqueue_t *queue);
+
+/** copies 'elem' in, returns 0 if the queue is full. */
+LIBRARY_INLINE
+uint32_t
+cqueue_push(cqueue_t *queue, const void *elem);
+
+/** copies the oldest element into 'elem', returns 0 if the queue is empty. */
+LIBRARY_INLINE
+uint32_t
+cqueue_pop(cqueue_t *queue, void *elem);
+
+#include "cqueue.impl"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
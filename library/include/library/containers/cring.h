@@ -0,0 +1,181 @@
+/**
+ * @file cring.h
+ * @author khalilhenoud@gmail.com
+ * @brief lock-free single-producer single-consumer ring buffer
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef LIB_RING_H
+#define LIB_RING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+#include <library/allocator/allocator.h>
+#include <library/internal/module.h>
+#include <library/threading/atomic.h>
+#include <library/type_registry/type_registry.h>
+
+#define CRING_CACHE_LINE              64
+
+
+////////////////////////////////////////////////////////////////////////////////
+//| cring_t, * = cring
+//|=============================================================================
+//| OPERATION                   | SUPPORTED
+//|=============================================================================
+//|    *_def                    | YES
+//|    *_is_def                 | YES
+//|    *_replicate              |
+//|    *_fullswap               |
+//|    *_serialize              |
+//|    *_deserialize            |
+//|    *_hash                   |
+//|    *_is_equal               |
+//|    *_compare                |
+//|    *_type_size              | YES
+//|    *_type_alignment         |
+//|    *_type_id_count          | YES
+//|    *_type_ids               | YES
+//|    *_owns_alloc             | YES
+//|    *_get_alloc              | YES
+//|    *_cleanup                | YES
+//|    *_get_dir                |
+//|    *_get_loader             |
+//|    *_get_deloader           |
+//|    *_type_asset_count       |
+//|    *_type_get_assets        |
+//|    *_is_asset_type          |
+////////////////////////////////////////////////////////////////////////////////
+// NOTES:
+//  - one producer thread and one consumer thread, each only writes its own
+//    index. each side keeps a cached copy of the other's index and only reads
+//    the shared one when the cached copy says full or empty.
+//  - elements are copied in and out as raw bytes, the ring owns what it holds
+//    until popped. cleanup releases whatever is left.
+//  - setup and cleanup are not thread safe.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef
+struct cring_t {
+  container_elem_data_t elem_data;
+  size_t capacity;                      // power of two
+  const allocator_t *allocator;
+  uint8_t *data;
+  uint8_t pad0[CRING_CACHE_LINE];
+  volatile uint64_t head;               // next slot to pop, consumer owned
+  uint64_t cached_tail;
+  uint8_t pad1[CRING_CACHE_LINE - 2 * sizeof(uint64_t)];
+  volatile uint64_t tail;               // next slot to push, producer owned
+  uint64_t cached_head;
+  uint8_t pad2[CRING_CACHE_LINE - 2 * sizeof(uint64_t)];
+} cring_t;
+
+LIBRARY_INLINE
+void
+cring_def(void *ptr)
+{
+  assert(ptr);
+  memset(ptr, 0, sizeof(cring_t));
+}
+
+LIBRARY_INLINE
+uint32_t
+cring_is_def(const void *ptr)
+{
+  const cring_t *ring = (const cring_t *)ptr;
+  cring_t def;
+  cring_def(&def);
+  return
+    elem_data_identical(&ring->elem_data, &def.elem_data) &&
+    ring->capacity == def.capacity &&
+    ring->allocator == def.allocator &&
+    ring->data == def.data;
+}
+
+LIBRARY_INLINE
+size_t
+cring_type_size(void)
+{
+  return sizeof(cring_t);
+}
+
+LIBRARY_INLINE
+uint32_t
+cring_type_id_count(void)
+{
+  return 1;
+}
+
+LIBRARY_INLINE
+void
+cring_type_ids(
+  const void *src,
+  type_id_t *ids)
+{
+  assert(src && ids);
+  ids[0] = ((const cring_t *)src)->elem_data.type_id;
+}
+
+LIBRARY_INLINE
+uint32_t
+cring_owns_alloc(void)
+{
+  return 1;
+}
+
+LIBRARY_INLINE
+const allocator_t*
+cring_get_alloc(const void *ring)
+{
+  assert(ring);
+  return ((const cring_t *)ring)->allocator;
+}
+
+LIBRARY_INLINE
+void
+cring_cleanup(void *ptr, const allocator_t* allocator);
+
+////////////////////////////////////////////////////////////////////////////////
+/** 'capacity' is rounded up to a power of two, at least 2. */
+LIBRARY_INLINE
+void
+cring_setup(
+  cring_t *ring,
+  type_data_t type_data,
+  size_t capacity,
+  const allocator_t* allocator);
+
+LIBRARY_INLINE
+size_t
+cring_capacity(const cring_t *ring);
+
+/** a snapshot, exact only when called from the producer or the consumer. */
+LIBRARY_INLINE
+size_t
+cring_size(const cring_t *ring);
+
+/** producer only. copies 'elem' in, returns 0 if the ring is full. */
+LIBRARY_INLINE
+uint32_t
+cring_push(cring_t *ring, const void *elem);
+
+/** consumer only. copies the oldest element out, returns 0 if empty. */
+LIBRARY_INLINE
+uint32_t
+cring_pop(cring_t *ring, void *elem);
+
+#include "cring.impl"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
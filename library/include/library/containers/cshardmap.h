@@ -0,0 +1,228 @@
+/**
+ * @file cshardmap.h
+ * @author khalilhenoud@gmail.com
+ * @brief hashmap safe to share between threads, sharded reader/writer locks
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef LIB_SHARDMAP_H
+#define LIB_SHARDMAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <library/internal/module.h>
+#include <library/threading/mutex.h>
+#include <library/type_registry/type_registry.h>
+
+#define CSHARDMAP_CACHE_LINE          64
+#define CSHARDMAP_DEFAULT_SHARDS      64
+
+
+////////////////////////////////////////////////////////////////////////////////
+//| cshardmap_t, * = cshardmap
+//|=============================================================================
+//| OPERATION                   | SUPPORTED
+//|=============================================================================
+//|    *_def                    | YES
+//|    *_is_def                 | YES
+//|    *_replicate              |
+//|    *_fullswap               |
+//|    *_serialize              |
+//|    *_deserialize            |
+//|    *_hash                   |
+//|    *_is_equal               |
+//|    *_compare                |
+//|    *_type_size              | YES
+//|    *_type_alignment         |
+//|    *_type_id_count          | YES
+//|    *_type_ids               | YES
+//|    *_owns_alloc             | YES
+//|    *_get_alloc              | YES
+//|    *_cleanup                | YES
+//|    *_get_dir                |
+//|    *_get_loader             |
+//|    *_get_deloader           |
+//|    *_type_asset_count       |
+//|    *_type_get_assets        |
+//|    *_is_asset_type          |
+////////////////////////////////////////////////////////////////////////////////
+// NOTES:
+//  - the keys are spread over a power of two number of shards by their hash,
+//    each shard is a linear probing table behind its own rwlock_t. lookups
+//    only take the shard lock as readers, so readers of different (or the
+//    same) keys never wait on each other, only on a writer of the same shard.
+//  - the key type must register fn_hash and fn_is_equal, the registry's are
+//    used as is.
+//  - like chashmap_t, keys are replicated when the type has a replicate
+//    function and values are copied in as raw bytes, the map owns both.
+//  - nothing handed out points into the map, a shard can rehash under any
+//    reader that has let go of its lock. use cshardmap_read() to look at a
+//    value in place.
+//  - setup and cleanup are not thread safe, everything else is. writers
+//    allocate under their shard lock, the allocator must be thread safe.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef
+struct cshardmap_shard_t {
+  rwlock_t lock;
+  size_t size;
+  size_t capacity;                      // power of two, 0 until first insert
+  uint32_t *tags;                       // 0 marks an empty slot
+  uint8_t *keys;
+  uint8_t *values;
+  uint8_t pad[
+    CSHARDMAP_CACHE_LINE - 2 * sizeof(size_t) - 3 * sizeof(void *)];
+} cshardmap_shard_t;
+
+typedef
+struct cshardmap_t {
+  container_elem_data_t key_data;
+  container_elem_data_t value_data;
+  fn_hash_t hash;
+  fn_is_equal_t is_equal;
+  uint32_t shard_count;
+  uint32_t shard_shift;
+  const allocator_t *allocator;
+  cshardmap_shard_t *shards;
+} cshardmap_t;
+
+/** called under the shard's reader lock, 'value' is only valid in the call. */
+typedef void (*cshardmap_reader_t)(const void *value, void *user_data);
+
+LIBRARY_INLINE
+void
+cshardmap_def(void *ptr)
+{
+  assert(ptr);
+  memset(ptr, 0, sizeof(cshardmap_t));
+}
+
+LIBRARY_INLINE
+uint32_t
+cshardmap_is_def(const void *ptr)
+{
+  const cshardmap_t *map = (const cshardmap_t *)ptr;
+  cshardmap_t def;
+  cshardmap_def(&def);
+  return
+    elem_data_identical(&map->key_data, &def.key_data) &&
+    elem_data_identical(&map->value_data, &def.value_data) &&
+    map->shard_count == def.shard_count &&
+    map->allocator == def.allocator &&
+    map->shards == def.shards;
+}
+
+LIBRARY_INLINE
+size_t
+cshardmap_type_size(void)
+{
+  return sizeof(cshardmap_t);
+}
+
+LIBRARY_INLINE
+uint32_t
+cshardmap_type_id_count(void)
+{
+  return 2;
+}
+
+LIBRARY_INLINE
+void
+cshardmap_type_ids(const void *src, type_id_t *ids)
+{
+  assert(src && ids);
+  {
+    const cshardmap_t *map = (const cshardmap_t *)src;
+    ids[0] = map->key_data.type_id;
+    ids[1] = map->value_data.type_id;
+  }
+}
+
+LIBRARY_INLINE
+uint32_t
+cshardmap_owns_alloc(void)
+{
+  return 1;
+}
+
+LIBRARY_INLINE
+const allocator_t*
+cshardmap_get_alloc(const void *ptr)
+{
+  assert(ptr && !cshardmap_is_def(ptr));
+  return ((const cshardmap_t *)ptr)->allocator;
+}
+
+LIBRARY_API
+void
+cshardmap_cleanup(void *ptr, const allocator_t *allocator);
+
+////////////////////////////////////////////////////////////////////////////////
+/** 'shard_count' is rounded up to a power of two, 0 picks the default. */
+LIBRARY_API
+void
+cshardmap_setup(
+  cshardmap_t *map,
+  type_data_t key_type_data,
+  type_data_t value_type_data,
+  uint32_t shard_count,
+  const allocator_t *allocator);
+
+/** a snapshot summed over the shards, can be stale by the time it returns. */
+LIBRARY_API
+size_t
+cshardmap_size(cshardmap_t *map);
+
+/**
+ * adds or replaces the value of 'key', a replaced value is cleaned up.
+ * returns 1 if the key was not in the map.
+ */
+LIBRARY_API
+uint32_t
+cshardmap_insert(cshardmap_t *map, const void *key, const void *value);
+
+/**
+ * adds 'value' only if 'key' is missing, returns 1 if it did. otherwise the
+ * map is left alone and 'value' still belongs to the caller.
+ */
+LIBRARY_API
+uint32_t
+cshardmap_try_insert(cshardmap_t *map, const void *key, const void *value);
+
+/**
+ * returns 1 if 'key' is in the map. when 'value' is not NULL the stored value
+ * is copied into it, replicated with the map's allocator if the type has a
+ * replicate function (the copy is then the caller's to clean up).
+ */
+LIBRARY_API
+uint32_t
+cshardmap_find(cshardmap_t *map, const void *key, void *value);
+
+/** calls 'reader' on the value of 'key' if present, returns 1 if it was. */
+LIBRARY_API
+uint32_t
+cshardmap_read(
+  cshardmap_t *map,
+  const void *key,
+  cshardmap_reader_t reader,
+  void *user_data);
+
+/** removes 'key' and cleans up its key and value, returns 1 if it was found. */
+LIBRARY_API
+uint32_t
+cshardmap_erase(cshardmap_t *map, const void *key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -19,6 +19,8 @@ extern "C" {
 #include <stdint.h>
 #include <string.h>
 #include <library/allocator/allocator.h>
+#include <library/internal/module.h>
+#include <library/profiler/profiler.h>
 #include <library/type_registry/type_registry.h>
 
 
@@ -35,6 +37,7 @@ extern "C" {
 //|    *_deserialize            | YES
 //|    *_hash                   |
 //|    *_is_equal               |
+//|    *_compare                |
 //|    *_type_size              | YES
 //|    *_type_alignment         |
 //|    *_type_id_count          | YES
@@ -66,7 +69,7 @@ struct cvector_t {
   void *data;
 } cvector_t;
 
-inline
+LIBRARY_INLINE
 void
 cvector_def(void *ptr)
 {
@@ -74,7 +77,7 @@ cvector_def(void *ptr)
   memset(ptr, 0, sizeof(cvector_t));
 }
 
-inline
+LIBRARY_INLINE
 uint32_t
 cvector_is_def(const void *ptr)
 {
@@ -98,32 +101,38 @@ cvector_is_def(const void *ptr)
  * with non-zero size.
  * NOTE: capacity is carried over from the src vector.
  */
+LIBRARY_INLINE
 void
 cvector_replicate(
   const void *src,
   void *dst,
   const allocator_t *allocator);
 
+LIBRARY_INLINE
 void
 cvector_fullswap(void* src, void* dst);
 
+LIBRARY_INLINE
 void
 cvector_serialize(
   const void *src,
   binary_stream_t *stream);
 
+LIBRARY_INLINE
 void
 cvector_serialize_func(
   const void *src,
   binary_stream_t *stream,
   fn_serialize_t serialize);
 
+LIBRARY_INLINE
 void
 cvector_deserialize(
   void *dst,
   const allocator_t *allocator,
   binary_stream_t *stream);
 
+LIBRARY_INLINE
 void
 cvector_deserialize_func(
   void *dst,
@@ -131,21 +140,40 @@ cvector_deserialize_func(
   binary_stream_t *stream,
   fn_deserialize_t deserialize);
 
-inline
+/**
+ * delta encoding for integer vectors (elements of 1, 2, 4 or 8 bytes with no
+ * serialize function). consecutive differences are written as zigzag varints,
+ * sorted vectors shrink considerably. the layout ignores the stream flags.
+ * NOTE: the deserialized capacity matches the size.
+ */
+LIBRARY_INLINE
+void
+cvector_serialize_delta(
+  const void *src,
+  binary_stream_t *stream);
+
+LIBRARY_INLINE
+void
+cvector_deserialize_delta(
+  void *dst,
+  const allocator_t *allocator,
+  binary_stream_t *stream);
+
+LIBRARY_INLINE
 size_t
 cvector_type_size(void)
 {
   return sizeof(cvector_t);
 }
 
-inline
+LIBRARY_INLINE
 uint32_t
 cvector_type_id_count(void)
 {
   return 1;
 }
 
-inline
+LIBRARY_INLINE
 void
 cvector_type_ids(const void *src, type_id_t *ids)
 {
@@ -153,14 +181,14 @@ cvector_type_ids(const void *src, type_id_t *ids)
   ids[0] = ((const cvector_t *)src)->elem_data.type_id;
 }
 
-inline
+LIBRARY_INLINE
 uint32_t
 cvector_owns_alloc(void)
 {
   return 1;
 }
 
-inline
+LIBRARY_INLINE
 const allocator_t*
 cvector_get_alloc(const void *vec)
 {
@@ -168,9 +196,11 @@ cvector_get_alloc(const void *vec)
   return ((const cvector_t *)vec)->allocator;
 }
 
+LIBRARY_INLINE
 void
 cvector_cleanup(void *ptr, const allocator_t *allocator);
 
+LIBRARY_INLINE
 void
 cvector_cleanup_func(
   void *ptr,
@@ -183,6 +213,7 @@ cvector_cleanup_func(
  * dereferenced. this is intended behavior. allocation after the fact will
  * remedy this.
  */
+LIBRARY_INLINE
 void
 cvector_setup(
   cvector_t *vec,
@@ -190,37 +221,47 @@ cvector_setup(
   size_t capacity,
   const allocator_t* allocator);
 
+LIBRARY_INLINE
 size_t
 cvector_capacity(const cvector_t* vec);
 
+LIBRARY_INLINE
 size_t
 cvector_size(const cvector_t* vec);
 
+LIBRARY_INLINE
 size_t
 cvector_elem_size(const cvector_t* vec);
 
+LIBRARY_INLINE
 int32_t
 cvector_empty(const cvector_t* vec);
 
 /** internal: used to cleanup an element to reuse the space. */
+LIBRARY_INLINE
 void
 cvector_cleanup_at(cvector_t* vec, size_t index);
 
 /** expands capacity to max(capacity, vec->capacity) */
+LIBRARY_INLINE
 void
 cvector_reserve(cvector_t* vec, size_t capacity);
 
 /** returns a pointer to the element at index, asserts otherwise */
+LIBRARY_INLINE
 void*
 cvector_at(cvector_t* vec, size_t index);
+LIBRARY_INLINE
 const void*
 cvector_at_cst(const cvector_t* vec, size_t index);
 
 /** removes the element at index from the vector. */
+LIBRARY_INLINE
 void
 cvector_erase(cvector_t* vec, size_t index);
 
 /** erases all of the elements in the vector, does not affect capacity */
+LIBRARY_INLINE
 void
 cvector_clear(cvector_t* vec);
 
@@ -228,6 +269,7 @@ cvector_clear(cvector_t* vec);
  * reserves 'count' * 'elem_size' in terms of capacity, internal use.
  * NOTE: this can be used to reduce overall capacity as in shrink_to_fit()
  */
+LIBRARY_INLINE
 void
 cvector_grow(cvector_t* vec, size_t new_capacity);
 
@@ -238,10 +280,12 @@ cvector_grow(cvector_t* vec, size_t new_capacity);
   ((size) >= CVECTOR_INIT_SIZE ? ((size) + (size)/2) : CVECTOR_INIT_SIZE )
 
 /** discards extra memory capacity. */
+LIBRARY_INLINE
 void
 cvector_shrink_to_fit(cvector_t* vec);
 
 /** removes the last element from the vector, memory capacity is preserved */
+LIBRARY_INLINE
 void
 cvector_pop_back(cvector_t* vec);
 
@@ -250,6 +294,7 @@ cvector_pop_back(cvector_t* vec);
  * initialized.
  * TODO: provide a variant that takes an initializer function
  */
+LIBRARY_INLINE
 void
 cvector_resize(cvector_t* vec, size_t count);
 
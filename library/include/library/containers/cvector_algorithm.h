@@ -0,0 +1,87 @@
+/**
+ * @file cvector_algorithm.h
+ * @author khalilhenoud@gmail.com
+ * @brief sorting and searching over cvector_t
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef LIB_VECTOR_ALGORITHM_H
+#define LIB_VECTOR_ALGORITHM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <library/internal/module.h>
+#include <library/type_registry/type_registry.h>
+
+#define CVECTOR_SORT_PARALLEL_MIN     (1 << 16)
+
+
+////////////////////////////////////////////////////////////////////////////////
+// NOTES:
+//  - a NULL 'compare' or 'is_equal' falls back on the element vtable, it
+//    asserts if the type registered none.
+//  - elements are moved around as raw bytes, like cvector_insert() does.
+//  - the registered integer and floating point types are radix sorted when no
+//    custom comparator is given (or it is the registered one). floats follow
+//    the registered order, -0 before +0 and NaNs at both ends.
+//  - with a job system of more than one worker and CVECTOR_SORT_PARALLEL_MIN
+//    elements or more, chunks are sorted on the workers and merged in parallel
+//    (merge path). the call must come from the thread owning 'jobs'.
+//  - temporary memory comes from the vector's allocator, on the calling thread.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct cvector_t cvector_t;
+typedef struct job_system_t job_system_t;
+
+/** 'user_data' is passed through, returns non zero for the leading group. */
+typedef uint32_t (*cvector_predicate_t)(const void *elem, void *user_data);
+
+/** introsort, equal elements end up in no particular order. */
+LIBRARY_API
+void
+cvector_sort(cvector_t *vec, fn_compare_t compare, job_system_t *jobs);
+
+/** merge sort, equal elements keep their relative order. */
+LIBRARY_API
+void
+cvector_stable_sort(cvector_t *vec, fn_compare_t compare, job_system_t *jobs);
+
+/**
+ * drops every element equal to the one before it, the dropped ones are
+ * cleaned up. returns the new size.
+ */
+LIBRARY_API
+size_t
+cvector_unique(cvector_t *vec, fn_is_equal_t is_equal);
+
+/**
+ * moves the elements matching 'predicate' to the front, not stable. returns
+ * the index of the first element that does not match.
+ */
+LIBRARY_API
+size_t
+cvector_partition(
+  cvector_t *vec,
+  cvector_predicate_t predicate,
+  void *user_data);
+
+/** index of the first element not ordered before 'key', size if none. */
+LIBRARY_API
+size_t
+cvector_lower_bound(
+  const cvector_t *vec,
+  const void *key,
+  fn_compare_t compare);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -19,6 +19,20 @@
     #endif
 #endif
 
+// NOTE: a read hint that brings the line holding 'addr' into the cache, it does
+// not fault on an invalid address. a no-op where no intrinsic is known.
+#ifndef PREFETCH
+    #if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        #include <xmmintrin.h>
+        #define PREFETCH(addr) \
+            _mm_prefetch((const char *)(addr), _MM_HINT_T0)
+    #elif defined(__GNUC__) || defined(__clang__)
+        #define PREFETCH(addr)      __builtin_prefetch((addr), 0, 3)
+    #else
+        #define PREFETCH(addr)      ((void)(addr))
+    #endif
+#endif
+
 // NOTE: this code is provided by Joe Lowe and initially found at:
 // https://stackoverflow.com/questions/1113409/attribute-constructor-equivalent-in-vc
 // NOTE: also see for more info on pragma(comment(...)):
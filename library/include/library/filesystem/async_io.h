@@ -0,0 +1,163 @@
+/**
+ * @file async_io.h
+ * @author khalilhenoud@gmail.com
+ * @brief asynchronous positional reads/writes against file handles
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef LIB_ASYNC_IO_H
+#define LIB_ASYNC_IO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <library/internal/module.h>
+#include <library/filesystem/io.h>
+#include <library/threading/mutex.h>
+#include <library/threading/thread.h>
+
+#define ASYNC_IO_MAX_WORKERS          16
+
+
+////////////////////////////////////////////////////////////////////////////////
+// NOTES:
+//  - requests are owned by the caller and must stay alive (and untouched) until
+//    they complete, nothing is allocated per request.
+//  - a request doubles as its own future, poll or wait on it. the completion
+//    callback runs on an io thread, before the request reports completion, it
+//    can submit follow up requests.
+//  - io is positional (pread/pwrite semantics) on the handle's descriptor, do
+//    not mix it with buffered read_buffer/write_buffer on the same handle.
+//  - linux uses io_uring when the kernel allows it, every other case falls
+//    back to a pool of worker threads doing blocking io.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct allocator_t allocator_t;
+
+typedef
+enum async_io_backend_t {
+  ASYNC_IO_BACKEND_AUTO,
+  ASYNC_IO_BACKEND_THREADS,
+  ASYNC_IO_BACKEND_IO_URING
+} async_io_backend_t;
+
+typedef
+enum async_io_status_t {
+  ASYNC_IO_STATUS_IDLE,
+  ASYNC_IO_STATUS_PENDING,
+  ASYNC_IO_STATUS_DONE,
+  ASYNC_IO_STATUS_FAILED
+} async_io_status_t;
+
+typedef
+enum async_io_op_t {
+  ASYNC_IO_OP_READ,
+  ASYNC_IO_OP_WRITE
+} async_io_op_t;
+
+typedef struct async_io_request_t async_io_request_t;
+typedef void (*async_io_callback_t)(async_io_request_t *request);
+
+typedef
+struct async_io_request_t {
+  file_handle_t file;
+  async_io_op_t op;
+  void *buffer;
+  size_t size;
+  uint64_t offset;
+  async_io_callback_t fn_complete;      // optional
+  void *user_data;
+
+  // filled in on completion.
+  size_t transferred;                   // < size on a read past the end.
+  int32_t error;                        // errno/GetLastError() style code.
+  volatile uint32_t status;             // async_io_status_t
+
+  // internal.
+  async_io_request_t *next;
+  uintptr_t iov[2];                     // struct iovec storage for io_uring
+} async_io_request_t;
+
+// opaque io_uring state.
+typedef struct async_io_ring_t async_io_ring_t;
+
+typedef
+struct async_io_t {
+  async_io_backend_t backend;
+  const allocator_t *allocator;
+  mutex_t mutex;
+  condvar_t pending;                    // workers wait for requests
+  condvar_t completed;                  // waiters wait for completions
+  async_io_request_t *head;
+  async_io_request_t *tail;
+  uint32_t stop;
+  uint32_t thread_count;
+  thread_handle_t threads[ASYNC_IO_MAX_WORKERS];
+  async_io_ring_t *ring;
+} async_io_t;
+
+/**
+ * 'worker_count' sizes the thread pool fallback (0 picks one per logical
+ * core, capped at ASYNC_IO_MAX_WORKERS). returns the backend that is in use.
+ */
+LIBRARY_API
+async_io_backend_t
+async_io_setup(
+  async_io_t *io,
+  async_io_backend_t backend,
+  uint32_t worker_count,
+  const allocator_t *allocator);
+
+/** waits for all in flight requests and stops the io threads. */
+LIBRARY_API
+void
+async_io_cleanup(async_io_t *io);
+
+/** queues the request, its status becomes ASYNC_IO_STATUS_PENDING. */
+LIBRARY_API
+void
+async_io_submit(async_io_t *io, async_io_request_t *request);
+
+/** non-blocking, returns the async_io_status_t of the request. */
+LIBRARY_API
+uint32_t
+async_io_poll(const async_io_request_t *request);
+
+/** blocks until the request completes, returns its final status. */
+LIBRARY_API
+uint32_t
+async_io_wait(async_io_t *io, async_io_request_t *request);
+
+/** convenience setup of a read request, the callback can be NULL. */
+LIBRARY_API
+void
+async_io_request_read(
+  async_io_request_t *request,
+  file_handle_t file,
+  void *buffer,
+  size_t size,
+  uint64_t offset,
+  async_io_callback_t fn_complete,
+  void *user_data);
+
+LIBRARY_API
+void
+async_io_request_write(
+  async_io_request_t *request,
+  file_handle_t file,
+  const void *buffer,
+  size_t size,
+  uint64_t offset,
+  async_io_callback_t fn_complete,
+  void *user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,127 @@
+/**
+ * @file directory.h
+ * @author khalilhenoud@gmail.com
+ * @brief streaming directory iteration and parallel recursive walks
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef LIB_DIRECTORY_H
+#define LIB_DIRECTORY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <library/internal/module.h>
+#include <library/filesystem/filesystem.h>
+
+#define DIR_ITERATOR_STORAGE          640
+
+
+////////////////////////////////////////////////////////////////////////////////
+// NOTES:
+//  - the iterator lives on the caller's stack, nothing is allocated. entries
+//    are yielded one at a time and '.'/'..' are skipped.
+//  - an entry's name is only valid until the next call on the iterator.
+//  - size and mtime cost a stat per entry on posix, they are only filled when
+//    DIR_FLAG_STAT is passed (win32 gets them for free and always fills them).
+//  - mtime is in nanoseconds since the unix epoch.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct allocator_t allocator_t;
+
+typedef
+enum dir_flags_t {
+  DIR_FLAG_NONE = 0,
+  DIR_FLAG_STAT = 1 << 0
+} dir_flags_t;
+
+typedef
+enum dir_entry_type_t {
+  DIR_ENTRY_FILE,
+  DIR_ENTRY_DIRECTORY,
+  DIR_ENTRY_OTHER                       // links, devices, pipes...
+} dir_entry_type_t;
+
+typedef
+struct dir_entry_t {
+  const char *name;
+  uint32_t name_length;
+  uint32_t type;                        // dir_entry_type_t
+  uint64_t size;
+  uint64_t mtime;
+} dir_entry_t;
+
+typedef
+struct dir_iterator_t {
+  uint32_t flags;
+  uint32_t pending;                     // an entry was read ahead (win32)
+  union {
+    void *align;
+    uint8_t bytes[DIR_ITERATOR_STORAGE];
+  } storage;
+} dir_iterator_t;
+
+/** returns 0 if 'directory' cannot be opened. */
+LIBRARY_API
+uint32_t
+dir_iterator_open(
+  dir_iterator_t *iterator,
+  const char *directory,
+  uint32_t flags);
+
+/** returns 0 once every entry was yielded. */
+LIBRARY_API
+uint32_t
+dir_iterator_next(dir_iterator_t *iterator, dir_entry_t *entry);
+
+LIBRARY_API
+void
+dir_iterator_close(dir_iterator_t *iterator);
+
+////////////////////////////////////////////////////////////////////////////////
+// recursive walks:
+//  - directories are handed out to 'worker_count' threads (the caller being
+//    one of them), 'fn' is called concurrently with the worker index so it
+//    can write to per-worker storage.
+//  - 'path' is the full path of the entry. returning 0 from 'fn' for a
+//    directory prunes it, the return value is ignored for other entries.
+//  - entries whose path exceeds MAX_PATH_LENGTH are counted as skipped, so
+//    is a root that long (nothing is walked).
+//  - 'allocator' is only used under the walker's lock, once per directory.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef
+uint32_t (*dir_walk_fn_t)(
+  const char *path,
+  const dir_entry_t *entry,
+  uint32_t worker,
+  void *user_data);
+
+typedef
+struct dir_walk_stats_t {
+  uint64_t directories;
+  uint64_t files;
+  uint64_t skipped;                     // unreadable directories, long paths
+} dir_walk_stats_t;
+
+LIBRARY_API
+void
+dir_walk(
+  const char *root,
+  uint32_t flags,
+  uint32_t worker_count,
+  dir_walk_fn_t fn,
+  void *user_data,
+  const allocator_t *allocator,
+  dir_walk_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -33,6 +33,7 @@ struct dir_entries_t {
   uint32_t used;
 } dir_entries_t;
 
+// NOTE: lists at most MAX_DIR_ENTRIES, see directory.h for large trees.
 LIBRARY_API
 void
 get_subdirectories(
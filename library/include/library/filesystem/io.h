@@ -15,6 +15,7 @@
 extern "C" {
 #endif
 
+#include <stddef.h>
 #include <stdint.h>
 #include <library/internal/module.h>
 
@@ -63,6 +64,25 @@ LIBRARY_API
 uint32_t
 file_exists(const char *path);
 
+////////////////////////////////////////////////////////////////////////////////
+// read-only file mappings, the pages are faulted in by the os on access.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef
+struct file_mapping_t {
+  const void *data;
+  size_t size;
+} file_mapping_t;
+
+/** returns 0 if the file cannot be opened, is empty or cannot be mapped. */
+LIBRARY_API
+uint32_t
+map_file(const char *path, file_mapping_t *mapping);
+
+LIBRARY_API
+void
+unmap_file(file_mapping_t *mapping);
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,8 +18,29 @@ extern "C" {
 #include <stdint.h>
 #include <library/internal/module.h>
 
-#define BUFFER_TIME_MS                1
+#define FRAMERATE_STATS_WINDOW        256
 
+////////////////////////////////////////////////////////////////////////////////
+// NOTES:
+//  - a locked controller paces frames against absolute deadlines kept in
+//    performance counter ticks, time a frame runs late is taken off the next.
+//  - the wait sleeps in 1 ms steps while the measured sleep overshoot still
+//    fits, then spins on the counter. set_periodic_timers_resolution() makes
+//    the sleeps tighter and leaves less to spin.
+//  - a frame lasts from one controller_start() to the next. the last
+//    FRAMERATE_STATS_WINDOW of them feed min/avg/max and a log-linear
+//    histogram (~3% wide buckets) the percentiles are read from. none of the
+//    stats calls allocate.
+//  - a frame spanning n target periods (rounded) counts n - 1 as dropped.
+//  - with a fixed step set, every controller_start() adds the frame's ticks
+//    to an accumulator and turns it into whole simulation steps. the
+//    accumulator is kept in ticks * steps_per_second so a step is exactly
+//    ticks_per_second of it, no rounding builds up. past 'max_steps' in a
+//    frame the backlog is thrown away (counted as skipped) rather than let
+//    the simulation fall further behind every frame.
+//  - controller_set_clock() replaces the performance counter and os_sleep()
+//    with another time source, a simulated one makes the pacing deterministic.
+////////////////////////////////////////////////////////////////////////////////
 
 typedef struct allocator_t allocator_t;
 typedef struct framerate_controller_t framerate_controller_t;
@@ -31,6 +52,29 @@ enum framerate_duration_t {
   FPS_DURATION_COUNT
 } framerate_duration_t;
 
+typedef
+struct framerate_stats_t {
+  uint32_t frames;                      // in the window
+  double min_ms;
+  double avg_ms;
+  double max_ms;
+  double p50_ms;
+  double p95_ms;
+  double p99_ms;
+  double p999_ms;
+  double smoothed_fps;                  // exponentially weighted
+  uint64_t dropped_frames;              // since setup or the last reset
+  uint64_t total_frames;
+} framerate_stats_t;
+
+typedef
+struct framerate_clock_t {
+  uint64_t (*fn_ticks)(void *user_data);
+  void (*fn_sleep)(void *user_data, uint32_t ms);
+  uint64_t ticks_per_second;
+  void *user_data;
+} framerate_clock_t;
+
 LIBRARY_API
 framerate_controller_t *
 controller_allocate(
@@ -66,8 +110,69 @@ LIBRARY_API
 void
 unlock_fps(framerate_controller_t *controller);
 
+/** frame time in ms at 'percentile' (0 to 100) over the window, 0 if empty. */
+LIBRARY_API
+double
+controller_frame_percentile(
+  framerate_controller_t *controller,
+  double percentile);
+
+LIBRARY_API
+void
+controller_get_stats(
+  framerate_controller_t *controller,
+  framerate_stats_t *stats);
+
+LIBRARY_API
+void
+controller_reset_stats(framerate_controller_t *controller);
+
+/**
+ * 'clock' is copied, NULL goes back to the os clock. the schedule, the sleep
+ * estimate, the stats and the fixed step backlog start over.
+ */
+LIBRARY_API
+void
+controller_set_clock(
+  framerate_controller_t *controller,
+  const framerate_clock_t *clock);
+
+/**
+ * decouples the simulation from the frame rate, 0 steps_per_second turns it
+ * off. 'max_steps' caps the steps run in one frame, at least 1.
+ */
+LIBRARY_API
+void
+controller_set_fixed_step(
+  framerate_controller_t *controller,
+  uint64_t steps_per_second,
+  uint32_t max_steps);
+
+/** the simulation steps to run this frame, set by controller_start(). */
+LIBRARY_API
+uint32_t
+controller_fixed_steps(framerate_controller_t *controller);
+
+/** the step length in seconds. */
+LIBRARY_API
+double
+controller_fixed_dt(framerate_controller_t *controller);
+
+/**
+ * how far into the next step the frame is, in [0, 1). renders blend the last
+ * two simulated states by it.
+ */
+LIBRARY_API
+double
+controller_fixed_alpha(framerate_controller_t *controller);
+
+/** steps thrown away by the 'max_steps' clamp since the step was set. */
+LIBRARY_API
+uint64_t
+controller_fixed_skipped(framerate_controller_t *controller);
+
 #ifdef __cplusplus
 }
 #endif
 
-#endif
+#endif
\ No newline at end of file
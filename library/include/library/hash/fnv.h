@@ -15,7 +15,9 @@
 extern "C" {
 #endif
 
+#include <stddef.h>
 #include <stdint.h>
+#include <library/internal/module.h>
 
 #define FNV32_PRIME           0x01000193
 #define FNV32_OFFSET_BASIS    0x811c9dc5
@@ -23,9 +25,11 @@ extern "C" {
 #define FNV64_OFFSET_BASIS    0xcbf29ce484222325
 
 
+LIBRARY_INLINE
 uint32_t
 hash_fnv1a_32(const void* bytes, size_t length);
 
+LIBRARY_INLINE
 uint64_t
 hash_fnv1a_64(const void* bytes, size_t length);
 
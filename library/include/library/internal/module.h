@@ -12,3 +12,14 @@
 
 #endif // !defined(LIBRARY_API)
 
+
+// the functions defined in the headers are 'inline' in every translation
+// unit, source/internal/inline.c defines LIBRARY_INLINE_DEFINITIONS and emits
+// the single out-of-line definition of each.
+#if !defined(LIBRARY_INLINE)
+	#if defined(LIBRARY_INLINE_DEFINITIONS) && !defined(__cplusplus)
+		#define LIBRARY_INLINE extern inline
+	#else
+		#define LIBRARY_INLINE inline
+	#endif
+#endif // !defined(LIBRARY_INLINE)
\ No newline at end of file
@@ -94,9 +94,11 @@ int32_t
 set_cursor_position(int32_t x, int32_t y);
 
 ////////////////////////////////////////////////////////////////////////////////
+// NOTE: not sleep(), a global sleep() would take the place of libc's sleep(3)
+// in every process that loads the library.
 LIBRARY_API
 void
-sleep(uint64_t ms);
+os_sleep(uint64_t ms);
 
 ////////////////////////////////////////////////////////////////////////////////
 LIBRARY_API
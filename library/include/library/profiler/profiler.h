@@ -0,0 +1,150 @@
+/**
+ * @file profiler.h
+ * @author khalilhenoud@gmail.com
+ * @brief scoped cpu profiler, per frame call trees and chrome trace output
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef LIB_PROFILER_H
+#define LIB_PROFILER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <library/internal/module.h>
+
+#define PROFILER_MAX_THREADS          64
+#define PROFILER_MAX_DEPTH            64
+#define PROFILER_RING_CAPACITY        (1 << 14)   // events, per thread
+#define PROFILER_TRACE_MAX            (1 << 18)   // spans kept for the trace
+#define PROFILER_INVALID_NODE         ((uint32_t)-1)
+
+
+////////////////////////////////////////////////////////////////////////////////
+// NOTES:
+//  - every thread writes begin/end events into its own single producer ring
+//    (a cring_t), no locks are taken on the instrumented path. a full ring
+//    drops events, see profiler_dropped_events().
+//  - profiler_frame_end(), called once a frame from one thread, drains the
+//    rings into a call tree per thread (a node per distinct path) and into
+//    the span list profiler_write_chrome_trace() exports.
+//  - a scope still open at frame end is counted in the frame it closes in.
+//  - names are compared by pointer first, string literals are expected.
+//  - the PROFILE_* macros compile to nothing unless LIBRARY_PROFILE is
+//    defined, the functions are always there.
+//  - PROFILE_SCOPE() closes itself when the enclosing block exits. it needs
+//    c++ or the gcc/clang cleanup attribute, PROFILE_BEGIN/END work anywhere.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct allocator_t allocator_t;
+
+typedef
+struct profiler_node_t {
+  const char *name;
+  uint32_t thread;
+  uint32_t depth;
+  uint32_t parent;                      // PROFILER_INVALID_NODE for roots
+  uint32_t first_child;
+  uint32_t next_sibling;
+  uint32_t calls;
+  uint64_t total_ticks;
+  uint64_t child_ticks;
+  double total_ms;
+  double self_ms;
+} profiler_node_t;
+
+/** 'allocator' must be thread safe, the thread rings come from it. */
+LIBRARY_API
+void
+profiler_setup(const allocator_t *allocator);
+
+/** no thread may be inside a scope anymore. */
+LIBRARY_API
+void
+profiler_cleanup(void);
+
+/** no-ops while the profiler is not setup. */
+LIBRARY_API
+void
+profiler_begin(const char *name);
+
+LIBRARY_API
+void
+profiler_end(void);
+
+/** drains every thread's events, the previous frame's tree is replaced. */
+LIBRARY_API
+void
+profiler_frame_end(void);
+
+/**
+ * the nodes of the last frame, in order of first appearance (a parent comes
+ * before its children). valid until the next profiler_frame_end().
+ */
+LIBRARY_API
+const profiler_node_t *
+profiler_frame_nodes(uint32_t *count);
+
+LIBRARY_API
+uint64_t
+profiler_dropped_events(void);
+
+/**
+ * writes the spans collected so far as chrome trace json (chrome://tracing,
+ * perfetto) and forgets them. returns 0 if the file could not be written.
+ */
+LIBRARY_API
+uint32_t
+profiler_write_chrome_trace(const char *path);
+
+#if defined(LIBRARY_PROFILE)
+
+#define PROFILE_CONCAT_(a, b)         a##b
+#define PROFILE_CONCAT(a, b)          PROFILE_CONCAT_(a, b)
+#define PROFILE_BEGIN(name)           profiler_begin(name)
+#define PROFILE_END()                 profiler_end()
+
+#if defined(__cplusplus)
+
+struct profile_scope_t {
+  profile_scope_t(const char *name) { profiler_begin(name); }
+  ~profile_scope_t() { profiler_end(); }
+};
+
+#define PROFILE_SCOPE(name) \
+  profile_scope_t PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+
+#elif defined(__GNUC__) || defined(__clang__)
+
+LIBRARY_INLINE
+void
+profile_scope_close(const char **name)
+{
+  (void)name;
+  profiler_end();
+}
+
+#define PROFILE_SCOPE(name)                                                   \
+  const char *PROFILE_CONCAT(profile_scope_, __LINE__)                        \
+    __attribute__((cleanup(profile_scope_close))) =                           \
+    (profiler_begin(name), (name))
+#endif
+
+#else
+
+#define PROFILE_BEGIN(name)
+#define PROFILE_END()
+#define PROFILE_SCOPE(name)
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,186 @@
+/**
+ * @file binary_archive.h
+ * @author khalilhenoud@gmail.com
+ * @brief versioned, self-describing framing on top of binary_stream_t
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef LIB_BINARY_ARCHIVE_H
+#define LIB_BINARY_ARCHIVE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <library/internal/module.h>
+#include <library/type_registry/type_registry.h>
+
+// 'CLAR' when read as little endian bytes.
+#define ARCHIVE_MAGIC                 0x52414c43u
+// the magic of an archive written on a host of the other endianness.
+#define ARCHIVE_MAGIC_SWAPPED         0x434c4152u
+#define ARCHIVE_VERSION               1
+// written in host order, reads back as ARCHIVE_ENDIAN_SWAPPED on a mismatch.
+#define ARCHIVE_ENDIAN_TAG            0x01020304u
+#define ARCHIVE_ENDIAN_SWAPPED        0x04030201u
+
+
+////////////////////////////////////////////////////////////////////////////////
+// layout:
+//  [archive_header_t][archive_block_t][payload]...[archive_block_t][payload]
+// NOTES:
+//  - a payload is whatever the type's fn_serialize writes, the block header
+//    carries the type id/size, the stream flags used to write it, the payload
+//    length and an fnv1a checksum of the payload.
+//  - blocks of unknown (unregistered) types can be skipped using the length.
+//  - payloads are opaque, so a file written on a host with a different byte
+//    order is rejected rather than swapped.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct allocator_t allocator_t;
+typedef struct binary_stream_t binary_stream_t;
+
+typedef
+enum archive_result_t {
+  ARCHIVE_OK,
+  ARCHIVE_ERROR_EOF,
+  ARCHIVE_ERROR_MAGIC,
+  ARCHIVE_ERROR_VERSION,
+  ARCHIVE_ERROR_ENDIANNESS,
+  ARCHIVE_ERROR_CHECKSUM,
+  ARCHIVE_ERROR_UNKNOWN_TYPE,
+  ARCHIVE_ERROR_TYPE_SIZE,
+  ARCHIVE_ERROR_COUNT
+} archive_result_t;
+
+typedef
+struct archive_header_t {
+  uint32_t magic;
+  uint32_t endian_tag;
+  uint32_t version;
+  uint32_t flags;                 // default binary_stream_flags_t of the blocks
+} archive_header_t;
+
+typedef
+struct archive_block_t {
+  type_id_t type_id;
+  uint32_t type_size;
+  uint32_t flags;                 // binary_stream_flags_t used by the payload
+  uint32_t checksum;              // hash_fnv1a_32 of the payload
+  uint64_t length;                // payload length in bytes
+} archive_block_t;
+
+// writes the header and sets the stream flags to 'flags'.
+LIBRARY_API
+void
+binary_archive_write_header(binary_stream_t *stream, uint32_t flags);
+
+// validates the header and sets the stream flags to the recorded ones.
+LIBRARY_API
+archive_result_t
+binary_archive_read_header(
+  binary_stream_t *stream,
+  archive_header_t *header);
+
+/**
+ * serializes 'src' using the registered fn_serialize of 'type_id' into a new
+ * block, the current stream flags are recorded in the block.
+ */
+LIBRARY_API
+void
+binary_archive_write_block(
+  binary_stream_t *stream,
+  type_id_t type_id,
+  const void *src);
+
+/** reads the next block header, the stream is left at the payload start. */
+LIBRARY_API
+archive_result_t
+binary_archive_read_block_header(
+  binary_stream_t *stream,
+  archive_block_t *block);
+
+/** moves past the payload of a block whose header was just read. */
+LIBRARY_API
+void
+binary_archive_skip_block(
+  binary_stream_t *stream,
+  const archive_block_t *block);
+
+/**
+ * validates the payload against the header (checksum, registered type and
+ * size) then deserializes it into 'dst' using the type's fn_deserialize.
+ * NOTE: on failure the payload is skipped and 'dst' is left untouched.
+ */
+LIBRARY_API
+archive_result_t
+binary_archive_read_block(
+  binary_stream_t *stream,
+  const archive_block_t *block,
+  void *dst,
+  const allocator_t *allocator);
+
+LIBRARY_API
+const char *
+binary_archive_result_str(archive_result_t result);
+
+////////////////////////////////////////////////////////////////////////////////
+// parallel loading:
+//  - binary_archive_scan_blocks() records the payload offset of every block by
+//    hopping over the block headers, payloads are not touched.
+//  - binary_archive_load_parallel() then decodes the blocks concurrently, each
+//    worker claims the next block and decodes it into an instance allocated
+//    from its own allocator (allocators[worker]), so allocators need not be
+//    thread safe as long as they are distinct.
+//  - the stream is only read from, blocks must be independent of each other.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef
+struct archive_load_t {
+  archive_block_t block;
+  size_t offset;                  // payload offset within the stream
+  void *dst;                      // decoded instance, NULL on failure
+  const allocator_t *allocator;   // the allocator 'dst' was decoded with
+  archive_result_t result;
+} archive_load_t;
+
+/**
+ * reads the block headers following the archive header (the stream must be
+ * positioned past it), fills up to 'capacity' entries and returns the number
+ * of blocks in the archive, which can exceed 'capacity'.
+ * NOTE: a truncated trailing block is not counted.
+ */
+LIBRARY_API
+uint32_t
+binary_archive_scan_blocks(
+  binary_stream_t *stream,
+  archive_load_t *loads,
+  uint32_t capacity);
+
+/**
+ * decodes the scanned blocks on 'worker_count' threads (the calling thread
+ * being one of them), returns the number of blocks that failed.
+ */
+LIBRARY_API
+uint32_t
+binary_archive_load_parallel(
+  const binary_stream_t *stream,
+  archive_load_t *loads,
+  uint32_t count,
+  const allocator_t *allocators[],
+  uint32_t worker_count);
+
+/** cleans up and frees the decoded instances. */
+LIBRARY_API
+void
+binary_archive_load_cleanup(archive_load_t *loads, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -26,19 +26,31 @@ extern "C" {
 
 
 ////////////////////////////////////////////////////////////////////////////////
-// TODO:
-//  - support seeking, among other functionality.
 // NOTE:
 //  - we do not allocate until the first write request.
+//  - flags are read by the type serializers, they change the layout of what is
+//    written (see binary_archive.h, which records them per block).
 ////////////////////////////////////////////////////////////////////////////////
 
 typedef struct cvector_t cvector_t;
+typedef struct stream_codec_t stream_codec_t;
+
+typedef
+enum binary_stream_flags_t {
+  STREAM_FLAG_NONE = 0,
+  // containers do not write their capacity, loads allocate 'size' elements.
+  STREAM_FLAG_OMIT_CAPACITY = 1 << 0,
+  // lengths are written as LEB128 varints and hashmaps drop their index table
+  // (it is rebuilt on load).
+  STREAM_FLAG_COMPACT = 1 << 1
+} binary_stream_flags_t;
 
 typedef
 struct binary_stream_t {
   cvector_t *data;
   size_t pos;
   const allocator_t *allocator;
+  uint32_t flags;
 } binary_stream_t;
 
 LIBRARY_API
@@ -78,14 +90,55 @@ binary_stream_read2(
   uint8_t buffer[],
   size_t buffer_size);
 
-// NOTE: the user is responsible for freeing the returned instance
+// writes 'value' as an unsigned LEB128 varint (1 to 10 bytes).
+LIBRARY_API
+void
+binary_stream_write_varint(binary_stream_t *stream, uint64_t value);
+
+// reads an unsigned LEB128 varint and increments pos. returns 0 at the end
+// of the stream, and on a truncated or overlong varint, which also moves pos to
+// STREAM_EOF.
+LIBRARY_API
+uint64_t
+binary_stream_read_varint(binary_stream_t *stream);
+
+// returns the number of bytes written to the stream so far.
+LIBRARY_API
+size_t
+binary_stream_size(const binary_stream_t *stream);
+
+// returns the read position, STREAM_EOF if everything was consumed.
+LIBRARY_API
+size_t
+binary_stream_tell(const binary_stream_t *stream);
+
+// moves the read position, seeking to the size of the stream yields STREAM_EOF.
+LIBRARY_API
+void
+binary_stream_seek(binary_stream_t *stream, size_t pos);
+
+/**
+ * NOTE: the user is responsible for freeing the returned instance. files
+ * written with a codec (see stream_file.h) are decoded transparently, NULL is
+ * returned if such a file is malformed.
+ */
 LIBRARY_API
 binary_stream_t *
 binary_stream_from_file(
   const char *path,
   const allocator_t *allocator);
 
-// TODO: add a binary_stream_to_file() function. it is useful
+/**
+ * writes the stream content to 'path', as is if 'codec' is NULL, otherwise as
+ * a block compressed stream file. returns 0 if the file could not be created
+ * or a write came up short.
+ */
+LIBRARY_API
+uint32_t
+binary_stream_to_file(
+  const binary_stream_t *stream,
+  const char *path,
+  const stream_codec_t *codec);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,71 @@
+/**
+ * @file stream_codec.h
+ * @author khalilhenoud@gmail.com
+ * @brief pluggable block transforms used by the compressed stream files
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef LIB_STREAM_CODEC_H
+#define LIB_STREAM_CODEC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <library/internal/module.h>
+
+#define STREAM_CODEC_MAX_COUNT        8
+#define STREAM_CODEC_LZ_ID            1
+
+
+////////////////////////////////////////////////////////////////////////////////
+// NOTES:
+//  - a codec transforms one block at a time, blocks are independent of each
+//    other which allows decoding a block while the next one is being read.
+//  - the id is recorded in the file, it has to be unique and stable.
+//  - fn_encode returns 0 if the output does not fit 'dst_capacity', the
+//    caller then stores the block as is.
+//  - fn_decode must not trust 'src', it returns the number of bytes produced
+//    or 0 if the input is malformed.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef
+struct stream_codec_t {
+  uint32_t id;
+  const char *name;
+  size_t (*fn_bound)(size_t src_size);
+  size_t (*fn_encode)(
+    const uint8_t *src, size_t src_size,
+    uint8_t *dst, size_t dst_capacity);
+  size_t (*fn_decode)(
+    const uint8_t *src, size_t src_size,
+    uint8_t *dst, size_t dst_size);
+} stream_codec_t;
+
+/**
+ * lz77 byte oriented codec in the lz4 family: greedy hash chain-less matching,
+ * 64KB window, no entropy stage. favours decode speed over ratio.
+ */
+LIBRARY_API
+extern const stream_codec_t g_lz_codec;
+
+/** makes a codec available to the readers, the built-in one is implicit. */
+LIBRARY_API
+void
+stream_codec_register(const stream_codec_t *codec);
+
+/** NULL if no codec with that id was registered. */
+LIBRARY_API
+const stream_codec_t *
+stream_codec_find(uint32_t id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,114 @@
+/**
+ * @file stream_file.h
+ * @author khalilhenoud@gmail.com
+ * @brief block compressed files, written incrementally and read back while
+ * decoding
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef LIB_STREAM_FILE_H
+#define LIB_STREAM_FILE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <library/internal/module.h>
+#include <library/filesystem/io.h>
+
+// 'CLZS' when read as little endian bytes.
+#define STREAM_FILE_MAGIC             0x535a4c43u
+#define STREAM_FILE_VERSION           1
+#define STREAM_FILE_BLOCK_SIZE        (64 * 1024)
+// set in stored_size when the block did not compress and is kept as is.
+#define STREAM_FILE_STORED_RAW        0x80000000u
+// number of blocks the reader thread can run ahead of the decoder.
+#define STREAM_FILE_READ_AHEAD        4
+
+
+////////////////////////////////////////////////////////////////////////////////
+// layout:
+//  [stream_file_header_t][stream_file_block_t][bytes]...[0, 0]
+// NOTES:
+//  - blocks are encoded independently, a zeroed block header ends the file.
+//  - binary_stream_from_file() recognizes the magic and reads the blocks on a
+//    separate thread so file reads overlap with decoding.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct allocator_t allocator_t;
+typedef struct binary_stream_t binary_stream_t;
+typedef struct stream_codec_t stream_codec_t;
+
+typedef
+struct stream_file_header_t {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t codec_id;
+  uint32_t block_size;            // upper bound of a block's raw size
+} stream_file_header_t;
+
+typedef
+struct stream_file_block_t {
+  uint32_t raw_size;
+  uint32_t stored_size;           // byte count, can carry STREAM_FILE_STORED_RAW
+} stream_file_block_t;
+
+typedef
+struct stream_writer_t {
+  file_handle_t file;
+  const stream_codec_t *codec;
+  const allocator_t *allocator;
+  uint8_t *block;                 // pending raw bytes
+  size_t block_used;
+  uint8_t *encoded;
+  size_t encoded_capacity;
+  uint64_t raw_bytes;
+  uint64_t file_bytes;
+  uint32_t failed;                // a write came up short, sticky
+} stream_writer_t;
+
+/** opens 'path' for writing, returns 0 if the file could not be created. */
+LIBRARY_API
+uint32_t
+stream_writer_setup(
+  stream_writer_t *writer,
+  const char *path,
+  const stream_codec_t *codec,
+  const allocator_t *allocator);
+
+/** buffers 'size' bytes, every full block is encoded and written out. */
+LIBRARY_API
+void
+stream_writer_write(stream_writer_t *writer, const void *data, size_t size);
+
+/**
+ * flushes the pending block, terminates and closes the file. returns 0 if any
+ * write since the setup came up short, the file is then incomplete.
+ */
+LIBRARY_API
+uint32_t
+stream_writer_cleanup(stream_writer_t *writer);
+
+/** 1 if the file starts with a stream file header. */
+LIBRARY_API
+uint32_t
+stream_file_is_compressed(const char *path);
+
+/**
+ * decodes a stream file into a new binary stream, returns NULL if the file is
+ * malformed or uses an unregistered codec.
+ * NOTE: the user is responsible for freeing the returned instance.
+ */
+LIBRARY_API
+binary_stream_t *
+stream_file_read(const char *path, const allocator_t *allocator);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
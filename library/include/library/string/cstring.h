@@ -20,6 +20,7 @@ extern "C" {
 #include <string.h>
 #include <library/allocator/allocator.h>
 #include <library/hash/fnv.h>
+#include <library/internal/module.h>
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -35,6 +36,7 @@ extern "C" {
 //|    *_deserialize            | YES
 //|    *_hash                   | YES
 //|    *_is_equal               | YES
+//|    *_compare                | YES
 //|    *_type_size              | YES
 //|    *_type_alignment         |
 //|    *_type_id_count          |
@@ -59,7 +61,7 @@ struct cstring_t {
   const allocator_t *allocator;
 } cstring_t;
 
-inline
+LIBRARY_INLINE
 void
 cstring_def(void *ptr)
 {
@@ -71,7 +73,7 @@ cstring_def(void *ptr)
   }
 }
 
-inline
+LIBRARY_INLINE
 uint32_t
 cstring_is_def(const void *ptr)
 {
@@ -87,49 +89,62 @@ cstring_is_def(const void *ptr)
  * NOTE: will assert if 'src' is not initialized, or if 'dst' is initialized but
  * with non-zero size.
  */
+LIBRARY_INLINE
 void
 cstring_replicate(
   const void *src,
   void *dst,
   const allocator_t* allocator);
 
+LIBRARY_INLINE
 void
 cstring_fullswap(void* lhs, void* rhs);
 
+LIBRARY_INLINE
 void
 cstring_serialize(
   const void *src,
   binary_stream_t* stream);
 
+LIBRARY_INLINE
 void
 cstring_deserialize(
   void *dst,
   const allocator_t *allocator,
   binary_stream_t* stream);
 
+LIBRARY_INLINE
 uint32_t
 cstring_hash(const void *ptr);
 
+LIBRARY_INLINE
 uint32_t
 cstring_is_equal(
   const void *lhs,
   const void *rhs);
 
-inline
+/** lexicographic, strcmp() order. */
+LIBRARY_INLINE
+int32_t
+cstring_compare(
+  const void *lhs,
+  const void *rhs);
+
+LIBRARY_INLINE
 size_t
 cstring_type_size(void)
 {
   return sizeof(cstring_t);
 }
 
-inline
+LIBRARY_INLINE
 uint32_t
 cstring_owns_alloc(void)
 {
   return 1;
 }
 
-inline
+LIBRARY_INLINE
 const allocator_t*
 cstring_get_alloc(const void *ptr)
 {
@@ -138,48 +153,58 @@ cstring_get_alloc(const void *ptr)
   return cstr->allocator;
 }
 
+LIBRARY_INLINE
 void
 cstring_cleanup(void *ptr, const allocator_t* allocator);
 
 ////////////////////////////////////////////////////////////////////////////////
 
+LIBRARY_INLINE
 void
 cstring_cleanup2(void *ptr);
 
 // clears the internal string.
+LIBRARY_INLINE
 void
 cstring_clear(cstring_t* string);
 
 // assign str to the string and return its size.
+LIBRARY_INLINE
 uint32_t
 cstring_assign(cstring_t *string, const char *str);
 
+LIBRARY_INLINE
 void
 cstring_setup(
   cstring_t *string,
   const char *str,
   const allocator_t *allocator);
 
+LIBRARY_INLINE
 void
 cstring_setup2(
   cstring_t *string,
   const char *str);
 
 // NOTE: allocates and sets up the string.
+LIBRARY_INLINE
 cstring_t *
 cstring_create(
   const char *str,
   const allocator_t *allocator);
 
+LIBRARY_INLINE
 cstring_t *
 cstring_create2(const char *str);
 
 // NOTE: deallocate the instance after cleanup.
+LIBRARY_INLINE
 void
 cstring_free(
   cstring_t *string,
   const allocator_t *allocator);
 
+LIBRARY_INLINE
 void
 cstring_free2(cstring_t *string);
 
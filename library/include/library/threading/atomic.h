@@ -0,0 +1,263 @@
+/**
+ * @file atomic.h
+ * @author khalilhenoud@gmail.com
+ * @brief minimal atomics over msvc intrinsics and the gcc/clang builtins
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef LIB_ATOMIC_H
+#define LIB_ATOMIC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#include <library/internal/module.h>
+
+
+////////////////////////////////////////////////////////////////////////////////
+// NOTES:
+//  - loads are acquire, stores are release, read-modify-write operations are
+//    sequentially consistent.
+//  - the msvc path assumes x86/x64 (strongly ordered loads and stores).
+////////////////////////////////////////////////////////////////////////////////
+
+#if defined(_MSC_VER)
+
+LIBRARY_INLINE
+uint32_t
+atomic_load_u32(const volatile uint32_t *ptr)
+{
+  uint32_t value = *ptr;
+  _ReadWriteBarrier();
+  return value;
+}
+
+LIBRARY_INLINE
+void
+atomic_store_u32(volatile uint32_t *ptr, uint32_t value)
+{
+  _ReadWriteBarrier();
+  *ptr = value;
+}
+
+LIBRARY_INLINE
+uint64_t
+atomic_load_u64(const volatile uint64_t *ptr)
+{
+  uint64_t value = *ptr;
+  _ReadWriteBarrier();
+  return value;
+}
+
+LIBRARY_INLINE
+void
+atomic_store_u64(volatile uint64_t *ptr, uint64_t value)
+{
+  _ReadWriteBarrier();
+  *ptr = value;
+}
+
+LIBRARY_INLINE
+void *
+atomic_load_ptr(void *const volatile *ptr)
+{
+  void *value = *ptr;
+  _ReadWriteBarrier();
+  return value;
+}
+
+LIBRARY_INLINE
+void
+atomic_store_ptr(void *volatile *ptr, void *value)
+{
+  _ReadWriteBarrier();
+  *ptr = value;
+}
+
+/** returns the value prior to the addition. */
+LIBRARY_INLINE
+uint32_t
+atomic_fetch_add_u32(volatile uint32_t *ptr, uint32_t value)
+{
+  return (uint32_t)_InterlockedExchangeAdd((volatile long *)ptr, (long)value);
+}
+
+LIBRARY_INLINE
+uint64_t
+atomic_fetch_add_u64(volatile uint64_t *ptr, uint64_t value)
+{
+  return (uint64_t)_InterlockedExchangeAdd64(
+    (volatile __int64 *)ptr, (__int64)value);
+}
+
+/** 1 if '*ptr' was 'expected' and got replaced by 'desired', 0 otherwise. */
+LIBRARY_INLINE
+uint32_t
+atomic_cas_u32(volatile uint32_t *ptr, uint32_t expected, uint32_t desired)
+{
+  return (uint32_t)_InterlockedCompareExchange(
+    (volatile long *)ptr, (long)desired, (long)expected) == expected;
+}
+
+LIBRARY_INLINE
+uint32_t
+atomic_cas_u64(volatile uint64_t *ptr, uint64_t expected, uint64_t desired)
+{
+  return (uint64_t)_InterlockedCompareExchange64(
+    (volatile __int64 *)ptr, (__int64)desired, (__int64)expected) == expected;
+}
+
+LIBRARY_INLINE
+uint32_t
+atomic_cas_ptr(void *volatile *ptr, void *expected, void *desired)
+{
+  return _InterlockedCompareExchangePointer(ptr, desired, expected) == expected;
+}
+
+LIBRARY_INLINE
+void *
+atomic_exchange_ptr(void *volatile *ptr, void *value)
+{
+  return _InterlockedExchangePointer(ptr, value);
+}
+
+LIBRARY_INLINE
+void
+atomic_thread_fence(void)
+{
+  _mm_mfence();
+}
+
+/** hint for spin-wait loops. */
+LIBRARY_INLINE
+void
+atomic_cpu_relax(void)
+{
+  _mm_pause();
+}
+
+#else
+
+LIBRARY_INLINE
+uint32_t
+atomic_load_u32(const volatile uint32_t *ptr)
+{
+  return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+LIBRARY_INLINE
+void
+atomic_store_u32(volatile uint32_t *ptr, uint32_t value)
+{
+  __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+LIBRARY_INLINE
+uint64_t
+atomic_load_u64(const volatile uint64_t *ptr)
+{
+  return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+LIBRARY_INLINE
+void
+atomic_store_u64(volatile uint64_t *ptr, uint64_t value)
+{
+  __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+LIBRARY_INLINE
+void *
+atomic_load_ptr(void *const volatile *ptr)
+{
+  return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+LIBRARY_INLINE
+void
+atomic_store_ptr(void *volatile *ptr, void *value)
+{
+  __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+/** returns the value prior to the addition. */
+LIBRARY_INLINE
+uint32_t
+atomic_fetch_add_u32(volatile uint32_t *ptr, uint32_t value)
+{
+  return __atomic_fetch_add(ptr, value, __ATOMIC_SEQ_CST);
+}
+
+LIBRARY_INLINE
+uint64_t
+atomic_fetch_add_u64(volatile uint64_t *ptr, uint64_t value)
+{
+  return __atomic_fetch_add(ptr, value, __ATOMIC_SEQ_CST);
+}
+
+/** 1 if '*ptr' was 'expected' and got replaced by 'desired', 0 otherwise. */
+LIBRARY_INLINE
+uint32_t
+atomic_cas_u32(volatile uint32_t *ptr, uint32_t expected, uint32_t desired)
+{
+  return __atomic_compare_exchange_n(
+    ptr, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+LIBRARY_INLINE
+uint32_t
+atomic_cas_u64(volatile uint64_t *ptr, uint64_t expected, uint64_t desired)
+{
+  return __atomic_compare_exchange_n(
+    ptr, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+LIBRARY_INLINE
+uint32_t
+atomic_cas_ptr(void *volatile *ptr, void *expected, void *desired)
+{
+  return __atomic_compare_exchange_n(
+    ptr, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+LIBRARY_INLINE
+void *
+atomic_exchange_ptr(void *volatile *ptr, void *value)
+{
+  return __atomic_exchange_n(ptr, value, __ATOMIC_SEQ_CST);
+}
+
+LIBRARY_INLINE
+void
+atomic_thread_fence(void)
+{
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+/** hint for spin-wait loops. */
+LIBRARY_INLINE
+void
+atomic_cpu_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  __asm__ __volatile__("yield");
+#endif
+}
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,132 @@
+/**
+ * @file epoch.h
+ * @author khalilhenoud@gmail.com
+ * @brief epoch based reclamation, deferred frees for lock-free readers
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef LIB_EPOCH_H
+#define LIB_EPOCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <library/containers/cvector.h>
+#include <library/internal/module.h>
+
+#define EPOCH_MAX_RECORDS             64
+#define EPOCH_COLLECT_EVERY           64      // retires between collections
+#define EPOCH_CACHE_LINE              64
+
+
+////////////////////////////////////////////////////////////////////////////////
+// NOTES:
+//  - every thread touching the shared structure registers once and gets a
+//    record. reads happen between epoch_enter() and epoch_exit(), nothing
+//    loaded in there can be freed before the matching exit.
+//  - a writer unlinks a node first, then epoch_retire()s it. the pointer goes
+//    to the record's limbo list for the current epoch and is handed back to
+//    its own allocator once every pinned thread has moved two epochs past.
+//  - the global epoch only moves when all pinned records have seen the
+//    current one, a thread that stays pinned holds back every free.
+//  - limbo lists are per record, only the owning thread frees from them.
+//    a record given back with pending pointers passes them on to whoever
+//    registers next, the domain cleanup frees the rest.
+//  - enter/exit nest, only the outermost pair pins.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct allocator_t allocator_t;
+typedef struct epoch_domain_t epoch_domain_t;
+
+typedef
+struct epoch_record_t {
+  volatile uint64_t state;              // (epoch << 1) | 1 while pinned
+  volatile uint32_t in_use;
+  uint32_t nesting;
+  uint8_t pad0[EPOCH_CACHE_LINE - 2 * sizeof(uint64_t)];
+  // only the owning thread touches what follows.
+  epoch_domain_t *domain;
+  uint32_t retired;                     // since the last collection
+  uint64_t limbo_epoch[3];
+  cvector_t limbo[3];                   // epoch_retired_t, by epoch % 3
+} epoch_record_t;
+
+typedef
+struct epoch_retired_t {
+  void *ptr;
+  const allocator_t *allocator;
+} epoch_retired_t;
+
+struct epoch_domain_t {
+  volatile uint64_t global;
+  uint8_t pad0[EPOCH_CACHE_LINE - sizeof(uint64_t)];
+  const allocator_t *allocator;         // limbo list storage
+  epoch_record_t records[EPOCH_MAX_RECORDS];
+};
+
+/** 'allocator' backs the limbo lists, it must be thread safe. */
+LIBRARY_API
+void
+epoch_domain_setup(epoch_domain_t *domain, const allocator_t *allocator);
+
+/** no thread may be pinned, every pending pointer is freed. */
+LIBRARY_API
+void
+epoch_domain_cleanup(epoch_domain_t *domain);
+
+/** claims a free record for the calling thread, asserts if none is left. */
+LIBRARY_API
+epoch_record_t *
+epoch_register(epoch_domain_t *domain);
+
+/** frees what is safe and gives the record back, it must not be pinned. */
+LIBRARY_API
+void
+epoch_unregister(epoch_record_t *record);
+
+LIBRARY_API
+void
+epoch_enter(epoch_record_t *record);
+
+LIBRARY_API
+void
+epoch_exit(epoch_record_t *record);
+
+/**
+ * 'ptr' must already be unreachable for new readers. it is released through
+ * 'allocator' once no reader can still hold it.
+ */
+LIBRARY_API
+void
+epoch_retire(
+  epoch_record_t *record,
+  void *ptr,
+  const allocator_t *allocator);
+
+/**
+ * tries to move the global epoch then frees the record's safe pointers.
+ * returns how many are still pending.
+ */
+LIBRARY_API
+size_t
+epoch_collect(epoch_record_t *record);
+
+/**
+ * waits until every pointer the record retired is freed. the record must not
+ * be pinned, and neither can any other for long or this never returns.
+ */
+LIBRARY_API
+void
+epoch_barrier(epoch_record_t *record);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,146 @@
+/**
+ * @file job.h
+ * @author khalilhenoud@gmail.com
+ * @brief work stealing job system
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef LIB_JOB_H
+#define LIB_JOB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <library/internal/module.h>
+#include <library/threading/mutex.h>
+#include <library/threading/thread.h>
+
+#define JOB_MAX_WORKERS               32
+#define JOB_QUEUE_CAPACITY            4096    // per worker, power of two
+#define JOB_PAYLOAD_SIZE              64
+#define JOB_SCRATCH_SIZE              (1 << 20)
+
+
+////////////////////////////////////////////////////////////////////////////////
+// NOTES:
+//  - every worker owns a chase-lev deque. it pushes and pops at the bottom,
+//    idle workers steal from the top of the others.
+//  - the thread calling job_system_setup() is worker 0, it runs jobs while it
+//    waits. jobs can only be created and run from worker threads.
+//  - jobs come from a per-worker ring of JOB_QUEUE_CAPACITY entries and are
+//    recycled, a worker cannot have more than that many jobs alive.
+//  - a job is finished once its function returned and all of its children are
+//    finished. waiting on a job runs other jobs in the meantime.
+//  - each worker has a scratch arena (see job_scratch_allocator()), what a job
+//    allocates from it is released when the job function returns.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct allocator_t allocator_t;
+typedef struct job_t job_t;
+typedef struct job_worker_t job_worker_t;
+
+/** 'data' is the payload copy if one was given, the raw pointer otherwise. */
+typedef void (*job_fn_t)(job_t *job, void *data);
+
+/** called with sub-ranges of [0, count). */
+typedef
+void (*job_range_fn_t)(uint32_t begin, uint32_t end, void *user_data);
+
+struct job_t {
+  job_fn_t fn;
+  void *data;
+  job_t *parent;
+  volatile uint32_t unfinished;         // the job itself plus its children
+  union {
+    uint8_t bytes[JOB_PAYLOAD_SIZE];
+    uint64_t align_u64;
+    double align_double;
+    void *align_ptr;
+  } payload;
+};
+
+typedef
+struct job_system_t {
+  job_worker_t *workers;
+  uint32_t worker_count;
+  thread_handle_t threads[JOB_MAX_WORKERS];
+  volatile uint32_t stop;
+  volatile uint32_t epoch;              // bumped on every push
+  volatile uint32_t sleeping;
+  mutex_t mutex;
+  condvar_t wake;
+  const allocator_t *allocator;
+} job_system_t;
+
+/** 0 workers uses every hardware thread, the count includes the caller. */
+LIBRARY_API
+void
+job_system_setup(
+  job_system_t *system,
+  uint32_t worker_count,
+  const allocator_t *allocator);
+
+/** must be called from the thread that set the system up. */
+LIBRARY_API
+void
+job_system_cleanup(job_system_t *system);
+
+/**
+ * 'size' bytes of 'data' are copied into the job when non zero. the job is
+ * only queued by job_run(). a non NULL 'parent' is not finished before it.
+ */
+LIBRARY_API
+job_t *
+job_create(
+  job_system_t *system,
+  job_fn_t fn,
+  const void *data,
+  size_t size,
+  job_t *parent);
+
+LIBRARY_API
+void
+job_run(job_system_t *system, job_t *job);
+
+LIBRARY_API
+void
+job_wait(job_system_t *system, job_t *job);
+
+LIBRARY_API
+uint32_t
+job_is_finished(const job_t *job);
+
+/** splits [0, count) down to 'grain' sized ranges and waits for all of them. */
+LIBRARY_API
+void
+job_parallel_for(
+  job_system_t *system,
+  uint32_t count,
+  uint32_t grain,
+  job_range_fn_t fn,
+  void *user_data);
+
+/** index of the calling worker, (uint32_t)-1 outside of the job system. */
+LIBRARY_API
+uint32_t
+job_worker_index(void);
+
+/**
+ * allocates from the calling worker's arena. free is a no-op, everything is
+ * released when the running job returns.
+ */
+LIBRARY_API
+const allocator_t *
+job_scratch_allocator(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
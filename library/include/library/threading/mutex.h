@@ -0,0 +1,126 @@
+/**
+ * @file mutex.h
+ * @author khalilhenoud@gmail.com
+ * @brief mutex and condition variable over win32 srw locks/pthreads
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef LIB_MUTEX_H
+#define LIB_MUTEX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <library/internal/module.h>
+
+
+////////////////////////////////////////////////////////////////////////////////
+// NOTES:
+//  - the native objects live inside the structs (no allocation), the storage
+//    is large enough for the biggest supported platform type.
+//  - rwlock_t lets any number of readers in at once, or a single writer.
+//  - none of the types can be copied or moved once setup.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef
+struct mutex_t {
+  union {
+    void *align;
+    uint8_t bytes[64];
+  } storage;
+} mutex_t;
+
+typedef
+struct condvar_t {
+  union {
+    void *align;
+    uint8_t bytes[64];
+  } storage;
+} condvar_t;
+
+typedef
+struct rwlock_t {
+  union {
+    void *align;
+    uint8_t bytes[64];
+  } storage;
+} rwlock_t;
+
+LIBRARY_API
+void
+mutex_setup(mutex_t *mutex);
+
+LIBRARY_API
+void
+mutex_cleanup(mutex_t *mutex);
+
+LIBRARY_API
+void
+mutex_lock(mutex_t *mutex);
+
+// returns 1 if the lock was acquired.
+LIBRARY_API
+uint32_t
+mutex_trylock(mutex_t *mutex);
+
+LIBRARY_API
+void
+mutex_unlock(mutex_t *mutex);
+
+LIBRARY_API
+void
+condvar_setup(condvar_t *condvar);
+
+LIBRARY_API
+void
+condvar_cleanup(condvar_t *condvar);
+
+/** 'mutex' must be locked, spurious wakeups are possible. */
+LIBRARY_API
+void
+condvar_wait(condvar_t *condvar, mutex_t *mutex);
+
+LIBRARY_API
+void
+condvar_signal(condvar_t *condvar);
+
+LIBRARY_API
+void
+condvar_broadcast(condvar_t *condvar);
+
+LIBRARY_API
+void
+rwlock_setup(rwlock_t *rwlock);
+
+LIBRARY_API
+void
+rwlock_cleanup(rwlock_t *rwlock);
+
+/** shared, other readers may hold the lock at the same time. */
+LIBRARY_API
+void
+rwlock_read_lock(rwlock_t *rwlock);
+
+LIBRARY_API
+void
+rwlock_read_unlock(rwlock_t *rwlock);
+
+/** exclusive, waits for the readers to leave. */
+LIBRARY_API
+void
+rwlock_write_lock(rwlock_t *rwlock);
+
+LIBRARY_API
+void
+rwlock_write_unlock(rwlock_t *rwlock);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,50 @@
+/**
+ * @file thread.h
+ * @author khalilhenoud@gmail.com
+ * @brief thin wrapper over win32/pthread threads
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef LIB_THREAD_H
+#define LIB_THREAD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <library/internal/module.h>
+
+#define INVALID_THREAD ((thread_handle_t)0)
+
+
+typedef uintptr_t thread_handle_t;
+typedef void (*thread_fn_t)(void *arg);
+
+/** starts 'fn(arg)' on a new thread, returns INVALID_THREAD on failure. */
+LIBRARY_API
+thread_handle_t
+thread_create(thread_fn_t fn, void *arg);
+
+/** waits for the thread to finish and releases its handle. */
+LIBRARY_API
+void
+thread_join(thread_handle_t thread);
+
+LIBRARY_API
+void
+thread_yield(void);
+
+/** number of logical processors, at least 1. */
+LIBRARY_API
+uint32_t
+thread_hardware_concurrency(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -49,6 +49,8 @@ typedef void (*fn_deserialize_t)(
   void *dst, const allocator_t *allocator, binary_stream_t* stream);
 typedef uint32_t (*fn_hash_t)(const void *ptr);
 typedef uint32_t (*fn_is_equal_t)(const void *lhs, const void *rhs);
+/** negative, zero or positive as lhs orders before, with or after rhs. */
+typedef int32_t (*fn_compare_t)(const void *lhs, const void *rhs);
 typedef size_t (*fn_type_size_t)(void);
 typedef size_t (*fn_type_alignment_t)(void);
 typedef uint32_t (*fn_type_id_count_t)(void);
@@ -74,6 +76,7 @@ struct vtable_t {
   fn_deserialize_t                      fn_deserialize;
   fn_hash_t                             fn_hash;
   fn_is_equal_t                         fn_is_equal;
+  fn_compare_t                          fn_compare;
   fn_type_size_t                        fn_type_size;
   fn_type_alignment_t                   fn_type_alignment;
   fn_type_id_count_t                    fn_type_id_count;
@@ -100,14 +103,14 @@ struct container_elem_data_t {
   vtable_t *vtable;
 } container_elem_data_t;
 
-inline
+LIBRARY_INLINE
 type_data_t
 get_type_data_from_elem_data(const container_elem_data_t *src)
 {
   return pack_type_data(src->type_id, src->size);
 }
 
-inline
+LIBRARY_INLINE
 uint32_t
 elem_data_identical(
   const container_elem_data_t *left,
@@ -121,7 +124,7 @@ elem_data_identical(
     left->vtable == right->vtable;
 }
 
-inline
+LIBRARY_INLINE
 fn_cleanup_t
 elem_data_get_cleanup_fn(const container_elem_data_t *elem)
 {
@@ -131,7 +134,20 @@ elem_data_get_cleanup_fn(const container_elem_data_t *elem)
     NULL : elem->vtable->fn_cleanup;
 }
 
-inline
+/** types holding their own allocator expect NULL when cleaned up. */
+LIBRARY_INLINE
+const allocator_t *
+elem_data_get_cleanup_alloc(
+  const container_elem_data_t *elem,
+  const allocator_t *allocator)
+{
+  assert(elem);
+  return
+    (elem->vtable && elem->vtable->fn_owns_alloc &&
+    elem->vtable->fn_owns_alloc()) ? NULL : allocator;
+}
+
+LIBRARY_INLINE
 fn_replicate_t
 elem_data_get_replicate_fn(const container_elem_data_t *elem)
 {
@@ -141,7 +157,7 @@ elem_data_get_replicate_fn(const container_elem_data_t *elem)
     NULL : elem->vtable->fn_replicate;
 }
 
-inline
+LIBRARY_INLINE
 fn_hash_t
 elem_data_get_hash_fn(const container_elem_data_t *elem)
 {
@@ -151,7 +167,7 @@ elem_data_get_hash_fn(const container_elem_data_t *elem)
     NULL : elem->vtable->fn_hash;
 }
 
-inline
+LIBRARY_INLINE
 fn_is_equal_t
 elem_data_get_is_equal_fn(const container_elem_data_t *elem)
 {
@@ -161,7 +177,17 @@ elem_data_get_is_equal_fn(const container_elem_data_t *elem)
     NULL : elem->vtable->fn_is_equal;
 }
 
-inline
+LIBRARY_INLINE
+fn_compare_t
+elem_data_get_compare_fn(const container_elem_data_t *elem)
+{
+  assert(elem);
+  return
+    (elem->vtable == NULL || elem->vtable->fn_compare == NULL) ?
+    NULL : elem->vtable->fn_compare;
+}
+
+LIBRARY_INLINE
 fn_serialize_t
 elem_data_get_serialize_fn(const container_elem_data_t *elem)
 {
@@ -171,7 +197,7 @@ elem_data_get_serialize_fn(const container_elem_data_t *elem)
     NULL : elem->vtable->fn_serialize;
 }
 
-inline
+LIBRARY_INLINE
 fn_deserialize_t
 elem_data_get_deserialize_fn(const container_elem_data_t *elem)
 {
@@ -181,7 +207,7 @@ elem_data_get_deserialize_fn(const container_elem_data_t *elem)
     NULL : elem->vtable->fn_deserialize;
 }
 
-inline
+LIBRARY_INLINE
 void
 elem_data_clear(container_elem_data_t *elem)
 {
@@ -207,7 +233,7 @@ LIBRARY_API
 vtable_t *
 get_vtable(const type_id_t type);
 
-inline
+LIBRARY_INLINE
 container_elem_data_t
 get_cont_elem_data(type_id_t id, size_t size)
 {
@@ -228,7 +254,7 @@ get_cont_elem_data(type_id_t id, size_t size)
   return data;
 }
 
-inline
+LIBRARY_INLINE
 container_elem_data_t
 get_cont_elem_data_from_packed(type_data_t type_data)
 {
@@ -0,0 +1,247 @@
+/**
+ * @file workload.h
+ * @author khalilhenoud@gmail.com
+ * @brief seeded key streams, container operation traces and their replay
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef LIB_WORKLOAD_H
+#define LIB_WORKLOAD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <library/internal/module.h>
+#include <library/containers/cvector.h>
+#include <library/hash/fnv.h>
+
+// 'CLWT' when read as little endian bytes.
+#define WORKLOAD_TRACE_MAGIC          0x54574c43u
+#define WORKLOAD_TRACE_VERSION        1
+#define WORKLOAD_MAX_COLLISION_BITS   20
+// what a find, erase or pop observes when there is nothing to observe.
+#define WORKLOAD_MISS                 ((uint64_t)-1)
+#define WORKLOAD_CHECKSUM_INIT        FNV64_OFFSET_BASIS
+
+
+////////////////////////////////////////////////////////////////////////////////
+// NOTES:
+//  - a key stream yields the same keys for the same parameters and seed, on
+//    every platform.
+//  - uniform and zipf draw from 'universe' distinct keys, the rank of a key
+//    is scrambled (a bijection) so the popular keys are not neighbours.
+//    zipf uses rejection-inversion sampling, no table of the universe.
+//  - sequential yields 0, 1, 2... and ignores the seed.
+//  - fnv collisions yields distinct 8 byte keys whose hash_fnv1a_32 share
+//    their low 'collision_bits', which is how chashmap_t picks a bucket for
+//    a uint64_t key (hash % capacity, a power of two). every key lands in the
+//    same bucket up to 2^collision_bits buckets and the probe chains degrade
+//    to a linear scan.
+//  - a trace is a list of operations against one container of uint64_t (keys
+//    and values for a chashmap_t). production code records the operations it
+//    performs with workload_trace_record() and saves the trace, the replay
+//    performs them again against a fresh container.
+//  - positions are taken modulo the container size at replay time (see
+//    workload_op_type_t), any key recorded is valid.
+//  - the replay returns a checksum of everything the operations observed,
+//    two replays of a trace agree as long as the container behaves the same.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct allocator_t allocator_t;
+
+typedef
+enum workload_distribution_t {
+  WORKLOAD_UNIFORM,
+  WORKLOAD_ZIPF,
+  WORKLOAD_SEQUENTIAL,
+  WORKLOAD_FNV_COLLISIONS,
+  WORKLOAD_DISTRIBUTION_COUNT
+} workload_distribution_t;
+
+typedef
+struct workload_key_params_t {
+  workload_distribution_t distribution;
+  uint64_t universe;                    // distinct keys, uniform and zipf
+  double zipf_exponent;                 // > 0, ~1 for typical popularity
+  uint32_t collision_bits;              // fnv collisions, 1 to 20
+  uint64_t seed;
+} workload_key_params_t;
+
+typedef
+struct workload_keys_t {
+  workload_key_params_t params;
+  uint64_t state;
+  uint64_t next;
+  uint32_t target;                      // fnv collisions, the shared bits
+
+  // zipf sampler constants.
+  double h_integral_x1;
+  double h_integral_n;
+  double s;
+} workload_keys_t;
+
+LIBRARY_API
+void
+workload_keys_setup(
+  workload_keys_t *keys,
+  const workload_key_params_t *params);
+
+LIBRARY_API
+uint64_t
+workload_keys_next(workload_keys_t *keys);
+
+LIBRARY_API
+const char *
+workload_distribution_name(workload_distribution_t distribution);
+
+////////////////////////////////////////////////////////////////////////////////
+typedef
+enum workload_target_t {
+  WORKLOAD_TARGET_CHASHMAP,
+  WORKLOAD_TARGET_CVECTOR,
+  WORKLOAD_TARGET_CLIST,
+  WORKLOAD_TARGET_COUNT
+} workload_target_t;
+
+/**
+ * 'pos' below is the key modulo the container size (size + 1 for inserts).
+ *                 chashmap            cvector/clist
+ *  INSERT         key = value         value at pos
+ *  ERASE          key                 element at pos
+ *  FIND           key                 element at pos
+ *  ITERATE        every value         every value
+ *  CLEAR          everything          everything
+ *  PUSH_BACK      -                   value
+ *  POP_BACK       -                   last element
+ *  PUSH_FRONT     -                   value, clist only
+ *  POP_FRONT      -                   first element, clist only
+ */
+typedef
+enum workload_op_type_t {
+  WORKLOAD_OP_INSERT,
+  WORKLOAD_OP_ERASE,
+  WORKLOAD_OP_FIND,
+  WORKLOAD_OP_ITERATE,
+  WORKLOAD_OP_CLEAR,
+  WORKLOAD_OP_PUSH_BACK,
+  WORKLOAD_OP_POP_BACK,
+  WORKLOAD_OP_PUSH_FRONT,
+  WORKLOAD_OP_POP_FRONT,
+  WORKLOAD_OP_COUNT
+} workload_op_type_t;
+
+typedef
+struct workload_op_t {
+  uint32_t type;                        // workload_op_type_t
+  uint64_t key;
+  uint64_t value;
+} workload_op_t;
+
+typedef
+struct workload_trace_t {
+  workload_target_t target;
+  cvector_t ops;                        // workload_op_t
+} workload_trace_t;
+
+/** relative weights of the operations a generated trace picks from. */
+typedef
+struct workload_mix_t {
+  uint32_t weights[WORKLOAD_OP_COUNT];
+} workload_mix_t;
+
+LIBRARY_API
+void
+workload_trace_setup(
+  workload_trace_t *trace,
+  workload_target_t target,
+  const allocator_t *allocator);
+
+LIBRARY_API
+void
+workload_trace_cleanup(workload_trace_t *trace);
+
+/** returns 1 if 'type' can be performed against the trace's target. */
+LIBRARY_API
+uint32_t
+workload_op_valid(workload_target_t target, workload_op_type_t type);
+
+LIBRARY_API
+void
+workload_trace_record(
+  workload_trace_t *trace,
+  workload_op_type_t type,
+  uint64_t key,
+  uint64_t value);
+
+/**
+ * appends 'count' operations picked by 'mix', the keys come from 'keys' and
+ * the values from 'seed'. every weighted operation must be valid for the
+ * trace's target.
+ */
+LIBRARY_API
+void
+workload_trace_generate(
+  workload_trace_t *trace,
+  workload_keys_t *keys,
+  const workload_mix_t *mix,
+  uint64_t count,
+  uint64_t seed);
+
+/** returns 0 if the file could not be written. */
+LIBRARY_API
+uint32_t
+workload_trace_save(const workload_trace_t *trace, const char *path);
+
+/**
+ * the trace must not be setup, it is on success. returns 0 if the file is
+ * missing or is not a trace this version can read.
+ */
+LIBRARY_API
+uint32_t
+workload_trace_load(
+  workload_trace_t *trace,
+  const char *path,
+  const allocator_t *allocator);
+
+/**
+ * performs the trace against a new container allocated from 'allocator',
+ * cleans it up and returns the checksum of what the operations observed.
+ */
+LIBRARY_API
+uint64_t
+workload_replay(const workload_trace_t *trace, const allocator_t *allocator);
+
+LIBRARY_API
+const char *
+workload_target_name(workload_target_t target);
+
+/**
+ * folds one observation into the replay checksum, exposed so a replay
+ * against another implementation (e.g. the std containers) can be compared.
+ *                 chashmap            cvector/clist
+ *  INSERT         1 if new, else 0    the size after
+ *  ERASE          1 if erased, else 0 the value or WORKLOAD_MISS
+ *  FIND           the value or WORKLOAD_MISS
+ *  ITERATE        the sum of the values (wrapping), then the size
+ *  CLEAR          the size before
+ *  PUSH_*         -                   the size after
+ *  POP_*          -                   the value or WORKLOAD_MISS
+ * the size of the container is folded last.
+ */
+LIBRARY_INLINE
+uint64_t
+workload_checksum(uint64_t checksum, uint64_t observed)
+{
+  return (checksum ^ observed) * FNV64_PRIME;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
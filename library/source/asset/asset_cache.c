@@ -0,0 +1,437 @@
+/**
+ * @file asset_cache.c
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <assert.h>
+#include <string.h>
+#include <library/asset/asset_cache.h>
+#include <library/asset/types.h>
+#include <library/threading/atomic.h>
+#include <library/type_registry/type_registry.h>
+
+
+struct asset_handle_t {
+  asset_ref_t ref;                      // owned copy, also the map key
+  void *asset;
+  vtable_t *vtable;                     // NULL if the type is not registered
+  volatile uint32_t state;              // asset_state_t
+  uint32_t refcount;
+  uint64_t bytes;
+  asset_handle_t **deps;
+  uint32_t dep_count;
+  asset_handle_t *queue_next;
+  asset_handle_t *lru_prev;
+  asset_handle_t *lru_next;
+};
+
+static
+asset_handle_t *
+cache_find(asset_cache_t *cache, const asset_ref_t *ref)
+{
+  asset_handle_t **found;
+
+  // an empty bucket table cannot be probed.
+  if (!cvector_size(&cache->handles.indices))
+    return NULL;
+
+  chashmap_at(&cache->handles, *ref, asset_ref_t, asset_handle_t *, found);
+  return found ? *found : NULL;
+}
+
+static
+void
+lru_unlink(asset_cache_t *cache, asset_handle_t *handle)
+{
+  if (handle->lru_prev)
+    handle->lru_prev->lru_next = handle->lru_next;
+  else
+    cache->lru_head = handle->lru_next;
+
+  if (handle->lru_next)
+    handle->lru_next->lru_prev = handle->lru_prev;
+  else
+    cache->lru_tail = handle->lru_prev;
+
+  handle->lru_prev = handle->lru_next = NULL;
+}
+
+static
+void
+lru_push(asset_cache_t *cache, asset_handle_t *handle)
+{
+  handle->lru_prev = NULL;
+  handle->lru_next = cache->lru_head;
+  if (cache->lru_head)
+    cache->lru_head->lru_prev = handle;
+  else
+    cache->lru_tail = handle;
+  cache->lru_head = handle;
+}
+
+static
+uint32_t
+in_lru(const asset_cache_t *cache, const asset_handle_t *handle)
+{
+  return handle->lru_prev || cache->lru_head == handle;
+}
+
+static
+void
+queue_push(asset_cache_t *cache, asset_handle_t *handle)
+{
+  handle->queue_next = NULL;
+  if (cache->queue_tail)
+    cache->queue_tail->queue_next = handle;
+  else
+    cache->queue_head = handle;
+  cache->queue_tail = handle;
+}
+
+static
+asset_handle_t *
+queue_pop(asset_cache_t *cache)
+{
+  asset_handle_t *handle = cache->queue_head;
+  if (handle) {
+    cache->queue_head = handle->queue_next;
+    if (!cache->queue_head)
+      cache->queue_tail = NULL;
+    handle->queue_next = NULL;
+  }
+  return handle;
+}
+
+static
+void
+handle_free(asset_cache_t *cache, asset_handle_t *handle)
+{
+  const allocator_t *allocator = cache->allocator;
+
+  if (handle->asset && handle->vtable->fn_get_deloader)
+    handle->vtable->fn_get_deloader()(&handle->asset, &handle->ref, allocator);
+
+  if (handle->deps)
+    allocator->mem_free(handle->deps);
+  asset_ref_cleanup(&handle->ref, allocator);
+  allocator->mem_free(handle);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// NOTE: everything below is called with the cache mutex held.
+
+static
+asset_handle_t *
+acquire_locked(asset_cache_t *cache, const asset_ref_t *ref)
+{
+  asset_handle_t *handle = cache_find(cache, ref);
+
+  if (handle) {
+    if (!handle->refcount++ && in_lru(cache, handle))
+      lru_unlink(cache, handle);
+    ++cache->stats.hits;
+    return handle;
+  }
+
+  handle = (asset_handle_t *)cache->allocator->mem_alloc(
+    sizeof(asset_handle_t));
+  memset(handle, 0, sizeof(asset_handle_t));
+  asset_ref_replicate(ref, &handle->ref, cache->allocator);
+  handle->vtable =
+    is_type_registered(ref->type_id) ? get_vtable(ref->type_id) : NULL;
+  handle->state = ASSET_STATE_QUEUED;
+  handle->refcount = 1;
+  chashmap_insert(
+    &cache->handles, handle->ref, asset_ref_t, handle, asset_handle_t *);
+
+  queue_push(cache, handle);
+  condvar_signal(&cache->pending);
+  return handle;
+}
+
+// failures are not cached, the next acquire of the ref loads it again.
+static
+void
+drop_locked(asset_cache_t *cache, asset_handle_t *handle)
+{
+  chashmap_erase(&cache->handles, handle->ref, asset_ref_t);
+  handle_free(cache, handle);
+}
+
+// ready handles with no reference left become eviction candidates.
+static
+void
+release_locked(asset_cache_t *cache, asset_handle_t *handle)
+{
+  assert(handle->refcount && "released more often than acquired!");
+
+  if (!--handle->refcount) {
+    if (handle->state == ASSET_STATE_READY)
+      lru_push(cache, handle);
+    else if (handle->state == ASSET_STATE_FAILED)
+      drop_locked(cache, handle);
+  }
+}
+
+static
+void
+evict_locked(asset_cache_t *cache)
+{
+  while (cache->stats.resident > cache->budget && cache->lru_tail) {
+    asset_handle_t *handle = cache->lru_tail;
+    uint32_t i;
+
+    lru_unlink(cache, handle);
+    chashmap_erase(&cache->handles, handle->ref, asset_ref_t);
+    cache->stats.resident -= handle->bytes;
+    ++cache->stats.evictions;
+
+    // dependencies may join the lru, the loop picks them up if needed.
+    for (i = 0; i < handle->dep_count; ++i)
+      release_locked(cache, handle->deps[i]);
+    handle_free(cache, handle);
+  }
+}
+
+static
+void
+publish_locked(asset_cache_t *cache, asset_handle_t *handle, void *asset)
+{
+  vtable_t *vtable = handle->vtable;
+  handle->asset = asset;
+
+  if (!asset) {
+    ++cache->stats.failures;
+    atomic_store_u32(&handle->state, ASSET_STATE_FAILED);
+  } else {
+    handle->bytes =
+      cache->fn_size ? cache->fn_size(&handle->ref, asset) :
+      vtable->fn_type_size ? vtable->fn_type_size() : 0;
+    cache->stats.resident += handle->bytes;
+    ++cache->stats.loads;
+
+    // the refs held by the asset are preloaded and pinned while it lives.
+    if (vtable->fn_type_asset_count && vtable->fn_type_get_assets) {
+      uint32_t i, count = vtable->fn_type_asset_count(asset);
+      if (count) {
+        const asset_ref_t **refs = (const asset_ref_t **)
+          cache->allocator->mem_alloc(sizeof(asset_ref_t *) * count);
+        vtable->fn_type_get_assets(asset, refs);
+        handle->deps = (asset_handle_t **)cache->allocator->mem_alloc(
+          sizeof(asset_handle_t *) * count);
+        for (i = 0; i < count; ++i)
+          handle->deps[i] = acquire_locked(cache, refs[i]);
+        handle->dep_count = count;
+        cache->allocator->mem_free((void *)refs);
+      }
+    }
+
+    atomic_store_u32(&handle->state, ASSET_STATE_READY);
+  }
+
+  condvar_broadcast(&cache->loaded);
+  if (!handle->refcount) {
+    if (asset)
+      lru_push(cache, handle);
+    else
+      drop_locked(cache, handle);
+  }
+  evict_locked(cache);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static
+void *
+load_handle(asset_cache_t *cache, asset_handle_t *handle)
+{
+  void *asset = NULL;
+  if (handle->vtable && handle->vtable->fn_get_loader)
+    handle->vtable->fn_get_loader()(&asset, &handle->ref, cache->allocator);
+  return asset;
+}
+
+// runs the queued loads on the calling thread, used when there is no worker.
+static
+void
+cache_drain(asset_cache_t *cache)
+{
+  asset_handle_t *handle;
+
+  mutex_lock(&cache->mutex);
+  while ((handle = queue_pop(cache)) != NULL) {
+    void *asset;
+    handle->state = ASSET_STATE_LOADING;
+    mutex_unlock(&cache->mutex);
+    asset = load_handle(cache, handle);
+    mutex_lock(&cache->mutex);
+    publish_locked(cache, handle, asset);
+  }
+  mutex_unlock(&cache->mutex);
+}
+
+static
+void
+cache_worker(void *arg)
+{
+  asset_cache_t *cache = (asset_cache_t *)arg;
+
+  mutex_lock(&cache->mutex);
+  for (;;) {
+    asset_handle_t *handle;
+    void *asset;
+
+    while (!cache->stop && !cache->queue_head)
+      condvar_wait(&cache->pending, &cache->mutex);
+    if (cache->stop)
+      break;
+
+    handle = queue_pop(cache);
+    handle->state = ASSET_STATE_LOADING;
+    mutex_unlock(&cache->mutex);
+    asset = load_handle(cache, handle);
+    mutex_lock(&cache->mutex);
+    publish_locked(cache, handle, asset);
+  }
+  mutex_unlock(&cache->mutex);
+}
+
+void
+asset_cache_setup(
+  asset_cache_t *cache,
+  uint64_t budget,
+  uint32_t worker_count,
+  asset_cache_size_fn_t fn_size,
+  const allocator_t *allocator)
+{
+  assert(cache && allocator);
+
+  {
+    uint32_t i;
+    memset(cache, 0, sizeof(asset_cache_t));
+    chashmap_setup(
+      &cache->handles,
+      get_type_data(asset_ref_t),
+      get_type_data(asset_handle_t *),
+      allocator, 0.6f);
+    mutex_setup(&cache->mutex);
+    condvar_setup(&cache->pending);
+    condvar_setup(&cache->loaded);
+    cache->budget = budget;
+    cache->fn_size = fn_size;
+    cache->allocator = allocator;
+
+    worker_count =
+      worker_count > ASSET_CACHE_MAX_WORKERS ?
+      ASSET_CACHE_MAX_WORKERS : worker_count;
+    for (i = 0; i < worker_count; ++i) {
+      cache->threads[cache->worker_count] = thread_create(cache_worker, cache);
+      if (cache->threads[cache->worker_count] != INVALID_THREAD)
+        ++cache->worker_count;
+    }
+  }
+}
+
+void
+asset_cache_cleanup(asset_cache_t *cache)
+{
+  assert(cache && cache->allocator);
+
+  {
+    uint32_t i;
+    size_t index, count;
+
+    mutex_lock(&cache->mutex);
+    cache->stop = 1;
+    condvar_broadcast(&cache->pending);
+    mutex_unlock(&cache->mutex);
+    for (i = 0; i < cache->worker_count; ++i)
+      thread_join(cache->threads[i]);
+
+    // dependencies are handles of the map too, no refcount is walked here.
+    for (index = 0, count = chashmap_size(&cache->handles); index < count;
+      ++index)
+      handle_free(
+        cache,
+        *cvector_as(&cache->handles.values, index, asset_handle_t *));
+
+    chashmap_cleanup(&cache->handles, NULL);
+    condvar_cleanup(&cache->loaded);
+    condvar_cleanup(&cache->pending);
+    mutex_cleanup(&cache->mutex);
+    memset(cache, 0, sizeof(asset_cache_t));
+  }
+}
+
+asset_handle_t *
+asset_cache_acquire(asset_cache_t *cache, const asset_ref_t *ref)
+{
+  assert(cache && ref && !asset_ref_is_def(ref));
+
+  {
+    asset_handle_t *handle;
+    mutex_lock(&cache->mutex);
+    handle = acquire_locked(cache, ref);
+    mutex_unlock(&cache->mutex);
+
+    if (!cache->worker_count)
+      cache_drain(cache);
+    return handle;
+  }
+}
+
+void
+asset_cache_release(asset_cache_t *cache, asset_handle_t *handle)
+{
+  assert(cache && handle);
+
+  mutex_lock(&cache->mutex);
+  release_locked(cache, handle);
+  evict_locked(cache);
+  mutex_unlock(&cache->mutex);
+}
+
+void *
+asset_cache_wait(asset_cache_t *cache, asset_handle_t *handle)
+{
+  assert(cache && handle && handle->refcount);
+
+  if (atomic_load_u32(&handle->state) < ASSET_STATE_READY) {
+    mutex_lock(&cache->mutex);
+    while (handle->state < ASSET_STATE_READY)
+      condvar_wait(&cache->loaded, &cache->mutex);
+    mutex_unlock(&cache->mutex);
+  }
+
+  return handle->state == ASSET_STATE_READY ? handle->asset : NULL;
+}
+
+void *
+asset_cache_get(const asset_handle_t *handle)
+{
+  assert(handle);
+  return
+    atomic_load_u32((volatile uint32_t *)&handle->state) ==
+    ASSET_STATE_READY ? handle->asset : NULL;
+}
+
+asset_state_t
+asset_cache_state(const asset_handle_t *handle)
+{
+  assert(handle);
+  return (asset_state_t)atomic_load_u32((volatile uint32_t *)&handle->state);
+}
+
+void
+asset_cache_get_stats(asset_cache_t *cache, asset_cache_stats_t *stats)
+{
+  assert(cache && stats);
+
+  mutex_lock(&cache->mutex);
+  *stats = cache->stats;
+  mutex_unlock(&cache->mutex);
+}
\ No newline at end of file
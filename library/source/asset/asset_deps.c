@@ -0,0 +1,258 @@
+/**
+ * @file asset_deps.c
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <assert.h>
+#include <string.h>
+#include <library/asset/asset_cache.h>
+#include <library/asset/asset_deps.h>
+#include <library/asset/asset_ref.h>
+#include <library/containers/chashmap.h>
+#include <library/containers/clist.h>
+#include <library/containers/cvector.h>
+
+
+static
+void
+visit_elements(
+  const void *data,
+  size_t count,
+  const container_elem_data_t *elem,
+  asset_deps_fn_t fn,
+  void *user_data)
+{
+  size_t i;
+  const vtable_t *vtable = elem->vtable;
+
+  // skips containers of plain data without touching every element.
+  if (
+    elem->type_id != get_type_id(asset_ref_t) && (!vtable || (
+    !(vtable->fn_type_asset_count && vtable->fn_type_get_assets) &&
+    !vtable->fn_type_ids)))
+    return;
+
+  for (i = 0; i < count; ++i)
+    asset_deps_visit(
+      (const uint8_t *)data + i * elem->size, elem->type_id, fn, user_data);
+}
+
+void
+asset_deps_visit(
+  const void *src,
+  type_id_t type_id,
+  asset_deps_fn_t fn,
+  void *user_data)
+{
+  assert(src && fn);
+
+  {
+    vtable_t *vtable;
+
+    if (type_id == get_type_id(asset_ref_t)) {
+      fn((const asset_ref_t *)src, user_data);
+      return;
+    }
+
+    if (!is_type_registered(type_id))
+      return;
+
+    vtable = get_vtable(type_id);
+    if (vtable->fn_type_asset_count && vtable->fn_type_get_assets) {
+      const asset_ref_t *refs[64];
+      const asset_ref_t **array = refs;
+      uint32_t i, count = vtable->fn_type_asset_count(src);
+
+      if (count > sizeof(refs) / sizeof(refs[0]))
+        array = (const asset_ref_t **)g_default_allocator.mem_alloc(
+          sizeof(asset_ref_t *) * count);
+
+      if (count)
+        vtable->fn_type_get_assets(src, array);
+      for (i = 0; i < count; ++i)
+        fn(array[i], user_data);
+
+      if (array != refs)
+        g_default_allocator.mem_free((void *)array);
+    }
+
+    // containers only expose their element types, the walk itself has to know
+    // the layout of each one.
+    if (!vtable->fn_type_id_count || !vtable->fn_type_ids)
+      return;
+
+    if (type_id == get_type_id(cvector_t)) {
+      const cvector_t *vec = (const cvector_t *)src;
+      visit_elements(vec->data, vec->size, &vec->elem_data, fn, user_data);
+    } else if (type_id == get_type_id(chashmap_t)) {
+      const chashmap_t *map = (const chashmap_t *)src;
+      asset_deps_visit(&map->keys, get_type_id(cvector_t), fn, user_data);
+      asset_deps_visit(&map->values, get_type_id(cvector_t), fn, user_data);
+    } else if (type_id == get_type_id(clist_t)) {
+      const clist_t *list = (const clist_t *)src;
+      const clist_node_t *node = list->nodes;
+      size_t i;
+      for (i = 0; i < list->size; ++i, node = node->next)
+        asset_deps_visit(node->data, list->elem_data.type_id, fn, user_data);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+typedef
+struct deps_node_t {
+  const asset_ref_t *ref;               // lives in the source or a held asset
+  asset_handle_t *handle;
+  uint32_t edges;                       // first child in the edge vector
+  uint32_t edge_count;
+} deps_node_t;
+
+typedef
+struct deps_graph_t {
+  cvector_t nodes;                      // deps_node_t, in discovery order
+  cvector_t edges;                      // uint32_t, node indices
+  chashmap_t seen;                      // asset_ref_t -> node index
+  uint32_t parent;
+} deps_graph_t;
+
+#define DEPS_NO_PARENT ((uint32_t)-1)
+
+static
+void
+graph_add(const asset_ref_t *ref, void *user_data)
+{
+  deps_graph_t *graph = (deps_graph_t *)user_data;
+  uint32_t *found = NULL;
+  uint32_t node_index;                  // chashmap_insert declares an index
+
+  if (cvector_size(&graph->seen.indices))
+    chashmap_at(&graph->seen, *ref, asset_ref_t, uint32_t, found);
+
+  if (found)
+    node_index = *found;
+  else {
+    deps_node_t node;
+    memset(&node, 0, sizeof(deps_node_t));
+    node.ref = ref;
+    node_index = (uint32_t)cvector_size(&graph->nodes);
+    cvector_push_back(&graph->nodes, node, deps_node_t);
+    chashmap_insert(&graph->seen, *ref, asset_ref_t, node_index, uint32_t);
+  }
+
+  if (graph->parent != DEPS_NO_PARENT)
+    cvector_push_back(&graph->edges, node_index, uint32_t);
+}
+
+// post order walk from every root, children land before their parents.
+static
+void
+graph_sort(
+  deps_graph_t *graph,
+  uint32_t root_count,
+  cvector_t *handles,
+  const allocator_t *allocator)
+{
+  size_t count = cvector_size(&graph->nodes);
+  uint8_t *visited = (uint8_t *)allocator->mem_alloc(count);
+  uint32_t *stack = (uint32_t *)allocator->mem_alloc(
+    sizeof(uint32_t) * 2 * count);
+  uint32_t root, top;
+  memset(visited, 0, count);
+
+  for (root = 0; root < root_count; ++root) {
+    if (visited[root])
+      continue;
+
+    visited[root] = 1;
+    top = 0;
+    stack[top++] = root;
+    stack[top++] = 0;
+
+    while (top) {
+      uint32_t index = stack[top - 2];
+      uint32_t *next = stack + top - 1;
+      deps_node_t *node = cvector_as(&graph->nodes, index, deps_node_t);
+
+      if (*next < node->edge_count) {
+        uint32_t child = *cvector_as(
+          &graph->edges, node->edges + (*next)++, uint32_t);
+        if (!visited[child]) {
+          visited[child] = 1;
+          stack[top++] = child;
+          stack[top++] = 0;
+        }
+      } else {
+        cvector_push_back(handles, node->handle, asset_handle_t *);
+        top -= 2;
+      }
+    }
+  }
+
+  allocator->mem_free(stack);
+  allocator->mem_free(visited);
+}
+
+uint32_t
+asset_deps_prefetch(
+  asset_cache_t *cache,
+  const void *src,
+  type_id_t type_id,
+  uint32_t max_inflight,
+  cvector_t *handles)
+{
+  assert(cache && src && max_inflight && handles);
+
+  {
+    const allocator_t *allocator = cache->allocator;
+    deps_graph_t graph;
+    uint32_t issued = 0, expanded = 0, root_count, failed = 0;
+
+    cvector_setup(&graph.nodes, get_type_data(deps_node_t), 0, allocator);
+    cvector_setup(&graph.edges, get_type_data(uint32_t), 0, allocator);
+    chashmap_def(&graph.seen);
+    chashmap_setup(
+      &graph.seen,
+      get_type_data(asset_ref_t), get_type_data(uint32_t), allocator, 0.6f);
+    graph.parent = DEPS_NO_PARENT;
+    asset_deps_visit(src, type_id, graph_add, &graph);
+    root_count = (uint32_t)cvector_size(&graph.nodes);
+
+    // loads are issued ahead of the one being waited on, up to the window.
+    // every finished asset is expanded into the refs it holds.
+    while (expanded < cvector_size(&graph.nodes)) {
+      deps_node_t *node;
+      void *asset;
+
+      while (
+        issued < cvector_size(&graph.nodes) &&
+        issued - expanded < max_inflight) {
+        node = cvector_as(&graph.nodes, issued++, deps_node_t);
+        node->handle = asset_cache_acquire(cache, node->ref);
+      }
+
+      node = cvector_as(&graph.nodes, expanded, deps_node_t);
+      asset = asset_cache_wait(cache, node->handle);
+      node->edges = (uint32_t)cvector_size(&graph.edges);
+      if (asset) {
+        graph.parent = expanded;
+        asset_deps_visit(asset, node->ref->type_id, graph_add, &graph);
+        node = cvector_as(&graph.nodes, expanded, deps_node_t);
+      } else
+        ++failed;
+      node->edge_count = (uint32_t)cvector_size(&graph.edges) - node->edges;
+      ++expanded;
+    }
+
+    graph_sort(&graph, root_count, handles, allocator);
+
+    chashmap_cleanup(&graph.seen, NULL);
+    cvector_cleanup(&graph.edges, NULL);
+    cvector_cleanup(&graph.nodes, NULL);
+    return failed;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,456 @@
+/**
+ * @file asset_index.c
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <library/asset/asset_index.h>
+#include <library/containers/cvector.h>
+#include <library/filesystem/directory.h>
+#include <library/filesystem/io.h>
+#include <library/hash/fnv.h>
+#include <library/streams/binary_stream.h>
+#include <library/string/cstring.h>
+#include <library/threading/atomic.h>
+#include <library/threading/mutex.h>
+#include <library/threading/thread.h>
+
+#define ASSET_INDEX_HASH_CHUNK        (64 * 1024)
+#define ASSET_INDEX_MAX_WORKERS       16
+
+
+typedef
+struct index_header_t {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t payload_size;
+  uint64_t payload_hash;
+} index_header_t;
+
+typedef
+enum index_scan_state_t {
+  SCAN_UNCHANGED,
+  SCAN_ADDED,
+  SCAN_MODIFIED
+} index_scan_state_t;
+
+typedef
+struct index_scan_t {
+  size_t path;                          // offset of the full path in the pool
+  uint32_t length;
+  uint32_t state;                       // index_scan_state_t
+  asset_index_entry_t entry;
+} index_scan_t;
+
+typedef
+struct index_walk_t {
+  mutex_t mutex;
+  cvector_t scans;                      // index_scan_t
+  cvector_t pool;                       // char, zero terminated paths
+  size_t root_length;                   // skipped to get the relative path
+  asset_index_classify_fn_t classify;
+  void *user_data;
+} index_walk_t;
+
+typedef
+struct index_hasher_t {
+  index_walk_t *walk;
+  uint32_t *dirty;
+  uint32_t count;
+  volatile uint32_t next;
+} index_hasher_t;
+
+
+void
+asset_index_setup(asset_index_t *index, const allocator_t *allocator)
+{
+  assert(index && allocator);
+
+  chashmap_def(&index->entries);
+  chashmap_setup(
+    &index->entries,
+    get_type_data(cstring_t),
+    get_type_data(asset_index_entry_t),
+    allocator, 0.6f);
+  index->allocator = allocator;
+}
+
+void
+asset_index_cleanup(asset_index_t *index)
+{
+  assert(index && index->allocator);
+
+  chashmap_cleanup(&index->entries, NULL);
+  index->allocator = NULL;
+}
+
+size_t
+asset_index_size(const asset_index_t *index)
+{
+  assert(index && index->allocator);
+  return chashmap_size(&index->entries);
+}
+
+static
+uint32_t
+index_lookup(const chashmap_t *entries, const char *path, size_t length)
+{
+  uint32_t found;
+  cstring_t key;
+
+  // an empty bucket table cannot be probed.
+  if (!cvector_size(&entries->indices))
+    return CHASHTABLE_INVALID_INDEX;
+
+  key.str = (char *)path;
+  key.length = (uint32_t)length;
+  key.allocator = NULL;
+  chashmap_contains((chashmap_t *)entries, key, cstring_t, found);
+  return found;
+}
+
+const asset_index_entry_t *
+asset_index_find(const asset_index_t *index, const char *path)
+{
+  assert(index && index->allocator && path);
+
+  {
+    uint32_t found = index_lookup(&index->entries, path, strlen(path));
+    return found == CHASHTABLE_INVALID_INDEX ? NULL :
+      cvector_as_c(&index->entries.values, found, asset_index_entry_t);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+uint32_t
+asset_index_load(asset_index_t *index, const char *path)
+{
+  assert(index && index->allocator && path);
+
+  {
+    file_mapping_t mapping;
+    index_header_t header;
+    const uint8_t *payload;
+    cvector_t view;
+    binary_stream_t stream;
+    chashmap_t loaded;
+
+    if (!map_file(path, &mapping))
+      return 0;
+
+    if (mapping.size < sizeof(index_header_t)) {
+      unmap_file(&mapping);
+      return 0;
+    }
+
+    // the payload is only parsed once it is known to be intact, the
+    // deserializers assume well formed input.
+    memcpy(&header, mapping.data, sizeof(index_header_t));
+    payload = (const uint8_t *)mapping.data + sizeof(index_header_t);
+    if (
+      header.magic != ASSET_INDEX_MAGIC ||
+      header.version != ASSET_INDEX_VERSION ||
+      header.payload_size != mapping.size - sizeof(index_header_t) ||
+      header.payload_hash !=
+        hash_fnv1a_64(payload, (size_t)header.payload_size)) {
+      unmap_file(&mapping);
+      return 0;
+    }
+
+    // a read-only stream over the mapped pages, nothing is copied up front.
+    memset(&view, 0, sizeof(cvector_t));
+    view.elem_data = get_cont_elem_data_from_packed(get_type_data(uint8_t));
+    view.data = (void *)payload;
+    view.size = view.capacity = (size_t)header.payload_size;
+    view.allocator = index->allocator;
+    stream.data = &view;
+    stream.pos = STREAM_START_POS;
+    stream.allocator = index->allocator;
+    stream.flags = STREAM_FLAG_NONE;
+
+    chashmap_def(&loaded);
+    chashmap_deserialize(&loaded, index->allocator, &stream);
+    unmap_file(&mapping);
+
+    chashmap_fullswap(&index->entries, &loaded);
+    chashmap_cleanup(&loaded, NULL);
+    return 1;
+  }
+}
+
+uint32_t
+asset_index_save(const asset_index_t *index, const char *path)
+{
+  assert(index && index->allocator && path);
+
+  {
+    binary_stream_t stream;
+    index_header_t header;
+    file_handle_t file;
+    char temp[MAX_PATH_LENGTH];
+    size_t length = strlen(path), written = 0;
+    const uint8_t *payload;
+
+    if (length + 5 > sizeof(temp))
+      return 0;
+
+    binary_stream_def(&stream);
+    binary_stream_setup(&stream, index->allocator);
+    chashmap_serialize(&index->entries, &stream);
+    payload = (const uint8_t *)stream.data->data;
+
+    header.magic = ASSET_INDEX_MAGIC;
+    header.version = ASSET_INDEX_VERSION;
+    header.payload_size = binary_stream_size(&stream);
+    header.payload_hash =
+      hash_fnv1a_64(payload, (size_t)header.payload_size);
+
+    // written aside then renamed, a crash never leaves a torn index behind.
+    memcpy(temp, path, length);
+    memcpy(temp + length, ".tmp", 5);
+    file = open_file(
+      temp, (file_open_flags_t)(FILE_OPEN_MODE_WRITE | FILE_OPEN_MODE_BINARY));
+    if (file) {
+      written += write_buffer(file, &header, sizeof(index_header_t), 1);
+      written += write_buffer(file, payload, (size_t)header.payload_size, 1);
+      close_file(file);
+    }
+    binary_stream_cleanup(&stream);
+
+    if (written != 2) {
+      if (file)
+        remove(temp);
+      return 0;
+    }
+
+    remove(path);
+    return rename(temp, path) == 0;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static
+uint32_t
+index_walk_fn(
+  const char *path,
+  const dir_entry_t *entry,
+  uint32_t worker,
+  void *user_data)
+{
+  index_walk_t *walk = (index_walk_t *)user_data;
+  index_scan_t scan;
+  size_t length;
+  (void)worker;
+
+  if (entry->type != DIR_ENTRY_FILE)
+    return 1;
+
+  memset(&scan, 0, sizeof(index_scan_t));
+  if (walk->classify) {
+    scan.entry.type_id =
+      walk->classify(path + walk->root_length, walk->user_data);
+    if (!scan.entry.type_id)
+      return 1;
+  }
+
+  scan.entry.size = entry->size;
+  scan.entry.mtime = entry->mtime;
+  length = strlen(path);
+  scan.length = (uint32_t)length;
+
+  mutex_lock(&walk->mutex);
+  scan.path = cvector_size(&walk->pool);
+  cvector_resize(&walk->pool, scan.path + length + 1);
+  memcpy(cvector_at(&walk->pool, scan.path), path, length + 1);
+  cvector_push_back(&walk->scans, scan, index_scan_t);
+  mutex_unlock(&walk->mutex);
+  return 1;
+}
+
+static
+uint64_t
+index_hash_file(const char *path)
+{
+  uint8_t chunk[ASSET_INDEX_HASH_CHUNK];
+  uint64_t hash = FNV64_OFFSET_BASIS;
+  size_t read, i;
+  file_handle_t file = open_file(
+    path, (file_open_flags_t)(FILE_OPEN_MODE_READ | FILE_OPEN_MODE_BINARY));
+  if (!file)
+    return 0;
+
+  // fnv1a folds one byte at a time, chunks continue from the running value.
+  while ((read = read_buffer(file, chunk, 1, sizeof(chunk))) != 0) {
+    for (i = 0; i < read; ++i) {
+      hash ^= chunk[i];
+      hash *= FNV64_PRIME;
+    }
+  }
+
+  close_file(file);
+  return hash;
+}
+
+static
+void
+index_hash_worker(void *arg)
+{
+  index_hasher_t *hasher = (index_hasher_t *)arg;
+  index_walk_t *walk = hasher->walk;
+  uint32_t i;
+
+  while ((i = atomic_fetch_add_u32(&hasher->next, 1)) < hasher->count) {
+    index_scan_t *scan = cvector_as(&walk->scans, hasher->dirty[i], index_scan_t);
+    scan->entry.hash =
+      index_hash_file((const char *)cvector_at(&walk->pool, scan->path));
+  }
+}
+
+static
+void
+index_hash_dirty(index_hasher_t *hasher, uint32_t worker_count)
+{
+  thread_handle_t threads[ASSET_INDEX_MAX_WORKERS];
+  uint32_t i, spawned = 0;
+
+  worker_count = worker_count > hasher->count ? hasher->count : worker_count;
+  worker_count =
+    worker_count > ASSET_INDEX_MAX_WORKERS ?
+    ASSET_INDEX_MAX_WORKERS : worker_count;
+
+  // the calling thread doubles as the first worker.
+  for (i = 1; i < worker_count; ++i) {
+    threads[spawned] = thread_create(index_hash_worker, hasher);
+    if (threads[spawned] != INVALID_THREAD)
+      ++spawned;
+  }
+  index_hash_worker(hasher);
+  for (i = 0; i < spawned; ++i)
+    thread_join(threads[i]);
+}
+
+void
+asset_index_refresh(
+  asset_index_t *index,
+  const char *root,
+  asset_index_classify_fn_t classify,
+  void *user_data,
+  uint32_t worker_count,
+  asset_index_stats_t *stats)
+{
+  assert(index && index->allocator && root && worker_count);
+
+  {
+    const allocator_t *allocator = index->allocator;
+    chashmap_t *entries = &index->entries;
+    asset_index_stats_t local;
+    index_walk_t walk;
+    index_hasher_t hasher;
+    uint8_t *seen;
+    size_t i, count, existing = chashmap_size(entries);
+    size_t length = strlen(root);
+
+    // the walker strips trailing separators the same way.
+    while (length > 1 && (root[length - 1] == '/' || root[length - 1] == '\\'))
+      --length;
+
+    memset(&local, 0, sizeof(asset_index_stats_t));
+    memset(&walk, 0, sizeof(index_walk_t));
+    mutex_setup(&walk.mutex);
+    cvector_setup(&walk.scans, get_type_data(index_scan_t), 0, allocator);
+    cvector_setup(&walk.pool, get_type_data(char), 0, allocator);
+    walk.root_length = length + 1;
+    walk.classify = classify;
+    walk.user_data = user_data;
+    dir_walk(
+      root, DIR_FLAG_STAT, worker_count, index_walk_fn, &walk, allocator, NULL);
+    mutex_cleanup(&walk.mutex);
+
+    // diff against the index, only new files and mismatches get rehashed.
+    count = cvector_size(&walk.scans);
+    local.scanned = count;
+    seen = (uint8_t *)allocator->mem_alloc(existing + 1);
+    memset(seen, 0, existing + 1);
+    hasher.walk = &walk;
+    hasher.dirty = (uint32_t *)allocator->mem_alloc(
+      sizeof(uint32_t) * (count + 1));
+    hasher.count = 0;
+    hasher.next = 0;
+
+    for (i = 0; i < count; ++i) {
+      index_scan_t *scan = cvector_as(&walk.scans, i, index_scan_t);
+      const char *relative =
+        (const char *)cvector_at(&walk.pool, scan->path) + walk.root_length;
+      uint32_t found = index_lookup(
+        entries, relative, scan->length - walk.root_length);
+
+      if (found == CHASHTABLE_INVALID_INDEX)
+        scan->state = SCAN_ADDED;
+      else {
+        const asset_index_entry_t *entry =
+          cvector_as(&entries->values, found, asset_index_entry_t);
+        seen[found] = 1;
+        scan->entry.hash = entry->hash;
+        scan->state =
+          entry->size == scan->entry.size &&
+          entry->mtime == scan->entry.mtime &&
+          entry->type_id == scan->entry.type_id ?
+          SCAN_UNCHANGED : SCAN_MODIFIED;
+      }
+
+      if (scan->state != SCAN_UNCHANGED)
+        hasher.dirty[hasher.count++] = (uint32_t)i;
+    }
+
+    local.hashed = hasher.count;
+    if (hasher.count)
+      index_hash_dirty(&hasher, worker_count);
+
+    // stale pairs are dropped back to front so the lower indices stay valid,
+    // the bucket table is rebuilt once at the end.
+    for (i = existing; i-- > 0;) {
+      if (!seen[i]) {
+        cvector_erase(&entries->keys, i);
+        cvector_erase(&entries->values, i);
+        ++local.removed;
+      }
+    }
+
+    if (local.removed)
+      chashmap_rehash(entries, cvector_size(&entries->indices));
+
+    for (i = 0; i < hasher.count; ++i) {
+      index_scan_t *scan = cvector_as(&walk.scans, hasher.dirty[i], index_scan_t);
+      const char *relative =
+        (const char *)cvector_at(&walk.pool, scan->path) + walk.root_length;
+      cstring_t key;
+
+      if (scan->state == SCAN_MODIFIED) {
+        const asset_index_entry_t *entry =
+          asset_index_find(index, relative);
+        local.updated += entry->hash != scan->entry.hash;
+      } else
+        ++local.added;
+
+      key.str = (char *)relative;
+      key.length = scan->length - (uint32_t)walk.root_length;
+      key.allocator = NULL;
+      chashmap_insert(entries, key, cstring_t, scan->entry, asset_index_entry_t);
+    }
+
+    allocator->mem_free(hasher.dirty);
+    allocator->mem_free(seen);
+    cvector_cleanup(&walk.pool, NULL);
+    cvector_cleanup(&walk.scans, NULL);
+
+    if (stats)
+      *stats = local;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,430 @@
+/**
+ * @file cshardmap.c
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <assert.h>
+#include <string.h>
+#include <library/allocator/allocator.h>
+#include <library/containers/cshardmap.h>
+
+#define SHARD_INIT_CAPACITY           16
+
+#define slot_key(map, shard, slot) \
+  ((shard)->keys + (slot) * (map)->key_data.size)
+#define slot_value(map, shard, slot) \
+  ((shard)->values + (slot) * (map)->value_data.size)
+
+
+// registry hashes can be weak in the low or high bits, both are used here.
+static
+uint32_t
+mix_hash(uint32_t hash)
+{
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6b;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+static
+uint32_t
+key_hash(const cshardmap_t *map, const void *key)
+{
+  return mix_hash(map->hash(key));
+}
+
+static
+cshardmap_shard_t *
+key_shard(const cshardmap_t *map, uint32_t hash)
+{
+  // the high bits pick the shard, the low bits the slot inside of it.
+  return map->shards + (uint32_t)((uint64_t)hash >> map->shard_shift);
+}
+
+// the top bit only flags the slot as used, the low bits still give its home.
+static
+uint32_t
+hash_tag(uint32_t hash)
+{
+  return hash | 0x80000000;
+}
+
+static
+void
+elem_copy_in(
+  const container_elem_data_t *elem_data,
+  const void *src,
+  void *dst,
+  const allocator_t *allocator)
+{
+  fn_replicate_t replicate = elem_data_get_replicate_fn(elem_data);
+  if (replicate) {
+    if (elem_data->vtable->fn_def)
+      elem_data->vtable->fn_def(dst);
+    else
+      memset(dst, 0, elem_data->size);
+    replicate(src, dst, allocator);
+  } else
+    memcpy(dst, src, elem_data->size);
+}
+
+static
+void
+elem_release(
+  const container_elem_data_t *elem_data,
+  void *elem,
+  const allocator_t *allocator)
+{
+  fn_cleanup_t cleanup = elem_data_get_cleanup_fn(elem_data);
+  if (cleanup)
+    cleanup(elem, elem_data_get_cleanup_alloc(elem_data, allocator));
+}
+
+/** returns the slot holding 'key', or (size_t)-1. */
+static
+size_t
+shard_find(
+  const cshardmap_t *map,
+  const cshardmap_shard_t *shard,
+  const void *key,
+  uint32_t hash)
+{
+  size_t mask, slot;
+  uint32_t tag = hash_tag(hash);
+
+  if (!shard->capacity)
+    return (size_t)-1;
+
+  mask = shard->capacity - 1;
+  slot = hash & mask;
+  while (shard->tags[slot]) {
+    if (
+      shard->tags[slot] == tag &&
+      map->is_equal(slot_key(map, shard, slot), key))
+      return slot;
+    slot = (slot + 1) & mask;
+  }
+  return (size_t)-1;
+}
+
+static
+void
+shard_free(const cshardmap_t *map, cshardmap_shard_t *shard)
+{
+  map->allocator->mem_free(shard->tags);
+  map->allocator->mem_free(shard->keys);
+  map->allocator->mem_free(shard->values);
+}
+
+/** keys and values move as raw bytes, nothing is replicated. */
+static
+void
+shard_grow(const cshardmap_t *map, cshardmap_shard_t *shard)
+{
+  cshardmap_shard_t grown = *shard;
+  size_t i, slot, mask;
+
+  grown.capacity =
+    shard->capacity ? shard->capacity * 2 : SHARD_INIT_CAPACITY;
+  grown.tags = (uint32_t *)map->allocator->mem_cont_alloc(
+    grown.capacity, sizeof(uint32_t));
+  grown.keys = (uint8_t *)map->allocator->mem_alloc(
+    grown.capacity * map->key_data.size);
+  grown.values = (uint8_t *)map->allocator->mem_alloc(
+    grown.capacity * map->value_data.size);
+  mask = grown.capacity - 1;
+
+  for (i = 0; i < shard->capacity; ++i) {
+    if (!shard->tags[i])
+      continue;
+
+    slot = shard->tags[i] & mask;
+    while (grown.tags[slot])
+      slot = (slot + 1) & mask;
+    grown.tags[slot] = shard->tags[i];
+    memcpy(
+      slot_key(map, &grown, slot),
+      slot_key(map, shard, i), map->key_data.size);
+    memcpy(
+      slot_value(map, &grown, slot),
+      slot_value(map, shard, i), map->value_data.size);
+  }
+
+  if (shard->capacity)
+    shard_free(map, shard);
+  shard->capacity = grown.capacity;
+  shard->tags = grown.tags;
+  shard->keys = grown.keys;
+  shard->values = grown.values;
+}
+
+/** the caller holds the writer lock and made sure 'key' is missing. */
+static
+void
+shard_add(
+  const cshardmap_t *map,
+  cshardmap_shard_t *shard,
+  const void *key,
+  const void *value,
+  uint32_t hash)
+{
+  size_t mask, slot;
+
+  // linear probing stays short under half load.
+  if ((shard->size + 1) * 2 > shard->capacity)
+    shard_grow(map, shard);
+
+  mask = shard->capacity - 1;
+  slot = hash & mask;
+  while (shard->tags[slot])
+    slot = (slot + 1) & mask;
+
+  shard->tags[slot] = hash_tag(hash);
+  elem_copy_in(
+    &map->key_data, key, slot_key(map, shard, slot), map->allocator);
+  memcpy(slot_value(map, shard, slot), value, map->value_data.size);
+  ++shard->size;
+}
+
+/** backward shift deletion, probe chains never hold tombstones. */
+static
+void
+shard_remove(const cshardmap_t *map, cshardmap_shard_t *shard, size_t slot)
+{
+  size_t mask = shard->capacity - 1, next = slot, home;
+
+  elem_release(&map->key_data, slot_key(map, shard, slot), map->allocator);
+  elem_release(
+    &map->value_data, slot_value(map, shard, slot), map->allocator);
+
+  for (;;) {
+    next = (next + 1) & mask;
+    if (!shard->tags[next])
+      break;
+
+    // an entry can fill the hole if its home slot is not between the two.
+    home = shard->tags[next] & mask;
+    if (
+      (slot <= next) ?
+      (home > slot && home <= next) :
+      (home > slot || home <= next))
+      continue;
+
+    shard->tags[slot] = shard->tags[next];
+    memcpy(
+      slot_key(map, shard, slot),
+      slot_key(map, shard, next), map->key_data.size);
+    memcpy(
+      slot_value(map, shard, slot),
+      slot_value(map, shard, next), map->value_data.size);
+    slot = next;
+  }
+
+  shard->tags[slot] = 0;
+  --shard->size;
+}
+
+void
+cshardmap_cleanup(void *ptr, const allocator_t *allocator)
+{
+  cshardmap_t *map = (cshardmap_t *)ptr;
+  assert(map && !cshardmap_is_def(map));
+  assert(!allocator && "this type owns its own allocator!");
+
+  {
+    uint32_t i;
+    size_t slot;
+    for (i = 0; i < map->shard_count; ++i) {
+      cshardmap_shard_t *shard = map->shards + i;
+      for (slot = 0; slot < shard->capacity; ++slot) {
+        if (!shard->tags[slot])
+          continue;
+        elem_release(
+          &map->key_data, slot_key(map, shard, slot), map->allocator);
+        elem_release(
+          &map->value_data, slot_value(map, shard, slot), map->allocator);
+      }
+
+      if (shard->capacity)
+        shard_free(map, shard);
+      rwlock_cleanup(&shard->lock);
+    }
+
+    map->allocator->mem_free(map->shards);
+    cshardmap_def(map);
+  }
+}
+
+void
+cshardmap_setup(
+  cshardmap_t *map,
+  type_data_t key_type_data,
+  type_data_t value_type_data,
+  uint32_t shard_count,
+  const allocator_t *allocator)
+{
+  assert(map && allocator);
+
+  {
+    uint32_t i, rounded = 1, shift = 32;
+    shard_count = shard_count ? shard_count : CSHARDMAP_DEFAULT_SHARDS;
+    while (rounded < shard_count) {
+      rounded <<= 1;
+      --shift;
+    }
+
+    cshardmap_def(map);
+    map->key_data = get_cont_elem_data_from_packed(key_type_data);
+    map->value_data = get_cont_elem_data_from_packed(value_type_data);
+    map->hash = elem_data_get_hash_fn(&map->key_data);
+    map->is_equal = elem_data_get_is_equal_fn(&map->key_data);
+    assert(
+      map->hash && map->is_equal &&
+      "the key type must register hash and is_equal!");
+    map->shard_count = rounded;
+    map->shard_shift = shift;
+    map->allocator = allocator;
+    map->shards = (cshardmap_shard_t *)allocator->mem_cont_alloc(
+      rounded, sizeof(cshardmap_shard_t));
+    for (i = 0; i < rounded; ++i)
+      rwlock_setup(&map->shards[i].lock);
+  }
+}
+
+size_t
+cshardmap_size(cshardmap_t *map)
+{
+  assert(map && !cshardmap_is_def(map));
+
+  {
+    uint32_t i;
+    size_t size = 0;
+    for (i = 0; i < map->shard_count; ++i) {
+      rwlock_read_lock(&map->shards[i].lock);
+      size += map->shards[i].size;
+      rwlock_read_unlock(&map->shards[i].lock);
+    }
+    return size;
+  }
+}
+
+uint32_t
+cshardmap_insert(cshardmap_t *map, const void *key, const void *value)
+{
+  assert(map && !cshardmap_is_def(map) && key && value);
+
+  {
+    uint32_t hash = key_hash(map, key), added = 0;
+    cshardmap_shard_t *shard = key_shard(map, hash);
+    size_t slot;
+
+    rwlock_write_lock(&shard->lock);
+    slot = shard_find(map, shard, key, hash);
+    if (slot != (size_t)-1) {
+      void *stored = slot_value(map, shard, slot);
+      elem_release(&map->value_data, stored, map->allocator);
+      memcpy(stored, value, map->value_data.size);
+    } else {
+      shard_add(map, shard, key, value, hash);
+      added = 1;
+    }
+    rwlock_write_unlock(&shard->lock);
+    return added;
+  }
+}
+
+uint32_t
+cshardmap_try_insert(cshardmap_t *map, const void *key, const void *value)
+{
+  assert(map && !cshardmap_is_def(map) && key && value);
+
+  {
+    uint32_t hash = key_hash(map, key), added = 0;
+    cshardmap_shard_t *shard = key_shard(map, hash);
+
+    // most calls find the key (interning), a reader lock is enough for that.
+    rwlock_read_lock(&shard->lock);
+    added = shard_find(map, shard, key, hash) == (size_t)-1;
+    rwlock_read_unlock(&shard->lock);
+    if (!added)
+      return 0;
+
+    rwlock_write_lock(&shard->lock);
+    added = shard_find(map, shard, key, hash) == (size_t)-1;
+    if (added)
+      shard_add(map, shard, key, value, hash);
+    rwlock_write_unlock(&shard->lock);
+    return added;
+  }
+}
+
+uint32_t
+cshardmap_find(cshardmap_t *map, const void *key, void *value)
+{
+  assert(map && !cshardmap_is_def(map) && key);
+
+  {
+    uint32_t hash = key_hash(map, key);
+    cshardmap_shard_t *shard = key_shard(map, hash);
+    size_t slot;
+
+    rwlock_read_lock(&shard->lock);
+    slot = shard_find(map, shard, key, hash);
+    if (slot != (size_t)-1 && value)
+      elem_copy_in(
+        &map->value_data,
+        slot_value(map, shard, slot), value, map->allocator);
+    rwlock_read_unlock(&shard->lock);
+    return slot != (size_t)-1;
+  }
+}
+
+uint32_t
+cshardmap_read(
+  cshardmap_t *map,
+  const void *key,
+  cshardmap_reader_t reader,
+  void *user_data)
+{
+  assert(map && !cshardmap_is_def(map) && key && reader);
+
+  {
+    uint32_t hash = key_hash(map, key);
+    cshardmap_shard_t *shard = key_shard(map, hash);
+    size_t slot;
+
+    rwlock_read_lock(&shard->lock);
+    slot = shard_find(map, shard, key, hash);
+    if (slot != (size_t)-1)
+      reader(slot_value(map, shard, slot), user_data);
+    rwlock_read_unlock(&shard->lock);
+    return slot != (size_t)-1;
+  }
+}
+
+uint32_t
+cshardmap_erase(cshardmap_t *map, const void *key)
+{
+  assert(map && !cshardmap_is_def(map) && key);
+
+  {
+    uint32_t hash = key_hash(map, key);
+    cshardmap_shard_t *shard = key_shard(map, hash);
+    size_t slot;
+
+    rwlock_write_lock(&shard->lock);
+    slot = shard_find(map, shard, key, hash);
+    if (slot != (size_t)-1)
+      shard_remove(map, shard, slot);
+    rwlock_write_unlock(&shard->lock);
+    return slot != (size_t)-1;
+  }
+}
\ No newline at end of file
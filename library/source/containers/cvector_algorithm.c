@@ -0,0 +1,771 @@
+/**
+ * @file cvector_algorithm.c
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <assert.h>
+#include <string.h>
+#include <library/containers/cvector.h>
+#include <library/containers/cvector_algorithm.h>
+#include <library/profiler/profiler.h>
+#include <library/threading/job.h>
+
+#define SORT_INSERTION_MAX            16
+#define SORT_RADIX_MIN                64
+#define SORT_SWAP_CHUNK               64
+
+#define elem_at(base, index, size)    ((base) + (size_t)(index) * (size))
+
+typedef
+enum key_kind_t {
+  KEY_NONE,
+  KEY_UNSIGNED,
+  KEY_SIGNED,
+  KEY_FLOAT
+} key_kind_t;
+
+// how a registered primitive maps to an unsigned radix key.
+typedef
+struct key_info_t {
+  key_kind_t kind;
+  uint32_t width;
+} key_info_t;
+
+
+static
+void
+swap_elems(uint8_t *lhs, uint8_t *rhs, size_t size)
+{
+  uint8_t tmp[SORT_SWAP_CHUNK];
+
+  // the common widths, a fixed size copy is a couple of moves.
+  if (size == sizeof(uint32_t)) {
+    memcpy(tmp, lhs, sizeof(uint32_t));
+    memcpy(lhs, rhs, sizeof(uint32_t));
+    memcpy(rhs, tmp, sizeof(uint32_t));
+    return;
+  } else if (size == sizeof(uint64_t)) {
+    memcpy(tmp, lhs, sizeof(uint64_t));
+    memcpy(lhs, rhs, sizeof(uint64_t));
+    memcpy(rhs, tmp, sizeof(uint64_t));
+    return;
+  }
+
+  while (size) {
+    size_t bytes = size < SORT_SWAP_CHUNK ? size : SORT_SWAP_CHUNK;
+    memcpy(tmp, lhs, bytes);
+    memcpy(lhs, rhs, bytes);
+    memcpy(rhs, tmp, bytes);
+    lhs += bytes;
+    rhs += bytes;
+    size -= bytes;
+  }
+}
+
+static
+void
+insertion_sort(uint8_t *base, size_t count, size_t size, fn_compare_t compare)
+{
+  size_t i, j;
+  for (i = 1; i < count; ++i)
+    for (j = i; j; --j) {
+      uint8_t *prev = elem_at(base, j - 1, size), *curr = prev + size;
+      if (compare(prev, curr) <= 0)
+        break;
+      swap_elems(prev, curr, size);
+    }
+}
+
+static
+void
+sift_down(
+  uint8_t *base,
+  size_t root,
+  size_t count,
+  size_t size,
+  fn_compare_t compare)
+{
+  size_t child;
+  while ((child = 2 * root + 1) < count) {
+    if (
+      child + 1 < count &&
+      compare(elem_at(base, child, size), elem_at(base, child + 1, size)) < 0)
+      ++child;
+    if (compare(elem_at(base, root, size), elem_at(base, child, size)) >= 0)
+      return;
+    swap_elems(elem_at(base, root, size), elem_at(base, child, size), size);
+    root = child;
+  }
+}
+
+static
+void
+heap_sort(uint8_t *base, size_t count, size_t size, fn_compare_t compare)
+{
+  size_t i;
+  for (i = count / 2; i--;)
+    sift_down(base, i, count, size, compare);
+  for (i = count; i-- > 1;) {
+    swap_elems(base, elem_at(base, i, size), size);
+    sift_down(base, 0, i, size, compare);
+  }
+}
+
+static
+void
+intro_sort(
+  uint8_t *base,
+  size_t count,
+  size_t size,
+  fn_compare_t compare,
+  uint32_t depth)
+{
+  while (count > SORT_INSERTION_MAX) {
+    uint8_t *first = base, *mid, *last;
+    size_t i, j;
+
+    // too many bad pivots, the worst case stays n log n.
+    if (!depth--) {
+      heap_sort(base, count, size, compare);
+      return;
+    }
+
+    // median of three ends up at 0, 'last' is no smaller and stops the scan.
+    mid = elem_at(base, count / 2, size);
+    last = elem_at(base, count - 1, size);
+    if (compare(mid, first) < 0)
+      swap_elems(mid, first, size);
+    if (compare(last, mid) < 0) {
+      swap_elems(last, mid, size);
+      if (compare(mid, first) < 0)
+        swap_elems(mid, first, size);
+    }
+    swap_elems(first, mid, size);
+
+    // both scans stop on equal keys, runs of duplicates split evenly.
+    i = 0;
+    j = count;
+    for (;;) {
+      do ++i; while (i < count && compare(elem_at(base, i, size), base) < 0);
+      do --j; while (compare(elem_at(base, j, size), base) > 0);
+      if (i >= j)
+        break;
+      swap_elems(elem_at(base, i, size), elem_at(base, j, size), size);
+    }
+    swap_elems(base, elem_at(base, j, size), size);
+
+    // recurse on the smaller side, loop on the larger.
+    if (j < count - j - 1) {
+      intro_sort(base, j, size, compare, depth);
+      base = elem_at(base, j + 1, size);
+      count = count - j - 1;
+    } else {
+      intro_sort(
+        elem_at(base, j + 1, size), count - j - 1, size, compare, depth);
+      count = j;
+    }
+  }
+
+  insertion_sort(base, count, size, compare);
+}
+
+static
+uint32_t
+depth_limit(size_t count)
+{
+  uint32_t depth = 0;
+  for (; count > 1; count >>= 1)
+    depth += 2;
+  return depth;
+}
+
+// stable, takes from 'lhs' on ties.
+static
+void
+merge(
+  const uint8_t *lhs, size_t lhs_count,
+  const uint8_t *rhs, size_t rhs_count,
+  uint8_t *out,
+  size_t size,
+  fn_compare_t compare)
+{
+  const uint8_t *lhs_end = elem_at(lhs, lhs_count, size);
+  const uint8_t *rhs_end = elem_at(rhs, rhs_count, size);
+
+  while (lhs != lhs_end && rhs != rhs_end) {
+    if (compare(rhs, lhs) < 0) {
+      memcpy(out, rhs, size);
+      rhs += size;
+    } else {
+      memcpy(out, lhs, size);
+      lhs += size;
+    }
+    out += size;
+  }
+
+  // the tail of 'rhs' can already sit where it belongs, see merge_sort().
+  memcpy(out, lhs, lhs_end - lhs);
+  memmove(out + (lhs_end - lhs), rhs, rhs_end - rhs);
+}
+
+// 'temp' holds at least count / 2 elements.
+static
+void
+merge_sort(
+  uint8_t *base,
+  uint8_t *temp,
+  size_t count,
+  size_t size,
+  fn_compare_t compare)
+{
+  size_t half = count / 2;
+
+  if (count <= SORT_INSERTION_MAX) {
+    insertion_sort(base, count, size, compare);
+    return;
+  }
+
+  merge_sort(base, temp, half, size, compare);
+  merge_sort(elem_at(base, half, size), temp, count - half, size, compare);
+  if (compare(elem_at(base, half - 1, size), elem_at(base, half, size)) <= 0)
+    return;
+
+  // the right half is read ahead of where the output is written.
+  memcpy(temp, base, half * size);
+  merge(
+    temp, half, elem_at(base, half, size), count - half, base, size, compare);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// keys are turned into unsigned integers of the same width whose order is the
+// registered one, sorted, then turned back.
+
+#define DEFINE_KEY_CODEC(name__, type__)                                      \
+static                                                                        \
+void                                                                          \
+name__(void *data, size_t count, key_kind_t kind, uint32_t decode)            \
+{                                                                             \
+  type__ *keys = (type__ *)data;                                              \
+  const type__ sign = (type__)((type__)1 << (sizeof(type__) * 8 - 1));        \
+  size_t i;                                                                   \
+  if (kind == KEY_SIGNED) {                                                   \
+    for (i = 0; i < count; ++i)                                               \
+      keys[i] ^= sign;                                                        \
+  } else if (kind == KEY_FLOAT && !decode) {                                  \
+    for (i = 0; i < count; ++i)                                               \
+      keys[i] = (type__)((keys[i] & sign) ? ~keys[i] : (keys[i] | sign));     \
+  } else if (kind == KEY_FLOAT) {                                             \
+    for (i = 0; i < count; ++i)                                               \
+      keys[i] = (type__)((keys[i] & sign) ? (keys[i] ^ sign) : ~keys[i]);     \
+  }                                                                           \
+}
+
+// lsd, one byte per pass. passes where every key has the same digit are
+// skipped, small ranges only pay for the bytes that differ.
+#define DEFINE_RADIX_SORT(name__, type__)                                     \
+static                                                                        \
+void                                                                          \
+name__(void *data, void *temp, size_t count)                                  \
+{                                                                             \
+  size_t counts[sizeof(type__)][256];                                         \
+  type__ *src = (type__ *)data, *dst = (type__ *)temp, *swap;                 \
+  size_t i;                                                                   \
+  uint32_t pass;                                                              \
+  memset(counts, 0, sizeof(counts));                                          \
+  for (i = 0; i < count; ++i)                                                 \
+    for (pass = 0; pass < sizeof(type__); ++pass)                             \
+      ++counts[pass][(src[i] >> (pass * 8)) & 0xff];                          \
+  for (pass = 0; pass < sizeof(type__); ++pass) {                             \
+    size_t *offsets = counts[pass], total = 0;                                \
+    uint32_t shift = pass * 8;                                                \
+    if (offsets[(src[0] >> shift) & 0xff] == count)                           \
+      continue;                                                               \
+    for (i = 0; i < 256; ++i) {                                               \
+      size_t digit_count = offsets[i];                                        \
+      offsets[i] = total;                                                     \
+      total += digit_count;                                                   \
+    }                                                                         \
+    for (i = 0; i < count; ++i)                                               \
+      dst[offsets[(src[i] >> shift) & 0xff]++] = src[i];                      \
+    swap = src;                                                               \
+    src = dst;                                                                \
+    dst = swap;                                                               \
+  }                                                                           \
+  if (src != (type__ *)data)                                                  \
+    memcpy(data, src, count * sizeof(type__));                                \
+}
+
+// same as merge(), on encoded keys.
+#define DEFINE_KEY_MERGE(name__, type__)                                      \
+static                                                                        \
+void                                                                          \
+name__(                                                                       \
+  const void *lhs, size_t lhs_count,                                          \
+  const void *rhs, size_t rhs_count,                                          \
+  void *out)                                                                  \
+{                                                                             \
+  const type__ *left = (const type__ *)lhs, *right = (const type__ *)rhs;     \
+  const type__ *left_end = left + lhs_count, *right_end = right + rhs_count;  \
+  type__ *dst = (type__ *)out;                                                \
+  while (left != left_end && right != right_end)                              \
+    *dst++ = (*right < *left) ? *right++ : *left++;                           \
+  while (left != left_end)                                                    \
+    *dst++ = *left++;                                                         \
+  while (right != right_end)                                                  \
+    *dst++ = *right++;                                                        \
+}
+
+DEFINE_KEY_CODEC(key_codec_8, uint8_t)
+DEFINE_KEY_CODEC(key_codec_16, uint16_t)
+DEFINE_KEY_CODEC(key_codec_32, uint32_t)
+DEFINE_KEY_CODEC(key_codec_64, uint64_t)
+DEFINE_RADIX_SORT(radix_sort_8, uint8_t)
+DEFINE_RADIX_SORT(radix_sort_16, uint16_t)
+DEFINE_RADIX_SORT(radix_sort_32, uint32_t)
+DEFINE_RADIX_SORT(radix_sort_64, uint64_t)
+DEFINE_KEY_MERGE(key_merge_8, uint8_t)
+DEFINE_KEY_MERGE(key_merge_16, uint16_t)
+DEFINE_KEY_MERGE(key_merge_32, uint32_t)
+DEFINE_KEY_MERGE(key_merge_64, uint64_t)
+
+static
+int32_t
+compare_key_8(const void *lhs, const void *rhs)
+{
+  uint8_t left = *(const uint8_t *)lhs, right = *(const uint8_t *)rhs;
+  return (left > right) - (left < right);
+}
+
+static
+int32_t
+compare_key_16(const void *lhs, const void *rhs)
+{
+  uint16_t left = *(const uint16_t *)lhs, right = *(const uint16_t *)rhs;
+  return (left > right) - (left < right);
+}
+
+static
+int32_t
+compare_key_32(const void *lhs, const void *rhs)
+{
+  uint32_t left = *(const uint32_t *)lhs, right = *(const uint32_t *)rhs;
+  return (left > right) - (left < right);
+}
+
+static
+int32_t
+compare_key_64(const void *lhs, const void *rhs)
+{
+  uint64_t left = *(const uint64_t *)lhs, right = *(const uint64_t *)rhs;
+  return (left > right) - (left < right);
+}
+
+static
+void
+key_codec(void *data, size_t count, const key_info_t *key, uint32_t decode)
+{
+  switch (key->width) {
+    case 1: key_codec_8(data, count, key->kind, decode); break;
+    case 2: key_codec_16(data, count, key->kind, decode); break;
+    case 4: key_codec_32(data, count, key->kind, decode); break;
+    default: key_codec_64(data, count, key->kind, decode); break;
+  }
+}
+
+static
+void
+radix_sort(void *data, void *temp, size_t count, const key_info_t *key)
+{
+  switch (key->width) {
+    case 1: radix_sort_8(data, temp, count); break;
+    case 2: radix_sort_16(data, temp, count); break;
+    case 4: radix_sort_32(data, temp, count); break;
+    default: radix_sort_64(data, temp, count); break;
+  }
+}
+
+static
+void
+key_merge(
+  const void *lhs, size_t lhs_count,
+  const void *rhs, size_t rhs_count,
+  void *out,
+  const key_info_t *key)
+{
+  switch (key->width) {
+    case 1: key_merge_8(lhs, lhs_count, rhs, rhs_count, out); break;
+    case 2: key_merge_16(lhs, lhs_count, rhs, rhs_count, out); break;
+    case 4: key_merge_32(lhs, lhs_count, rhs, rhs_count, out); break;
+    default: key_merge_64(lhs, lhs_count, rhs, rhs_count, out); break;
+  }
+}
+
+static
+fn_compare_t
+key_compare(const key_info_t *key)
+{
+  switch (key->width) {
+    case 1: return compare_key_8;
+    case 2: return compare_key_16;
+    case 4: return compare_key_32;
+    default: return compare_key_64;
+  }
+}
+
+static
+key_info_t
+get_key_info(const container_elem_data_t *elem, fn_compare_t compare)
+{
+  key_info_t key;
+  type_id_t id = elem->type_id;
+  key.kind = KEY_NONE;
+  key.width = (uint32_t)elem->size;
+
+  // a custom order cannot be radix sorted.
+  if (compare && compare != elem_data_get_compare_fn(elem))
+    return key;
+
+  if (
+    id == get_type_id(uint8_t) || id == get_type_id(unsigned char) ||
+    id == get_type_id(uint16_t) || id == get_type_id(unsigned short) ||
+    id == get_type_id(uint32_t) || id == get_type_id(unsigned int) ||
+    id == get_type_id(uint64_t) || id == get_type_id(unsigned long long) ||
+    id == get_type_id(size_t))
+    key.kind = KEY_UNSIGNED;
+  else if (
+    id == get_type_id(int8_t) ||
+    id == get_type_id(int16_t) || id == get_type_id(short) ||
+    id == get_type_id(int32_t) || id == get_type_id(int) ||
+    id == get_type_id(int64_t) || id == get_type_id(long long))
+    key.kind = KEY_SIGNED;
+  else if (id == get_type_id(float) || id == get_type_id(double))
+    key.kind = KEY_FLOAT;
+  else if (id == get_type_id(char))
+    key.kind = ((char)-1 < 0) ? KEY_SIGNED : KEY_UNSIGNED;
+
+  if (key.width != 1 && key.width != 2 && key.width != 4 && key.width != 8)
+    key.kind = KEY_NONE;
+  return key;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+typedef
+struct sort_state_t {
+  uint8_t *data;
+  uint8_t *temp;
+  uint8_t *src;                         // sorted runs, swaps with dst per pass
+  uint8_t *dst;
+  size_t count;
+  size_t size;
+  fn_compare_t compare;
+  key_info_t key;
+  uint32_t stable;
+  uint32_t chunks;
+  uint32_t run;                         // chunks per sorted run
+} sort_state_t;
+
+static
+size_t
+chunk_start(const sort_state_t *state, uint32_t chunk)
+{
+  return (size_t)((uint64_t)state->count * chunk / state->chunks);
+}
+
+// sorts [0, count) of 'base' with 'temp' as scratch, keys already encoded.
+static
+void
+sort_range(
+  uint8_t *base,
+  uint8_t *temp,
+  size_t count,
+  const sort_state_t *state)
+{
+  if (state->key.kind != KEY_NONE)
+    radix_sort(base, temp, count, &state->key);
+  else if (state->stable)
+    merge_sort(base, temp, count, state->size, state->compare);
+  else
+    intro_sort(base, count, state->size, state->compare, depth_limit(count));
+}
+
+static
+void
+sort_chunks(uint32_t begin, uint32_t end, void *user_data)
+{
+  sort_state_t *state = (sort_state_t *)user_data;
+  for (; begin < end; ++begin) {
+    size_t first = chunk_start(state, begin);
+    size_t count = chunk_start(state, begin + 1) - first;
+    uint8_t *base = elem_at(state->data, first, state->size);
+    if (state->key.kind != KEY_NONE)
+      key_codec(base, count, &state->key, 0);
+    sort_range(base, elem_at(state->temp, first, state->size), count, state);
+  }
+}
+
+// how many of the first 'diagonal' merged elements come from 'lhs'.
+static
+size_t
+merge_path(
+  const uint8_t *lhs, size_t lhs_count,
+  const uint8_t *rhs, size_t rhs_count,
+  size_t diagonal,
+  size_t size,
+  fn_compare_t compare)
+{
+  size_t low = diagonal > rhs_count ? diagonal - rhs_count : 0;
+  size_t high = diagonal < lhs_count ? diagonal : lhs_count;
+
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    const uint8_t *left = elem_at(lhs, mid, size);
+    const uint8_t *right = elem_at(rhs, diagonal - mid - 1, size);
+    if (compare(left, right) <= 0)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+
+  return low;
+}
+
+// every pair of runs is cut in run * 2 pieces of equal output length, the
+// pass always has 'chunks' pieces to hand out, however few runs are left.
+static
+void
+merge_pieces(uint32_t begin, uint32_t end, void *user_data)
+{
+  sort_state_t *state = (sort_state_t *)user_data;
+  uint32_t pieces = state->run * 2;
+  size_t size = state->size;
+
+  for (; begin < end; ++begin) {
+    uint32_t pair = begin / pieces, piece = begin % pieces;
+    size_t first = chunk_start(state, pair * pieces);
+    size_t middle = chunk_start(state, pair * pieces + state->run);
+    size_t last = chunk_start(state, pair * pieces + pieces);
+    const uint8_t *lhs = elem_at(state->src, first, size);
+    const uint8_t *rhs = elem_at(state->src, middle, size);
+    size_t lhs_count = middle - first, rhs_count = last - middle;
+    size_t total = lhs_count + rhs_count;
+    size_t from = (size_t)((uint64_t)total * piece / pieces);
+    size_t to = (size_t)((uint64_t)total * (piece + 1) / pieces);
+    size_t lhs_from = merge_path(
+      lhs, lhs_count, rhs, rhs_count, from, size, state->compare);
+    size_t lhs_to = merge_path(
+      lhs, lhs_count, rhs, rhs_count, to, size, state->compare);
+    uint8_t *out = elem_at(state->dst, first + from, size);
+
+    lhs_count = lhs_to - lhs_from;
+    rhs_count = (to - lhs_to) - (from - lhs_from);
+    lhs = elem_at(lhs, lhs_from, size);
+    rhs = elem_at(rhs, from - lhs_from, size);
+    if (state->key.kind != KEY_NONE)
+      key_merge(lhs, lhs_count, rhs, rhs_count, out, &state->key);
+    else
+      merge(lhs, lhs_count, rhs, rhs_count, out, size, state->compare);
+  }
+}
+
+static
+void
+finish_chunks(uint32_t begin, uint32_t end, void *user_data)
+{
+  sort_state_t *state = (sort_state_t *)user_data;
+  size_t first = chunk_start(state, begin);
+  size_t count = chunk_start(state, end) - first;
+  uint8_t *base = elem_at(state->data, first, state->size);
+
+  if (state->src != state->data)
+    memcpy(base, elem_at(state->src, first, state->size), count * state->size);
+  if (state->key.kind != KEY_NONE)
+    key_codec(base, count, &state->key, 1);
+}
+
+static
+void
+parallel_sort(sort_state_t *state, job_system_t *jobs)
+{
+  uint8_t *swap;
+
+  // a power of two, so runs always pair up.
+  state->chunks = 1;
+  while (state->chunks < jobs->worker_count * 2)
+    state->chunks <<= 1;
+
+  job_parallel_for(jobs, state->chunks, 1, sort_chunks, state);
+
+  // the merges compare encoded keys.
+  if (state->key.kind != KEY_NONE)
+    state->compare = key_compare(&state->key);
+
+  state->src = state->data;
+  state->dst = state->temp;
+  for (state->run = 1; state->run < state->chunks; state->run <<= 1) {
+    job_parallel_for(jobs, state->chunks, 1, merge_pieces, state);
+    swap = state->src;
+    state->src = state->dst;
+    state->dst = swap;
+  }
+
+  job_parallel_for(jobs, state->chunks, 1, finish_chunks, state);
+}
+
+static
+void
+sort_common(
+  cvector_t *vec,
+  fn_compare_t compare,
+  job_system_t *jobs,
+  uint32_t stable)
+{
+  assert(vec);
+
+  {
+    sort_state_t state;
+    size_t count = vec->size;
+    const allocator_t *allocator = vec->allocator;
+    uint32_t parallel;
+
+    if (count < 2)
+      return;
+
+    memset(&state, 0, sizeof(sort_state_t));
+    state.data = (uint8_t *)vec->data;
+    state.count = count;
+    state.size = vec->elem_data.size;
+    state.stable = stable;
+    state.key = get_key_info(&vec->elem_data, compare);
+    state.compare =
+      compare ? compare : elem_data_get_compare_fn(&vec->elem_data);
+    assert(state.compare && "no comparator given or registered!");
+
+    parallel =
+      jobs && jobs->worker_count > 1 && count >= CVECTOR_SORT_PARALLEL_MIN;
+    if (state.key.kind != KEY_NONE && count < SORT_RADIX_MIN && !parallel)
+      state.key.kind = KEY_NONE;
+
+    if (!parallel && state.key.kind == KEY_NONE && !stable) {
+      intro_sort(state.data, count, state.size, state.compare,
+        depth_limit(count));
+      return;
+    }
+
+    state.temp = (uint8_t *)allocator->mem_alloc(count * state.size);
+    if (parallel)
+      parallel_sort(&state, jobs);
+    else {
+      if (state.key.kind != KEY_NONE)
+        key_codec(state.data, count, &state.key, 0);
+      sort_range(state.data, state.temp, count, &state);
+      if (state.key.kind != KEY_NONE)
+        key_codec(state.data, count, &state.key, 1);
+    }
+    allocator->mem_free(state.temp);
+  }
+}
+
+void
+cvector_sort(cvector_t *vec, fn_compare_t compare, job_system_t *jobs)
+{
+  PROFILE_BEGIN("cvector_sort");
+  sort_common(vec, compare, jobs, 0);
+  PROFILE_END();
+}
+
+void
+cvector_stable_sort(cvector_t *vec, fn_compare_t compare, job_system_t *jobs)
+{
+  PROFILE_BEGIN("cvector_stable_sort");
+  sort_common(vec, compare, jobs, 1);
+  PROFILE_END();
+}
+
+size_t
+cvector_unique(cvector_t *vec, fn_is_equal_t is_equal)
+{
+  assert(vec);
+
+  {
+    size_t size = vec->elem_data.size, read, write = 0;
+    uint8_t *base = (uint8_t *)vec->data;
+    fn_cleanup_t cleanup = elem_data_get_cleanup_fn(&vec->elem_data);
+    const allocator_t *allocator =
+      elem_data_get_cleanup_alloc(&vec->elem_data, vec->allocator);
+    is_equal = is_equal ? is_equal : elem_data_get_is_equal_fn(&vec->elem_data);
+    assert(is_equal && "no equality given or registered!");
+
+    if (!vec->size)
+      return 0;
+
+    for (read = 1; read < vec->size; ++read) {
+      if (is_equal(elem_at(base, write, size), elem_at(base, read, size))) {
+        if (cleanup)
+          cleanup(elem_at(base, read, size), allocator);
+      } else if (++write != read)
+        memcpy(elem_at(base, write, size), elem_at(base, read, size), size);
+    }
+
+    vec->size = write + 1;
+    return vec->size;
+  }
+}
+
+size_t
+cvector_partition(
+  cvector_t *vec,
+  cvector_predicate_t predicate,
+  void *user_data)
+{
+  assert(vec && predicate);
+
+  {
+    size_t size = vec->elem_data.size, first = 0, last = vec->size;
+    uint8_t *base = (uint8_t *)vec->data;
+
+    for (;;) {
+      uint8_t *front, *back;
+      while (first < last && predicate(elem_at(base, first, size), user_data))
+        ++first;
+      while (
+        first < last && !predicate(elem_at(base, last - 1, size), user_data))
+        --last;
+      if (first >= last)
+        return first;
+      front = elem_at(base, first++, size);
+      back = elem_at(base, --last, size);
+      swap_elems(front, back, size);
+    }
+  }
+}
+
+size_t
+cvector_lower_bound(
+  const cvector_t *vec,
+  const void *key,
+  fn_compare_t compare)
+{
+  assert(vec && key);
+
+  {
+    size_t size = vec->elem_data.size, low = 0, high = vec->size;
+    const uint8_t *base = (const uint8_t *)vec->data;
+    compare = compare ? compare : elem_data_get_compare_fn(&vec->elem_data);
+    assert(compare && "no comparator given or registered!");
+
+    while (low < high) {
+      size_t mid = low + (high - low) / 2;
+      if (compare(elem_at(base, mid, size), key) < 0)
+        low = mid + 1;
+      else
+        high = mid;
+    }
+
+    return low;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,570 @@
+/**
+ * @file async_io.c
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#if defined(WIN32) || defined(WIN64)
+#include <windows.h>
+#include <io.h>
+#else
+#include <sys/types.h>
+#include <unistd.h>
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define ASYNC_IO_HAS_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+#endif
+#endif
+#include <library/allocator/allocator.h>
+#include <library/filesystem/async_io.h>
+#include <library/threading/atomic.h>
+
+#define ASYNC_IO_RING_ENTRIES         256
+
+
+// blocking positional io, used by the worker threads.
+static
+void
+perform_blocking(async_io_request_t *request)
+{
+  uint8_t *buffer = (uint8_t *)request->buffer;
+  size_t done = 0;
+  int32_t error = 0;
+
+#if defined(WIN32) || defined(WIN64)
+  HANDLE handle =
+    (HANDLE)_get_osfhandle(_fileno((FILE *)request->file));
+
+  while (done < request->size) {
+    OVERLAPPED overlapped;
+    uint64_t offset = request->offset + done;
+    size_t left = request->size - done;
+    DWORD chunk = left > 0x40000000 ? 0x40000000 : (DWORD)left;
+    DWORD count = 0;
+    BOOL result;
+
+    memset(&overlapped, 0, sizeof(OVERLAPPED));
+    overlapped.Offset = (DWORD)offset;
+    overlapped.OffsetHigh = (DWORD)(offset >> 32);
+    result = request->op == ASYNC_IO_OP_READ ?
+      ReadFile(handle, buffer + done, chunk, &count, &overlapped) :
+      WriteFile(handle, buffer + done, chunk, &count, &overlapped);
+
+    if (!result) {
+      DWORD code = GetLastError();
+      if (code != ERROR_HANDLE_EOF)
+        error = (int32_t)code;
+      break;
+    }
+
+    if (!count)
+      break;
+    done += count;
+  }
+#else
+  int fd = fileno((FILE *)request->file);
+
+  while (done < request->size) {
+    off_t offset = (off_t)(request->offset + done);
+    ssize_t count = request->op == ASYNC_IO_OP_READ ?
+      pread(fd, buffer + done, request->size - done, offset) :
+      pwrite(fd, buffer + done, request->size - done, offset);
+
+    if (count < 0) {
+      if (errno == EINTR)
+        continue;
+      error = errno;
+      break;
+    }
+
+    if (!count)
+      break;
+    done += (size_t)count;
+  }
+#endif
+
+  request->transferred = done;
+  request->error = error;
+}
+
+// publishes the completion, the request is not touched afterwards.
+static
+void
+finish(async_io_t *io, async_io_request_t *request)
+{
+  if (request->fn_complete)
+    request->fn_complete(request);
+
+  mutex_lock(&io->mutex);
+  atomic_store_u32(
+    &request->status,
+    request->error ? ASYNC_IO_STATUS_FAILED : ASYNC_IO_STATUS_DONE);
+  condvar_broadcast(&io->completed);
+  mutex_unlock(&io->mutex);
+}
+
+static
+void
+worker_thread(void *arg)
+{
+  async_io_t *io = (async_io_t *)arg;
+
+  for (;;) {
+    async_io_request_t *request;
+
+    // the queue is drained before honouring 'stop'.
+    mutex_lock(&io->mutex);
+    while (!io->head && !io->stop)
+      condvar_wait(&io->pending, &io->mutex);
+    request = io->head;
+    if (request) {
+      io->head = request->next;
+      if (!io->head)
+        io->tail = NULL;
+    }
+    mutex_unlock(&io->mutex);
+
+    if (!request)
+      return;
+
+    perform_blocking(request);
+    finish(io, request);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#if defined(ASYNC_IO_HAS_IO_URING)
+
+struct async_io_ring_t {
+  int fd;
+  void *sq_ptr;
+  size_t sq_size;
+  void *cq_ptr;
+  size_t cq_size;
+  struct io_uring_sqe *sqes;
+  size_t sqes_size;
+  uint32_t *sq_tail;
+  uint32_t *sq_mask;
+  uint32_t *sq_array;
+  uint32_t *cq_head;
+  uint32_t *cq_tail;
+  uint32_t *cq_mask;
+  struct io_uring_cqe *cqes;
+  uint32_t cq_entries;
+  uint32_t inflight;                    // guarded by the io mutex
+  thread_handle_t reaper;
+};
+
+static
+int
+ring_enter(int fd, uint32_t submit, uint32_t wait, uint32_t flags)
+{
+  int result;
+  do {
+    result = (int)syscall(
+      __NR_io_uring_enter, fd, submit, wait, flags, NULL, 0);
+  } while (result < 0 && (errno == EINTR || errno == EAGAIN));
+  return result;
+}
+
+static
+void
+ring_unmap(async_io_ring_t *ring)
+{
+  if (ring->sqes)
+    munmap(ring->sqes, ring->sqes_size);
+  if (ring->cq_ptr && ring->cq_ptr != ring->sq_ptr)
+    munmap(ring->cq_ptr, ring->cq_size);
+  if (ring->sq_ptr)
+    munmap(ring->sq_ptr, ring->sq_size);
+  close(ring->fd);
+}
+
+// returns 0 if io_uring is unavailable (old kernel, seccomp, limits).
+static
+uint32_t
+ring_setup(async_io_ring_t *ring)
+{
+  struct io_uring_params params;
+  uint8_t *sq, *cq;
+
+  memset(ring, 0, sizeof(async_io_ring_t));
+  memset(&params, 0, sizeof(params));
+  ring->fd = (int)syscall(
+    __NR_io_uring_setup, ASYNC_IO_RING_ENTRIES, &params);
+  if (ring->fd < 0)
+    return 0;
+
+  ring->sq_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  ring->cq_size =
+    params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  if (params.features & IORING_FEAT_SINGLE_MMAP) {
+    if (ring->cq_size > ring->sq_size)
+      ring->sq_size = ring->cq_size;
+    ring->cq_size = ring->sq_size;
+  }
+
+  ring->sq_ptr = mmap(
+    NULL, ring->sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+    ring->fd, IORING_OFF_SQ_RING);
+  if (ring->sq_ptr == MAP_FAILED) {
+    ring->sq_ptr = NULL;
+    ring_unmap(ring);
+    return 0;
+  }
+
+  if (params.features & IORING_FEAT_SINGLE_MMAP)
+    ring->cq_ptr = ring->sq_ptr;
+  else {
+    ring->cq_ptr = mmap(
+      NULL, ring->cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+      ring->fd, IORING_OFF_CQ_RING);
+    if (ring->cq_ptr == MAP_FAILED) {
+      ring->cq_ptr = NULL;
+      ring_unmap(ring);
+      return 0;
+    }
+  }
+
+  ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+  ring->sqes = (struct io_uring_sqe *)mmap(
+    NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+    ring->fd, IORING_OFF_SQES);
+  if (ring->sqes == MAP_FAILED) {
+    ring->sqes = NULL;
+    ring_unmap(ring);
+    return 0;
+  }
+
+  sq = (uint8_t *)ring->sq_ptr;
+  cq = (uint8_t *)ring->cq_ptr;
+  ring->sq_tail = (uint32_t *)(sq + params.sq_off.tail);
+  ring->sq_mask = (uint32_t *)(sq + params.sq_off.ring_mask);
+  ring->sq_array = (uint32_t *)(sq + params.sq_off.array);
+  ring->cq_head = (uint32_t *)(cq + params.cq_off.head);
+  ring->cq_tail = (uint32_t *)(cq + params.cq_off.tail);
+  ring->cq_mask = (uint32_t *)(cq + params.cq_off.ring_mask);
+  ring->cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+  ring->cq_entries = params.cq_entries;
+  return 1;
+}
+
+// NOTE: the io mutex must be held, a NULL request is the reaper's stop marker.
+static
+void
+ring_push(async_io_ring_t *ring, async_io_request_t *request)
+{
+  uint32_t tail = *ring->sq_tail;
+  uint32_t index = tail & *ring->sq_mask;
+  struct io_uring_sqe *sqe = ring->sqes + index;
+
+  memset(sqe, 0, sizeof(struct io_uring_sqe));
+  if (request) {
+    struct iovec *iov = (struct iovec *)request->iov;
+    iov->iov_base = (uint8_t *)request->buffer + request->transferred;
+    iov->iov_len = request->size - request->transferred;
+    sqe->opcode = request->op == ASYNC_IO_OP_READ ?
+      IORING_OP_READV : IORING_OP_WRITEV;
+    sqe->fd = fileno((FILE *)request->file);
+    sqe->addr = (uint64_t)(uintptr_t)iov;
+    sqe->len = 1;
+    sqe->off = request->offset + request->transferred;
+    ++ring->inflight;
+  } else
+    sqe->opcode = IORING_OP_NOP;
+  sqe->user_data = (uint64_t)(uintptr_t)request;
+
+  ring->sq_array[index] = index;
+  atomic_store_u32(ring->sq_tail, tail + 1);
+  ring_enter(ring->fd, 1, 0, 0);
+}
+
+static
+void
+reaper_thread(void *arg)
+{
+  async_io_t *io = (async_io_t *)arg;
+  async_io_ring_t *ring = io->ring;
+
+  for (;;) {
+    uint32_t head = *ring->cq_head;
+    uint32_t tail = atomic_load_u32(ring->cq_tail);
+
+    if (head == tail) {
+      ring_enter(ring->fd, 0, 1, IORING_ENTER_GETEVENTS);
+      continue;
+    }
+
+    {
+      struct io_uring_cqe *cqe = ring->cqes + (head & *ring->cq_mask);
+      async_io_request_t *request =
+        (async_io_request_t *)(uintptr_t)cqe->user_data;
+      int32_t result = cqe->res;
+      atomic_store_u32(ring->cq_head, head + 1);
+
+      if (!request)
+        return;
+
+      // short transfers are resubmitted for the remainder, 0 means eof.
+      mutex_lock(&io->mutex);
+      --ring->inflight;
+      if (result > 0) {
+        request->transferred += (size_t)result;
+        if (request->transferred < request->size) {
+          ring_push(ring, request);
+          mutex_unlock(&io->mutex);
+          continue;
+        }
+      } else if (result < 0)
+        request->error = -result;
+      condvar_broadcast(&io->completed);
+      mutex_unlock(&io->mutex);
+
+      finish(io, request);
+    }
+  }
+}
+
+static
+uint32_t
+uring_setup(async_io_t *io)
+{
+  async_io_ring_t *ring =
+    (async_io_ring_t *)io->allocator->mem_alloc(sizeof(async_io_ring_t));
+  if (!ring_setup(ring)) {
+    io->allocator->mem_free(ring);
+    return 0;
+  }
+
+  io->ring = ring;
+  ring->reaper = thread_create(reaper_thread, io);
+  if (ring->reaper == INVALID_THREAD) {
+    ring_unmap(ring);
+    io->allocator->mem_free(ring);
+    io->ring = NULL;
+    return 0;
+  }
+
+  return 1;
+}
+
+static
+void
+uring_submit(async_io_t *io, async_io_request_t *request)
+{
+  async_io_ring_t *ring = io->ring;
+
+  // never have more requests in flight than the completion queue can hold.
+  mutex_lock(&io->mutex);
+  while (ring->inflight >= ring->cq_entries)
+    condvar_wait(&io->completed, &io->mutex);
+  ring_push(ring, request);
+  mutex_unlock(&io->mutex);
+}
+
+static
+void
+uring_cleanup(async_io_t *io)
+{
+  async_io_ring_t *ring = io->ring;
+
+  mutex_lock(&io->mutex);
+  while (ring->inflight)
+    condvar_wait(&io->completed, &io->mutex);
+  ring_push(ring, NULL);
+  mutex_unlock(&io->mutex);
+
+  thread_join(ring->reaper);
+  ring_unmap(ring);
+  io->allocator->mem_free(ring);
+  io->ring = NULL;
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+async_io_backend_t
+async_io_setup(
+  async_io_t *io,
+  async_io_backend_t backend,
+  uint32_t worker_count,
+  const allocator_t *allocator)
+{
+  assert(io && allocator);
+
+  memset(io, 0, sizeof(async_io_t));
+  io->allocator = allocator;
+  mutex_setup(&io->mutex);
+  condvar_setup(&io->pending);
+  condvar_setup(&io->completed);
+
+#if defined(ASYNC_IO_HAS_IO_URING)
+  if (backend != ASYNC_IO_BACKEND_THREADS && uring_setup(io)) {
+    io->backend = ASYNC_IO_BACKEND_IO_URING;
+    return io->backend;
+  }
+#endif
+
+  io->backend = ASYNC_IO_BACKEND_THREADS;
+  if (!worker_count)
+    worker_count = thread_hardware_concurrency();
+  worker_count =
+    worker_count > ASYNC_IO_MAX_WORKERS ? ASYNC_IO_MAX_WORKERS : worker_count;
+
+  for (; io->thread_count < worker_count; ++io->thread_count) {
+    io->threads[io->thread_count] = thread_create(worker_thread, io);
+    if (io->threads[io->thread_count] == INVALID_THREAD)
+      break;
+  }
+  assert(io->thread_count && "could not start any io thread!");
+
+  return io->backend;
+}
+
+void
+async_io_cleanup(async_io_t *io)
+{
+  assert(io);
+
+#if defined(ASYNC_IO_HAS_IO_URING)
+  if (io->ring)
+    uring_cleanup(io);
+#endif
+
+  {
+    uint32_t i;
+    mutex_lock(&io->mutex);
+    io->stop = 1;
+    condvar_broadcast(&io->pending);
+    mutex_unlock(&io->mutex);
+
+    for (i = 0; i < io->thread_count; ++i)
+      thread_join(io->threads[i]);
+    io->thread_count = 0;
+  }
+
+  condvar_cleanup(&io->completed);
+  condvar_cleanup(&io->pending);
+  mutex_cleanup(&io->mutex);
+}
+
+void
+async_io_submit(async_io_t *io, async_io_request_t *request)
+{
+  assert(io && request);
+  assert((void *)request->file != NULL);
+  assert(request->buffer || !request->size);
+  assert(atomic_load_u32(&request->status) != ASYNC_IO_STATUS_PENDING);
+
+  request->next = NULL;
+  request->transferred = 0;
+  request->error = 0;
+  atomic_store_u32(&request->status, ASYNC_IO_STATUS_PENDING);
+
+#if defined(ASYNC_IO_HAS_IO_URING)
+  if (io->ring) {
+    uring_submit(io, request);
+    return;
+  }
+#endif
+
+  mutex_lock(&io->mutex);
+  if (io->tail)
+    io->tail->next = request;
+  else
+    io->head = request;
+  io->tail = request;
+  condvar_signal(&io->pending);
+  mutex_unlock(&io->mutex);
+}
+
+uint32_t
+async_io_poll(const async_io_request_t *request)
+{
+  assert(request);
+  return atomic_load_u32(&request->status);
+}
+
+uint32_t
+async_io_wait(async_io_t *io, async_io_request_t *request)
+{
+  assert(io && request);
+
+  {
+    uint32_t status;
+    mutex_lock(&io->mutex);
+    while ((status = atomic_load_u32(&request->status)) ==
+      ASYNC_IO_STATUS_PENDING)
+      condvar_wait(&io->completed, &io->mutex);
+    mutex_unlock(&io->mutex);
+    return status;
+  }
+}
+
+static
+void
+request_setup(
+  async_io_request_t *request,
+  async_io_op_t op,
+  file_handle_t file,
+  void *buffer,
+  size_t size,
+  uint64_t offset,
+  async_io_callback_t fn_complete,
+  void *user_data)
+{
+  assert(request);
+  memset(request, 0, sizeof(async_io_request_t));
+  request->file = file;
+  request->op = op;
+  request->buffer = buffer;
+  request->size = size;
+  request->offset = offset;
+  request->fn_complete = fn_complete;
+  request->user_data = user_data;
+  request->status = ASYNC_IO_STATUS_IDLE;
+}
+
+void
+async_io_request_read(
+  async_io_request_t *request,
+  file_handle_t file,
+  void *buffer,
+  size_t size,
+  uint64_t offset,
+  async_io_callback_t fn_complete,
+  void *user_data)
+{
+  request_setup(
+    request, ASYNC_IO_OP_READ, file,
+    buffer, size, offset, fn_complete, user_data);
+}
+
+void
+async_io_request_write(
+  async_io_request_t *request,
+  file_handle_t file,
+  const void *buffer,
+  size_t size,
+  uint64_t offset,
+  async_io_callback_t fn_complete,
+  void *user_data)
+{
+  // the buffer is only read from for writes.
+  request_setup(
+    request, ASYNC_IO_OP_WRITE, file,
+    (void *)buffer, size, offset, fn_complete, user_data);
+}
\ No newline at end of file
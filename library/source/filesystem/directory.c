@@ -0,0 +1,396 @@
+/**
+ * @file directory.c
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+#if defined(WIN32) || defined(WIN64)
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#endif
+#include <library/allocator/allocator.h>
+#include <library/filesystem/directory.h>
+#include <library/threading/mutex.h>
+#include <library/threading/thread.h>
+
+#if defined(WIN32) || defined(WIN64)
+typedef
+struct dir_state_t {
+  HANDLE handle;
+  WIN32_FIND_DATAA ffd;
+} dir_state_t;
+#else
+typedef
+struct dir_state_t {
+  DIR *dir;
+  int fd;
+} dir_state_t;
+#endif
+
+// a negative array size fails the build if the storage is too small.
+typedef char dir_storage_check_t[
+  sizeof(dir_state_t) <= DIR_ITERATOR_STORAGE ? 1 : -1];
+
+#define DIR_STATE(iterator) ((dir_state_t *)(iterator)->storage.bytes)
+
+
+static
+uint32_t
+is_dot_entry(const char *name)
+{
+  return name[0] == '.' && (!name[1] || (name[1] == '.' && !name[2]));
+}
+
+#if defined(WIN32) || defined(WIN64)
+
+uint32_t
+dir_iterator_open(
+  dir_iterator_t *iterator,
+  const char *directory,
+  uint32_t flags)
+{
+  assert(iterator && directory);
+
+  {
+    dir_state_t *state = DIR_STATE(iterator);
+    char pattern[MAX_PATH_LENGTH + 2];
+    size_t length = strlen(directory);
+    if (length + 2 >= sizeof(pattern))
+      return 0;
+
+    memcpy(pattern, directory, length);
+    pattern[length++] = '\\';
+    pattern[length++] = '*';
+    pattern[length] = 0;
+
+    iterator->flags = flags;
+    state->handle = FindFirstFileExA(
+      pattern, FindExInfoBasic, &state->ffd, FindExSearchNameMatch, NULL,
+      FIND_FIRST_EX_LARGE_FETCH);
+    iterator->pending = state->handle != INVALID_HANDLE_VALUE;
+    return iterator->pending;
+  }
+}
+
+uint32_t
+dir_iterator_next(dir_iterator_t *iterator, dir_entry_t *entry)
+{
+  assert(iterator && entry);
+
+  {
+    dir_state_t *state = DIR_STATE(iterator);
+    WIN32_FIND_DATAA *ffd = &state->ffd;
+
+    do {
+      if (!iterator->pending && !FindNextFileA(state->handle, ffd))
+        return 0;
+      iterator->pending = 0;
+    } while (is_dot_entry(ffd->cFileName));
+
+    entry->name = ffd->cFileName;
+    entry->name_length = (uint32_t)strlen(ffd->cFileName);
+    if (ffd->dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)
+      entry->type = DIR_ENTRY_OTHER;
+    else if (ffd->dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+      entry->type = DIR_ENTRY_DIRECTORY;
+    else
+      entry->type = DIR_ENTRY_FILE;
+    entry->size =
+      ((uint64_t)ffd->nFileSizeHigh << 32) | (uint64_t)ffd->nFileSizeLow;
+
+    {
+      // FILETIME counts 100ns intervals since 1601.
+      uint64_t time =
+        ((uint64_t)ffd->ftLastWriteTime.dwHighDateTime << 32) |
+        (uint64_t)ffd->ftLastWriteTime.dwLowDateTime;
+      entry->mtime = time > 116444736000000000ull ?
+        (time - 116444736000000000ull) * 100 : 0;
+    }
+
+    return 1;
+  }
+}
+
+void
+dir_iterator_close(dir_iterator_t *iterator)
+{
+  assert(iterator);
+  FindClose(DIR_STATE(iterator)->handle);
+}
+
+#else
+
+uint32_t
+dir_iterator_open(
+  dir_iterator_t *iterator,
+  const char *directory,
+  uint32_t flags)
+{
+  assert(iterator && directory);
+
+  {
+    dir_state_t *state = DIR_STATE(iterator);
+    iterator->flags = flags;
+    iterator->pending = 0;
+    state->dir = opendir(directory);
+    state->fd = state->dir ? dirfd(state->dir) : -1;
+    return state->dir != NULL;
+  }
+}
+
+uint32_t
+dir_iterator_next(dir_iterator_t *iterator, dir_entry_t *entry)
+{
+  assert(iterator && entry);
+
+  {
+    dir_state_t *state = DIR_STATE(iterator);
+    struct dirent *dirent;
+    uint32_t need_stat;
+
+    // readdir() pulls entries in bulk through getdents64 on linux.
+    do {
+      if (!(dirent = readdir(state->dir)))
+        return 0;
+    } while (is_dot_entry(dirent->d_name));
+
+    entry->name = dirent->d_name;
+    entry->name_length = (uint32_t)strlen(dirent->d_name);
+    entry->size = entry->mtime = 0;
+
+    switch (dirent->d_type) {
+      case DT_DIR: entry->type = DIR_ENTRY_DIRECTORY; break;
+      case DT_REG: entry->type = DIR_ENTRY_FILE; break;
+      default: entry->type = DIR_ENTRY_OTHER; break;
+    }
+
+    need_stat =
+      (iterator->flags & DIR_FLAG_STAT) || dirent->d_type == DT_UNKNOWN;
+    if (need_stat) {
+      struct stat info;
+      if (!fstatat(state->fd, dirent->d_name, &info, AT_SYMLINK_NOFOLLOW)) {
+        entry->type =
+          S_ISDIR(info.st_mode) ? DIR_ENTRY_DIRECTORY :
+          S_ISREG(info.st_mode) ? DIR_ENTRY_FILE : DIR_ENTRY_OTHER;
+        entry->size = (uint64_t)info.st_size;
+#if defined(__APPLE__)
+        entry->mtime =
+          (uint64_t)info.st_mtimespec.tv_sec * 1000000000ull +
+          (uint64_t)info.st_mtimespec.tv_nsec;
+#else
+        entry->mtime =
+          (uint64_t)info.st_mtim.tv_sec * 1000000000ull +
+          (uint64_t)info.st_mtim.tv_nsec;
+#endif
+      }
+    }
+
+    return 1;
+  }
+}
+
+void
+dir_iterator_close(dir_iterator_t *iterator)
+{
+  assert(iterator);
+  closedir(DIR_STATE(iterator)->dir);
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+typedef
+struct walk_node_t {
+  struct walk_node_t *next;
+  char path[1];
+} walk_node_t;
+
+typedef
+struct walk_shared_t {
+  mutex_t mutex;
+  condvar_t wake;
+  walk_node_t *stack;                   // pending directories, depth first
+  uint32_t active;                      // workers inside a directory
+  uint32_t flags;
+  dir_walk_fn_t fn;
+  void *user_data;
+  const allocator_t *allocator;
+  dir_walk_stats_t stats;
+} walk_shared_t;
+
+typedef
+struct walk_worker_t {
+  walk_shared_t *shared;
+  uint32_t index;
+} walk_worker_t;
+
+// NOTE: the walker mutex must be held.
+static
+void
+walk_push(walk_shared_t *shared, const char *path, size_t length)
+{
+  walk_node_t *node = (walk_node_t *)shared->allocator->mem_alloc(
+    offsetof(walk_node_t, path) + length + 1);
+  memcpy(node->path, path, length);
+  node->path[length] = 0;
+  node->next = shared->stack;
+  shared->stack = node;
+}
+
+static
+void
+walk_directory(
+  walk_shared_t *shared,
+  const char *directory,
+  uint32_t worker,
+  dir_walk_stats_t *stats)
+{
+  dir_iterator_t iterator;
+  dir_entry_t entry;
+  char path[MAX_PATH_LENGTH];
+  size_t length = strlen(directory);
+
+  // the children are bounded when they are joined, the root is not.
+  if (
+    length + 1 >= MAX_PATH_LENGTH ||
+    !dir_iterator_open(&iterator, directory, shared->flags)) {
+    ++stats->skipped;
+    return;
+  }
+
+  ++stats->directories;
+  memcpy(path, directory, length);
+  path[length++] = '/';
+
+  while (dir_iterator_next(&iterator, &entry)) {
+    uint32_t descend;
+    if (length + entry.name_length >= MAX_PATH_LENGTH) {
+      ++stats->skipped;
+      continue;
+    }
+
+    memcpy(path + length, entry.name, entry.name_length + 1);
+    descend = shared->fn ?
+      shared->fn(path, &entry, worker, shared->user_data) : 1;
+
+    if (entry.type != DIR_ENTRY_DIRECTORY)
+      ++stats->files;
+    else if (descend) {
+      mutex_lock(&shared->mutex);
+      walk_push(shared, path, length + entry.name_length);
+      condvar_signal(&shared->wake);
+      mutex_unlock(&shared->mutex);
+    }
+  }
+
+  dir_iterator_close(&iterator);
+}
+
+static
+void
+walk_worker(void *arg)
+{
+  walk_worker_t *worker = (walk_worker_t *)arg;
+  walk_shared_t *shared = worker->shared;
+  dir_walk_stats_t stats;
+  memset(&stats, 0, sizeof(dir_walk_stats_t));
+
+  mutex_lock(&shared->mutex);
+  for (;;) {
+    walk_node_t *node;
+
+    // finished once nothing is queued and nobody can queue more.
+    while (!shared->stack && shared->active)
+      condvar_wait(&shared->wake, &shared->mutex);
+    if (!shared->stack)
+      break;
+
+    node = shared->stack;
+    shared->stack = node->next;
+    ++shared->active;
+    mutex_unlock(&shared->mutex);
+
+    walk_directory(shared, node->path, worker->index, &stats);
+
+    mutex_lock(&shared->mutex);
+    shared->allocator->mem_free(node);
+    if (!--shared->active && !shared->stack)
+      condvar_broadcast(&shared->wake);
+  }
+
+  shared->stats.directories += stats.directories;
+  shared->stats.files += stats.files;
+  shared->stats.skipped += stats.skipped;
+  mutex_unlock(&shared->mutex);
+}
+
+void
+dir_walk(
+  const char *root,
+  uint32_t flags,
+  uint32_t worker_count,
+  dir_walk_fn_t fn,
+  void *user_data,
+  const allocator_t *allocator,
+  dir_walk_stats_t *stats)
+{
+  assert(root && allocator && worker_count);
+
+  {
+    walk_shared_t shared;
+    walk_worker_t *workers;
+    thread_handle_t *threads;
+    uint32_t i, spawned = 0;
+    size_t length = strlen(root);
+
+    // a trailing separator would be doubled when joining.
+    while (length > 1 && (root[length - 1] == '/' || root[length - 1] == '\\'))
+      --length;
+
+    memset(&shared, 0, sizeof(walk_shared_t));
+    mutex_setup(&shared.mutex);
+    condvar_setup(&shared.wake);
+    shared.flags = flags;
+    shared.fn = fn;
+    shared.user_data = user_data;
+    shared.allocator = allocator;
+    walk_push(&shared, root, length);
+
+    workers = (walk_worker_t *)allocator->mem_alloc(
+      sizeof(walk_worker_t) * worker_count);
+    threads = (thread_handle_t *)allocator->mem_alloc(
+      sizeof(thread_handle_t) * worker_count);
+    for (i = 0; i < worker_count; ++i) {
+      workers[i].shared = &shared;
+      workers[i].index = i;
+    }
+
+    // the calling thread doubles as worker 0.
+    for (i = 1; i < worker_count; ++i) {
+      threads[spawned] = thread_create(walk_worker, workers + i);
+      if (threads[spawned] != INVALID_THREAD)
+        ++spawned;
+    }
+    walk_worker(workers);
+    for (i = 0; i < spawned; ++i)
+      thread_join(threads[i]);
+
+    allocator->mem_free(threads);
+    allocator->mem_free(workers);
+    condvar_cleanup(&shared.wake);
+    mutex_cleanup(&shared.mutex);
+
+    if (stats)
+      *stats = shared.stats;
+  }
+}
\ No newline at end of file
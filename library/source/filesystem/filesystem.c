@@ -9,6 +9,7 @@
  *
  */
 #include <assert.h>
+#include <string.h>
 #include <library/filesystem/filesystem.h>
 #include <library/os/os.h>
 
@@ -28,8 +29,10 @@ get_subdirectories(
 
     hFind = find_first_file(directory, &ffd);
 
-    if (hFind == INVALID_HANDLE)
+    if (hFind == INVALID_HANDLE) {
       assert(0 && "get_subdirectories failed on first attempt!");
+      return;
+    }
 
     // get all sub directories names.
     do {
@@ -37,6 +40,16 @@ get_subdirectories(
           ffd.file_attributes & FILE_IS_DIRECTORY &&
           strcmp(ffd.name, ".") &&
           strcmp(ffd.name, "..")) {
+          size_t length = strlen(ffd.name);
+
+          // dir_iterator_t/dir_walk() have no such limits.
+          assert(
+            entries->used < MAX_DIR_ENTRIES &&
+            "too many sub directories for dir_entries_t!");
+          assert(length < MAX_PATH_LENGTH && "directory name too long!");
+          if (entries->used == MAX_DIR_ENTRIES || length >= MAX_PATH_LENGTH)
+            continue;
+
           memset(
             entries->dir_names[entries->used],
             0,
@@ -45,7 +58,7 @@ get_subdirectories(
           memcpy(
             entries->dir_names[entries->used],
             ffd.name,
-            strlen(ffd.name));
+            length);
 
           entries->used++;
         }
@@ -11,6 +11,14 @@
 #include <assert.h>
 #include <stdio.h>
 #include <string.h>
+#if defined(WIN32) || defined(WIN64)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 #include <library/filesystem/io.h>
 
 
@@ -93,4 +101,98 @@ file_exists(const char *path)
     return 1;
   }
   return 0;
-}
\ No newline at end of file
+}
+
+#if defined(WIN32) || defined(WIN64)
+
+uint32_t
+map_file(const char *path, file_mapping_t *mapping)
+{
+  assert(path && mapping);
+
+  {
+    LARGE_INTEGER size;
+    HANDLE file, map;
+    mapping->data = NULL;
+    mapping->size = 0;
+
+    file = CreateFileA(
+      path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+      return 0;
+
+    if (!GetFileSizeEx(file, &size) || !size.QuadPart) {
+      CloseHandle(file);
+      return 0;
+    }
+
+    // the view keeps the mapping and the file alive, both handles can go.
+    map = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!map)
+      return 0;
+
+    mapping->data = MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(map);
+    if (!mapping->data)
+      return 0;
+
+    mapping->size = (size_t)size.QuadPart;
+    return 1;
+  }
+}
+
+void
+unmap_file(file_mapping_t *mapping)
+{
+  assert(mapping && mapping->data);
+  UnmapViewOfFile(mapping->data);
+  mapping->data = NULL;
+  mapping->size = 0;
+}
+
+#else
+
+uint32_t
+map_file(const char *path, file_mapping_t *mapping)
+{
+  assert(path && mapping);
+
+  {
+    struct stat info;
+    void *data;
+    int fd = open(path, O_RDONLY);
+    mapping->data = NULL;
+    mapping->size = 0;
+
+    if (fd < 0)
+      return 0;
+
+    if (fstat(fd, &info) || !info.st_size) {
+      close(fd);
+      return 0;
+    }
+
+    // the mapping holds its own reference to the file.
+    data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+      return 0;
+
+    mapping->data = data;
+    mapping->size = (size_t)info.st_size;
+    return 1;
+  }
+}
+
+void
+unmap_file(file_mapping_t *mapping)
+{
+  assert(mapping && mapping->data);
+  munmap((void *)mapping->data, mapping->size);
+  mapping->data = NULL;
+  mapping->size = 0;
+}
+
+#endif
\ No newline at end of file
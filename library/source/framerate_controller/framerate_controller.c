@@ -10,9 +10,21 @@
  */
 #include <assert.h>
 #include <math.h>
+#include <string.h>
 #include <library/allocator/allocator.h>
 #include <library/framerate_controller/framerate_controller.h>
 #include <library/os/os.h>
+#include <library/threading/atomic.h>
+
+// the sleep statistics turn into moving averages past this many samples.
+#define SLEEP_SAMPLES_MAX             1024
+
+// log-linear histogram over microseconds: exact below 64, then 32 buckets per
+// power of two (~3% wide) up to 2^32 us.
+#define HISTOGRAM_LINEAR              64
+#define HISTOGRAM_SUB_BUCKETS         32
+#define HISTOGRAM_BUCKETS             896
+#define FPS_EWMA_ALPHA                0.1
 
 
 typedef
@@ -22,11 +34,44 @@ struct framerate_controller_internal_t {
   // cast to DWORD when working with timegettime.
   uint64_t start;
   uint64_t end;
-  uint64_t target_frame_ms;
 
   // performance counter specific
   uint64_t ticks_per_second;
   uint32_t freq_counters_supported;
+
+  // replaces the performance counter when fn_ticks is set.
+  framerate_clock_t clock;
+
+  // pacing, in ticks (ms without the performance counter). the period is
+  // ticks_per_second / target_fps, the remainder is spread over the frames.
+  uint64_t target_frame_ticks;
+  uint64_t target_frame_rem;
+  uint64_t rem_accumulator;
+  uint64_t deadline;                    // 0 until the first locked frame
+
+  // running mean and deviation of what os_sleep(1) really takes, in ticks.
+  double sleep_mean;
+  double sleep_variance;
+  double sleep_estimate;
+  uint64_t sleep_count;
+
+  // frame statistics, a frame runs from one controller_start() to the next.
+  uint32_t started;
+  uint32_t window_next;
+  uint32_t window_count;
+  uint64_t window[FRAMERATE_STATS_WINDOW];
+  uint64_t window_sum;
+  uint16_t histogram[HISTOGRAM_BUCKETS];
+  double ewma_frame_ticks;
+  uint64_t dropped_frames;
+  uint64_t total_frames;
+
+  // fixed step simulation, the accumulator is in ticks * fixed_rate.
+  uint64_t fixed_rate;                  // steps per second, 0 when off
+  uint32_t fixed_max_steps;
+  uint32_t fixed_steps;                 // for the current frame
+  uint64_t fixed_accumulator;
+  uint64_t fixed_skipped;
 } framerate_controller_internal_t;
 
 // make this opaque
@@ -37,6 +82,7 @@ struct framerate_controller_t {
   framerate_controller_internal_t internal;
 } framerate_controller_t;
 
+static
 inline
 uint32_t
 is_zero(double val)
@@ -45,32 +91,58 @@ is_zero(double val)
   return fabs(val) <= eps;
 }
 
+static
+inline
+uint64_t
+get_ticks(framerate_controller_t *controller)
+{
+  framerate_controller_internal_t *internal = &controller->internal;
+  uint64_t ticks = 0;
+  if (internal->clock.fn_ticks)
+    ticks = internal->clock.fn_ticks(internal->clock.user_data);
+  else if (internal->freq_counters_supported)
+    get_performance_counter(&ticks);
+  else
+    ticks = time_get_time();
+  return ticks;
+}
+
+static
+inline
+void
+sleep_ms(framerate_controller_t *controller, uint32_t ms)
+{
+  framerate_controller_internal_t *internal = &controller->internal;
+  if (internal->clock.fn_sleep)
+    internal->clock.fn_sleep(internal->clock.user_data, ms);
+  else
+    os_sleep(ms);
+}
+
+static
 inline
 void
 populate_at_start(framerate_controller_t *controller)
 {
+  framerate_controller_internal_t *internal = &controller->internal;
   assert(controller);
 
-  if (controller->internal.freq_counters_supported) {
-    controller->internal.freq_counters_supported =
-      get_performance_frequency(&controller->internal.ticks_per_second);
-    get_performance_counter(&controller->internal.start);
-  } else
-    controller->internal.start = time_get_time();
+  if (internal->freq_counters_supported && !internal->clock.fn_ticks)
+    internal->freq_counters_supported =
+      get_performance_frequency(&internal->ticks_per_second);
+  internal->start = get_ticks(controller);
 }
 
+static
 inline
 void
 populate_at_end(framerate_controller_t *controller)
 {
   assert(controller);
-
-  if (controller->internal.freq_counters_supported)
-    get_performance_counter(&controller->internal.end);
-  else
-    controller->internal.end = time_get_time();
+  controller->internal.end = get_ticks(controller);
 }
 
+static
 inline
 double
 get_cycle_duration(
@@ -93,6 +165,199 @@ get_cycle_duration(
   }
 }
 
+static
+inline
+uint64_t
+get_tick_rate(framerate_controller_t *controller)
+{
+  return
+    controller->internal.freq_counters_supported ?
+    controller->internal.ticks_per_second : 1000ull;
+}
+
+static
+void
+set_target(framerate_controller_t *controller, uint64_t target_fps)
+{
+  framerate_controller_internal_t *internal = &controller->internal;
+  uint64_t ticks_per_second = get_tick_rate(controller);
+  assert(target_fps);
+
+  controller->target_fps = target_fps;
+  internal->target_frame_ticks = ticks_per_second / target_fps;
+  internal->target_frame_rem = ticks_per_second % target_fps;
+  internal->rem_accumulator = 0;
+  internal->deadline = 0;
+}
+
+static
+void
+reset_sleep_estimate(framerate_controller_t *controller)
+{
+  framerate_controller_internal_t *internal = &controller->internal;
+  double ms =
+    internal->freq_counters_supported ?
+    (double)internal->ticks_per_second / 1000. : 1.;
+
+  // pessimistic until the first measurements come in.
+  internal->sleep_mean = ms;
+  internal->sleep_variance = 0.;
+  internal->sleep_estimate = 2. * ms;
+  internal->sleep_count = 1;
+}
+
+static
+void
+record_sleep(framerate_controller_t *controller, double observed)
+{
+  framerate_controller_internal_t *internal = &controller->internal;
+  double delta = observed - internal->sleep_mean, alpha;
+
+  // a running mean and variance, weighted like a plain average until the
+  // count is capped, then like a moving one that follows the scheduler.
+  if (internal->sleep_count < SLEEP_SAMPLES_MAX)
+    ++internal->sleep_count;
+  alpha = 1. / (double)internal->sleep_count;
+  internal->sleep_mean += alpha * delta;
+  internal->sleep_variance =
+    (1. - alpha) * (internal->sleep_variance + alpha * delta * delta);
+  internal->sleep_estimate =
+    internal->sleep_mean + sqrt(internal->sleep_variance);
+}
+
+/**
+ * sleeps 1 ms at a time while the estimated wakeup still lands before the
+ * deadline, then spins on the counter for the rest.
+ */
+static
+void
+wait_until(framerate_controller_t *controller, uint64_t deadline)
+{
+  framerate_controller_internal_t *internal = &controller->internal;
+  uint64_t now = get_ticks(controller), before;
+
+  while (
+    now < deadline &&
+    (double)(deadline - now) > internal->sleep_estimate) {
+    before = now;
+    sleep_ms(controller, 1);
+    now = get_ticks(controller);
+    record_sleep(controller, (double)(now - before));
+  }
+
+  while (now < deadline) {
+    atomic_cpu_relax();
+    now = get_ticks(controller);
+  }
+}
+
+static
+uint32_t
+histogram_bucket(uint64_t us)
+{
+  uint32_t shift = 0;
+  if (us < HISTOGRAM_LINEAR)
+    return (uint32_t)us;
+
+  us = us > 0xffffffffull ? 0xffffffffull : us;
+  while ((us >> shift) >= 2 * HISTOGRAM_SUB_BUCKETS)
+    ++shift;
+  return
+    HISTOGRAM_LINEAR + (shift - 1) * HISTOGRAM_SUB_BUCKETS +
+    (uint32_t)(us >> shift) - HISTOGRAM_SUB_BUCKETS;
+}
+
+/** the middle of the bucket's range, in microseconds. */
+static
+double
+histogram_value(uint32_t bucket)
+{
+  uint32_t shift, sub;
+  if (bucket < HISTOGRAM_LINEAR)
+    return (double)bucket;
+
+  bucket -= HISTOGRAM_LINEAR;
+  shift = bucket / HISTOGRAM_SUB_BUCKETS + 1;
+  sub = bucket % HISTOGRAM_SUB_BUCKETS + HISTOGRAM_SUB_BUCKETS;
+  return ((double)sub + 0.5) * (double)(1ull << shift);
+}
+
+static
+inline
+uint64_t
+ticks_to_us(framerate_controller_t *controller, uint64_t ticks)
+{
+  return (uint64_t)((double)ticks * 1000000. / get_tick_rate(controller));
+}
+
+static
+inline
+double
+ticks_to_ms(framerate_controller_t *controller, double ticks)
+{
+  return ticks * 1000. / get_tick_rate(controller);
+}
+
+static
+inline
+double
+clamp_ms(double value, double min, double max)
+{
+  return value < min ? min : (value > max ? max : value);
+}
+
+static
+void
+record_frame(framerate_controller_t *controller, uint64_t ticks)
+{
+  framerate_controller_internal_t *internal = &controller->internal;
+  uint64_t period = internal->target_frame_ticks;
+
+  // the window is a ring, the evicted frame leaves the histogram too.
+  if (internal->window_count == FRAMERATE_STATS_WINDOW) {
+    uint64_t evicted = internal->window[internal->window_next];
+    internal->window_sum -= evicted;
+    --internal->histogram[histogram_bucket(ticks_to_us(controller, evicted))];
+  } else
+    ++internal->window_count;
+  internal->window[internal->window_next] = ticks;
+  internal->window_next = (internal->window_next + 1) % FRAMERATE_STATS_WINDOW;
+  internal->window_sum += ticks;
+  ++internal->histogram[histogram_bucket(ticks_to_us(controller, ticks))];
+
+  internal->ewma_frame_ticks =
+    internal->total_frames ?
+    internal->ewma_frame_ticks +
+    FPS_EWMA_ALPHA * ((double)ticks - internal->ewma_frame_ticks) :
+    (double)ticks;
+  ++internal->total_frames;
+
+  // a frame covering n periods (rounded) dropped n - 1 of them.
+  if (controller->target_fps && period && ticks >= period + period / 2)
+    internal->dropped_frames += (ticks + period / 2) / period - 1;
+}
+
+/** turns the frame's ticks into whole steps, the rest stays accumulated. */
+static
+void
+advance_fixed_step(framerate_controller_t *controller, uint64_t ticks)
+{
+  framerate_controller_internal_t *internal = &controller->internal;
+  uint64_t tick_rate = get_tick_rate(controller), steps;
+
+  // whole seconds and the rest apart, ticks * rate never overflows.
+  steps = ticks / tick_rate * internal->fixed_rate;
+  internal->fixed_accumulator += ticks % tick_rate * internal->fixed_rate;
+  steps += internal->fixed_accumulator / tick_rate;
+  internal->fixed_accumulator %= tick_rate;
+
+  if (steps > internal->fixed_max_steps) {
+    internal->fixed_skipped += steps - internal->fixed_max_steps;
+    steps = internal->fixed_max_steps;
+  }
+  internal->fixed_steps = (uint32_t)steps;
+}
+
 static
 void
 initialize_controller(
@@ -101,7 +366,9 @@ initialize_controller(
   uint32_t locked)
 {
   assert(controller);
+  assert((!locked || target_fps) && "a locked controller needs a target!");
 
+  memset(&controller->internal, 0, sizeof(framerate_controller_internal_t));
   controller->target_fps = target_fps;
   controller->locked = locked;
 
@@ -112,7 +379,9 @@ initialize_controller(
   populate_at_start(controller);
 
   controller->internal.current_fps = 0.;
-  controller->internal.target_frame_ms = locked ? (1000ull / target_fps) : 1ull;
+  if (target_fps)
+    set_target(controller, target_fps);
+  reset_sleep_estimate(controller);
 }
 
 framerate_controller_t *
@@ -144,6 +413,17 @@ controller_start(framerate_controller_t *controller)
   {
     uint64_t prior_start = controller->internal.start;
     populate_at_start(controller);
+
+    // the first call closes no frame, only the time since setup.
+    controller->internal.fixed_steps = 0;
+    if (controller->internal.started) {
+      uint64_t ticks = controller->internal.start - prior_start;
+      record_frame(controller, ticks);
+      if (controller->internal.fixed_rate)
+        advance_fixed_step(controller, ticks);
+    }
+    controller->internal.started = 1;
+
     return get_cycle_duration(
       controller,
       prior_start,
@@ -170,13 +450,24 @@ controller_end(framerate_controller_t *controller)
     duration_ms = is_zero(duration_ms) ? 1. : duration_ms;
     controller->internal.current_fps = 1000. / duration_ms;
 
-    if (
-      controller->locked &&
-      controller->internal.target_frame_ms > (duration_ms + BUFFER_TIME_MS)) {
-      double ms_sleep =
-        controller->internal.target_frame_ms - (duration_ms + BUFFER_TIME_MS);
+    if (controller->locked) {
+      framerate_controller_internal_t *internal = &controller->internal;
+      uint64_t deadline = internal->deadline + internal->target_frame_ticks;
+      internal->rem_accumulator += internal->target_frame_rem;
+      if (internal->rem_accumulator >= controller->target_fps) {
+        internal->rem_accumulator -= controller->target_fps;
+        ++deadline;
+      }
+
+      // frames run from deadline to deadline, a late frame is made up by the
+      // next one. past a whole period behind (a hitch) the schedule restarts.
+      if (
+        !internal->deadline ||
+        deadline + internal->target_frame_ticks < internal->end)
+        deadline = internal->start + internal->target_frame_ticks;
 
-      sleep((uint64_t)ms_sleep);
+      wait_until(controller, deadline);
+      internal->deadline = deadline;
     }
 
     return previous_fps;
@@ -195,10 +486,9 @@ lock_fps(
   framerate_controller_t *controller,
   uint64_t target_fps)
 {
-  assert(controller);
+  assert(controller && target_fps);
   controller->locked = 1u;
-  controller->target_fps = target_fps;
-  controller->internal.target_frame_ms = 1000ull / target_fps;
+  set_target(controller, target_fps);
 }
 
 void
@@ -206,4 +496,175 @@ unlock_fps(framerate_controller_t *controller)
 {
   assert(controller);
   controller->locked = 0u;
+  controller->internal.deadline = 0;
+}
+
+double
+controller_frame_percentile(
+  framerate_controller_t *controller,
+  double percentile)
+{
+  assert(controller);
+  assert(percentile >= 0. && percentile <= 100.);
+
+  {
+    framerate_controller_internal_t *internal = &controller->internal;
+    uint64_t rank, seen = 0;
+    uint32_t i;
+    if (!internal->window_count)
+      return 0.;
+
+    // the nearest rank, 1 based.
+    rank = (uint64_t)ceil(percentile / 100. * internal->window_count);
+    rank = rank ? rank : 1;
+    for (i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+      seen += internal->histogram[i];
+      if (seen >= rank)
+        return histogram_value(i) / 1000.;
+    }
+    return histogram_value(HISTOGRAM_BUCKETS - 1) / 1000.;
+  }
+}
+
+void
+controller_get_stats(
+  framerate_controller_t *controller,
+  framerate_stats_t *stats)
+{
+  assert(controller && stats);
+
+  {
+    framerate_controller_internal_t *internal = &controller->internal;
+    uint64_t min = (uint64_t)-1, max = 0;
+    uint32_t i;
+
+    memset(stats, 0, sizeof(framerate_stats_t));
+    stats->total_frames = internal->total_frames;
+    stats->dropped_frames = internal->dropped_frames;
+    stats->frames = internal->window_count;
+    if (!internal->window_count)
+      return;
+
+    for (i = 0; i < internal->window_count; ++i) {
+      min = internal->window[i] < min ? internal->window[i] : min;
+      max = internal->window[i] > max ? internal->window[i] : max;
+    }
+    stats->min_ms = ticks_to_ms(controller, (double)min);
+    stats->max_ms = ticks_to_ms(controller, (double)max);
+    stats->avg_ms =
+      ticks_to_ms(controller, (double)internal->window_sum) /
+      internal->window_count;
+    // bucket middles can land past the exact extremes, kept inside them.
+    stats->p50_ms = clamp_ms(
+      controller_frame_percentile(controller, 50.),
+      stats->min_ms, stats->max_ms);
+    stats->p95_ms = clamp_ms(
+      controller_frame_percentile(controller, 95.),
+      stats->min_ms, stats->max_ms);
+    stats->p99_ms = clamp_ms(
+      controller_frame_percentile(controller, 99.),
+      stats->min_ms, stats->max_ms);
+    stats->p999_ms = clamp_ms(
+      controller_frame_percentile(controller, 99.9),
+      stats->min_ms, stats->max_ms);
+    stats->smoothed_fps =
+      internal->ewma_frame_ticks > 0. ?
+      1000. / ticks_to_ms(controller, internal->ewma_frame_ticks) : 0.;
+  }
+}
+
+void
+controller_reset_stats(framerate_controller_t *controller)
+{
+  assert(controller);
+
+  {
+    framerate_controller_internal_t *internal = &controller->internal;
+    internal->window_next = internal->window_count = 0;
+    internal->window_sum = 0;
+    memset(internal->histogram, 0, sizeof(internal->histogram));
+    internal->ewma_frame_ticks = 0.;
+    internal->dropped_frames = internal->total_frames = 0;
+  }
+}
+
+void
+controller_set_fixed_step(
+  framerate_controller_t *controller,
+  uint64_t steps_per_second,
+  uint32_t max_steps)
+{
+  assert(controller);
+  assert((!steps_per_second || max_steps) && "at least a step per frame!");
+
+  {
+    framerate_controller_internal_t *internal = &controller->internal;
+    internal->fixed_rate = steps_per_second;
+    internal->fixed_max_steps = max_steps;
+    internal->fixed_steps = 0;
+    internal->fixed_accumulator = 0;
+    internal->fixed_skipped = 0;
+  }
+}
+
+uint32_t
+controller_fixed_steps(framerate_controller_t *controller)
+{
+  assert(controller);
+  return controller->internal.fixed_steps;
+}
+
+double
+controller_fixed_dt(framerate_controller_t *controller)
+{
+  assert(controller && controller->internal.fixed_rate);
+  return 1. / (double)controller->internal.fixed_rate;
+}
+
+double
+controller_fixed_alpha(framerate_controller_t *controller)
+{
+  assert(controller);
+  return
+    (double)controller->internal.fixed_accumulator /
+    (double)get_tick_rate(controller);
+}
+
+uint64_t
+controller_fixed_skipped(framerate_controller_t *controller)
+{
+  assert(controller);
+  return controller->internal.fixed_skipped;
+}
+
+void
+controller_set_clock(
+  framerate_controller_t *controller,
+  const framerate_clock_t *clock)
+{
+  assert(controller);
+  assert(
+    !clock ||
+    (clock->fn_ticks && clock->fn_sleep && clock->ticks_per_second));
+
+  {
+    framerate_controller_internal_t *internal = &controller->internal;
+    if (clock) {
+      internal->clock = *clock;
+      internal->ticks_per_second = clock->ticks_per_second;
+      internal->freq_counters_supported = 1;
+    } else {
+      memset(&internal->clock, 0, sizeof(framerate_clock_t));
+      internal->freq_counters_supported =
+        get_performance_frequency(&internal->ticks_per_second);
+    }
+
+    if (controller->target_fps)
+      set_target(controller, controller->target_fps);
+    reset_sleep_estimate(controller);
+    controller_reset_stats(controller);
+    internal->fixed_accumulator = 0;
+    internal->started = 0;
+    internal->start = internal->end = get_ticks(controller);
+  }
 }
\ No newline at end of file
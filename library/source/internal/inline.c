@@ -0,0 +1,26 @@
+/**
+ * @file inline.c
+ * @author khalilhenoud@gmail.com
+ * @brief the out-of-line definitions of the functions defined in the headers
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+// every other translation unit only sees inline definitions (C99), the calls
+// that are not inlined resolve to the definitions emitted here.
+#define LIBRARY_INLINE_DEFINITIONS
+#include <library/asset/asset_ref.h>
+#include <library/containers/chashmap.h>
+#include <library/containers/clist.h>
+#include <library/containers/cqueue.h>
+#include <library/containers/cring.h>
+#include <library/containers/cshardmap.h>
+#include <library/containers/cvector.h>
+#include <library/hash/fnv.h>
+#include <library/profiler/profiler.h>
+#include <library/string/cstring.h>
+#include <library/threading/atomic.h>
+#include <library/type_registry/type_registry.h>
+#include <library/workload/workload.h>
\ No newline at end of file
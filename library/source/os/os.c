@@ -11,10 +11,28 @@
 #if defined(WIN32) || defined(WIN64)
 #include <windows.h>
 #else
-// TODO: Implement static assert for C using negative indices array.
+#include <dirent.h>
+#include <errno.h>
+#include <fnmatch.h>
+#include <limits.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#if defined(__linux__)
+#include <sys/prctl.h>
 #endif
+#endif
+#include <library/allocator/allocator.h>
 #include <library/os/os.h>
 
+#if defined(WIN32) || defined(WIN64)
+
+// the find data has to outlive the call, the names point into it.
+typedef
+struct find_state_t {
+  HANDLE handle;
+  WIN32_FIND_DATA ffd;
+} find_state_t;
 
 int32_t
 get_screen_width()
@@ -96,7 +114,7 @@ set_cursor_position(int32_t x, int32_t y)
 
 ////////////////////////////////////////////////////////////////////////////////
 void
-sleep(uint64_t ms)
+os_sleep(uint64_t ms)
 {
   Sleep(ms);
 }
@@ -105,32 +123,298 @@ sleep(uint64_t ms)
 file_handle_t
 find_first_file(const char *file, file_find_data_t *file_data)
 {
-  file_handle_t handle = INVALID_HANDLE;
-  WIN32_FIND_DATA ffd;
-  handle = (file_handle_t)FindFirstFile(file, &ffd);
-  file_data->name = ffd.cFileName;
-  file_data->file_attributes = ffd.dwFileAttributes;
-  return handle;
+  find_state_t *state =
+    (find_state_t *)g_default_allocator.mem_alloc(sizeof(find_state_t));
+  state->handle = FindFirstFile(file, &state->ffd);
+  if (state->handle == INVALID_HANDLE_VALUE) {
+    // keep the error code intact for get_last_error().
+    DWORD error = GetLastError();
+    g_default_allocator.mem_free(state);
+    SetLastError(error);
+    return INVALID_HANDLE;
+  }
+
+  file_data->name = state->ffd.cFileName;
+  file_data->file_attributes = state->ffd.dwFileAttributes;
+  return (file_handle_t)state;
 }
 
 int32_t
 find_next_file(file_handle_t handle, file_find_data_t *file_data)
 {
-  WIN32_FIND_DATA ffd;
-  int32_t result = FindNextFile((HANDLE)handle, &ffd);
-  file_data->name = ffd.cFileName;
-  file_data->file_attributes = ffd.dwFileAttributes;
+  find_state_t *state = (find_state_t *)handle;
+  int32_t result = FindNextFile(state->handle, &state->ffd);
+  file_data->name = state->ffd.cFileName;
+  file_data->file_attributes = state->ffd.dwFileAttributes;
   return result;
 }
 
 int32_t
 find_close(file_handle_t handle)
 {
-  return FindClose((HWND)handle);
+  find_state_t *state = (find_state_t *)handle;
+  int32_t result = FindClose(state->handle);
+  g_default_allocator.mem_free(state);
+  return result;
 }
 
 uint64_t
 get_last_error()
 {
   return GetLastError();
-}
\ No newline at end of file
+}
+
+#else
+
+////////////////////////////////////////////////////////////////////////////////
+// POSIX:
+//  - there is no windowing system dependency, the screen/keyboard/cursor
+//    functions report nothing.
+//  - timings use CLOCK_MONOTONIC, the performance counter ticks in ns.
+//  - find_*_file() match the last path component as a glob (fnmatch), both
+//    '/' and '\\' are accepted as separators.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef
+struct find_state_t {
+  DIR *dir;
+  char directory[PATH_MAX];
+  char pattern[NAME_MAX + 1];
+  char name[NAME_MAX + 1];
+} find_state_t;
+
+// mirrors GetLastError() for the find functions.
+static __thread uint64_t s_last_error;
+
+int32_t
+get_screen_width()
+{
+  return 0;
+}
+
+int32_t
+get_screen_height()
+{
+  return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void
+set_periodic_timers_resolution(uint32_t ms)
+{
+#if defined(__linux__)
+  // the closest analogue to timeBeginPeriod(), tightens sleep wakeups.
+  prctl(PR_SET_TIMERSLACK, (unsigned long)ms * 1000ul, 0, 0, 0);
+#else
+  (void)ms;
+#endif
+}
+
+void
+end_periodic_timers_resolution(uint32_t ms)
+{
+  (void)ms;
+#if defined(__linux__)
+  // 0 restores the default slack.
+  prctl(PR_SET_TIMERSLACK, 0ul, 0, 0, 0);
+#endif
+}
+
+uint64_t
+time_get_time()
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000 + (uint64_t)now.tv_nsec / 1000000;
+}
+
+int32_t
+get_performance_frequency(uint64_t *frequency)
+{
+  *frequency = 1000000000ull;
+  return 1;
+}
+
+int32_t
+get_performance_counter(uint64_t *counter)
+{
+  struct timespec now;
+  if (clock_gettime(CLOCK_MONOTONIC, &now))
+    return 0;
+  *counter = (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+  return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int32_t
+get_keyboard_state(uint8_t key_states[256])
+{
+  memset(key_states, 0, 256);
+  return 0;
+}
+
+int16_t
+get_async_key_state(int32_t key)
+{
+  (void)key;
+  return 0;
+}
+
+int32_t
+show_cursor(int32_t show)
+{
+  (void)show;
+  return 0;
+}
+
+int32_t
+get_cursor_position(cursor_pos_t *position)
+{
+  position->x = position->y = 0;
+  return 0;
+}
+
+int32_t
+set_cursor_position(int32_t x, int32_t y)
+{
+  (void)x;
+  (void)y;
+  return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void
+os_sleep(uint64_t ms)
+{
+  struct timespec request;
+  request.tv_sec = (time_t)(ms / 1000);
+  request.tv_nsec = (long)(ms % 1000) * 1000000l;
+
+  // the remaining time is written back on interruption.
+  while (clock_nanosleep(CLOCK_MONOTONIC, 0, &request, &request) == EINTR);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static
+uint64_t
+find_is_directory(const find_state_t *state, const struct dirent *entry)
+{
+#if defined(_DIRENT_HAVE_D_TYPE) || defined(DT_DIR)
+  if (entry->d_type == DT_DIR)
+    return 1;
+  if (entry->d_type != DT_UNKNOWN && entry->d_type != DT_LNK)
+    return 0;
+#endif
+
+  {
+    char path[PATH_MAX];
+    struct stat info;
+    size_t length = strlen(state->directory);
+    if (length + 1 + strlen(entry->d_name) >= sizeof(path))
+      return 0;
+
+    memcpy(path, state->directory, length);
+    path[length] = '/';
+    strcpy(path + length + 1, entry->d_name);
+    return !stat(path, &info) && S_ISDIR(info.st_mode);
+  }
+}
+
+static
+int32_t
+find_advance(find_state_t *state, file_find_data_t *file_data)
+{
+  struct dirent *entry;
+
+  errno = 0;
+  while ((entry = readdir(state->dir))) {
+    if (fnmatch(state->pattern, entry->d_name, 0))
+      continue;
+
+    strncpy(state->name, entry->d_name, sizeof(state->name) - 1);
+    state->name[sizeof(state->name) - 1] = 0;
+    file_data->name = state->name;
+    file_data->file_attributes =
+      find_is_directory(state, entry) ? FILE_IS_DIRECTORY : 0;
+    return 1;
+  }
+
+  s_last_error = errno ? (uint64_t)errno : LIBRARY_ERROR_NO_MORE_FILES;
+  return 0;
+}
+
+file_handle_t
+find_first_file(const char *file, file_find_data_t *file_data)
+{
+  const char *separator = NULL, *iter;
+  find_state_t *state;
+  size_t length;
+
+  for (iter = file; *iter; ++iter) {
+    if (*iter == '/' || *iter == '\\')
+      separator = iter;
+  }
+
+  state = (find_state_t *)g_default_allocator.mem_alloc(sizeof(find_state_t));
+  memset(state, 0, sizeof(find_state_t));
+
+  if (!separator)
+    strcpy(state->directory, ".");
+  else {
+    length = separator == file ? 1 : (size_t)(separator - file);
+    if (length >= sizeof(state->directory)) {
+      g_default_allocator.mem_free(state);
+      s_last_error = ENAMETOOLONG;
+      return INVALID_HANDLE;
+    }
+    memcpy(state->directory, file, length);
+  }
+
+  iter = separator ? separator + 1 : file;
+  if (strlen(iter) >= sizeof(state->pattern)) {
+    g_default_allocator.mem_free(state);
+    s_last_error = ENAMETOOLONG;
+    return INVALID_HANDLE;
+  }
+  strcpy(state->pattern, *iter ? iter : "*");
+
+  state->dir = opendir(state->directory);
+  if (!state->dir) {
+    s_last_error = (uint64_t)errno;
+    g_default_allocator.mem_free(state);
+    return INVALID_HANDLE;
+  }
+
+  // like FindFirstFile(), no match at all is a failure.
+  if (!find_advance(state, file_data)) {
+    closedir(state->dir);
+    g_default_allocator.mem_free(state);
+    s_last_error = ENOENT;
+    return INVALID_HANDLE;
+  }
+
+  return (file_handle_t)state;
+}
+
+int32_t
+find_next_file(file_handle_t handle, file_find_data_t *file_data)
+{
+  return find_advance((find_state_t *)handle, file_data);
+}
+
+int32_t
+find_close(file_handle_t handle)
+{
+  find_state_t *state = (find_state_t *)handle;
+  int32_t result = closedir(state->dir) == 0;
+  g_default_allocator.mem_free(state);
+  return result;
+}
+
+uint64_t
+get_last_error()
+{
+  return s_last_error;
+}
+
+#endif
\ No newline at end of file
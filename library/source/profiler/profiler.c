@@ -0,0 +1,464 @@
+/**
+ * @file profiler.c
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <library/allocator/allocator.h>
+#include <library/containers/cring.h>
+#include <library/containers/cvector.h>
+#include <library/filesystem/io.h>
+#include <library/os/os.h>
+#include <library/profiler/profiler.h>
+#include <library/threading/atomic.h>
+
+#if defined(_MSC_VER)
+#define PROFILER_THREAD_LOCAL __declspec(thread)
+#else
+#define PROFILER_THREAD_LOCAL __thread
+#endif
+
+#define TRACE_LINE_MAX                512
+#define TRACE_BUFFER_SIZE             (1 << 16)
+
+
+// a NULL name marks the end of the innermost scope.
+typedef
+struct profile_event_t {
+  const char *name;
+  uint64_t ticks;
+} profile_event_t;
+
+typedef
+struct profile_span_t {
+  const char *name;
+  uint32_t thread;
+  uint64_t begin;
+  uint64_t end;
+} profile_span_t;
+
+typedef
+struct profiler_thread_t {
+  cring_t ring;
+  volatile uint64_t dropped;
+
+  // producer side, the owning thread only.
+  uint32_t open;                        // begins pushed, not yet ended
+  uint32_t skipped;                     // begins dropped, not yet ended
+
+  // consumer side, profiler_frame_end() only.
+  uint32_t index;
+  uint32_t depth;
+  uint32_t overflow;
+  uint32_t first_root;
+  uint32_t open_nodes[PROFILER_MAX_DEPTH];
+  const char *open_names[PROFILER_MAX_DEPTH];
+  uint64_t open_ticks[PROFILER_MAX_DEPTH];
+} profiler_thread_t;
+
+typedef
+struct profiler_t {
+  volatile uint32_t enabled;
+  volatile uint32_t generation;
+  volatile uint32_t thread_count;
+  const allocator_t *allocator;
+  uint64_t ticks_per_second;
+  uint64_t origin;
+  void *volatile threads[PROFILER_MAX_THREADS];
+  cvector_t nodes;                      // profiler_node_t
+  cvector_t spans;                      // profile_span_t
+} profiler_t;
+
+static profiler_t s_profiler;
+static PROFILER_THREAD_LOCAL profiler_thread_t *s_thread;
+static PROFILER_THREAD_LOCAL uint32_t s_thread_generation;
+
+
+static
+uint64_t
+get_ticks(void)
+{
+  uint64_t ticks = 0;
+  get_performance_counter(&ticks);
+  return ticks;
+}
+
+/** the calling thread's slot, claimed on first use. NULL when disabled. */
+static
+profiler_thread_t *
+get_thread(void)
+{
+  uint32_t generation, index;
+  profiler_thread_t *thread;
+
+  if (!atomic_load_u32(&s_profiler.enabled))
+    return NULL;
+
+  generation = atomic_load_u32(&s_profiler.generation);
+  if (s_thread_generation == generation)
+    return s_thread;
+
+  // a slot from an older setup is gone, this one starts over.
+  s_thread = NULL;
+  s_thread_generation = generation;
+  index = atomic_fetch_add_u32(&s_profiler.thread_count, 1);
+  if (index >= PROFILER_MAX_THREADS)
+    return NULL;
+
+  thread = (profiler_thread_t *)s_profiler.allocator->mem_cont_alloc(
+    1, sizeof(profiler_thread_t));
+  cring_def(&thread->ring);
+  cring_setup(
+    &thread->ring, get_type_data(profile_event_t),
+    PROFILER_RING_CAPACITY, s_profiler.allocator);
+  thread->index = index;
+  thread->first_root = PROFILER_INVALID_NODE;
+  atomic_store_ptr(&s_profiler.threads[index], thread);
+  s_thread = thread;
+  return thread;
+}
+
+void
+profiler_setup(const allocator_t *allocator)
+{
+  assert(allocator && !s_profiler.enabled);
+
+  {
+    uint32_t generation = s_profiler.generation + 1;
+    memset(&s_profiler, 0, sizeof(profiler_t));
+    s_profiler.allocator = allocator;
+    get_performance_frequency(&s_profiler.ticks_per_second);
+    s_profiler.origin = get_ticks();
+    cvector_def(&s_profiler.nodes);
+    cvector_setup(
+      &s_profiler.nodes, get_type_data(profiler_node_t), 64, allocator);
+    cvector_def(&s_profiler.spans);
+    cvector_setup(
+      &s_profiler.spans, get_type_data(profile_span_t), 1024, allocator);
+    atomic_store_u32(&s_profiler.generation, generation);
+    atomic_store_u32(&s_profiler.enabled, 1);
+  }
+}
+
+void
+profiler_cleanup(void)
+{
+  assert(s_profiler.enabled);
+
+  {
+    uint32_t i, generation = s_profiler.generation;
+    atomic_store_u32(&s_profiler.enabled, 0);
+    for (i = 0; i < PROFILER_MAX_THREADS; ++i) {
+      profiler_thread_t *thread =
+        (profiler_thread_t *)atomic_load_ptr(&s_profiler.threads[i]);
+      if (!thread)
+        continue;
+      cring_cleanup(&thread->ring, NULL);
+      s_profiler.allocator->mem_free(thread);
+    }
+
+    cvector_cleanup(&s_profiler.nodes, NULL);
+    cvector_cleanup(&s_profiler.spans, NULL);
+    memset(&s_profiler, 0, sizeof(profiler_t));
+    // kept, the thread locals compare against it.
+    s_profiler.generation = generation;
+  }
+}
+
+void
+profiler_begin(const char *name)
+{
+  profiler_thread_t *thread = get_thread();
+  profile_event_t event;
+  assert(name);
+
+  if (!thread)
+    return;
+
+  // a begin needs room for itself and for every end still owed, so that an
+  // end is never dropped and the nesting survives a full ring.
+  if (
+    thread->skipped ||
+    cring_size(&thread->ring) + thread->open + 2 >
+    cring_capacity(&thread->ring)) {
+    ++thread->skipped;
+    atomic_store_u64(&thread->dropped, thread->dropped + 1);
+    return;
+  }
+
+  event.name = name;
+  event.ticks = get_ticks();
+  cring_push(&thread->ring, &event);
+  ++thread->open;
+}
+
+void
+profiler_end(void)
+{
+  profiler_thread_t *thread = get_thread();
+  profile_event_t event;
+
+  if (!thread)
+    return;
+
+  if (thread->skipped) {
+    --thread->skipped;
+    return;
+  }
+
+  if (!thread->open)
+    return;
+
+  event.name = NULL;
+  event.ticks = get_ticks();
+  cring_push(&thread->ring, &event);
+  --thread->open;
+}
+
+static
+profiler_node_t *
+node_at(uint32_t index)
+{
+  return cvector_as(&s_profiler.nodes, index, profiler_node_t);
+}
+
+static
+uint32_t
+names_equal(const char *left, const char *right)
+{
+  return left == right || !strcmp(left, right);
+}
+
+static
+uint32_t
+find_or_add_node(profiler_thread_t *thread, uint32_t parent, const char *name)
+{
+  uint32_t index =
+    parent == PROFILER_INVALID_NODE ?
+    thread->first_root : node_at(parent)->first_child;
+  profiler_node_t node;
+
+  for (; index != PROFILER_INVALID_NODE; index = node_at(index)->next_sibling)
+    if (names_equal(node_at(index)->name, name))
+      return index;
+
+  memset(&node, 0, sizeof(profiler_node_t));
+  node.name = name;
+  node.thread = thread->index;
+  node.parent = parent;
+  node.first_child = PROFILER_INVALID_NODE;
+  if (parent == PROFILER_INVALID_NODE) {
+    node.next_sibling = thread->first_root;
+    thread->first_root = (uint32_t)cvector_size(&s_profiler.nodes);
+  } else {
+    node.depth = node_at(parent)->depth + 1;
+    node.next_sibling = node_at(parent)->first_child;
+    node_at(parent)->first_child = (uint32_t)cvector_size(&s_profiler.nodes);
+  }
+  cvector_push_back(&s_profiler.nodes, node, profiler_node_t);
+  return (uint32_t)cvector_size(&s_profiler.nodes) - 1;
+}
+
+static
+void
+close_scope(profiler_thread_t *thread, uint64_t ticks)
+{
+  uint64_t duration;
+  profiler_node_t *node;
+
+  --thread->depth;
+  duration = ticks - thread->open_ticks[thread->depth];
+  node = node_at(thread->open_nodes[thread->depth]);
+  ++node->calls;
+  node->total_ticks += duration;
+  if (thread->depth)
+    node_at(thread->open_nodes[thread->depth - 1])->child_ticks += duration;
+
+  if (cvector_size(&s_profiler.spans) < PROFILER_TRACE_MAX) {
+    profile_span_t span;
+    span.name = thread->open_names[thread->depth];
+    span.thread = thread->index;
+    span.begin = thread->open_ticks[thread->depth];
+    span.end = ticks;
+    cvector_push_back(&s_profiler.spans, span, profile_span_t);
+  }
+}
+
+static
+void
+drain_thread(profiler_thread_t *thread)
+{
+  profile_event_t event;
+  uint32_t i;
+
+  // scopes left open last frame get their path back in the new tree.
+  thread->first_root = PROFILER_INVALID_NODE;
+  for (i = 0; i < thread->depth; ++i)
+    thread->open_nodes[i] = find_or_add_node(
+      thread,
+      i ? thread->open_nodes[i - 1] : PROFILER_INVALID_NODE,
+      thread->open_names[i]);
+
+  while (cring_pop(&thread->ring, &event)) {
+    if (event.name) {
+      if (thread->depth == PROFILER_MAX_DEPTH) {
+        ++thread->overflow;
+        continue;
+      }
+
+      thread->open_nodes[thread->depth] = find_or_add_node(
+        thread,
+        thread->depth ?
+        thread->open_nodes[thread->depth - 1] : PROFILER_INVALID_NODE,
+        event.name);
+      thread->open_names[thread->depth] = event.name;
+      thread->open_ticks[thread->depth] = event.ticks;
+      ++thread->depth;
+    } else if (thread->overflow)
+      --thread->overflow;
+    else if (thread->depth)
+      close_scope(thread, event.ticks);
+  }
+}
+
+void
+profiler_frame_end(void)
+{
+  uint32_t i, count;
+
+  if (!s_profiler.enabled)
+    return;
+
+  cvector_clear(&s_profiler.nodes);
+  count = atomic_load_u32(&s_profiler.thread_count);
+  count = count < PROFILER_MAX_THREADS ? count : PROFILER_MAX_THREADS;
+  for (i = 0; i < count; ++i) {
+    profiler_thread_t *thread =
+      (profiler_thread_t *)atomic_load_ptr(&s_profiler.threads[i]);
+    if (thread)
+      drain_thread(thread);
+  }
+
+  for (i = 0; i < cvector_size(&s_profiler.nodes); ++i) {
+    profiler_node_t *node = node_at(i);
+    double ms = 1000. / (double)s_profiler.ticks_per_second;
+    node->total_ms = (double)node->total_ticks * ms;
+    node->self_ms = (double)(node->total_ticks - node->child_ticks) * ms;
+  }
+}
+
+const profiler_node_t *
+profiler_frame_nodes(uint32_t *count)
+{
+  assert(count);
+
+  if (!s_profiler.enabled) {
+    *count = 0;
+    return NULL;
+  }
+
+  *count = (uint32_t)cvector_size(&s_profiler.nodes);
+  return *count ? node_at(0) : NULL;
+}
+
+uint64_t
+profiler_dropped_events(void)
+{
+  uint64_t dropped = 0;
+  uint32_t i;
+  for (i = 0; i < PROFILER_MAX_THREADS; ++i) {
+    profiler_thread_t *thread =
+      (profiler_thread_t *)atomic_load_ptr(&s_profiler.threads[i]);
+    if (thread)
+      dropped += atomic_load_u64(&thread->dropped);
+  }
+  return dropped;
+}
+
+/** copies 'name' into 'dst' with the json specials escaped. */
+static
+void
+escape_name(const char *name, char *dst, size_t size)
+{
+  size_t i = 0;
+  for (; *name && i + 2 < size; ++name) {
+    if (*name == '"' || *name == '\\')
+      dst[i++] = '\\';
+    dst[i++] = (uint8_t)*name < 0x20 ? ' ' : *name;
+  }
+  dst[i] = 0;
+}
+
+static
+uint32_t
+flush_trace(file_handle_t file, char *buffer, size_t *used)
+{
+  uint32_t written = 1;
+  if (*used)
+    written = write_buffer(file, buffer, *used, 1) == 1;
+  *used = 0;
+  return written;
+}
+
+uint32_t
+profiler_write_chrome_trace(const char *path)
+{
+  assert(path && s_profiler.enabled);
+
+  {
+    char *buffer;
+    char name[TRACE_LINE_MAX / 2];
+    const char *separator = "";
+    size_t used = 0, i, count = cvector_size(&s_profiler.spans);
+    uint32_t ok = 1, thread, threads = s_profiler.thread_count;
+    double us = 1000000. / (double)s_profiler.ticks_per_second;
+    file_handle_t file = open_file(
+      path, (file_open_flags_t)(FILE_OPEN_MODE_WRITE | FILE_OPEN_MODE_BINARY));
+    if (!file)
+      return 0;
+
+    buffer = (char *)s_profiler.allocator->mem_alloc(TRACE_BUFFER_SIZE);
+    used += sprintf(buffer + used, "{\"traceEvents\":[\n");
+    threads = threads < PROFILER_MAX_THREADS ? threads : PROFILER_MAX_THREADS;
+    // the separator goes before a record, never after the last one.
+    for (thread = 0; thread < threads && ok; ++thread) {
+      if (TRACE_BUFFER_SIZE - used < TRACE_LINE_MAX)
+        ok = flush_trace(file, buffer, &used);
+      used += sprintf(
+        buffer + used,
+        "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,"
+        "\"args\":{\"name\":\"thread %u\"}}", separator, thread, thread);
+      separator = ",\n";
+    }
+
+    // complete events, the viewer nests them by time.
+    for (i = 0; i < count && ok; ++i) {
+      profile_span_t *span = cvector_as(&s_profiler.spans, i, profile_span_t);
+      if (TRACE_BUFFER_SIZE - used < TRACE_LINE_MAX)
+        ok = flush_trace(file, buffer, &used);
+      escape_name(span->name, name, sizeof(name));
+      used += sprintf(
+        buffer + used,
+        "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,"
+        "\"ts\":%.3f,\"dur\":%.3f}",
+        separator, name, span->thread,
+        (double)(span->begin - s_profiler.origin) * us,
+        (double)(span->end - span->begin) * us);
+      separator = ",\n";
+    }
+    used += sprintf(buffer + used, "\n]}\n");
+    ok = ok && flush_trace(file, buffer, &used);
+
+    close_file(file);
+    s_profiler.allocator->mem_free(buffer);
+    cvector_clear(&s_profiler.spans);
+    return ok;
+  }
+}
\ No newline at end of file
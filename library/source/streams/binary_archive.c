@@ -0,0 +1,400 @@
+/**
+ * @file binary_archive.c
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <assert.h>
+#include <string.h>
+#include <library/allocator/allocator.h>
+#include <library/containers/cvector.h>
+#include <library/hash/fnv.h>
+#include <library/streams/binary_archive.h>
+#include <library/streams/binary_stream.h>
+#include <library/threading/atomic.h>
+#include <library/threading/thread.h>
+
+
+// returns the read position as an offset, STREAM_EOF maps to the stream size.
+static
+size_t
+get_offset(const binary_stream_t *stream)
+{
+  size_t pos = binary_stream_tell(stream);
+  return pos == STREAM_EOF ? binary_stream_size(stream) : pos;
+}
+
+static
+size_t
+get_remaining(const binary_stream_t *stream)
+{
+  return binary_stream_size(stream) - get_offset(stream);
+}
+
+void
+binary_archive_write_header(binary_stream_t *stream, uint32_t flags)
+{
+  assert(stream);
+
+  {
+    archive_header_t header;
+    header.magic = ARCHIVE_MAGIC;
+    header.endian_tag = ARCHIVE_ENDIAN_TAG;
+    header.version = ARCHIVE_VERSION;
+    header.flags = flags;
+    binary_stream_write(stream, &header, sizeof(archive_header_t));
+    stream->flags = flags;
+  }
+}
+
+archive_result_t
+binary_archive_read_header(
+  binary_stream_t *stream,
+  archive_header_t *header)
+{
+  assert(stream && header);
+
+  if (get_remaining(stream) < sizeof(archive_header_t))
+    return ARCHIVE_ERROR_EOF;
+
+  binary_stream_read2(stream, (uint8_t *)header, sizeof(archive_header_t));
+
+  // every field of a foreign endian header is swapped, the magic included.
+  if (header->magic == ARCHIVE_MAGIC_SWAPPED)
+    return ARCHIVE_ERROR_ENDIANNESS;
+
+  if (header->magic != ARCHIVE_MAGIC)
+    return ARCHIVE_ERROR_MAGIC;
+
+  if (header->endian_tag != ARCHIVE_ENDIAN_TAG)
+    return ARCHIVE_ERROR_ENDIANNESS;
+
+  if (header->version > ARCHIVE_VERSION)
+    return ARCHIVE_ERROR_VERSION;
+
+  stream->flags = header->flags;
+  return ARCHIVE_OK;
+}
+
+void
+binary_archive_write_block(
+  binary_stream_t *stream,
+  type_id_t type_id,
+  const void *src)
+{
+  assert(stream && src);
+  assert(is_type_registered(type_id) && "only registered types are supported");
+
+  {
+    vtable_t *vtable = get_vtable(type_id);
+    archive_block_t block;
+    size_t block_at, payload_at;
+    uint8_t *data;
+
+    assert(vtable->fn_serialize && vtable->fn_type_size);
+
+    memset(&block, 0, sizeof(archive_block_t));
+    block.type_id = type_id;
+    block.type_size = (uint32_t)vtable->fn_type_size();
+    block.flags = stream->flags;
+
+    // write a placeholder, patched once the payload length is known.
+    block_at = binary_stream_size(stream);
+    binary_stream_write(stream, &block, sizeof(archive_block_t));
+    payload_at = binary_stream_size(stream);
+    vtable->fn_serialize(src, stream);
+
+    data = (uint8_t *)stream->data->data;
+    block.length = binary_stream_size(stream) - payload_at;
+    block.checksum = hash_fnv1a_32(data + payload_at, (size_t)block.length);
+    memcpy(data + block_at, &block, sizeof(archive_block_t));
+  }
+}
+
+archive_result_t
+binary_archive_read_block_header(
+  binary_stream_t *stream,
+  archive_block_t *block)
+{
+  assert(stream && block);
+
+  if (get_remaining(stream) < sizeof(archive_block_t))
+    return ARCHIVE_ERROR_EOF;
+
+  binary_stream_read2(stream, (uint8_t *)block, sizeof(archive_block_t));
+
+  if (get_remaining(stream) < block->length)
+    return ARCHIVE_ERROR_EOF;
+
+  return ARCHIVE_OK;
+}
+
+void
+binary_archive_skip_block(
+  binary_stream_t *stream,
+  const archive_block_t *block)
+{
+  assert(stream && block);
+  assert(get_remaining(stream) >= block->length);
+  binary_stream_seek(stream, get_offset(stream) + (size_t)block->length);
+}
+
+archive_result_t
+binary_archive_read_block(
+  binary_stream_t *stream,
+  const archive_block_t *block,
+  void *dst,
+  const allocator_t *allocator)
+{
+  assert(stream && block && dst && allocator);
+
+  {
+    size_t payload_at = get_offset(stream);
+    const uint8_t *data = (const uint8_t *)stream->data->data;
+    vtable_t *vtable = NULL;
+    uint32_t flags = stream->flags;
+
+    if (hash_fnv1a_32(data + payload_at, (size_t)block->length) !=
+        block->checksum) {
+      binary_archive_skip_block(stream, block);
+      return ARCHIVE_ERROR_CHECKSUM;
+    }
+
+    if (!is_type_registered(block->type_id)) {
+      binary_archive_skip_block(stream, block);
+      return ARCHIVE_ERROR_UNKNOWN_TYPE;
+    }
+
+    vtable = get_vtable(block->type_id);
+    if (
+      !vtable->fn_deserialize ||
+      (vtable->fn_type_size && vtable->fn_type_size() != block->type_size)) {
+      binary_archive_skip_block(stream, block);
+      return ARCHIVE_ERROR_TYPE_SIZE;
+    }
+
+    stream->flags = block->flags;
+    if (block->length)
+      vtable->fn_deserialize(dst, allocator, stream);
+    stream->flags = flags;
+
+    assert(
+      get_offset(stream) == payload_at + block->length &&
+      "the payload was not fully consumed, serializers are out of sync!");
+    return ARCHIVE_OK;
+  }
+}
+
+const char *
+binary_archive_result_str(archive_result_t result)
+{
+  static const char *strings[ARCHIVE_ERROR_COUNT] = {
+    "ok",
+    "unexpected end of stream",
+    "invalid magic",
+    "unsupported version",
+    "endianness mismatch",
+    "checksum mismatch",
+    "unknown type",
+    "type size mismatch" };
+
+  assert(result < ARCHIVE_ERROR_COUNT);
+  return strings[result];
+}
+
+uint32_t
+binary_archive_scan_blocks(
+  binary_stream_t *stream,
+  archive_load_t *loads,
+  uint32_t capacity)
+{
+  assert(stream);
+  assert(loads || !capacity);
+
+  {
+    uint32_t count = 0;
+    archive_block_t block;
+
+    while (binary_archive_read_block_header(stream, &block) == ARCHIVE_OK) {
+      if (count < capacity) {
+        loads[count].block = block;
+        loads[count].offset = get_offset(stream);
+        loads[count].dst = NULL;
+        loads[count].allocator = NULL;
+        loads[count].result = ARCHIVE_OK;
+      }
+
+      ++count;
+      binary_archive_skip_block(stream, &block);
+    }
+
+    return count;
+  }
+}
+
+typedef
+struct load_shared_t {
+  const binary_stream_t *stream;
+  archive_load_t *loads;
+  uint32_t count;
+  volatile uint32_t next;
+  volatile uint32_t failed;
+} load_shared_t;
+
+typedef
+struct load_worker_t {
+  load_shared_t *shared;
+  const allocator_t *allocator;
+} load_worker_t;
+
+static
+void
+load_block(
+  const binary_stream_t *stream,
+  archive_load_t *load,
+  const allocator_t *allocator)
+{
+  vtable_t *vtable;
+  cvector_t view;
+  binary_stream_t local;
+  size_t type_size;
+
+  load->dst = NULL;
+  load->allocator = allocator;
+
+  if (!is_type_registered(load->block.type_id)) {
+    load->result = ARCHIVE_ERROR_UNKNOWN_TYPE;
+    return;
+  }
+
+  vtable = get_vtable(load->block.type_id);
+  type_size = vtable->fn_type_size ? vtable->fn_type_size() : 0;
+  if (!type_size) {
+    load->result = ARCHIVE_ERROR_TYPE_SIZE;
+    return;
+  }
+
+  // a private read cursor over the shared buffer, the cvector is copied by
+  // value so nothing the other workers can see is written to.
+  view = *stream->data;
+  local.data = &view;
+  local.pos = STREAM_START_POS;
+  local.allocator = stream->allocator;
+  local.flags = stream->flags;
+  binary_stream_seek(&local, load->offset);
+
+  load->dst = allocator->mem_alloc(type_size);
+  memset(load->dst, 0, type_size);
+  if (vtable->fn_def)
+    vtable->fn_def(load->dst);
+
+  load->result =
+    binary_archive_read_block(&local, &load->block, load->dst, allocator);
+  if (load->result != ARCHIVE_OK) {
+    allocator->mem_free(load->dst);
+    load->dst = NULL;
+  }
+}
+
+static
+void
+load_worker(void *arg)
+{
+  load_worker_t *worker = (load_worker_t *)arg;
+  load_shared_t *shared = worker->shared;
+  uint32_t index;
+
+  while ((index = atomic_fetch_add_u32(&shared->next, 1)) < shared->count) {
+    archive_load_t *load = shared->loads + index;
+    load_block(shared->stream, load, worker->allocator);
+    if (load->result != ARCHIVE_OK)
+      atomic_fetch_add_u32(&shared->failed, 1);
+  }
+}
+
+uint32_t
+binary_archive_load_parallel(
+  const binary_stream_t *stream,
+  archive_load_t *loads,
+  uint32_t count,
+  const allocator_t *allocators[],
+  uint32_t worker_count)
+{
+  assert(stream && allocators && worker_count);
+  assert(loads || !count);
+
+  {
+    // the calling thread doubles as worker 0.
+    load_shared_t shared;
+    load_worker_t *workers;
+    thread_handle_t *threads;
+    uint32_t i, spawned = 0;
+
+    if (!stream->data || !count)
+      return 0;
+
+    worker_count = worker_count > count ? count : worker_count;
+    shared.stream = stream;
+    shared.loads = loads;
+    shared.count = count;
+    shared.next = 0;
+    shared.failed = 0;
+
+    workers = (load_worker_t *)allocators[0]->mem_alloc(
+      sizeof(load_worker_t) * worker_count);
+    threads = (thread_handle_t *)allocators[0]->mem_alloc(
+      sizeof(thread_handle_t) * worker_count);
+
+    for (i = 0; i < worker_count; ++i) {
+      assert(allocators[i]);
+      workers[i].shared = &shared;
+      workers[i].allocator = allocators[i];
+    }
+
+    for (i = 1; i < worker_count; ++i) {
+      threads[spawned] = thread_create(load_worker, workers + i);
+      if (threads[spawned] != INVALID_THREAD)
+        ++spawned;
+    }
+
+    load_worker(workers);
+
+    for (i = 0; i < spawned; ++i)
+      thread_join(threads[i]);
+
+    allocators[0]->mem_free(threads);
+    allocators[0]->mem_free(workers);
+    return shared.failed;
+  }
+}
+
+void
+binary_archive_load_cleanup(archive_load_t *loads, uint32_t count)
+{
+  assert(loads || !count);
+
+  {
+    uint32_t i;
+    for (i = 0; i < count; ++i) {
+      archive_load_t *load = loads + i;
+      vtable_t *vtable;
+
+      if (!load->dst)
+        continue;
+
+      vtable = get_vtable(load->block.type_id);
+      if (vtable->fn_cleanup)
+        vtable->fn_cleanup(
+          load->dst,
+          (vtable->fn_owns_alloc && vtable->fn_owns_alloc()) ?
+            NULL : load->allocator);
+
+      load->allocator->mem_free(load->dst);
+      load->dst = NULL;
+    }
+  }
+}
\ No newline at end of file
@@ -12,6 +12,8 @@
 #include <string.h>
 #include <library/containers/cvector.h>
 #include <library/filesystem/io.h>
+#include <library/streams/stream_codec.h>
+#include <library/streams/stream_file.h>
 
 
 void
@@ -22,6 +24,7 @@ binary_stream_def(binary_stream_t *stream)
   stream->data = NULL;
   stream->pos = STREAM_START_POS;
   stream->allocator = NULL;
+  stream->flags = STREAM_FLAG_NONE;
 }
 
 uint32_t
@@ -54,6 +57,7 @@ binary_stream_cleanup(binary_stream_t *stream)
   stream->allocator->mem_free(stream->data);
   stream->pos = STREAM_START_POS;
   stream->allocator = NULL;
+  stream->flags = STREAM_FLAG_NONE;
 }
 
 void
@@ -122,6 +126,77 @@ binary_stream_read(
   return STREAM_EOF;
 }
 
+void
+binary_stream_write_varint(binary_stream_t *stream, uint64_t value)
+{
+  assert(stream && !binary_stream_is_def(stream));
+
+  {
+    uint8_t bytes[10];
+    size_t count = 0;
+    do {
+      bytes[count] = (uint8_t)(value & 0x7f);
+      value >>= 7;
+      bytes[count++] |= value ? 0x80 : 0x00;
+    } while (value);
+    binary_stream_write(stream, bytes, count);
+  }
+}
+
+uint64_t
+binary_stream_read_varint(binary_stream_t *stream)
+{
+  assert(stream && !binary_stream_is_def(stream));
+
+  if (stream->pos == STREAM_EOF || stream->pos >= stream->data->size)
+    return 0;
+
+  {
+    // decode straight from the buffer rather than a read call per byte.
+    const uint8_t *src = (const uint8_t *)stream->data->data;
+    size_t pos = stream->pos, size = stream->data->size;
+    uint64_t value = 0;
+    uint32_t shift = 0;
+    uint8_t byte;
+    do {
+      // cut short by the end of the stream or past 64 bits, the data that
+      // follows cannot be trusted either.
+      if (pos == size || shift >= 64) {
+        stream->pos = STREAM_EOF;
+        return 0;
+      }
+      byte = src[pos++];
+      value |= (uint64_t)(byte & 0x7f) << shift;
+      shift += 7;
+    } while (byte & 0x80);
+
+    stream->pos = (pos == size) ? STREAM_EOF : pos;
+    return value;
+  }
+}
+
+size_t
+binary_stream_size(const binary_stream_t *stream)
+{
+  assert(stream && !binary_stream_is_def(stream));
+  return stream->data->size;
+}
+
+size_t
+binary_stream_tell(const binary_stream_t *stream)
+{
+  assert(stream && !binary_stream_is_def(stream));
+  return stream->pos;
+}
+
+void
+binary_stream_seek(binary_stream_t *stream, size_t pos)
+{
+  assert(stream && !binary_stream_is_def(stream));
+  assert(pos <= stream->data->size && "cannot seek past the end!");
+  stream->pos = (pos == stream->data->size) ? STREAM_EOF : pos;
+}
+
 binary_stream_t *
 binary_stream_from_file(
   const char *path,
@@ -129,6 +204,9 @@ binary_stream_from_file(
 {
   assert(file_exists(path));
 
+  if (stream_file_is_compressed(path))
+    return stream_file_read(path, allocator);
+
   {
     binary_stream_t *stream = allocator->mem_alloc(sizeof(binary_stream_t));
     binary_stream_def(stream);
@@ -140,15 +218,46 @@ binary_stream_from_file(
       file_handle_t file;
       file = open_file(path, FILE_OPEN_MODE_READ | FILE_OPEN_MODE_BINARY);
       assert((void*)file != NULL);
-      do {
-        read = read_buffer(
-          file,
-          buffer, sizeof(uint8_t), 16 * 1024);
-        binary_stream_write(stream, buffer, 16 * 1024);
-      } while (read);
+      while ((read = read_buffer(file, buffer, sizeof(uint8_t), 16 * 1024)))
+        binary_stream_write(stream, buffer, read);
       close_file(file);
     }
 
     return stream;
   }
+}
+
+uint32_t
+binary_stream_to_file(
+  const binary_stream_t *stream,
+  const char *path,
+  const stream_codec_t *codec)
+{
+  assert(stream && !binary_stream_is_def(stream));
+  assert(path);
+
+  {
+    const void *data = stream->data->data;
+    size_t size = binary_stream_size(stream);
+
+    uint32_t written = 1;
+
+    if (codec) {
+      stream_writer_t writer;
+      if (!stream_writer_setup(&writer, path, codec, stream->allocator))
+        return 0;
+      stream_writer_write(&writer, data, size);
+      written = stream_writer_cleanup(&writer);
+    } else {
+      file_handle_t file =
+        open_file(path, FILE_OPEN_MODE_WRITE | FILE_OPEN_MODE_BINARY);
+      if ((void *)file == NULL)
+        return 0;
+      if (size)
+        written = write_buffer(file, data, 1, size) == size;
+      close_file(file);
+    }
+
+    return written;
+  }
 }
\ No newline at end of file
@@ -0,0 +1,248 @@
+/**
+ * @file stream_codec.c
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <assert.h>
+#include <string.h>
+#include <library/streams/stream_codec.h>
+
+#define LZ_MIN_MATCH                  4
+#define LZ_MAX_OFFSET                 65535
+#define LZ_HASH_BITS                  12
+#define LZ_RUN_MASK                   15
+// the skip step grows by one for every 2^LZ_SKIP_TRIGGER missed positions.
+#define LZ_SKIP_TRIGGER               6
+
+
+////////////////////////////////////////////////////////////////////////////////
+// sequence layout (lz4 block format):
+//  [token][literal length ext...][literals][offset u16 le][match length ext...]
+//  - token high nibble is the literal count, low nibble the match length minus
+//    LZ_MIN_MATCH, 15 means the value continues in 255 valued bytes.
+//  - the last sequence only carries literals, it ends the block.
+////////////////////////////////////////////////////////////////////////////////
+
+static
+uint32_t
+lz_read32(const uint8_t *ptr)
+{
+  uint32_t value;
+  memcpy(&value, ptr, sizeof(uint32_t));
+  return value;
+}
+
+static
+uint32_t
+lz_hash(uint32_t sequence)
+{
+  return (sequence * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+static
+uint8_t *
+lz_write_length(uint8_t *op, size_t length)
+{
+  for (; length >= 255; length -= 255)
+    *op++ = 255;
+  *op++ = (uint8_t)length;
+  return op;
+}
+
+static
+size_t
+lz_bound(size_t src_size)
+{
+  return src_size + src_size / 255 + 16;
+}
+
+static
+size_t
+lz_encode(
+  const uint8_t *src, size_t src_size,
+  uint8_t *dst, size_t dst_capacity)
+{
+  uint32_t table[1 << LZ_HASH_BITS];
+  const uint8_t *ip = src, *anchor = src;
+  const uint8_t *iend = src + src_size;
+  uint8_t *op = dst, *oend = dst + dst_capacity;
+  size_t literals;
+
+  assert(src && dst);
+  assert(src_size <= UINT32_MAX);
+
+  memset(table, 0, sizeof(table));
+
+  while (ip + LZ_MIN_MATCH <= iend) {
+    uint32_t sequence = lz_read32(ip);
+    uint32_t h = lz_hash(sequence);
+    const uint8_t *ref = src + table[h];
+    table[h] = (uint32_t)(ip - src);
+
+    if (
+      ref < ip &&
+      (size_t)(ip - ref) <= LZ_MAX_OFFSET &&
+      lz_read32(ref) == sequence) {
+      size_t match = LZ_MIN_MATCH, offset = (size_t)(ip - ref);
+      uint8_t *token;
+      literals = (size_t)(ip - anchor);
+
+      while (ip + match < iend && ref[match] == ip[match])
+        ++match;
+
+      // token, both length extensions, literals and the offset.
+      if ((size_t)(oend - op) <
+          1 + literals / 255 + 1 + literals + 2 + match / 255 + 1)
+        return 0;
+
+      token = op++;
+      if (literals >= LZ_RUN_MASK) {
+        *token = LZ_RUN_MASK << 4;
+        op = lz_write_length(op, literals - LZ_RUN_MASK);
+      } else
+        *token = (uint8_t)(literals << 4);
+      memcpy(op, anchor, literals);
+      op += literals;
+
+      *op++ = (uint8_t)(offset & 0xff);
+      *op++ = (uint8_t)(offset >> 8);
+
+      match -= LZ_MIN_MATCH;
+      if (match >= LZ_RUN_MASK) {
+        *token |= LZ_RUN_MASK;
+        op = lz_write_length(op, match - LZ_RUN_MASK);
+      } else
+        *token |= (uint8_t)match;
+
+      ip += match + LZ_MIN_MATCH;
+      anchor = ip;
+    } else
+      ip += 1 + ((size_t)(ip - anchor) >> LZ_SKIP_TRIGGER);
+  }
+
+  // the remaining bytes go out as the final, literals only, sequence.
+  literals = (size_t)(iend - anchor);
+  if ((size_t)(oend - op) < 1 + literals / 255 + 1 + literals)
+    return 0;
+
+  if (literals >= LZ_RUN_MASK) {
+    *op++ = LZ_RUN_MASK << 4;
+    op = lz_write_length(op, literals - LZ_RUN_MASK);
+  } else
+    *op++ = (uint8_t)(literals << 4);
+  memcpy(op, anchor, literals);
+  op += literals;
+
+  return (size_t)(op - dst);
+}
+
+static
+size_t
+lz_decode(
+  const uint8_t *src, size_t src_size,
+  uint8_t *dst, size_t dst_size)
+{
+  const uint8_t *ip = src, *iend = src + src_size;
+  uint8_t *op = dst, *oend = dst + dst_size;
+
+  assert(src && dst);
+
+  while (ip < iend) {
+    uint8_t token = *ip++;
+    size_t length = token >> 4;
+    size_t offset;
+    const uint8_t *match;
+
+    if (length == LZ_RUN_MASK) {
+      uint8_t byte;
+      do {
+        if (ip >= iend)
+          return 0;
+        byte = *ip++;
+        length += byte;
+      } while (byte == 255);
+    }
+
+    if ((size_t)(iend - ip) < length || (size_t)(oend - op) < length)
+      return 0;
+    memcpy(op, ip, length);
+    ip += length;
+    op += length;
+
+    if (ip == iend)
+      break;
+
+    if (iend - ip < 2)
+      return 0;
+    offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+    ip += 2;
+    if (!offset || offset > (size_t)(op - dst))
+      return 0;
+
+    length = (token & LZ_RUN_MASK);
+    if (length == LZ_RUN_MASK) {
+      uint8_t byte;
+      do {
+        if (ip >= iend)
+          return 0;
+        byte = *ip++;
+        length += byte;
+      } while (byte == 255);
+    }
+    length += LZ_MIN_MATCH;
+
+    if ((size_t)(oend - op) < length)
+      return 0;
+
+    // the source can overlap the destination (repeating patterns).
+    match = op - offset;
+    if (offset >= length) {
+      memcpy(op, match, length);
+      op += length;
+    } else {
+      while (length--)
+        *op++ = *match++;
+    }
+  }
+
+  return (size_t)(op - dst);
+}
+
+const stream_codec_t g_lz_codec = {
+  STREAM_CODEC_LZ_ID,
+  "lz",
+  lz_bound,
+  lz_encode,
+  lz_decode };
+
+static const stream_codec_t *s_codecs[STREAM_CODEC_MAX_COUNT];
+static uint32_t s_codec_count;
+
+void
+stream_codec_register(const stream_codec_t *codec)
+{
+  assert(codec && codec->fn_bound && codec->fn_encode && codec->fn_decode);
+  assert(!stream_codec_find(codec->id) && "codec id already in use!");
+  assert(s_codec_count < STREAM_CODEC_MAX_COUNT);
+  s_codecs[s_codec_count++] = codec;
+}
+
+const stream_codec_t *
+stream_codec_find(uint32_t id)
+{
+  uint32_t i;
+  if (id == g_lz_codec.id)
+    return &g_lz_codec;
+
+  for (i = 0; i < s_codec_count; ++i) {
+    if (s_codecs[i]->id == id)
+      return s_codecs[i];
+  }
+
+  return NULL;
+}
\ No newline at end of file
@@ -0,0 +1,367 @@
+/**
+ * @file stream_file.c
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <assert.h>
+#include <string.h>
+#include <library/allocator/allocator.h>
+#include <library/containers/cvector.h>
+#include <library/streams/binary_stream.h>
+#include <library/streams/stream_codec.h>
+#include <library/streams/stream_file.h>
+#include <library/threading/mutex.h>
+#include <library/threading/thread.h>
+
+// guards the slot allocations against corrupted headers.
+#define STREAM_FILE_MAX_BLOCK_SIZE    (64 * 1024 * 1024)
+
+
+static
+void
+writer_flush(stream_writer_t *writer)
+{
+  stream_file_block_t block;
+  const uint8_t *bytes = writer->encoded;
+  size_t encoded = writer->codec->fn_encode(
+    writer->block, writer->block_used,
+    writer->encoded, writer->encoded_capacity);
+
+  block.raw_size = (uint32_t)writer->block_used;
+  if (!encoded || encoded >= writer->block_used) {
+    block.stored_size = (uint32_t)writer->block_used | STREAM_FILE_STORED_RAW;
+    bytes = writer->block;
+    encoded = writer->block_used;
+  } else
+    block.stored_size = (uint32_t)encoded;
+
+  writer->failed |=
+    write_buffer(writer->file, &block, sizeof(stream_file_block_t), 1) != 1;
+  writer->failed |= write_buffer(writer->file, bytes, 1, encoded) != encoded;
+  writer->file_bytes += sizeof(stream_file_block_t) + encoded;
+  writer->block_used = 0;
+}
+
+uint32_t
+stream_writer_setup(
+  stream_writer_t *writer,
+  const char *path,
+  const stream_codec_t *codec,
+  const allocator_t *allocator)
+{
+  assert(writer && path && codec && allocator);
+
+  {
+    stream_file_header_t header;
+    memset(writer, 0, sizeof(stream_writer_t));
+    writer->file = open_file(path, FILE_OPEN_MODE_WRITE | FILE_OPEN_MODE_BINARY);
+    if ((void *)writer->file == NULL)
+      return 0;
+
+    writer->codec = codec;
+    writer->allocator = allocator;
+    writer->block = (uint8_t *)allocator->mem_alloc(STREAM_FILE_BLOCK_SIZE);
+    writer->encoded_capacity = codec->fn_bound(STREAM_FILE_BLOCK_SIZE);
+    writer->encoded = (uint8_t *)allocator->mem_alloc(writer->encoded_capacity);
+
+    header.magic = STREAM_FILE_MAGIC;
+    header.version = STREAM_FILE_VERSION;
+    header.codec_id = codec->id;
+    header.block_size = STREAM_FILE_BLOCK_SIZE;
+    writer->failed =
+      write_buffer(writer->file, &header, sizeof(stream_file_header_t), 1) != 1;
+    writer->file_bytes = sizeof(stream_file_header_t);
+    return 1;
+  }
+}
+
+void
+stream_writer_write(stream_writer_t *writer, const void *data, size_t size)
+{
+  assert(writer && writer->block);
+  assert(data || !size);
+
+  {
+    const uint8_t *src = (const uint8_t *)data;
+    writer->raw_bytes += size;
+
+    while (size) {
+      size_t count = STREAM_FILE_BLOCK_SIZE - writer->block_used;
+      count = count > size ? size : count;
+      memcpy(writer->block + writer->block_used, src, count);
+      writer->block_used += count;
+      src += count;
+      size -= count;
+
+      if (writer->block_used == STREAM_FILE_BLOCK_SIZE)
+        writer_flush(writer);
+    }
+  }
+}
+
+uint32_t
+stream_writer_cleanup(stream_writer_t *writer)
+{
+  assert(writer && writer->block);
+
+  {
+    stream_file_block_t end;
+    if (writer->block_used)
+      writer_flush(writer);
+
+    end.raw_size = end.stored_size = 0;
+    writer->failed |=
+      write_buffer(writer->file, &end, sizeof(stream_file_block_t), 1) != 1;
+    writer->file_bytes += sizeof(stream_file_block_t);
+    close_file(writer->file);
+
+    writer->allocator->mem_free(writer->block);
+    writer->allocator->mem_free(writer->encoded);
+    writer->block = writer->encoded = NULL;
+    writer->file = (file_handle_t)NULL;
+    return !writer->failed;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static
+uint32_t
+read_header(file_handle_t file, stream_file_header_t *header)
+{
+  return
+    read_buffer(file, header, sizeof(stream_file_header_t), 1) == 1 &&
+    header->magic == STREAM_FILE_MAGIC;
+}
+
+uint32_t
+stream_file_is_compressed(const char *path)
+{
+  assert(path);
+
+  {
+    stream_file_header_t header;
+    uint32_t result;
+    file_handle_t file =
+      open_file(path, FILE_OPEN_MODE_READ | FILE_OPEN_MODE_BINARY);
+    if ((void *)file == NULL)
+      return 0;
+
+    result = read_header(file, &header);
+    close_file(file);
+    return result;
+  }
+}
+
+typedef
+struct read_slot_t {
+  stream_file_block_t block;
+  uint8_t *data;
+} read_slot_t;
+
+// the reader thread fills slots, the decoding thread drains them in order.
+typedef
+struct read_pipeline_t {
+  file_handle_t file;
+  uint32_t block_size;
+  size_t slot_capacity;
+  read_slot_t slots[STREAM_FILE_READ_AHEAD];
+  mutex_t mutex;
+  condvar_t filled;
+  condvar_t drained;
+  uint32_t produced;
+  uint32_t consumed;
+  uint32_t done;
+  uint32_t failed;
+  uint32_t abort;
+} read_pipeline_t;
+
+static
+uint32_t
+read_slot(read_pipeline_t *pipeline, read_slot_t *slot, uint32_t *end)
+{
+  stream_file_block_t *block = &slot->block;
+  size_t stored;
+
+  if (read_buffer(
+    pipeline->file, block, sizeof(stream_file_block_t), 1) != 1)
+    return 0;
+
+  *end = block->raw_size == 0;
+  if (*end)
+    return 1;
+
+  stored = block->stored_size & ~STREAM_FILE_STORED_RAW;
+  if (
+    block->raw_size > pipeline->block_size ||
+    stored > pipeline->slot_capacity ||
+    ((block->stored_size & STREAM_FILE_STORED_RAW) &&
+      stored != block->raw_size))
+    return 0;
+
+  return read_buffer(pipeline->file, slot->data, 1, stored) == stored;
+}
+
+// reads the next block into the free slot, returns 0 once the end is reached.
+static
+uint32_t
+read_next(read_pipeline_t *pipeline)
+{
+  // the slot is not visible to the decoder until 'produced' moves.
+  read_slot_t *slot =
+    pipeline->slots + pipeline->produced % STREAM_FILE_READ_AHEAD;
+  uint32_t end = 0, ok = read_slot(pipeline, slot, &end);
+
+  mutex_lock(&pipeline->mutex);
+  if (ok && !end)
+    ++pipeline->produced;
+  else {
+    pipeline->failed = !ok;
+    pipeline->done = 1;
+  }
+  condvar_signal(&pipeline->filled);
+  mutex_unlock(&pipeline->mutex);
+
+  return ok && !end;
+}
+
+static
+void
+reader_thread(void *arg)
+{
+  read_pipeline_t *pipeline = (read_pipeline_t *)arg;
+
+  do {
+    mutex_lock(&pipeline->mutex);
+    while (
+      pipeline->produced - pipeline->consumed == STREAM_FILE_READ_AHEAD &&
+      !pipeline->abort)
+      condvar_wait(&pipeline->drained, &pipeline->mutex);
+    if (pipeline->abort) {
+      mutex_unlock(&pipeline->mutex);
+      return;
+    }
+    mutex_unlock(&pipeline->mutex);
+  } while (read_next(pipeline));
+}
+
+static
+uint32_t
+decode_slot(
+  const stream_codec_t *codec,
+  const read_slot_t *slot,
+  binary_stream_t *stream)
+{
+  cvector_t *data = stream->data;
+  size_t at = data->size, raw = slot->block.raw_size;
+  uint8_t *dst;
+
+  // grow geometrically, the blocks are decoded in place.
+  if (at + raw > data->capacity)
+    cvector_reserve(
+      data, at + raw > data->capacity * 2 ? at + raw : data->capacity * 2);
+  dst = (uint8_t *)cvector_at_unchecked(data, at);
+
+  if (slot->block.stored_size & STREAM_FILE_STORED_RAW)
+    memcpy(dst, slot->data, raw);
+  else if (codec->fn_decode(
+    slot->data, slot->block.stored_size, dst, raw) != raw)
+    return 0;
+
+  data->size = at + raw;
+  return 1;
+}
+
+binary_stream_t *
+stream_file_read(const char *path, const allocator_t *allocator)
+{
+  assert(path && allocator);
+
+  {
+    read_pipeline_t pipeline;
+    stream_file_header_t header;
+    const stream_codec_t *codec;
+    binary_stream_t *stream;
+    thread_handle_t reader;
+    uint32_t i, ok = 1;
+
+    memset(&pipeline, 0, sizeof(read_pipeline_t));
+    pipeline.file = open_file(path, FILE_OPEN_MODE_READ | FILE_OPEN_MODE_BINARY);
+    if ((void *)pipeline.file == NULL)
+      return NULL;
+
+    if (
+      !read_header(pipeline.file, &header) ||
+      header.version > STREAM_FILE_VERSION ||
+      !header.block_size ||
+      header.block_size > STREAM_FILE_MAX_BLOCK_SIZE ||
+      !(codec = stream_codec_find(header.codec_id))) {
+      close_file(pipeline.file);
+      return NULL;
+    }
+
+    pipeline.block_size = header.block_size;
+    pipeline.slot_capacity = codec->fn_bound(header.block_size);
+    for (i = 0; i < STREAM_FILE_READ_AHEAD; ++i)
+      pipeline.slots[i].data =
+        (uint8_t *)allocator->mem_alloc(pipeline.slot_capacity);
+    mutex_setup(&pipeline.mutex);
+    condvar_setup(&pipeline.filled);
+    condvar_setup(&pipeline.drained);
+
+    stream = (binary_stream_t *)allocator->mem_alloc(sizeof(binary_stream_t));
+    binary_stream_def(stream);
+    binary_stream_setup(stream, allocator);
+
+    // without a reader thread the blocks are read one at a time, inline.
+    reader = thread_create(reader_thread, &pipeline);
+
+    while (ok) {
+      read_slot_t *slot;
+
+      if (reader == INVALID_THREAD && !pipeline.done)
+        read_next(&pipeline);
+
+      mutex_lock(&pipeline.mutex);
+      while (pipeline.produced == pipeline.consumed && !pipeline.done)
+        condvar_wait(&pipeline.filled, &pipeline.mutex);
+      if (pipeline.produced == pipeline.consumed) {
+        ok = !pipeline.failed;
+        mutex_unlock(&pipeline.mutex);
+        break;
+      }
+      mutex_unlock(&pipeline.mutex);
+
+      slot = pipeline.slots + pipeline.consumed % STREAM_FILE_READ_AHEAD;
+      ok = decode_slot(codec, slot, stream);
+
+      mutex_lock(&pipeline.mutex);
+      ++pipeline.consumed;
+      pipeline.abort = !ok;
+      condvar_signal(&pipeline.drained);
+      mutex_unlock(&pipeline.mutex);
+    }
+
+    if (reader != INVALID_THREAD)
+      thread_join(reader);
+
+    close_file(pipeline.file);
+    condvar_cleanup(&pipeline.drained);
+    condvar_cleanup(&pipeline.filled);
+    mutex_cleanup(&pipeline.mutex);
+    for (i = 0; i < STREAM_FILE_READ_AHEAD; ++i)
+      allocator->mem_free(pipeline.slots[i].data);
+
+    if (!ok) {
+      binary_stream_cleanup(stream);
+      allocator->mem_free(stream);
+      return NULL;
+    }
+
+    return stream;
+  }
+}
\ No newline at end of file
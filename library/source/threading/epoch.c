@@ -0,0 +1,206 @@
+/**
+ * @file epoch.c
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <assert.h>
+#include <string.h>
+#include <library/allocator/allocator.h>
+#include <library/containers/cvector.h>
+#include <library/threading/atomic.h>
+#include <library/threading/epoch.h>
+#include <library/threading/thread.h>
+
+
+static
+void
+limbo_free(cvector_t *limbo)
+{
+  size_t i, count = cvector_size(limbo);
+  for (i = 0; i < count; ++i) {
+    epoch_retired_t *retired = cvector_as(limbo, i, epoch_retired_t);
+    retired->allocator->mem_free(retired->ptr);
+  }
+  cvector_clear(limbo);
+}
+
+/** moves the global epoch if every pinned record is in the current one. */
+static
+uint64_t
+try_advance(epoch_domain_t *domain)
+{
+  uint64_t global = atomic_load_u64(&domain->global), state;
+  uint32_t i;
+
+  // pairs with the fence in epoch_enter(), a pin is either seen here or sees
+  // the unlinks that came before this scan.
+  atomic_thread_fence();
+  for (i = 0; i < EPOCH_MAX_RECORDS; ++i) {
+    state = atomic_load_u64(&domain->records[i].state);
+    if ((state & 1) && (state >> 1) != global)
+      return global;
+  }
+
+  if (atomic_cas_u64(&domain->global, global, global + 1))
+    return global + 1;
+  return atomic_load_u64(&domain->global);
+}
+
+void
+epoch_domain_setup(epoch_domain_t *domain, const allocator_t *allocator)
+{
+  assert(domain && allocator);
+
+  {
+    uint32_t i, j;
+    memset(domain, 0, sizeof(epoch_domain_t));
+    domain->allocator = allocator;
+    for (i = 0; i < EPOCH_MAX_RECORDS; ++i) {
+      epoch_record_t *record = domain->records + i;
+      record->domain = domain;
+      for (j = 0; j < 3; ++j) {
+        cvector_def(record->limbo + j);
+        cvector_setup(
+          record->limbo + j, get_type_data(epoch_retired_t), 0, allocator);
+      }
+    }
+  }
+}
+
+void
+epoch_domain_cleanup(epoch_domain_t *domain)
+{
+  assert(domain);
+
+  {
+    uint32_t i, j;
+    for (i = 0; i < EPOCH_MAX_RECORDS; ++i) {
+      epoch_record_t *record = domain->records + i;
+      assert(!record->state && "a thread is still pinned!");
+      for (j = 0; j < 3; ++j) {
+        limbo_free(record->limbo + j);
+        cvector_cleanup(record->limbo + j, NULL);
+      }
+    }
+    memset(domain, 0, sizeof(epoch_domain_t));
+  }
+}
+
+epoch_record_t *
+epoch_register(epoch_domain_t *domain)
+{
+  assert(domain);
+
+  {
+    uint32_t i;
+    for (i = 0; i < EPOCH_MAX_RECORDS; ++i) {
+      epoch_record_t *record = domain->records + i;
+      if (
+        !atomic_load_u32(&record->in_use) &&
+        atomic_cas_u32(&record->in_use, 0, 1))
+        return record;
+    }
+
+    assert(0 && "out of epoch records!");
+    return NULL;
+  }
+}
+
+void
+epoch_unregister(epoch_record_t *record)
+{
+  assert(record && !record->nesting);
+  epoch_collect(record);
+  atomic_store_u32(&record->in_use, 0);
+}
+
+void
+epoch_enter(epoch_record_t *record)
+{
+  assert(record);
+
+  if (record->nesting++)
+    return;
+
+  atomic_store_u64(
+    &record->state, (atomic_load_u64(&record->domain->global) << 1) | 1);
+  // the pin must be visible before any shared pointer is loaded.
+  atomic_thread_fence();
+}
+
+void
+epoch_exit(epoch_record_t *record)
+{
+  assert(record && record->nesting);
+
+  if (--record->nesting)
+    return;
+
+  atomic_store_u64(&record->state, 0);
+}
+
+void
+epoch_retire(
+  epoch_record_t *record,
+  void *ptr,
+  const allocator_t *allocator)
+{
+  assert(record && allocator);
+
+  if (!ptr)
+    return;
+
+  {
+    uint64_t global = atomic_load_u64(&record->domain->global);
+    uint32_t bucket = (uint32_t)(global % 3);
+    epoch_retired_t retired;
+
+    // the bucket still holds an epoch at least 3 behind, long safe to free.
+    if (record->limbo_epoch[bucket] != global) {
+      limbo_free(record->limbo + bucket);
+      record->limbo_epoch[bucket] = global;
+    }
+
+    retired.ptr = ptr;
+    retired.allocator = allocator;
+    cvector_push_back(record->limbo + bucket, retired, epoch_retired_t);
+
+    if (++record->retired >= EPOCH_COLLECT_EVERY)
+      epoch_collect(record);
+  }
+}
+
+size_t
+epoch_collect(epoch_record_t *record)
+{
+  assert(record);
+
+  {
+    uint64_t global = try_advance(record->domain);
+    size_t pending = 0;
+    uint32_t i;
+
+    record->retired = 0;
+    for (i = 0; i < 3; ++i) {
+      cvector_t *limbo = record->limbo + i;
+      if (record->limbo_epoch[i] + 2 <= global)
+        limbo_free(limbo);
+      pending += cvector_size(limbo);
+    }
+    return pending;
+  }
+}
+
+void
+epoch_barrier(epoch_record_t *record)
+{
+  assert(record && !record->nesting);
+
+  while (epoch_collect(record))
+    thread_yield();
+}
\ No newline at end of file
@@ -0,0 +1,494 @@
+/**
+ * @file job.c
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <assert.h>
+#include <string.h>
+#include <library/allocator/allocator.h>
+#include <library/threading/atomic.h>
+#include <library/threading/job.h>
+
+#if defined(_MSC_VER)
+#define JOB_THREAD_LOCAL __declspec(thread)
+#else
+#define JOB_THREAD_LOCAL __thread
+#endif
+
+#define JOB_QUEUE_MASK                (JOB_QUEUE_CAPACITY - 1)
+#define JOB_CACHE_LINE                64
+#define JOB_SPIN_COUNT                64
+#define JOB_SCRATCH_ALIGN             16
+
+
+// top and bottom sit on their own cache lines, thieves only touch top.
+struct job_worker_t {
+  volatile uint64_t top;
+  uint8_t pad0[JOB_CACHE_LINE - sizeof(uint64_t)];
+  volatile uint64_t bottom;
+  uint8_t pad1[JOB_CACHE_LINE - sizeof(uint64_t)];
+  job_t *volatile queue[JOB_QUEUE_CAPACITY];
+  job_t *pool;
+  uint32_t pool_next;
+  uint32_t index;
+  uint32_t seed;
+  uint8_t *scratch;
+  size_t scratch_top;
+  job_system_t *system;
+};
+
+typedef
+struct job_range_t {
+  uint32_t begin;
+  uint32_t end;
+  uint32_t grain;
+  job_range_fn_t fn;
+  void *user_data;
+  job_system_t *system;
+  job_t *root;
+} job_range_t;
+
+typedef char job_range_check_t[
+  sizeof(job_range_t) <= JOB_PAYLOAD_SIZE ? 1 : -1];
+
+static JOB_THREAD_LOCAL job_worker_t *s_worker;
+
+
+////////////////////////////////////////////////////////////////////////////////
+static
+void
+deque_push(job_worker_t *worker, job_t *job)
+{
+  uint64_t bottom = atomic_load_u64(&worker->bottom);
+  assert(
+    bottom - atomic_load_u64(&worker->top) < JOB_QUEUE_CAPACITY &&
+    "job queue overflow!");
+  atomic_store_ptr(
+    (void *volatile *)&worker->queue[bottom & JOB_QUEUE_MASK], job);
+  atomic_store_u64(&worker->bottom, bottom + 1);
+}
+
+static
+job_t *
+deque_pop(job_worker_t *worker)
+{
+  uint64_t bottom = atomic_load_u64(&worker->bottom) - 1;
+  uint64_t top;
+  job_t *job;
+
+  // reserve the bottom slot before looking at top, thieves see it as taken.
+  atomic_store_u64(&worker->bottom, bottom);
+  atomic_thread_fence();
+  top = atomic_load_u64(&worker->top);
+
+  if ((int64_t)top > (int64_t)bottom) {
+    atomic_store_u64(&worker->bottom, top);
+    return NULL;
+  }
+
+  job = (job_t *)atomic_load_ptr(
+    (void *const volatile *)&worker->queue[bottom & JOB_QUEUE_MASK]);
+  if (top != bottom)
+    return job;
+
+  // last job left, race the thieves for it.
+  if (!atomic_cas_u64(&worker->top, top, top + 1))
+    job = NULL;
+  atomic_store_u64(&worker->bottom, top + 1);
+  return job;
+}
+
+static
+job_t *
+deque_steal(job_worker_t *worker)
+{
+  uint64_t top = atomic_load_u64(&worker->top);
+  uint64_t bottom;
+  job_t *job;
+
+  atomic_thread_fence();
+  bottom = atomic_load_u64(&worker->bottom);
+  if ((int64_t)top >= (int64_t)bottom)
+    return NULL;
+
+  job = (job_t *)atomic_load_ptr(
+    (void *const volatile *)&worker->queue[top & JOB_QUEUE_MASK]);
+  return atomic_cas_u64(&worker->top, top, top + 1) ? job : NULL;
+}
+
+static
+job_t *
+get_job(job_worker_t *worker)
+{
+  job_system_t *system = worker->system;
+  job_t *job = deque_pop(worker);
+  uint32_t i, start;
+
+  if (job || system->worker_count == 1)
+    return job;
+
+  // xorshift, picks where the round of steals starts.
+  worker->seed ^= worker->seed << 13;
+  worker->seed ^= worker->seed >> 17;
+  worker->seed ^= worker->seed << 5;
+  start = worker->seed % system->worker_count;
+
+  for (i = 0; i < system->worker_count; ++i) {
+    job_worker_t *victim =
+      system->workers + (start + i) % system->worker_count;
+    if (victim != worker && (job = deque_steal(victim)) != NULL)
+      return job;
+  }
+
+  return NULL;
+}
+
+static
+void
+job_finish(job_t *job)
+{
+  // the slot can be recycled as soon as the count drops, read parent first.
+  job_t *parent = job->parent;
+  if (atomic_fetch_add_u32(&job->unfinished, (uint32_t)-1) == 1 && parent)
+    job_finish(parent);
+}
+
+static
+void
+job_execute(job_worker_t *worker, job_t *job)
+{
+  size_t mark = worker->scratch_top;
+  job->fn(job, job->data);
+  worker->scratch_top = mark;
+  job_finish(job);
+}
+
+static
+void
+worker_main(void *arg)
+{
+  job_worker_t *worker = (job_worker_t *)arg;
+  job_system_t *system = worker->system;
+  s_worker = worker;
+
+  while (!atomic_load_u32(&system->stop)) {
+    uint32_t epoch = atomic_load_u32(&system->epoch);
+    uint32_t spin;
+    job_t *job = NULL;
+
+    for (spin = 0; spin < JOB_SPIN_COUNT && !job; ++spin) {
+      if (!(job = get_job(worker)))
+        atomic_cpu_relax();
+    }
+
+    if (job) {
+      job_execute(worker, job);
+      continue;
+    }
+
+    // nothing was pushed since 'epoch' was read, sleep until something is.
+    mutex_lock(&system->mutex);
+    atomic_fetch_add_u32(&system->sleeping, 1);
+    atomic_thread_fence();
+    while (
+      !atomic_load_u32(&system->stop) &&
+      atomic_load_u32(&system->epoch) == epoch)
+      condvar_wait(&system->wake, &system->mutex);
+    atomic_fetch_add_u32(&system->sleeping, (uint32_t)-1);
+    mutex_unlock(&system->mutex);
+  }
+
+  s_worker = NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void
+job_system_setup(
+  job_system_t *system,
+  uint32_t worker_count,
+  const allocator_t *allocator)
+{
+  assert(system && allocator);
+  assert(!s_worker && "the calling thread already belongs to a job system!");
+
+  {
+    uint32_t i;
+    worker_count = worker_count ? worker_count : thread_hardware_concurrency();
+    worker_count =
+      worker_count > JOB_MAX_WORKERS ? JOB_MAX_WORKERS : worker_count;
+
+    memset(system, 0, sizeof(job_system_t));
+    mutex_setup(&system->mutex);
+    condvar_setup(&system->wake);
+    system->allocator = allocator;
+    system->workers = (job_worker_t *)allocator->mem_alloc(
+      sizeof(job_worker_t) * worker_count);
+    memset(system->workers, 0, sizeof(job_worker_t) * worker_count);
+
+    for (i = 0; i < worker_count; ++i) {
+      job_worker_t *worker = system->workers + i;
+      worker->pool = (job_t *)allocator->mem_alloc(
+        sizeof(job_t) * JOB_QUEUE_CAPACITY);
+      memset(worker->pool, 0, sizeof(job_t) * JOB_QUEUE_CAPACITY);
+      worker->scratch = (uint8_t *)allocator->mem_alloc(JOB_SCRATCH_SIZE);
+      worker->index = i;
+      worker->seed = 0x9e3779b9u * (i + 1);
+      worker->system = system;
+    }
+
+    // a worker whose thread failed to start keeps an empty deque, nothing is
+    // ever pushed to it and the others skip it when stealing.
+    system->worker_count = worker_count;
+    s_worker = system->workers;
+    for (i = 1; i < worker_count; ++i)
+      system->threads[i] = thread_create(worker_main, system->workers + i);
+  }
+}
+
+void
+job_system_cleanup(job_system_t *system)
+{
+  assert(system && s_worker == system->workers);
+
+  {
+    uint32_t i;
+
+    mutex_lock(&system->mutex);
+    atomic_store_u32(&system->stop, 1);
+    condvar_broadcast(&system->wake);
+    mutex_unlock(&system->mutex);
+    for (i = 1; i < system->worker_count; ++i) {
+      if (system->threads[i] != INVALID_THREAD)
+        thread_join(system->threads[i]);
+    }
+
+    for (i = 0; i < system->worker_count; ++i) {
+      system->allocator->mem_free(system->workers[i].scratch);
+      system->allocator->mem_free(system->workers[i].pool);
+    }
+    system->allocator->mem_free(system->workers);
+    condvar_cleanup(&system->wake);
+    mutex_cleanup(&system->mutex);
+    s_worker = NULL;
+  }
+}
+
+job_t *
+job_create(
+  job_system_t *system,
+  job_fn_t fn,
+  const void *data,
+  size_t size,
+  job_t *parent)
+{
+  job_worker_t *worker = s_worker;
+  assert(system && worker && worker->system == system);
+  assert(size <= JOB_PAYLOAD_SIZE);
+
+  {
+    // long lived jobs (parents) are stepped over, not waited on.
+    job_t *job = NULL;
+    uint32_t i;
+    for (i = 0; i < JOB_QUEUE_CAPACITY; ++i) {
+      job = worker->pool + (worker->pool_next++ & JOB_QUEUE_MASK);
+      if (job_is_finished(job))
+        break;
+    }
+    assert(i < JOB_QUEUE_CAPACITY && "too many jobs alive on this worker!");
+
+    job->fn = fn;
+    job->parent = parent;
+    job->unfinished = 1;
+    if (size) {
+      memcpy(job->payload.bytes, data, size);
+      job->data = job->payload.bytes;
+    } else
+      job->data = (void *)data;
+
+    if (parent)
+      atomic_fetch_add_u32(&parent->unfinished, 1);
+    return job;
+  }
+}
+
+void
+job_run(job_system_t *system, job_t *job)
+{
+  job_worker_t *worker = s_worker;
+  assert(system && job && job->fn && worker && worker->system == system);
+
+  deque_push(worker, job);
+
+  // pairs with the fence in worker_main, either the sleeper sees the new
+  // epoch or the pusher sees the sleeper.
+  atomic_fetch_add_u32(&system->epoch, 1);
+  atomic_thread_fence();
+  if (atomic_load_u32(&system->sleeping)) {
+    mutex_lock(&system->mutex);
+    condvar_signal(&system->wake);
+    mutex_unlock(&system->mutex);
+  }
+}
+
+void
+job_wait(job_system_t *system, job_t *job)
+{
+  job_worker_t *worker = s_worker;
+  assert(system && job && worker && worker->system == system);
+
+  while (!job_is_finished(job)) {
+    job_t *next = get_job(worker);
+    if (next)
+      job_execute(worker, next);
+    else
+      atomic_cpu_relax();
+  }
+}
+
+uint32_t
+job_is_finished(const job_t *job)
+{
+  assert(job);
+  return atomic_load_u32(&job->unfinished) == 0;
+}
+
+static
+void
+range_job(job_t *job, void *data)
+{
+  job_range_t range = *(job_range_t *)data;
+  (void)job;
+
+  // the upper halves are handed out, the lower one is kept and split again.
+  while (range.end - range.begin > range.grain) {
+    job_range_t half = range;
+    half.begin = range.begin + (range.end - range.begin) / 2;
+    range.end = half.begin;
+    job_run(
+      range.system,
+      job_create(range.system, range_job, &half, sizeof(job_range_t),
+      range.root));
+  }
+
+  range.fn(range.begin, range.end, range.user_data);
+}
+
+void
+job_parallel_for(
+  job_system_t *system,
+  uint32_t count,
+  uint32_t grain,
+  job_range_fn_t fn,
+  void *user_data)
+{
+  assert(system && fn);
+
+  if (count) {
+    // the root only counts the ranges, it is never queued.
+    job_t *root = job_create(system, NULL, NULL, 0, NULL);
+    job_range_t range;
+    range.begin = 0;
+    range.end = count;
+    range.grain = grain ? grain : 1;
+    range.fn = fn;
+    range.user_data = user_data;
+    range.system = system;
+    range.root = root;
+    job_run(
+      system, job_create(system, range_job, &range, sizeof(job_range_t), root));
+    job_finish(root);
+    job_wait(system, root);
+  }
+}
+
+uint32_t
+job_worker_index(void)
+{
+  return s_worker ? s_worker->index : (uint32_t)-1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// the size of every block sits right before it, realloc needs it.
+
+static
+void *
+scratch_alloc(size_t size)
+{
+  job_worker_t *worker = s_worker;
+  assert(worker && "scratch allocations are only valid on a worker!");
+
+  {
+    size_t top =
+      (worker->scratch_top + JOB_SCRATCH_ALIGN - 1) &
+      ~(size_t)(JOB_SCRATCH_ALIGN - 1);
+    uint8_t *ptr = worker->scratch + top + JOB_SCRATCH_ALIGN;
+    if (top + JOB_SCRATCH_ALIGN + size > JOB_SCRATCH_SIZE) {
+      assert(0 && "scratch arena exhausted!");
+      return NULL;
+    }
+
+    ((size_t *)ptr)[-1] = size;
+    worker->scratch_top = top + JOB_SCRATCH_ALIGN + size;
+    return ptr;
+  }
+}
+
+static
+void
+scratch_free(void *ptr)
+{
+  (void)ptr;
+}
+
+static
+void *
+scratch_realloc(void *ptr, size_t new_size)
+{
+  void *block = scratch_alloc(new_size);
+  if (ptr && block) {
+    size_t size = ((size_t *)ptr)[-1];
+    memcpy(block, ptr, size < new_size ? size : new_size);
+  }
+  return block;
+}
+
+static
+void *
+scratch_cont_alloc(size_t num, size_t size)
+{
+  void *block = scratch_alloc(num * size);
+  if (block)
+    memset(block, 0, num * size);
+  return block;
+}
+
+static
+void *
+scratch_aligned_alloc(size_t alignment, size_t size)
+{
+  uint8_t *block = (uint8_t *)scratch_alloc(size + alignment);
+  if (block) {
+    block = (uint8_t *)(
+      ((uintptr_t)block + alignment - 1) & ~(uintptr_t)(alignment - 1));
+    ((size_t *)block)[-1] = size;
+  }
+  return block;
+}
+
+static const allocator_t s_scratch_allocator = {
+  scratch_alloc,
+  scratch_free,
+  scratch_realloc,
+  scratch_cont_alloc,
+  scratch_aligned_alloc };
+
+const allocator_t *
+job_scratch_allocator(void)
+{
+  return &s_scratch_allocator;
+}
\ No newline at end of file
@@ -0,0 +1,245 @@
+/**
+ * @file mutex.c
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <assert.h>
+#if defined(WIN32) || defined(WIN64)
+#include <windows.h>
+typedef SRWLOCK native_mutex_t;
+typedef CONDITION_VARIABLE native_condvar_t;
+typedef SRWLOCK native_rwlock_t;
+#else
+#include <pthread.h>
+typedef pthread_mutex_t native_mutex_t;
+typedef pthread_cond_t native_condvar_t;
+typedef pthread_rwlock_t native_rwlock_t;
+#endif
+#include <library/threading/mutex.h>
+
+// a negative array size fails the build if the storage is too small.
+typedef char mutex_storage_check_t[
+  sizeof(native_mutex_t) <= sizeof(((mutex_t *)0)->storage) ? 1 : -1];
+typedef char condvar_storage_check_t[
+  sizeof(native_condvar_t) <= sizeof(((condvar_t *)0)->storage) ? 1 : -1];
+typedef char rwlock_storage_check_t[
+  sizeof(native_rwlock_t) <= sizeof(((rwlock_t *)0)->storage) ? 1 : -1];
+
+#define NATIVE_MUTEX(mutex) ((native_mutex_t *)(mutex)->storage.bytes)
+#define NATIVE_CONDVAR(condvar) ((native_condvar_t *)(condvar)->storage.bytes)
+#define NATIVE_RWLOCK(rwlock) ((native_rwlock_t *)(rwlock)->storage.bytes)
+
+
+#if defined(WIN32) || defined(WIN64)
+
+void
+mutex_setup(mutex_t *mutex)
+{
+  assert(mutex);
+  InitializeSRWLock(NATIVE_MUTEX(mutex));
+}
+
+void
+mutex_cleanup(mutex_t *mutex)
+{
+  // srw locks hold no resources.
+  assert(mutex);
+}
+
+void
+mutex_lock(mutex_t *mutex)
+{
+  AcquireSRWLockExclusive(NATIVE_MUTEX(mutex));
+}
+
+uint32_t
+mutex_trylock(mutex_t *mutex)
+{
+  return TryAcquireSRWLockExclusive(NATIVE_MUTEX(mutex)) ? 1 : 0;
+}
+
+void
+mutex_unlock(mutex_t *mutex)
+{
+  ReleaseSRWLockExclusive(NATIVE_MUTEX(mutex));
+}
+
+void
+condvar_setup(condvar_t *condvar)
+{
+  assert(condvar);
+  InitializeConditionVariable(NATIVE_CONDVAR(condvar));
+}
+
+void
+condvar_cleanup(condvar_t *condvar)
+{
+  assert(condvar);
+}
+
+void
+condvar_wait(condvar_t *condvar, mutex_t *mutex)
+{
+  SleepConditionVariableSRW(
+    NATIVE_CONDVAR(condvar), NATIVE_MUTEX(mutex), INFINITE, 0);
+}
+
+void
+condvar_signal(condvar_t *condvar)
+{
+  WakeConditionVariable(NATIVE_CONDVAR(condvar));
+}
+
+void
+condvar_broadcast(condvar_t *condvar)
+{
+  WakeAllConditionVariable(NATIVE_CONDVAR(condvar));
+}
+
+void
+rwlock_setup(rwlock_t *rwlock)
+{
+  assert(rwlock);
+  InitializeSRWLock(NATIVE_RWLOCK(rwlock));
+}
+
+void
+rwlock_cleanup(rwlock_t *rwlock)
+{
+  assert(rwlock);
+}
+
+void
+rwlock_read_lock(rwlock_t *rwlock)
+{
+  AcquireSRWLockShared(NATIVE_RWLOCK(rwlock));
+}
+
+void
+rwlock_read_unlock(rwlock_t *rwlock)
+{
+  ReleaseSRWLockShared(NATIVE_RWLOCK(rwlock));
+}
+
+void
+rwlock_write_lock(rwlock_t *rwlock)
+{
+  AcquireSRWLockExclusive(NATIVE_RWLOCK(rwlock));
+}
+
+void
+rwlock_write_unlock(rwlock_t *rwlock)
+{
+  ReleaseSRWLockExclusive(NATIVE_RWLOCK(rwlock));
+}
+
+#else
+
+void
+mutex_setup(mutex_t *mutex)
+{
+  assert(mutex);
+  pthread_mutex_init(NATIVE_MUTEX(mutex), NULL);
+}
+
+void
+mutex_cleanup(mutex_t *mutex)
+{
+  assert(mutex);
+  pthread_mutex_destroy(NATIVE_MUTEX(mutex));
+}
+
+void
+mutex_lock(mutex_t *mutex)
+{
+  pthread_mutex_lock(NATIVE_MUTEX(mutex));
+}
+
+uint32_t
+mutex_trylock(mutex_t *mutex)
+{
+  return pthread_mutex_trylock(NATIVE_MUTEX(mutex)) == 0;
+}
+
+void
+mutex_unlock(mutex_t *mutex)
+{
+  pthread_mutex_unlock(NATIVE_MUTEX(mutex));
+}
+
+void
+condvar_setup(condvar_t *condvar)
+{
+  assert(condvar);
+  pthread_cond_init(NATIVE_CONDVAR(condvar), NULL);
+}
+
+void
+condvar_cleanup(condvar_t *condvar)
+{
+  assert(condvar);
+  pthread_cond_destroy(NATIVE_CONDVAR(condvar));
+}
+
+void
+condvar_wait(condvar_t *condvar, mutex_t *mutex)
+{
+  pthread_cond_wait(NATIVE_CONDVAR(condvar), NATIVE_MUTEX(mutex));
+}
+
+void
+condvar_signal(condvar_t *condvar)
+{
+  pthread_cond_signal(NATIVE_CONDVAR(condvar));
+}
+
+void
+condvar_broadcast(condvar_t *condvar)
+{
+  pthread_cond_broadcast(NATIVE_CONDVAR(condvar));
+}
+
+void
+rwlock_setup(rwlock_t *rwlock)
+{
+  assert(rwlock);
+  pthread_rwlock_init(NATIVE_RWLOCK(rwlock), NULL);
+}
+
+void
+rwlock_cleanup(rwlock_t *rwlock)
+{
+  assert(rwlock);
+  pthread_rwlock_destroy(NATIVE_RWLOCK(rwlock));
+}
+
+void
+rwlock_read_lock(rwlock_t *rwlock)
+{
+  pthread_rwlock_rdlock(NATIVE_RWLOCK(rwlock));
+}
+
+void
+rwlock_read_unlock(rwlock_t *rwlock)
+{
+  pthread_rwlock_unlock(NATIVE_RWLOCK(rwlock));
+}
+
+void
+rwlock_write_lock(rwlock_t *rwlock)
+{
+  pthread_rwlock_wrlock(NATIVE_RWLOCK(rwlock));
+}
+
+void
+rwlock_write_unlock(rwlock_t *rwlock)
+{
+  pthread_rwlock_unlock(NATIVE_RWLOCK(rwlock));
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,139 @@
+/**
+ * @file thread.c
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <assert.h>
+#if defined(WIN32) || defined(WIN64)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+#include <library/allocator/allocator.h>
+#include <library/threading/thread.h>
+
+
+typedef
+struct thread_start_t {
+  thread_fn_t fn;
+  void *arg;
+} thread_start_t;
+
+#if defined(WIN32) || defined(WIN64)
+
+static
+DWORD WINAPI
+thread_entry(LPVOID param)
+{
+  thread_start_t start = *(thread_start_t *)param;
+  g_default_allocator.mem_free(param);
+  start.fn(start.arg);
+  return 0;
+}
+
+thread_handle_t
+thread_create(thread_fn_t fn, void *arg)
+{
+  assert(fn);
+
+  {
+    HANDLE handle;
+    thread_start_t *start =
+      (thread_start_t *)g_default_allocator.mem_alloc(sizeof(thread_start_t));
+    start->fn = fn;
+    start->arg = arg;
+
+    handle = CreateThread(NULL, 0, thread_entry, start, 0, NULL);
+    if (!handle) {
+      g_default_allocator.mem_free(start);
+      return INVALID_THREAD;
+    }
+
+    return (thread_handle_t)handle;
+  }
+}
+
+void
+thread_join(thread_handle_t thread)
+{
+  assert(thread != INVALID_THREAD);
+  WaitForSingleObject((HANDLE)thread, INFINITE);
+  CloseHandle((HANDLE)thread);
+}
+
+void
+thread_yield(void)
+{
+  SwitchToThread();
+}
+
+uint32_t
+thread_hardware_concurrency(void)
+{
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwNumberOfProcessors ? (uint32_t)info.dwNumberOfProcessors : 1;
+}
+
+#else
+
+static
+void *
+thread_entry(void *param)
+{
+  thread_start_t start = *(thread_start_t *)param;
+  g_default_allocator.mem_free(param);
+  start.fn(start.arg);
+  return NULL;
+}
+
+thread_handle_t
+thread_create(thread_fn_t fn, void *arg)
+{
+  assert(fn);
+  assert(sizeof(pthread_t) <= sizeof(thread_handle_t));
+
+  {
+    pthread_t handle;
+    thread_start_t *start =
+      (thread_start_t *)g_default_allocator.mem_alloc(sizeof(thread_start_t));
+    start->fn = fn;
+    start->arg = arg;
+
+    if (pthread_create(&handle, NULL, thread_entry, start)) {
+      g_default_allocator.mem_free(start);
+      return INVALID_THREAD;
+    }
+
+    return (thread_handle_t)handle;
+  }
+}
+
+void
+thread_join(thread_handle_t thread)
+{
+  assert(thread != INVALID_THREAD);
+  pthread_join((pthread_t)thread, NULL);
+}
+
+void
+thread_yield(void)
+{
+  sched_yield();
+}
+
+uint32_t
+thread_hardware_concurrency(void)
+{
+  long count = sysconf(_SC_NPROCESSORS_ONLN);
+  return count > 0 ? (uint32_t)count : 1;
+}
+
+#endif
\ No newline at end of file
@@ -10,6 +10,9 @@
  */
 #include <library/containers/chashmap.h>
 #include <library/containers/clist.h>
+#include <library/containers/cqueue.h>
+#include <library/containers/cring.h>
+#include <library/containers/cshardmap.h>
 #include <library/containers/cvector.h>
 #include <library/core/core.h>
 #include <library/string/cstring.h>
@@ -82,6 +85,51 @@ INITIALIZER(register_chashmap_t)
   register_type(get_type_id(chashmap_t), &vtable);
 }
 
+INITIALIZER(register_cqueue_t)
+{
+  vtable_t vtable;
+  memset(&vtable, 0, sizeof(vtable_t));
+  vtable.fn_def = cqueue_def;
+  vtable.fn_is_def = cqueue_is_def;
+  vtable.fn_type_size = cqueue_type_size;
+  vtable.fn_type_id_count = cqueue_type_id_count;
+  vtable.fn_type_ids = cqueue_type_ids;
+  vtable.fn_owns_alloc = cqueue_owns_alloc;
+  vtable.fn_get_alloc = cqueue_get_alloc;
+  vtable.fn_cleanup = cqueue_cleanup;
+  register_type(get_type_id(cqueue_t), &vtable);
+}
+
+INITIALIZER(register_cring_t)
+{
+  vtable_t vtable;
+  memset(&vtable, 0, sizeof(vtable_t));
+  vtable.fn_def = cring_def;
+  vtable.fn_is_def = cring_is_def;
+  vtable.fn_type_size = cring_type_size;
+  vtable.fn_type_id_count = cring_type_id_count;
+  vtable.fn_type_ids = cring_type_ids;
+  vtable.fn_owns_alloc = cring_owns_alloc;
+  vtable.fn_get_alloc = cring_get_alloc;
+  vtable.fn_cleanup = cring_cleanup;
+  register_type(get_type_id(cring_t), &vtable);
+}
+
+INITIALIZER(register_cshardmap_t)
+{
+  vtable_t vtable;
+  memset(&vtable, 0, sizeof(vtable_t));
+  vtable.fn_def = cshardmap_def;
+  vtable.fn_is_def = cshardmap_is_def;
+  vtable.fn_type_size = cshardmap_type_size;
+  vtable.fn_type_id_count = cshardmap_type_id_count;
+  vtable.fn_type_ids = cshardmap_type_ids;
+  vtable.fn_owns_alloc = cshardmap_owns_alloc;
+  vtable.fn_get_alloc = cshardmap_get_alloc;
+  vtable.fn_cleanup = cshardmap_cleanup;
+  register_type(get_type_id(cshardmap_t), &vtable);
+}
+
 INITIALIZER(register_cstring_t)
 {
   vtable_t vtable;
@@ -94,6 +142,7 @@ INITIALIZER(register_cstring_t)
   vtable.fn_deserialize = cstring_deserialize;
   vtable.fn_hash = cstring_hash;
   vtable.fn_is_equal = cstring_is_equal;
+  vtable.fn_compare = cstring_compare;
   vtable.fn_type_size = cstring_type_size;
   vtable.fn_type_alignment = NULL;
   vtable.fn_type_id_count = NULL;
@@ -110,6 +159,28 @@ type_equal_1b(const void* key1, const void* key2)
   return *(uint8_t *)(key1) == *(uint8_t *)(key2);
 }
 
+int32_t
+type_compare_1bu(const void* key1, const void* key2)
+{
+  uint8_t lhs = *(const uint8_t *)key1, rhs = *(const uint8_t *)key2;
+  return (lhs > rhs) - (lhs < rhs);
+}
+
+int32_t
+type_compare_1bs(const void* key1, const void* key2)
+{
+  int8_t lhs = *(const int8_t *)key1, rhs = *(const int8_t *)key2;
+  return (lhs > rhs) - (lhs < rhs);
+}
+
+// plain char is signed or not depending on the compiler.
+int32_t
+type_compare_char(const void* key1, const void* key2)
+{
+  char lhs = *(const char *)key1, rhs = *(const char *)key2;
+  return (lhs > rhs) - (lhs < rhs);
+}
+
 size_t type_size_1b(void) { return 1; }
 uint32_t
 hash_1bytes(const void *_ptr)
@@ -127,6 +198,20 @@ type_equal_2b(const void* key1, const void* key2)
   return *(uint16_t *)(key1) == *(uint16_t *)(key2);
 }
 
+int32_t
+type_compare_2bu(const void* key1, const void* key2)
+{
+  uint16_t lhs = *(const uint16_t *)key1, rhs = *(const uint16_t *)key2;
+  return (lhs > rhs) - (lhs < rhs);
+}
+
+int32_t
+type_compare_2bs(const void* key1, const void* key2)
+{
+  int16_t lhs = *(const int16_t *)key1, rhs = *(const int16_t *)key2;
+  return (lhs > rhs) - (lhs < rhs);
+}
+
 size_t type_size_2b(void) { return 2; }
 uint32_t
 hash_2bytes(const void *_ptr)
@@ -150,6 +235,33 @@ type_equal_4bf(const void* key1, const void* key2)
   return *(float *)(key1) == *(float *)(key2);
 }
 
+int32_t
+type_compare_4bu(const void* key1, const void* key2)
+{
+  uint32_t lhs = *(const uint32_t *)key1, rhs = *(const uint32_t *)key2;
+  return (lhs > rhs) - (lhs < rhs);
+}
+
+int32_t
+type_compare_4bs(const void* key1, const void* key2)
+{
+  int32_t lhs = *(const int32_t *)key1, rhs = *(const int32_t *)key2;
+  return (lhs > rhs) - (lhs < rhs);
+}
+
+// total order on the bit patterns: -0 before +0, NaNs at both ends. this is
+// the order the radix sort in cvector_algorithm.c produces.
+int32_t
+type_compare_4bf(const void* key1, const void* key2)
+{
+  uint32_t lhs, rhs;
+  memcpy(&lhs, key1, sizeof(uint32_t));
+  memcpy(&rhs, key2, sizeof(uint32_t));
+  lhs = (lhs & 0x80000000u) ? ~lhs : (lhs | 0x80000000u);
+  rhs = (rhs & 0x80000000u) ? ~rhs : (rhs | 0x80000000u);
+  return (lhs > rhs) - (lhs < rhs);
+}
+
 size_t type_size_4b(void) { return 4; }
 uint32_t
 hash_4bytes(const void *_ptr)
@@ -173,6 +285,31 @@ type_equal_8bf(const void* key1, const void* key2)
   return *(double *)(key1) == *(double *)(key2);
 }
 
+int32_t
+type_compare_8bu(const void* key1, const void* key2)
+{
+  uint64_t lhs = *(const uint64_t *)key1, rhs = *(const uint64_t *)key2;
+  return (lhs > rhs) - (lhs < rhs);
+}
+
+int32_t
+type_compare_8bs(const void* key1, const void* key2)
+{
+  int64_t lhs = *(const int64_t *)key1, rhs = *(const int64_t *)key2;
+  return (lhs > rhs) - (lhs < rhs);
+}
+
+int32_t
+type_compare_8bf(const void* key1, const void* key2)
+{
+  uint64_t lhs, rhs, sign = (uint64_t)1 << 63;
+  memcpy(&lhs, key1, sizeof(uint64_t));
+  memcpy(&rhs, key2, sizeof(uint64_t));
+  lhs = (lhs & sign) ? ~lhs : (lhs | sign);
+  rhs = (rhs & sign) ? ~rhs : (rhs | sign);
+  return (lhs > rhs) - (lhs < rhs);
+}
+
 size_t type_size_8b(void) { return 8; }
 uint32_t
 hash_8bytes(const void *_ptr)
@@ -191,40 +328,51 @@ INITIALIZER(register_default_types_t)
   vtable.fn_hash = hash_1bytes;
   vtable.fn_type_size = type_size_1b;
   vtable.fn_is_equal = type_equal_1b;
+  vtable.fn_compare = type_compare_1bu;
   register_type(get_type_id(uint8_t), &vtable);
+  register_type(get_type_id(unsigned char), &vtable);
+  vtable.fn_compare = type_compare_1bs;
   register_type(get_type_id(int8_t), &vtable);
+  vtable.fn_compare = type_compare_char;
   register_type(get_type_id(char), &vtable);
-  register_type(get_type_id(unsigned char), &vtable);
 
   vtable.fn_hash = hash_2bytes;
   vtable.fn_type_size = type_size_2b;
   vtable.fn_is_equal = type_equal_2b;
+  vtable.fn_compare = type_compare_2bu;
   register_type(get_type_id(uint16_t), &vtable);
+  register_type(get_type_id(unsigned short), &vtable);
+  vtable.fn_compare = type_compare_2bs;
   register_type(get_type_id(int16_t), &vtable);
   register_type(get_type_id(short), &vtable);
-  register_type(get_type_id(unsigned short), &vtable);
 
   vtable.fn_hash = hash_4bytes;
   vtable.fn_type_size = type_size_4b;
   vtable.fn_is_equal = type_equal_4b;
+  vtable.fn_compare = type_compare_4bu;
   register_type(get_type_id(uint32_t), &vtable);
+  register_type(get_type_id(unsigned int), &vtable);
+  vtable.fn_compare = type_compare_4bs;
   register_type(get_type_id(int32_t), &vtable);
   register_type(get_type_id(int), &vtable);
-  register_type(get_type_id(unsigned int), &vtable);
 
   // floats can have the same value but different underlying bit patterns.
   vtable.fn_is_equal = type_equal_4bf;
+  vtable.fn_compare = type_compare_4bf;
   register_type(get_type_id(float), &vtable);
 
   vtable.fn_hash = hash_8bytes;
   vtable.fn_type_size = type_size_8b;
   vtable.fn_is_equal = type_equal_8b;
+  vtable.fn_compare = type_compare_8bu;
   register_type(get_type_id(uint64_t), &vtable);
-  register_type(get_type_id(int64_t), &vtable);
   register_type(get_type_id(size_t), &vtable);
-  register_type(get_type_id(long long), &vtable);
   register_type(get_type_id(unsigned long long), &vtable);
+  vtable.fn_compare = type_compare_8bs;
+  register_type(get_type_id(int64_t), &vtable);
+  register_type(get_type_id(long long), &vtable);
 
   vtable.fn_is_equal = type_equal_8bf;
+  vtable.fn_compare = type_compare_8bf;
   register_type(get_type_id(double), &vtable);
 }
\ No newline at end of file
@@ -33,6 +33,7 @@ uint32_t total_registered;
 static
 uint32_t total_aliases;
 
+static
 inline
 uint32_t
 get_shifted_key(const type_id_t type)
@@ -40,6 +41,7 @@ get_shifted_key(const type_id_t type)
   return type & ((1 << 11) - 1);
 }
 
+static
 inline
 uint32_t
 increment(const uint32_t key)
@@ -48,6 +50,7 @@ increment(const uint32_t key)
 }
 
 // returns the position of the type or a potential insertion point.
+static
 inline
 uint32_t
 get_key(const type_id_t type)
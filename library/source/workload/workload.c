@@ -0,0 +1,653 @@
+/**
+ * @file workload.c
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <assert.h>
+#include <math.h>
+#include <string.h>
+#include <library/allocator/allocator.h>
+#include <library/containers/chashmap.h>
+#include <library/containers/clist.h>
+#include <library/containers/cvector.h>
+#include <library/filesystem/io.h>
+#include <library/hash/fnv.h>
+#include <library/streams/binary_stream.h>
+#include <library/workload/workload.h>
+
+// the bytes of the collision keys that are not solved for, a counter.
+#define COLLISION_PREFIX_MASK         0xffffffffffffull
+
+
+static
+uint64_t
+splitmix64(uint64_t *state)
+{
+  uint64_t z = (*state += 0x9e3779b97f4a7c15ull);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+/** splitmix64's finalizer, a bijection, distinct ranks give distinct keys. */
+static
+uint64_t
+scramble(uint64_t rank, uint64_t seed)
+{
+  uint64_t z = rank ^ seed;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+static
+double
+random_unit(uint64_t *state)
+{
+  return (double)(splitmix64(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// rejection-inversion zipf sampling, Hormann and Derflinger, "rejection-
+// inversion to generate variates from monotone discrete distributions".
+// the helpers keep log1p(x)/x and expm1(x)/x accurate as x nears 0.
+
+static
+double
+helper1(double x)
+{
+  return fabs(x) > 1e-8 ?
+    log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+}
+
+static
+double
+helper2(double x)
+{
+  return fabs(x) > 1e-8 ?
+    expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + 0.25 * x));
+}
+
+static
+double
+zipf_h(double exponent, double x)
+{
+  return exp(-exponent * log(x));
+}
+
+static
+double
+zipf_h_integral(double exponent, double x)
+{
+  double log_x = log(x);
+  return helper2((1.0 - exponent) * log_x) * log_x;
+}
+
+static
+double
+zipf_h_integral_inverse(double exponent, double x)
+{
+  double t = x * (1.0 - exponent);
+  if (t < -1.0)
+    t = -1.0;
+  return exp(helper1(t) * x);
+}
+
+/** a rank in [1, universe], 1 being the most popular. */
+static
+uint64_t
+zipf_next(workload_keys_t *keys)
+{
+  double exponent = keys->params.zipf_exponent;
+  double n = (double)keys->params.universe;
+
+  for (;;) {
+    double u = keys->h_integral_n +
+      random_unit(&keys->state) * (keys->h_integral_x1 - keys->h_integral_n);
+    double x = zipf_h_integral_inverse(exponent, u);
+    double k = floor(x + 0.5);
+    k = k < 1.0 ? 1.0 : (k > n ? n : k);
+    if (
+      k - x <= keys->s ||
+      u >= zipf_h_integral(exponent, k + 0.5) - zipf_h(exponent, k))
+      return (uint64_t)k;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * fnv1a multiplies by an odd prime after each byte, so the low 8 bits of the
+ * hash after the last byte are a bijection of the low 8 bits before it: the
+ * last byte is solved for, the one before it searched. with more than 8
+ * shared bits a prefix can run out of candidates, the next one is tried.
+ */
+static
+uint64_t
+collision_next(workload_keys_t *keys)
+{
+  uint32_t mask = (uint32_t)((1ull << keys->params.collision_bits) - 1);
+  uint32_t inverse = FNV32_PRIME, b6, i;
+  uint8_t bytes[8];
+  uint64_t key;
+
+  // newton's iteration, each step doubles the correct low bits.
+  for (i = 0; i < 4; ++i)
+    inverse *= 2u - FNV32_PRIME * inverse;
+
+  for (;;) {
+    uint64_t prefix =
+      (keys->state + keys->next++) & COLLISION_PREFIX_MASK;
+    uint32_t h6 = FNV32_OFFSET_BASIS;
+    for (i = 0; i < 6; ++i) {
+      bytes[i] = (uint8_t)(prefix >> (i * 8));
+      h6 = (h6 ^ bytes[i]) * FNV32_PRIME;
+    }
+
+    for (b6 = 0; b6 < 256; ++b6) {
+      uint32_t h7 = (h6 ^ b6) * FNV32_PRIME;
+      uint32_t b7 = ((keys->target * inverse) ^ h7) & 0xff;
+      uint32_t h8 = (h7 ^ b7) * FNV32_PRIME;
+      if ((h8 & mask) != keys->target)
+        continue;
+
+      bytes[6] = (uint8_t)b6;
+      bytes[7] = (uint8_t)b7;
+      memcpy(&key, bytes, sizeof(key));
+      assert((hash_fnv1a_32(&key, sizeof(key)) & mask) == keys->target);
+      return key;
+    }
+  }
+}
+
+void
+workload_keys_setup(
+  workload_keys_t *keys,
+  const workload_key_params_t *params)
+{
+  assert(keys && params);
+  assert(params->distribution < WORKLOAD_DISTRIBUTION_COUNT);
+
+  memset(keys, 0, sizeof(workload_keys_t));
+  keys->params = *params;
+  keys->state = params->seed;
+
+  if (params->distribution == WORKLOAD_UNIFORM)
+    assert(params->universe);
+  else if (params->distribution == WORKLOAD_ZIPF) {
+    double exponent = params->zipf_exponent;
+    assert(params->universe && exponent > 0.0);
+    keys->h_integral_x1 = zipf_h_integral(exponent, 1.5) - 1.0;
+    keys->h_integral_n =
+      zipf_h_integral(exponent, (double)params->universe + 0.5);
+    keys->s = 2.0 - zipf_h_integral_inverse(
+      exponent,
+      zipf_h_integral(exponent, 2.5) - zipf_h(exponent, 2.0));
+  } else if (params->distribution == WORKLOAD_FNV_COLLISIONS) {
+    uint64_t state = params->seed;
+    assert(
+      params->collision_bits &&
+      params->collision_bits <= WORKLOAD_MAX_COLLISION_BITS);
+    keys->target =
+      (uint32_t)splitmix64(&state) &
+      (uint32_t)((1ull << params->collision_bits) - 1);
+    keys->state = splitmix64(&state);
+  }
+}
+
+uint64_t
+workload_keys_next(workload_keys_t *keys)
+{
+  assert(keys);
+
+  switch (keys->params.distribution) {
+    case WORKLOAD_UNIFORM:
+      return scramble(
+        splitmix64(&keys->state) % keys->params.universe, keys->params.seed);
+    case WORKLOAD_ZIPF:
+      return scramble(zipf_next(keys) - 1, keys->params.seed);
+    case WORKLOAD_SEQUENTIAL:
+      return keys->next++;
+    case WORKLOAD_FNV_COLLISIONS:
+      return collision_next(keys);
+    default:
+      assert(0);
+      return 0;
+  }
+}
+
+const char *
+workload_distribution_name(workload_distribution_t distribution)
+{
+  static const char *names[WORKLOAD_DISTRIBUTION_COUNT] = {
+    "uniform", "zipf", "sequential", "fnv_collisions" };
+  assert(distribution < WORKLOAD_DISTRIBUTION_COUNT);
+  return names[distribution];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void
+workload_trace_setup(
+  workload_trace_t *trace,
+  workload_target_t target,
+  const allocator_t *allocator)
+{
+  assert(trace && allocator && target < WORKLOAD_TARGET_COUNT);
+  trace->target = target;
+  cvector_def(&trace->ops);
+  cvector_setup(&trace->ops, get_type_data(workload_op_t), 0, allocator);
+}
+
+void
+workload_trace_cleanup(workload_trace_t *trace)
+{
+  assert(trace);
+  cvector_cleanup(&trace->ops, NULL);
+}
+
+uint32_t
+workload_op_valid(workload_target_t target, workload_op_type_t type)
+{
+  assert(target < WORKLOAD_TARGET_COUNT);
+  if (type >= WORKLOAD_OP_COUNT)
+    return 0;
+  if (target == WORKLOAD_TARGET_CHASHMAP)
+    return type <= WORKLOAD_OP_CLEAR;
+  if (target == WORKLOAD_TARGET_CVECTOR)
+    return type <= WORKLOAD_OP_POP_BACK;
+  return 1;
+}
+
+void
+workload_trace_record(
+  workload_trace_t *trace,
+  workload_op_type_t type,
+  uint64_t key,
+  uint64_t value)
+{
+  workload_op_t op;
+  assert(trace && workload_op_valid(trace->target, type));
+  op.type = (uint32_t)type;
+  op.key = key;
+  op.value = value;
+  cvector_push_back(&trace->ops, op, workload_op_t);
+}
+
+void
+workload_trace_generate(
+  workload_trace_t *trace,
+  workload_keys_t *keys,
+  const workload_mix_t *mix,
+  uint64_t count,
+  uint64_t seed)
+{
+  assert(trace && keys && mix);
+
+  {
+    uint64_t state = seed, total = 0, i, pick;
+    uint32_t type;
+    for (type = 0; type < WORKLOAD_OP_COUNT; ++type) {
+      assert(
+        !mix->weights[type] ||
+        workload_op_valid(trace->target, (workload_op_type_t)type));
+      total += mix->weights[type];
+    }
+    assert(total);
+
+    cvector_reserve(&trace->ops, cvector_size(&trace->ops) + count);
+    for (i = 0; i < count; ++i) {
+      pick = splitmix64(&state) % total;
+      for (type = 0; pick >= mix->weights[type]; ++type)
+        pick -= mix->weights[type];
+      workload_trace_record(
+        trace, (workload_op_type_t)type,
+        workload_keys_next(keys), splitmix64(&state));
+    }
+  }
+}
+
+uint32_t
+workload_trace_save(const workload_trace_t *trace, const char *path)
+{
+  assert(trace && path);
+
+  {
+    binary_stream_t stream;
+    uint32_t header[3], written;
+    size_t i, size = cvector_size(&trace->ops);
+    header[0] = WORKLOAD_TRACE_MAGIC;
+    header[1] = WORKLOAD_TRACE_VERSION;
+    header[2] = (uint32_t)trace->target;
+
+    binary_stream_def(&stream);
+    binary_stream_setup(&stream, trace->ops.allocator);
+    binary_stream_write(&stream, header, sizeof(header));
+    binary_stream_write_varint(&stream, size);
+    for (i = 0; i < size; ++i) {
+      const workload_op_t *op =
+        (const workload_op_t *)cvector_at_cst(&trace->ops, i);
+      uint8_t type = (uint8_t)op->type;
+      binary_stream_write(&stream, &type, sizeof(type));
+      binary_stream_write_varint(&stream, op->key);
+      binary_stream_write_varint(&stream, op->value);
+    }
+
+    written = binary_stream_to_file(&stream, path, NULL);
+    binary_stream_cleanup(&stream);
+    return written;
+  }
+}
+
+/**
+ * binary_stream_read_varint() reads a truncated varint as 0, a trace file is
+ * read a byte at a time to tell them apart. returns 0 at the end of the stream.
+ */
+static
+uint32_t
+read_varint(binary_stream_t *stream, uint64_t *value)
+{
+  uint32_t shift = 0;
+  uint8_t byte;
+  *value = 0;
+  do {
+    if (shift >= 64 || binary_stream_tell(stream) == STREAM_EOF)
+      return 0;
+    binary_stream_read2(stream, &byte, sizeof(byte));
+    *value |= (uint64_t)(byte & 0x7f) << shift;
+    shift += 7;
+  } while (byte & 0x80);
+  return 1;
+}
+
+uint32_t
+workload_trace_load(
+  workload_trace_t *trace,
+  const char *path,
+  const allocator_t *allocator)
+{
+  assert(trace && path && allocator);
+
+  if (!file_exists(path))
+    return 0;
+
+  {
+    binary_stream_t *stream = binary_stream_from_file(path, allocator);
+    uint32_t header[3], valid = 0;
+    uint64_t size = 0, i = 0;
+    workload_op_t op;
+    uint8_t type;
+    if (!stream)
+      return 0;
+
+    if (
+      binary_stream_size(stream) > sizeof(header) &&
+      binary_stream_read2(stream, (uint8_t *)header, sizeof(header)) ==
+        sizeof(header) &&
+      header[0] == WORKLOAD_TRACE_MAGIC &&
+      header[1] == WORKLOAD_TRACE_VERSION &&
+      header[2] < WORKLOAD_TARGET_COUNT &&
+      read_varint(stream, &size)) {
+      workload_trace_setup(trace, (workload_target_t)header[2], allocator);
+      for (; i < size; ++i) {
+        if (
+          binary_stream_tell(stream) == STREAM_EOF ||
+          binary_stream_read2(stream, &type, sizeof(type)) != sizeof(type) ||
+          !workload_op_valid(trace->target, (workload_op_type_t)type) ||
+          !read_varint(stream, &op.key) ||
+          !read_varint(stream, &op.value))
+          break;
+        op.type = type;
+        cvector_push_back(&trace->ops, op, workload_op_t);
+      }
+
+      valid = cvector_size(&trace->ops) == size;
+      if (!valid)
+        workload_trace_cleanup(trace);
+    }
+
+    binary_stream_cleanup(stream);
+    allocator->mem_free(stream);
+    return valid;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static
+uint64_t
+replay_chashmap(const workload_trace_t *trace, const allocator_t *allocator)
+{
+  chashmap_t map;
+  chashmap_iterator_t iter;
+  uint64_t checksum = WORKLOAD_CHECKSUM_INIT, *found, sum;
+  size_t i, before, size = cvector_size(&trace->ops);
+
+  chashmap_def(&map);
+  chashmap_setup(
+    &map, get_type_data(uint64_t), get_type_data(uint64_t), allocator,
+    0.75f);
+
+  for (i = 0; i < size; ++i) {
+    const workload_op_t *op =
+      (const workload_op_t *)cvector_at_cst(&trace->ops, i);
+    uint64_t key = op->key;
+    before = chashmap_size(&map);
+    switch (op->type) {
+      case WORKLOAD_OP_INSERT:
+        chashmap_insert(&map, key, uint64_t, op->value, uint64_t);
+        checksum = workload_checksum(checksum, chashmap_size(&map) != before);
+        break;
+      case WORKLOAD_OP_ERASE:
+        chashmap_erase(&map, key, uint64_t);
+        checksum = workload_checksum(checksum, chashmap_size(&map) != before);
+        break;
+      case WORKLOAD_OP_FIND:
+        chashmap_at(&map, key, uint64_t, uint64_t, found);
+        checksum = workload_checksum(checksum, found ? *found : WORKLOAD_MISS);
+        break;
+      case WORKLOAD_OP_ITERATE:
+        sum = 0;
+        iter = chashmap_begin(&map);
+        for (; !chashmap_iter_equal(iter, chashmap_end(&map));
+          chashmap_advance(&iter))
+          sum += *chashmap_value(&iter, uint64_t);
+        checksum = workload_checksum(checksum, sum);
+        checksum = workload_checksum(checksum, before);
+        break;
+      case WORKLOAD_OP_CLEAR:
+        chashmap_clear(&map);
+        checksum = workload_checksum(checksum, before);
+        break;
+      default:
+        assert(0);
+    }
+  }
+
+  checksum = workload_checksum(checksum, chashmap_size(&map));
+  chashmap_cleanup(&map, NULL);
+  return checksum;
+}
+
+static
+uint64_t
+replay_cvector(const workload_trace_t *trace, const allocator_t *allocator)
+{
+  cvector_t vec;
+  uint64_t checksum = WORKLOAD_CHECKSUM_INIT, observed, *begin, *end;
+  size_t i, pos, current, size = cvector_size(&trace->ops);
+
+  cvector_def(&vec);
+  cvector_setup(&vec, get_type_data(uint64_t), 0, allocator);
+
+  for (i = 0; i < size; ++i) {
+    const workload_op_t *op =
+      (const workload_op_t *)cvector_at_cst(&trace->ops, i);
+    current = cvector_size(&vec);
+    switch (op->type) {
+      case WORKLOAD_OP_INSERT:
+        pos = (size_t)(op->key % (current + 1));
+        cvector_insert(&vec, pos, op->value, uint64_t);
+        checksum = workload_checksum(checksum, cvector_size(&vec));
+        break;
+      case WORKLOAD_OP_ERASE:
+        observed = WORKLOAD_MISS;
+        if (current) {
+          pos = (size_t)(op->key % current);
+          observed = *cvector_as(&vec, pos, uint64_t);
+          cvector_erase(&vec, pos);
+        }
+        checksum = workload_checksum(checksum, observed);
+        break;
+      case WORKLOAD_OP_FIND:
+        observed = current ?
+          *cvector_as(&vec, (size_t)(op->key % current), uint64_t) :
+          WORKLOAD_MISS;
+        checksum = workload_checksum(checksum, observed);
+        break;
+      case WORKLOAD_OP_ITERATE:
+        observed = 0;
+        begin = cvector_begin(&vec, uint64_t);
+        end = cvector_end(&vec, uint64_t);
+        for (; begin != end; ++begin)
+          observed += *begin;
+        checksum = workload_checksum(checksum, observed);
+        checksum = workload_checksum(checksum, current);
+        break;
+      case WORKLOAD_OP_CLEAR:
+        cvector_clear(&vec);
+        checksum = workload_checksum(checksum, current);
+        break;
+      case WORKLOAD_OP_PUSH_BACK:
+        cvector_push_back(&vec, op->value, uint64_t);
+        checksum = workload_checksum(checksum, cvector_size(&vec));
+        break;
+      case WORKLOAD_OP_POP_BACK:
+        observed = WORKLOAD_MISS;
+        if (current) {
+          observed = *cvector_back(&vec, uint64_t);
+          cvector_pop_back(&vec);
+        }
+        checksum = workload_checksum(checksum, observed);
+        break;
+      default:
+        assert(0);
+    }
+  }
+
+  checksum = workload_checksum(checksum, cvector_size(&vec));
+  cvector_cleanup(&vec, NULL);
+  return checksum;
+}
+
+static
+uint64_t
+replay_clist(const workload_trace_t *trace, const allocator_t *allocator)
+{
+  clist_t list;
+  clist_iterator_t iter;
+  uint64_t checksum = WORKLOAD_CHECKSUM_INIT, observed;
+  size_t i, pos, current, size = cvector_size(&trace->ops);
+
+  clist_def(&list);
+  clist_setup(&list, get_type_data(uint64_t), allocator);
+
+  for (i = 0; i < size; ++i) {
+    const workload_op_t *op =
+      (const workload_op_t *)cvector_at_cst(&trace->ops, i);
+    current = clist_size(&list);
+    switch (op->type) {
+      case WORKLOAD_OP_INSERT:
+        pos = (size_t)(op->key % (current + 1));
+        clist_insert(&list, pos, op->value, uint64_t);
+        checksum = workload_checksum(checksum, clist_size(&list));
+        break;
+      case WORKLOAD_OP_ERASE:
+        observed = WORKLOAD_MISS;
+        if (current) {
+          pos = (size_t)(op->key % current);
+          observed = *clist_as(&list, pos, uint64_t);
+          clist_erase(&list, pos);
+        }
+        checksum = workload_checksum(checksum, observed);
+        break;
+      case WORKLOAD_OP_FIND:
+        observed = current ?
+          *clist_as(&list, (size_t)(op->key % current), uint64_t) :
+          WORKLOAD_MISS;
+        checksum = workload_checksum(checksum, observed);
+        break;
+      case WORKLOAD_OP_ITERATE:
+        observed = 0;
+        iter = clist_begin(&list);
+        for (; !clist_iter_equal(iter, clist_end(&list)); clist_advance(&iter))
+          observed += *clist_deref(&iter, uint64_t);
+        checksum = workload_checksum(checksum, observed);
+        checksum = workload_checksum(checksum, current);
+        break;
+      case WORKLOAD_OP_CLEAR:
+        clist_clear(&list);
+        checksum = workload_checksum(checksum, current);
+        break;
+      case WORKLOAD_OP_PUSH_BACK:
+        clist_push_back(&list, op->value, uint64_t);
+        checksum = workload_checksum(checksum, clist_size(&list));
+        break;
+      case WORKLOAD_OP_PUSH_FRONT:
+        clist_push_front(&list, op->value, uint64_t);
+        checksum = workload_checksum(checksum, clist_size(&list));
+        break;
+      case WORKLOAD_OP_POP_BACK:
+        observed = WORKLOAD_MISS;
+        if (current) {
+          observed = *clist_back(&list, uint64_t);
+          clist_pop_back(&list);
+        }
+        checksum = workload_checksum(checksum, observed);
+        break;
+      case WORKLOAD_OP_POP_FRONT:
+        observed = WORKLOAD_MISS;
+        if (current) {
+          observed = *clist_front(&list, uint64_t);
+          clist_pop_front(&list);
+        }
+        checksum = workload_checksum(checksum, observed);
+        break;
+      default:
+        assert(0);
+    }
+  }
+
+  checksum = workload_checksum(checksum, clist_size(&list));
+  clist_cleanup(&list, NULL);
+  return checksum;
+}
+
+uint64_t
+workload_replay(const workload_trace_t *trace, const allocator_t *allocator)
+{
+  assert(trace && allocator);
+
+  switch (trace->target) {
+    case WORKLOAD_TARGET_CHASHMAP:
+      return replay_chashmap(trace, allocator);
+    case WORKLOAD_TARGET_CVECTOR:
+      return replay_cvector(trace, allocator);
+    case WORKLOAD_TARGET_CLIST:
+      return replay_clist(trace, allocator);
+    default:
+      assert(0);
+      return 0;
+  }
+}
+
+const char *
+workload_target_name(workload_target_t target)
+{
+  static const char *names[WORKLOAD_TARGET_COUNT] = {
+    "chashmap", "cvector", "clist" };
+  assert(target < WORKLOAD_TARGET_COUNT);
+  return names[target];
+}
\ No newline at end of file
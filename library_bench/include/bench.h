@@ -0,0 +1,195 @@
+/**
+ * @file bench.h
+ * @author khalilhenoud@gmail.com
+ * @brief microbenchmark harness, warmup, repetitions and csv/json reports
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+#include <bench_perf.h>
+#include <library/allocator/allocator.h>
+
+#define BENCH_SEED                    0x9e3779b97f4a7c15ull
+
+
+////////////////////////////////////////////////////////////////////////////////
+// NOTES:
+//  - a benchmark is a setup, a body and a teardown run once per repetition,
+//    only the body is timed (performance counter ticks). warmup repetitions
+//    run the same way and are thrown away.
+//  - times are reported per operation, 'ops' is what the body does once.
+//    'bytes' per repetition, when given, turns into a MB/s column.
+//  - every random workload starts from BENCH_SEED, two runs time the same
+//    sequence of operations.
+//  - --smoke keeps the smallest size of every sweep and a single repetition,
+//    it checks the benchmarks still run, not how fast. --max-size cuts the
+//    sweeps short instead.
+//  - memory goes through bench_allocator() (the library containers) or
+//    bench_std_allocator_t (the std ones). both count the bytes they are
+//    asked for, and neither counts malloc's own overhead. the library side
+//    adds a 16 byte size header to each block, and the report leaves it out.
+//    peak_bytes is the most that was live during the body, setup included.
+//    peak_rss_kb is the process high water mark after it, it never goes down.
+//  - --perf adds hardware counters (see bench_perf.h) over the timed
+//    repetitions, per operation. a counter that could not be read is left
+//    empty (null in json).
+////////////////////////////////////////////////////////////////////////////////
+
+typedef std::function<void(void)> bench_fn_t;
+
+typedef
+struct bench_options_t {
+  uint32_t warmup = 1;
+  uint32_t repetitions = 5;
+  uint32_t smoke = 0;
+  uint64_t max_size = 0;                // 0 for no limit
+  uint32_t perf = 0;
+  std::string filter;                   // substring of "suite/name"
+  std::string format = "csv";           // csv or json
+  std::string out;                      // stdout when empty
+} bench_options_t;
+
+typedef
+struct bench_result_t {
+  std::string suite;
+  std::string name;
+  uint64_t size;                        // elements, or bytes for throughput
+  uint64_t ops;                         // per repetition
+  uint32_t repetitions;
+  double min_ns;                        // all per operation
+  double median_ns;
+  double mean_ns;
+  double max_ns;
+  double stddev_ns;
+  double mb_per_s;                      // from the median, 0 without bytes
+  uint64_t alloc_bytes;                 // requested during the body
+  uint64_t allocations;                 // during the body
+  uint64_t peak_bytes;                  // most live, setup included
+  uint64_t peak_rss_kb;
+  uint32_t perf_mask;                   // 1 << bench_perf_event_t counted
+  double perf_per_op[BENCH_PERF_COUNT];
+  double ipc;                           // needs cycles and instructions
+} bench_result_t;
+
+typedef
+struct bench_context_t {
+  bench_options_t options;
+  uint64_t ticks_per_second;
+  bench_perf_t perf;
+  std::vector<bench_result_t> results;
+} bench_context_t;
+
+typedef
+struct bench_rng_t {
+  uint64_t state;
+} bench_rng_t;
+
+void
+bench_setup(bench_context_t *context, const bench_options_t &options);
+
+void
+bench_cleanup(bench_context_t *context);
+
+/** 0 if the filter rules the benchmark out, it is skipped then. */
+uint32_t
+bench_enabled(
+  const bench_context_t *context,
+  const char *suite,
+  const char *name);
+
+void
+bench_run(
+  bench_context_t *context,
+  const char *suite,
+  const char *name,
+  uint64_t size,
+  uint64_t ops,
+  uint64_t bytes,
+  const bench_fn_t &setup,
+  const bench_fn_t &body,
+  const bench_fn_t &teardown);
+
+/** the sweep, cut down to its first size under --smoke, or to --max-size. */
+std::vector<uint64_t>
+bench_sizes(
+  const bench_context_t *context,
+  const std::vector<uint64_t> &sizes);
+
+/** 0 if the report could not be written. */
+uint32_t
+bench_report(const bench_context_t *context);
+
+/** keeps the compiler from dropping a result nothing else reads. */
+void
+bench_sink(uint64_t value);
+
+/** malloc backed and counted, not thread safe. */
+const allocator_t *
+bench_allocator(void);
+
+void
+bench_count_alloc(size_t size);
+
+void
+bench_count_free(size_t size);
+
+/** the std containers' side of bench_allocator(). */
+template<typename T>
+struct bench_std_allocator_t {
+  typedef T value_type;
+
+  bench_std_allocator_t() = default;
+  template<typename U>
+  bench_std_allocator_t(const bench_std_allocator_t<U> &) {}
+
+  T *
+  allocate(size_t count)
+  {
+    void *block = malloc(count * sizeof(T));
+    if (!block)
+      throw std::bad_alloc();
+    bench_count_alloc(count * sizeof(T));
+    return (T *)block;
+  }
+
+  void
+  deallocate(T *block, size_t count)
+  {
+    bench_count_free(count * sizeof(T));
+    free(block);
+  }
+
+  template<typename U>
+  bool operator==(const bench_std_allocator_t<U> &) const { return true; }
+  template<typename U>
+  bool operator!=(const bench_std_allocator_t<U> &) const { return false; }
+};
+
+inline
+void
+bench_rng_seed(bench_rng_t *rng, uint64_t seed)
+{
+  rng->state = seed;
+}
+
+/** splitmix64. */
+inline
+uint64_t
+bench_random(bench_rng_t *rng)
+{
+  uint64_t z = (rng->state += 0x9e3779b97f4a7c15ull);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
\ No newline at end of file
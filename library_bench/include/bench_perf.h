@@ -0,0 +1,62 @@
+/**
+ * @file bench_perf.h
+ * @author khalilhenoud@gmail.com
+ * @brief hardware counters around the timed body, linux perf_event_open
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <cstdint>
+
+
+////////////////////////////////////////////////////////////////////////////////
+// NOTES:
+//  - every event is opened on its own, user space only, for the calling
+//    thread. a counter the cpu or the kernel refuses is left out, the others
+//    still count (perf_event_paranoid above 2, containers and vms often
+//    refuse them all).
+//  - with more events than hardware counters the kernel multiplexes them,
+//    the values are scaled by time enabled over time running.
+//  - elsewhere than linux nothing opens and every counter reads unavailable.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef
+enum bench_perf_event_t {
+  BENCH_PERF_CYCLES,
+  BENCH_PERF_INSTRUCTIONS,
+  BENCH_PERF_L1D_MISSES,
+  BENCH_PERF_LLC_MISSES,
+  BENCH_PERF_BRANCH_MISSES,
+  BENCH_PERF_DTLB_MISSES,
+  BENCH_PERF_COUNT
+} bench_perf_event_t;
+
+typedef
+struct bench_perf_t {
+  int32_t fds[BENCH_PERF_COUNT];        // -1 when unavailable
+} bench_perf_t;
+
+/** returns how many events opened, 'error' says why the first one did not. */
+uint32_t
+bench_perf_open(bench_perf_t *perf, const char **error);
+
+void
+bench_perf_close(bench_perf_t *perf);
+
+/** resets and enables every open counter. */
+void
+bench_perf_start(bench_perf_t *perf);
+
+/**
+ * disables the counters and reads them into 'values', returns a mask of the
+ * ones that counted (1 << event).
+ */
+uint32_t
+bench_perf_stop(bench_perf_t *perf, uint64_t values[BENCH_PERF_COUNT]);
+
+const char *
+bench_perf_name(bench_perf_event_t event);
\ No newline at end of file
@@ -0,0 +1,105 @@
+/**
+ * @file allocator_bench.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <cstdint>
+#include <vector>
+#include <bench.h>
+#include <library/allocator/allocator.h>
+
+
+void
+bench_allocator_main(bench_context_t *context, const allocator_t *allocator)
+{
+  const uint64_t blocks_max = context->options.smoke ? 1000 : 100000;
+  std::vector<void *> blocks(blocks_max);
+  std::vector<uint64_t> sizes(blocks_max);
+
+  for (uint64_t size : std::vector<uint64_t>{ 16, 64, 256, 4096, 65536 }) {
+    // the batches stay under 128 MB live, twice that once grown.
+    uint64_t count = (1ull << 27) / size;
+    count = count < blocks_max ? count : blocks_max;
+
+    // an alloc right away freed, the allocator's fast path.
+    bench_run(
+      context, "allocator", "alloc_free", size, count, 0,
+      nullptr,
+      [&]() {
+        for (uint64_t i = 0; i < count; ++i) {
+          void *block = allocator->mem_alloc(size);
+          *(volatile uint8_t *)block = 1;
+          allocator->mem_free(block);
+        } },
+      nullptr);
+
+    bench_run(
+      context, "allocator", "alloc_batch", size, count, 0,
+      nullptr,
+      [&]() {
+        for (uint64_t i = 0; i < count; ++i)
+          blocks[i] = allocator->mem_alloc(size); },
+      [&]() {
+        for (uint64_t i = 0; i < count; ++i)
+          allocator->mem_free(blocks[i]); });
+
+    bench_run(
+      context, "allocator", "free_batch_fifo", size, count, 0,
+      [&]() {
+        for (uint64_t i = 0; i < count; ++i)
+          blocks[i] = allocator->mem_alloc(size); },
+      [&]() {
+        for (uint64_t i = 0; i < count; ++i)
+          allocator->mem_free(blocks[i]); },
+      nullptr);
+
+    bench_run(
+      context, "allocator", "free_batch_lifo", size, count, 0,
+      [&]() {
+        for (uint64_t i = 0; i < count; ++i)
+          blocks[i] = allocator->mem_alloc(size); },
+      [&]() {
+        for (uint64_t i = count; i-- > 0;)
+          allocator->mem_free(blocks[i]); },
+      nullptr);
+
+    bench_run(
+      context, "allocator", "realloc_grow", size, count, 0,
+      [&]() {
+        for (uint64_t i = 0; i < count; ++i)
+          blocks[i] = allocator->mem_alloc(size); },
+      [&]() {
+        for (uint64_t i = 0; i < count; ++i)
+          blocks[i] = allocator->mem_realloc(blocks[i], size * 2); },
+      [&]() {
+        for (uint64_t i = 0; i < count; ++i)
+          allocator->mem_free(blocks[i]); });
+  }
+
+  // mixed sizes freed in random order, closer to what containers do.
+  uint64_t count = blocks_max;
+  bench_rng_t rng;
+  bench_rng_seed(&rng, BENCH_SEED);
+  for (uint64_t i = 0; i < count; ++i)
+    sizes[i] = 8 + bench_random(&rng) % 1024;
+  bench_run(
+    context, "allocator", "mixed_random_free", 0, count, 0,
+    nullptr,
+    [&]() {
+      bench_rng_t order;
+      bench_rng_seed(&order, BENCH_SEED);
+      for (uint64_t i = 0; i < count; ++i)
+        blocks[i] = allocator->mem_alloc(sizes[i]);
+      for (uint64_t i = count; i > 1; --i) {
+        uint64_t j = bench_random(&order) % i;
+        allocator->mem_free(blocks[j]);
+        blocks[j] = blocks[i - 1];
+      }
+      allocator->mem_free(blocks[0]); },
+    nullptr);
+}
\ No newline at end of file
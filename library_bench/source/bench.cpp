@@ -0,0 +1,414 @@
+/**
+ * @file bench.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <bench.h>
+#include <library/os/os.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#ifndef BENCH_BUILD_TYPE
+#define BENCH_BUILD_TYPE ""
+#endif
+
+
+// keeps the block aligned like malloc's.
+#define SIZE_HEADER                   16
+
+
+typedef
+struct bench_memory_t {
+  uint64_t bytes;
+  uint64_t allocations;
+  uint64_t live;
+  uint64_t peak;
+} bench_memory_t;
+
+static volatile uint64_t s_sink;
+static bench_memory_t s_memory;
+
+static
+uint64_t
+get_ticks(void)
+{
+  uint64_t ticks = 0;
+  get_performance_counter(&ticks);
+  return ticks;
+}
+
+static
+uint64_t
+get_peak_rss_kb(void)
+{
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return 0;
+  return (uint64_t)counters.PeakWorkingSetSize / 1024;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage))
+    return 0;
+#if defined(__APPLE__)
+  return (uint64_t)usage.ru_maxrss / 1024;
+#else
+  return (uint64_t)usage.ru_maxrss;
+#endif
+#endif
+}
+
+void
+bench_setup(bench_context_t *context, const bench_options_t &options)
+{
+  assert(context);
+  context->options = options;
+  if (options.smoke) {
+    context->options.warmup = 0;
+    context->options.repetitions = 1;
+  }
+  context->ticks_per_second = 0;
+  get_performance_frequency(&context->ticks_per_second);
+  context->results.clear();
+
+  for (uint32_t i = 0; i < BENCH_PERF_COUNT; ++i)
+    context->perf.fds[i] = -1;
+  if (options.perf) {
+    const char *error = NULL;
+    uint32_t opened = bench_perf_open(&context->perf, &error);
+    std::cerr << "perf counters: " << opened << "/" << BENCH_PERF_COUNT <<
+      " opened" << (error ? std::string(", ") + error : "") << std::endl;
+  }
+}
+
+void
+bench_cleanup(bench_context_t *context)
+{
+  assert(context);
+  bench_perf_close(&context->perf);
+}
+
+uint32_t
+bench_enabled(
+  const bench_context_t *context,
+  const char *suite,
+  const char *name)
+{
+  assert(context && suite && name);
+  std::string full = std::string(suite) + "/" + name;
+  return
+    context->options.filter.empty() ||
+    full.find(context->options.filter) != std::string::npos;
+}
+
+void
+bench_run(
+  bench_context_t *context,
+  const char *suite,
+  const char *name,
+  uint64_t size,
+  uint64_t ops,
+  uint64_t bytes,
+  const bench_fn_t &setup,
+  const bench_fn_t &body,
+  const bench_fn_t &teardown)
+{
+  assert(context && ops);
+  if (!bench_enabled(context, suite, name))
+    return;
+
+  const bench_options_t &options = context->options;
+  std::vector<double> samples;
+  bench_memory_t before, after;
+  uint64_t counters[BENCH_PERF_COUNT], totals[BENCH_PERF_COUNT] = { 0 };
+  uint32_t mask = (1u << BENCH_PERF_COUNT) - 1;
+  for (uint32_t i = 0; i < options.warmup + options.repetitions; ++i) {
+    if (setup)
+      setup();
+    s_memory.peak = s_memory.live;
+    before = s_memory;
+    // the counters bracket the clock, their syscalls stay out of the time.
+    bench_perf_start(&context->perf);
+    uint64_t start = get_ticks();
+    body();
+    uint64_t end = get_ticks();
+    uint32_t counted = bench_perf_stop(&context->perf, counters);
+    after = s_memory;
+    if (teardown)
+      teardown();
+    if (i < options.warmup)
+      continue;
+
+    samples.push_back(
+      (double)(end - start) * 1e9 / (double)context->ticks_per_second /
+      (double)ops);
+    // a counter missing from any repetition is left out altogether.
+    mask &= counted;
+    for (uint32_t j = 0; j < BENCH_PERF_COUNT; ++j)
+      totals[j] += counters[j];
+  }
+
+  bench_result_t result;
+  result.suite = suite;
+  result.name = name;
+  result.size = size;
+  result.ops = ops;
+  result.repetitions = (uint32_t)samples.size();
+  std::sort(samples.begin(), samples.end());
+  result.min_ns = samples.front();
+  result.max_ns = samples.back();
+  result.median_ns =
+    samples.size() % 2 ?
+    samples[samples.size() / 2] :
+    (samples[samples.size() / 2 - 1] + samples[samples.size() / 2]) / 2.;
+  result.mean_ns = 0.;
+  for (double sample : samples)
+    result.mean_ns += sample;
+  result.mean_ns /= (double)samples.size();
+  result.stddev_ns = 0.;
+  for (double sample : samples)
+    result.stddev_ns += (sample - result.mean_ns) * (sample - result.mean_ns);
+  result.stddev_ns =
+    samples.size() > 1 ?
+    std::sqrt(result.stddev_ns / (double)(samples.size() - 1)) : 0.;
+  // bytes per repetition over the median repetition, in 10^6 bytes a second.
+  result.mb_per_s =
+    bytes && result.median_ns > 0. ?
+    (double)bytes / (result.median_ns * (double)ops) * 1e3 : 0.;
+  // the workloads are deterministic, the last repetition stands for all.
+  result.alloc_bytes = after.bytes - before.bytes;
+  result.allocations = after.allocations - before.allocations;
+  result.peak_bytes = after.peak;
+  result.peak_rss_kb = get_peak_rss_kb();
+  result.perf_mask = mask;
+  for (uint32_t i = 0; i < BENCH_PERF_COUNT; ++i)
+    result.perf_per_op[i] =
+      (double)totals[i] / ((double)ops * (double)samples.size());
+  result.ipc =
+    (mask & (1u << BENCH_PERF_CYCLES)) &&
+    (mask & (1u << BENCH_PERF_INSTRUCTIONS)) && totals[BENCH_PERF_CYCLES] ?
+    (double)totals[BENCH_PERF_INSTRUCTIONS] /
+    (double)totals[BENCH_PERF_CYCLES] : 0.;
+  context->results.push_back(result);
+
+  std::cerr << suite << "/" << name << " [" << size << "] " <<
+    result.median_ns << " ns/op" << std::endl;
+}
+
+std::vector<uint64_t>
+bench_sizes(
+  const bench_context_t *context,
+  const std::vector<uint64_t> &sizes)
+{
+  assert(context && !sizes.empty());
+  if (context->options.smoke)
+    return std::vector<uint64_t>(1, sizes.front());
+
+  std::vector<uint64_t> kept;
+  for (uint64_t size : sizes)
+    if (!context->options.max_size || size <= context->options.max_size)
+      kept.push_back(size);
+  return kept;
+}
+
+/**
+ * ipc then the per op counters, empty (null in json) for what was not
+ * counted. json gets the counter names in front of the values.
+ */
+static
+void
+write_perf(const bench_result_t &result, std::ostream &stream, uint32_t json)
+{
+  const char *separator = json ? ", " : ",";
+  const char *missing = json ? "null" : "";
+  uint32_t cycles = 1u << BENCH_PERF_CYCLES;
+  uint32_t instructions = 1u << BENCH_PERF_INSTRUCTIONS;
+  if ((result.perf_mask & cycles) && (result.perf_mask & instructions))
+    stream << result.ipc;
+  else
+    stream << missing;
+
+  for (uint32_t i = 0; i < BENCH_PERF_COUNT; ++i) {
+    stream << separator;
+    if (json)
+      stream << "\"" << bench_perf_name((bench_perf_event_t)i) <<
+        "_per_op\": ";
+    if (result.perf_mask & (1u << i))
+      stream << result.perf_per_op[i];
+    else
+      stream << missing;
+  }
+}
+
+static
+void
+write_csv(const bench_context_t *context, std::ostream &stream)
+{
+  stream << "suite,name,size,ops,repetitions,min_ns,median_ns,mean_ns,"
+    "max_ns,stddev_ns,cv,mb_per_s,alloc_bytes,allocations,peak_bytes,"
+    "peak_rss_kb,ipc";
+  for (uint32_t i = 0; i < BENCH_PERF_COUNT; ++i)
+    stream << "," << bench_perf_name((bench_perf_event_t)i) << "_per_op";
+  stream << "\n";
+  for (const bench_result_t &result : context->results) {
+    stream << result.suite << "," << result.name << "," << result.size <<
+      "," << result.ops << "," << result.repetitions << "," <<
+      result.min_ns << "," << result.median_ns << "," << result.mean_ns <<
+      "," << result.max_ns << "," << result.stddev_ns << "," <<
+      (result.mean_ns > 0. ? result.stddev_ns / result.mean_ns : 0.) <<
+      "," << result.mb_per_s << "," << result.alloc_bytes << "," <<
+      result.allocations << "," << result.peak_bytes << "," <<
+      result.peak_rss_kb << ",";
+    write_perf(result, stream, 0);
+    stream << "\n";
+  }
+}
+
+static
+void
+write_json(const bench_context_t *context, std::ostream &stream)
+{
+  const bench_options_t &options = context->options;
+  stream << "{\n  \"build_type\": \"" << BENCH_BUILD_TYPE << "\",\n" <<
+#if defined(NDEBUG)
+    "  \"asserts\": false,\n" <<
+#else
+    "  \"asserts\": true,\n" <<
+#endif
+    "  \"ticks_per_second\": " << context->ticks_per_second << ",\n" <<
+    "  \"warmup\": " << options.warmup << ",\n" <<
+    "  \"repetitions\": " << options.repetitions << ",\n" <<
+    "  \"seed\": " << BENCH_SEED << ",\n" <<
+    "  \"results\": [\n";
+  for (size_t i = 0; i < context->results.size(); ++i) {
+    const bench_result_t &result = context->results[i];
+    stream << "    {\"suite\": \"" << result.suite << "\", \"name\": \"" <<
+      result.name << "\", \"size\": " << result.size << ", \"ops\": " <<
+      result.ops << ", \"repetitions\": " << result.repetitions <<
+      ", \"min_ns\": " << result.min_ns << ", \"median_ns\": " <<
+      result.median_ns << ", \"mean_ns\": " << result.mean_ns <<
+      ", \"max_ns\": " << result.max_ns << ", \"stddev_ns\": " <<
+      result.stddev_ns << ", \"mb_per_s\": " << result.mb_per_s <<
+      ", \"alloc_bytes\": " << result.alloc_bytes << ", \"allocations\": " <<
+      result.allocations << ", \"peak_bytes\": " << result.peak_bytes <<
+      ", \"peak_rss_kb\": " << result.peak_rss_kb << ", \"ipc\": ";
+    write_perf(result, stream, 1);
+    stream << "}" << (i + 1 < context->results.size() ? "," : "") << "\n";
+  }
+  stream << "  ]\n}\n";
+}
+
+uint32_t
+bench_report(const bench_context_t *context)
+{
+  assert(context);
+
+  std::ofstream file;
+  if (!context->options.out.empty()) {
+    file.open(context->options.out, std::ios::binary);
+    if (!file)
+      return 0;
+  }
+
+  std::ostream &stream = context->options.out.empty() ? std::cout : file;
+  if (context->options.format == "json")
+    write_json(context, stream);
+  else
+    write_csv(context, stream);
+  stream.flush();
+  return !stream.fail();
+}
+
+void
+bench_sink(uint64_t value)
+{
+  s_sink = s_sink + value;
+}
+
+void
+bench_count_alloc(size_t size)
+{
+  s_memory.bytes += size;
+  ++s_memory.allocations;
+  s_memory.live += size;
+  s_memory.peak = s_memory.live > s_memory.peak ? s_memory.live : s_memory.peak;
+}
+
+void
+bench_count_free(size_t size)
+{
+  s_memory.live -= size;
+}
+
+static
+void *
+counted_alloc(size_t size)
+{
+  uint8_t *block = (uint8_t *)malloc(size + SIZE_HEADER);
+  assert(block);
+  *(size_t *)block = size;
+  bench_count_alloc(size);
+  return block + SIZE_HEADER;
+}
+
+static
+void
+counted_free(void *ptr)
+{
+  if (!ptr)
+    return;
+  uint8_t *block = (uint8_t *)ptr - SIZE_HEADER;
+  bench_count_free(*(size_t *)block);
+  free(block);
+}
+
+static
+void *
+counted_realloc(void *ptr, size_t size)
+{
+  if (!ptr)
+    return counted_alloc(size);
+  uint8_t *block = (uint8_t *)ptr - SIZE_HEADER;
+  bench_count_free(*(size_t *)block);
+  block = (uint8_t *)realloc(block, size + SIZE_HEADER);
+  assert(block);
+  *(size_t *)block = size;
+  bench_count_alloc(size);
+  return block + SIZE_HEADER;
+}
+
+static
+void *
+counted_cont_alloc(size_t count, size_t size)
+{
+  uint8_t *block = (uint8_t *)calloc(1, count * size + SIZE_HEADER);
+  assert(block);
+  *(size_t *)block = count * size;
+  bench_count_alloc(count * size);
+  return block + SIZE_HEADER;
+}
+
+static const allocator_t s_counted = {
+  counted_alloc, counted_free, counted_realloc, counted_cont_alloc, NULL };
+
+const allocator_t *
+bench_allocator(void)
+{
+  return &s_counted;
+}
\ No newline at end of file
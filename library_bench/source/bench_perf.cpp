@@ -0,0 +1,173 @@
+/**
+ * @file bench_perf.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <cassert>
+#include <cstring>
+#include <bench_perf.h>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+#if defined(__linux__)
+
+#define CACHE_EVENT(cache, op, result) \
+  ((cache) | ((op) << 8) | ((result) << 16))
+
+typedef
+struct perf_event_desc_t {
+  uint32_t type;
+  uint64_t config;
+} perf_event_desc_t;
+
+// in bench_perf_event_t order.
+static const perf_event_desc_t s_events[BENCH_PERF_COUNT] = {
+  { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+  { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+  { PERF_TYPE_HW_CACHE, CACHE_EVENT(
+    PERF_COUNT_HW_CACHE_L1D,
+    PERF_COUNT_HW_CACHE_OP_READ,
+    PERF_COUNT_HW_CACHE_RESULT_MISS) },
+  { PERF_TYPE_HW_CACHE, CACHE_EVENT(
+    PERF_COUNT_HW_CACHE_LL,
+    PERF_COUNT_HW_CACHE_OP_READ,
+    PERF_COUNT_HW_CACHE_RESULT_MISS) },
+  { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+  { PERF_TYPE_HW_CACHE, CACHE_EVENT(
+    PERF_COUNT_HW_CACHE_DTLB,
+    PERF_COUNT_HW_CACHE_OP_READ,
+    PERF_COUNT_HW_CACHE_RESULT_MISS) } };
+
+// what read() returns with the time fields requested.
+typedef
+struct perf_read_t {
+  uint64_t value;
+  uint64_t time_enabled;
+  uint64_t time_running;
+} perf_read_t;
+
+static
+int32_t
+open_event(const perf_event_desc_t *desc)
+{
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = desc->type;
+  attr.config = desc->config;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format =
+    PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return (int32_t)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+#endif
+
+uint32_t
+bench_perf_open(bench_perf_t *perf, const char **error)
+{
+  assert(perf);
+  uint32_t opened = 0;
+  for (uint32_t i = 0; i < BENCH_PERF_COUNT; ++i)
+    perf->fds[i] = -1;
+  if (error)
+    *error = NULL;
+
+#if defined(__linux__)
+  for (uint32_t i = 0; i < BENCH_PERF_COUNT; ++i) {
+    perf->fds[i] = open_event(s_events + i);
+    if (perf->fds[i] >= 0)
+      ++opened;
+    else if (error && !*error)
+      *error = strerror(errno);
+  }
+#else
+  if (error)
+    *error = "perf_event_open is linux only";
+#endif
+  return opened;
+}
+
+void
+bench_perf_close(bench_perf_t *perf)
+{
+  assert(perf);
+#if defined(__linux__)
+  for (uint32_t i = 0; i < BENCH_PERF_COUNT; ++i)
+    if (perf->fds[i] >= 0)
+      close(perf->fds[i]);
+#endif
+  for (uint32_t i = 0; i < BENCH_PERF_COUNT; ++i)
+    perf->fds[i] = -1;
+}
+
+void
+bench_perf_start(bench_perf_t *perf)
+{
+  assert(perf);
+#if defined(__linux__)
+  for (uint32_t i = 0; i < BENCH_PERF_COUNT; ++i) {
+    if (perf->fds[i] < 0)
+      continue;
+    ioctl(perf->fds[i], PERF_EVENT_IOC_RESET, 0);
+    ioctl(perf->fds[i], PERF_EVENT_IOC_ENABLE, 0);
+  }
+#endif
+}
+
+uint32_t
+bench_perf_stop(bench_perf_t *perf, uint64_t values[BENCH_PERF_COUNT])
+{
+  assert(perf && values);
+  uint32_t mask = 0;
+  memset(values, 0, sizeof(uint64_t) * BENCH_PERF_COUNT);
+
+#if defined(__linux__)
+  for (uint32_t i = 0; i < BENCH_PERF_COUNT; ++i)
+    if (perf->fds[i] >= 0)
+      ioctl(perf->fds[i], PERF_EVENT_IOC_DISABLE, 0);
+
+  for (uint32_t i = 0; i < BENCH_PERF_COUNT; ++i) {
+    perf_read_t read_back;
+    if (
+      perf->fds[i] < 0 ||
+      read(perf->fds[i], &read_back, sizeof(read_back)) != sizeof(read_back))
+      continue;
+    // never scheduled on the pmu, nothing to scale.
+    if (!read_back.time_running)
+      continue;
+    values[i] =
+      read_back.time_running < read_back.time_enabled ?
+      (uint64_t)(
+        (double)read_back.value *
+        (double)read_back.time_enabled / (double)read_back.time_running) :
+      read_back.value;
+    mask |= 1u << i;
+  }
+#endif
+  return mask;
+}
+
+const char *
+bench_perf_name(bench_perf_event_t event)
+{
+  static const char *names[BENCH_PERF_COUNT] = {
+    "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses",
+    "dtlb_misses" };
+  assert(event < BENCH_PERF_COUNT);
+  return names[event];
+}
\ No newline at end of file
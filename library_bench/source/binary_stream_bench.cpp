@@ -0,0 +1,88 @@
+/**
+ * @file binary_stream_bench.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <cstdint>
+#include <vector>
+#include <bench.h>
+#include <library/allocator/allocator.h>
+#include <library/streams/binary_stream.h>
+
+
+static
+void
+fill(binary_stream_t *stream, const uint8_t *chunk, uint64_t length, uint64_t n)
+{
+  for (uint64_t i = 0; i < n; ++i)
+    binary_stream_write(stream, chunk, length);
+}
+
+void
+bench_binary_stream_main(
+  bench_context_t *context,
+  const allocator_t *allocator)
+{
+  const uint64_t total = context->options.smoke ? 1 << 16 : 1 << 24;
+  std::vector<uint8_t> chunk(1 << 16);
+  for (size_t i = 0; i < chunk.size(); ++i)
+    chunk[i] = (uint8_t)i;
+
+  binary_stream_t stream;
+  auto setup = [&]() {
+    binary_stream_def(&stream);
+    binary_stream_setup(&stream, allocator); };
+  auto teardown = [&]() { binary_stream_cleanup(&stream); };
+
+  for (uint64_t length : std::vector<uint64_t>{ 4, 16, 256, 4096, 65536 }) {
+    uint64_t count = total / length;
+    bench_run(
+      context, "binary_stream", "write", length, count, total,
+      setup, [&]() { fill(&stream, chunk.data(), length, count); }, teardown);
+
+    bench_run(
+      context, "binary_stream", "read", length, count, total,
+      [&]() { setup(); fill(&stream, chunk.data(), length, count); },
+      [&]() {
+        uint64_t sum = 0;
+        for (uint64_t i = 0; i < count; ++i)
+          sum += binary_stream_read(
+            &stream, chunk.data(), chunk.size(), (uint32_t)length);
+        bench_sink(sum); },
+      teardown);
+  }
+
+  // small values mostly, like the lengths and counts containers write.
+  uint64_t count = total / 8;
+  std::vector<uint64_t> values(count);
+  bench_rng_t rng;
+  bench_rng_seed(&rng, BENCH_SEED);
+  for (uint64_t &value : values)
+    value = bench_random(&rng) >> (bench_random(&rng) % 64);
+
+  bench_run(
+    context, "binary_stream", "write_varint", 8, count, 0,
+    setup,
+    [&]() {
+      for (uint64_t i = 0; i < count; ++i)
+        binary_stream_write_varint(&stream, values[i]); },
+    teardown);
+
+  bench_run(
+    context, "binary_stream", "read_varint", 8, count, 0,
+    [&]() {
+      setup();
+      for (uint64_t i = 0; i < count; ++i)
+        binary_stream_write_varint(&stream, values[i]); },
+    [&]() {
+      uint64_t sum = 0;
+      for (uint64_t i = 0; i < count; ++i)
+        sum += binary_stream_read_varint(&stream);
+      bench_sink(sum); },
+    teardown);
+}
\ No newline at end of file
@@ -0,0 +1,202 @@
+/**
+ * @file chashmap_bench.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <bench.h>
+#include <library/allocator/allocator.h>
+#include <library/containers/chashmap.h>
+#include <library/string/cstring.h>
+
+
+template<typename K>
+static
+void
+make_key(K *key, uint64_t value, const allocator_t *allocator)
+{
+  (void)allocator;
+  *key = (K)value;
+}
+
+template<>
+void
+make_key<cstring_t>(
+  cstring_t *key,
+  uint64_t value,
+  const allocator_t *allocator)
+{
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "key_%llx", (unsigned long long)value);
+  cstring_def(key);
+  cstring_setup(key, buffer, allocator);
+}
+
+template<typename K>
+static
+void
+free_keys(std::vector<K> &keys)
+{
+  (void)keys;
+}
+
+template<>
+void
+free_keys<cstring_t>(std::vector<cstring_t> &keys)
+{
+  for (cstring_t &key : keys)
+    cstring_cleanup(&key, NULL);
+}
+
+template<typename K>
+static
+void
+fill(chashmap_t *map, const std::vector<K> &keys, uint64_t count)
+{
+  for (uint64_t i = 0; i < count; ++i)
+    chashmap_insert(map, keys[i], K, (uint32_t)i, uint32_t);
+}
+
+/**
+ * 'hits' are inserted, 'misses' never are. get_type_data() names the type, it
+ * cannot see through 'K', the caller passes it.
+ */
+template<typename K>
+static
+void
+bench_key_type(
+  bench_context_t *context,
+  const allocator_t *allocator,
+  type_data_t key_data,
+  const char *key_name,
+  uint64_t size)
+{
+  std::vector<K> hits(size), misses(size);
+  std::vector<uint32_t> indices(size);
+  std::vector<void *> found(size);
+  bench_rng_t rng;
+  bench_rng_seed(&rng, BENCH_SEED);
+  for (uint64_t i = 0; i < size; ++i) {
+    // unique in the low 20 bits, the lowest one tells the two sets apart.
+    uint64_t value = bench_random(&rng) << 20;
+    make_key(&hits[i], value | (i * 2), allocator);
+    make_key(&misses[i], value | (i * 2 + 1), allocator);
+    indices[i] = (uint32_t)i;
+  }
+
+  const float load_factors[] = { 0.5f, 0.75f, 0.9f };
+  for (float load_factor : load_factors) {
+    char name[64];
+    chashmap_t map;
+    auto setup = [&]() {
+      chashmap_def(&map);
+      chashmap_setup(
+        &map, key_data, get_type_data(uint32_t),
+        allocator, load_factor); };
+    auto setup_filled = [&]() { setup(); fill(&map, hits, size); };
+    auto teardown = [&]() { chashmap_cleanup(&map, NULL); };
+
+    snprintf(name, sizeof(name), "insert_%s_lf%.2f", key_name, load_factor);
+    bench_run(
+      context, "chashmap", name, size, size, 0,
+      setup, [&]() { fill(&map, hits, size); }, teardown);
+
+    snprintf(
+      name, sizeof(name), "insert_batch_%s_lf%.2f", key_name, load_factor);
+    bench_run(
+      context, "chashmap", name, size, size, 0,
+      setup,
+      [&]() { chashmap_insert_batch(&map, hits.data(), indices.data(), size); },
+      teardown);
+
+    snprintf(name, sizeof(name), "find_hit_%s_lf%.2f", key_name, load_factor);
+    bench_run(
+      context, "chashmap", name, size, size, 0,
+      setup_filled,
+      [&]() {
+        uint64_t sum = 0;
+        uint32_t *value;
+        for (uint64_t i = 0; i < size; ++i) {
+          chashmap_at(&map, hits[i], K, uint32_t, value);
+          sum += *value;
+        }
+        bench_sink(sum); },
+      teardown);
+
+    snprintf(
+      name, sizeof(name), "find_miss_%s_lf%.2f", key_name, load_factor);
+    bench_run(
+      context, "chashmap", name, size, size, 0,
+      setup_filled,
+      [&]() {
+        uint64_t found = 0;
+        uint32_t *value;
+        for (uint64_t i = 0; i < size; ++i) {
+          chashmap_at(&map, misses[i], K, uint32_t, value);
+          found += value != NULL;
+        }
+        bench_sink(found); },
+      teardown);
+
+    snprintf(
+      name, sizeof(name), "find_hit_batch_%s_lf%.2f", key_name, load_factor);
+    bench_run(
+      context, "chashmap", name, size, size, 0,
+      setup_filled,
+      [&]() {
+        uint64_t sum = 0;
+        chashmap_find_batch(&map, hits.data(), size, found.data());
+        for (uint64_t i = 0; i < size; ++i)
+          sum += *(uint32_t *)found[i];
+        bench_sink(sum); },
+      teardown);
+
+    snprintf(
+      name, sizeof(name), "find_miss_batch_%s_lf%.2f", key_name, load_factor);
+    bench_run(
+      context, "chashmap", name, size, size, 0,
+      setup_filled,
+      [&]() {
+        uint64_t hits_found = 0;
+        chashmap_find_batch(&map, misses.data(), size, found.data());
+        for (uint64_t i = 0; i < size; ++i)
+          hits_found += found[i] != NULL;
+        bench_sink(hits_found); },
+      teardown);
+
+    // every key once, each erase shifts one probe back.
+    snprintf(name, sizeof(name), "erase_%s_lf%.2f", key_name, load_factor);
+    bench_run(
+      context, "chashmap", name, size, size, 0,
+      setup_filled,
+      [&]() {
+        for (uint64_t i = 0; i < size; ++i)
+          chashmap_erase(&map, hits[i], K); },
+      teardown);
+  }
+
+  free_keys(hits);
+  free_keys(misses);
+}
+
+void
+bench_chashmap_main(bench_context_t *context, const allocator_t *allocator)
+{
+  for (uint64_t size : bench_sizes(context, { 1000, 10000, 100000 })) {
+    bench_key_type<uint32_t>(
+      context, allocator, get_type_data(uint32_t), "u32", size);
+    bench_key_type<uint64_t>(
+      context, allocator, get_type_data(uint64_t), "u64", size);
+    bench_key_type<cstring_t>(
+      context, allocator, get_type_data(cstring_t), "cstring", size);
+  }
+}
\ No newline at end of file
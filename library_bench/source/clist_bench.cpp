@@ -0,0 +1,87 @@
+/**
+ * @file clist_bench.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <cstdint>
+#include <cstring>
+#include <bench.h>
+#include <library/allocator/allocator.h>
+#include <library/containers/clist.h>
+
+
+static
+void
+fill(clist_t *list, uint64_t count)
+{
+  for (uint64_t i = 0; i < count; ++i)
+    clist_push_front(list, (uint32_t)i, uint32_t);
+}
+
+void
+bench_clist_main(bench_context_t *context, const allocator_t *allocator)
+{
+  clist_t list;
+  auto setup = [&]() {
+    clist_def(&list);
+    clist_setup(&list, get_type_data(uint32_t), allocator); };
+  auto setup_filled = [&](uint64_t size) { setup(); fill(&list, size); };
+  auto teardown = [&]() { clist_cleanup(&list, NULL); };
+
+  for (uint64_t size : bench_sizes(context, { 1000, 100000, 1000000 })) {
+    bench_run(
+      context, "clist", "push_front", size, size, 0,
+      setup, [&]() { fill(&list, size); }, teardown);
+
+    bench_run(
+      context, "clist", "pop_front", size, size, 0,
+      [&]() { setup_filled(size); },
+      [&]() {
+        for (uint64_t i = 0; i < size; ++i)
+          clist_pop_front(&list); },
+      teardown);
+
+    bench_run(
+      context, "clist", "iterate", size, size, 0,
+      [&]() { setup_filled(size); },
+      [&]() {
+        uint64_t sum = 0;
+        clist_iterator_t iter = clist_begin(&list);
+        for (; !clist_iter_equal(iter, clist_end(&list)); clist_advance(&iter))
+          sum += *clist_deref(&iter, uint32_t);
+        bench_sink(sum); },
+      teardown);
+  }
+
+  // the back and indexed access are found walking from the head, quadratic.
+  for (uint64_t size : bench_sizes(context, { 1000, 10000 })) {
+    bench_run(
+      context, "clist", "pop_back", size, size, 0,
+      [&]() { setup_filled(size); },
+      [&]() {
+        for (uint64_t i = 0; i < size; ++i)
+          clist_pop_back(&list); },
+      teardown);
+
+    bench_run(
+      context, "clist", "push_back", size, size, 0,
+      setup,
+      [&]() {
+        for (uint64_t i = 0; i < size; ++i)
+          clist_push_back(&list, (uint32_t)i, uint32_t); },
+      teardown);
+
+    bench_run(
+      context, "clist", "erase_middle", size, size, 0,
+      [&]() { setup_filled(size); },
+      [&]() {
+        for (uint64_t i = 0; i < size; ++i)
+          clist_erase(&list, clist_size(&list) / 2); },
+      teardown);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,335 @@
+/**
+ * @file compare_bench.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief the library containers against their std counterparts
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include <bench.h>
+#include <library/containers/chashmap.h>
+#include <library/containers/clist.h>
+#include <library/containers/cvector.h>
+#include <library/containers/cvector_algorithm.h>
+
+// names are 'workload/<library container>' next to 'workload/std', the two
+// run the same sizes and keys.
+#define SIZES                         { 1000, 10000, 100000, 1000000, 10000000 }
+
+typedef std::vector<uint64_t, bench_std_allocator_t<uint64_t>> std_vector_t;
+typedef std::list<uint64_t, bench_std_allocator_t<uint64_t>> std_list_t;
+typedef
+std::unordered_map<
+  uint64_t, uint64_t,
+  std::hash<uint64_t>, std::equal_to<uint64_t>,
+  bench_std_allocator_t<std::pair<const uint64_t, uint64_t>>> std_map_t;
+
+
+/** 'count' distinct keys, the low bit is 'odd' so two sets never meet. */
+static
+std::vector<uint64_t>
+make_keys(uint64_t count, uint64_t seed, uint64_t odd)
+{
+  std::vector<uint64_t> keys(count);
+  bench_rng_t rng;
+  bench_rng_seed(&rng, seed);
+  for (uint64_t i = 0; i < count; ++i)
+    keys[i] = (bench_random(&rng) << 25) | (i << 1) | odd;
+  return keys;
+}
+
+static
+void
+bench_vectors(bench_context_t *context)
+{
+  const char *suite = "compare_vector";
+  cvector_t cvec;
+  std_vector_t svec;
+  auto csetup = [&]() {
+    cvector_def(&cvec);
+    cvector_setup(&cvec, get_type_data(uint64_t), 0, bench_allocator()); };
+  auto cteardown = [&]() { cvector_cleanup(&cvec, NULL); };
+  auto steardown = [&]() { std_vector_t().swap(svec); };
+
+  for (uint64_t size : bench_sizes(context, SIZES)) {
+    std::vector<uint64_t> values = make_keys(size, BENCH_SEED, 0);
+    auto cfill = [&]() {
+      for (uint64_t i = 0; i < size; ++i)
+        cvector_push_back(&cvec, values[i], uint64_t); };
+    auto sfill = [&]() {
+      for (uint64_t i = 0; i < size; ++i)
+        svec.push_back(values[i]); };
+
+    bench_run(
+      context, suite, "push_back/cvector", size, size, 0,
+      csetup, cfill, cteardown);
+    bench_run(
+      context, suite, "push_back/std", size, size, 0,
+      nullptr, sfill, steardown);
+
+    bench_run(
+      context, suite, "iterate/cvector", size, size, 0,
+      [&]() { csetup(); cfill(); },
+      [&]() {
+        uint64_t sum = 0;
+        uint64_t *begin = cvector_begin(&cvec, uint64_t);
+        uint64_t *end = cvector_end(&cvec, uint64_t);
+        for (; begin != end; ++begin)
+          sum += *begin;
+        bench_sink(sum); },
+      cteardown);
+    bench_run(
+      context, suite, "iterate/std", size, size, 0,
+      sfill,
+      [&]() {
+        uint64_t sum = 0;
+        for (uint64_t value : svec)
+          sum += value;
+        bench_sink(sum); },
+      steardown);
+
+    // through the checked accessor, like the library's own code does.
+    bench_run(
+      context, suite, "random_access/cvector", size, size, 0,
+      [&]() { csetup(); cfill(); },
+      [&]() {
+        bench_rng_t rng;
+        uint64_t sum = 0;
+        bench_rng_seed(&rng, BENCH_SEED);
+        for (uint64_t i = 0; i < size; ++i)
+          sum += *(uint64_t *)cvector_at(&cvec, bench_random(&rng) % size);
+        bench_sink(sum); },
+      cteardown);
+    bench_run(
+      context, suite, "random_access/std", size, size, 0,
+      sfill,
+      [&]() {
+        bench_rng_t rng;
+        uint64_t sum = 0;
+        bench_rng_seed(&rng, BENCH_SEED);
+        for (uint64_t i = 0; i < size; ++i)
+          sum += svec[bench_random(&rng) % size];
+        bench_sink(sum); },
+      steardown);
+
+    bench_run(
+      context, suite, "sort/cvector", size, size, 0,
+      [&]() { csetup(); cfill(); },
+      [&]() { cvector_sort(&cvec, NULL, NULL); },
+      cteardown);
+    bench_run(
+      context, suite, "sort/std", size, size, 0,
+      sfill, [&]() { std::sort(svec.begin(), svec.end()); }, steardown);
+  }
+}
+
+static
+void
+bench_maps(bench_context_t *context)
+{
+  const char *suite = "compare_hashmap";
+  chashmap_t cmap;
+  std_map_t *smap = NULL;
+  auto csetup = [&]() {
+    chashmap_def(&cmap);
+    chashmap_setup(
+      &cmap, get_type_data(uint64_t), get_type_data(uint64_t),
+      bench_allocator(), 0.75f); };
+  auto cteardown = [&]() { chashmap_cleanup(&cmap, NULL); };
+  auto ssetup = [&]() { smap = new std_map_t(); };
+  auto steardown = [&]() { delete smap; smap = NULL; };
+
+  for (uint64_t size : bench_sizes(context, SIZES)) {
+    std::vector<uint64_t> hits = make_keys(size, BENCH_SEED, 0);
+    std::vector<uint64_t> misses = make_keys(size, BENCH_SEED + 1, 1);
+    std::vector<uint64_t> ranks(size);
+    std::vector<void *> found(size);
+    for (uint64_t i = 0; i < size; ++i)
+      ranks[i] = i;
+    auto cfill = [&]() {
+      for (uint64_t i = 0; i < size; ++i)
+        chashmap_insert(&cmap, hits[i], uint64_t, i, uint64_t); };
+    auto sfill = [&]() {
+      for (uint64_t i = 0; i < size; ++i)
+        (*smap)[hits[i]] = i; };
+
+    bench_run(
+      context, suite, "insert/chashmap", size, size, 0,
+      csetup, cfill, cteardown);
+    bench_run(
+      context, suite, "insert/chashmap_batch", size, size, 0,
+      csetup,
+      [&]() { chashmap_insert_batch(&cmap, hits.data(), ranks.data(), size); },
+      cteardown);
+    bench_run(
+      context, suite, "insert/std", size, size, 0,
+      ssetup, sfill, steardown);
+
+    bench_run(
+      context, suite, "find_hit/chashmap", size, size, 0,
+      [&]() { csetup(); cfill(); },
+      [&]() {
+        uint64_t sum = 0, *value;
+        for (uint64_t i = 0; i < size; ++i) {
+          chashmap_at(&cmap, hits[i], uint64_t, uint64_t, value);
+          sum += *value;
+        }
+        bench_sink(sum); },
+      cteardown);
+    bench_run(
+      context, suite, "find_hit/chashmap_batch", size, size, 0,
+      [&]() { csetup(); cfill(); },
+      [&]() {
+        uint64_t sum = 0;
+        chashmap_find_batch(&cmap, hits.data(), size, found.data());
+        for (uint64_t i = 0; i < size; ++i)
+          sum += *(uint64_t *)found[i];
+        bench_sink(sum); },
+      cteardown);
+    bench_run(
+      context, suite, "find_hit/std", size, size, 0,
+      [&]() { ssetup(); sfill(); },
+      [&]() {
+        uint64_t sum = 0;
+        for (uint64_t i = 0; i < size; ++i)
+          sum += smap->find(hits[i])->second;
+        bench_sink(sum); },
+      steardown);
+
+    bench_run(
+      context, suite, "find_miss/chashmap", size, size, 0,
+      [&]() { csetup(); cfill(); },
+      [&]() {
+        uint64_t found = 0, *value;
+        for (uint64_t i = 0; i < size; ++i) {
+          chashmap_at(&cmap, misses[i], uint64_t, uint64_t, value);
+          found += value != NULL;
+        }
+        bench_sink(found); },
+      cteardown);
+    bench_run(
+      context, suite, "find_miss/std", size, size, 0,
+      [&]() { ssetup(); sfill(); },
+      [&]() {
+        uint64_t found = 0;
+        for (uint64_t i = 0; i < size; ++i)
+          found += smap->find(misses[i]) != smap->end();
+        bench_sink(found); },
+      steardown);
+
+    bench_run(
+      context, suite, "erase/chashmap", size, size, 0,
+      [&]() { csetup(); cfill(); },
+      [&]() {
+        for (uint64_t i = 0; i < size; ++i)
+          chashmap_erase(&cmap, hits[i], uint64_t); },
+      cteardown);
+    bench_run(
+      context, suite, "erase/std", size, size, 0,
+      [&]() { ssetup(); sfill(); },
+      [&]() {
+        for (uint64_t i = 0; i < size; ++i)
+          smap->erase(hits[i]); },
+      steardown);
+  }
+}
+
+static
+void
+bench_lists(bench_context_t *context)
+{
+  const char *suite = "compare_list";
+  clist_t clist;
+  std_list_t slist;
+  auto csetup = [&]() {
+    clist_def(&clist);
+    clist_setup(&clist, get_type_data(uint64_t), bench_allocator()); };
+  auto cteardown = [&]() { clist_cleanup(&clist, NULL); };
+  auto steardown = [&]() { slist.clear(); };
+
+  for (uint64_t size : bench_sizes(context, SIZES)) {
+    auto cfill = [&]() {
+      for (uint64_t i = 0; i < size; ++i)
+        clist_push_front(&clist, i, uint64_t); };
+    auto sfill = [&]() {
+      for (uint64_t i = 0; i < size; ++i)
+        slist.push_front(i); };
+
+    bench_run(
+      context, suite, "push_front/clist", size, size, 0,
+      csetup, cfill, cteardown);
+    bench_run(
+      context, suite, "push_front/std", size, size, 0,
+      nullptr, sfill, steardown);
+
+    bench_run(
+      context, suite, "iterate/clist", size, size, 0,
+      [&]() { csetup(); cfill(); },
+      [&]() {
+        uint64_t sum = 0;
+        clist_iterator_t iter = clist_begin(&clist);
+        for (; !clist_iter_equal(iter, clist_end(&clist)); clist_advance(&iter))
+          sum += *clist_deref(&iter, uint64_t);
+        bench_sink(sum); },
+      cteardown);
+    bench_run(
+      context, suite, "iterate/std", size, size, 0,
+      sfill,
+      [&]() {
+        uint64_t sum = 0;
+        for (uint64_t value : slist)
+          sum += value;
+        bench_sink(sum); },
+      steardown);
+
+    bench_run(
+      context, suite, "pop_front/clist", size, size, 0,
+      [&]() { csetup(); cfill(); },
+      [&]() {
+        for (uint64_t i = 0; i < size; ++i)
+          clist_pop_front(&clist); },
+      cteardown);
+    bench_run(
+      context, suite, "pop_front/std", size, size, 0,
+      sfill,
+      [&]() {
+        for (uint64_t i = 0; i < size; ++i)
+          slist.pop_front(); },
+      steardown);
+
+    // the clist finds its back walking from the head, quadratic.
+    if (size > 10000)
+      continue;
+    bench_run(
+      context, suite, "push_back/clist", size, size, 0,
+      csetup,
+      [&]() {
+        for (uint64_t i = 0; i < size; ++i)
+          clist_push_back(&clist, i, uint64_t); },
+      cteardown);
+    bench_run(
+      context, suite, "push_back/std", size, size, 0,
+      nullptr,
+      [&]() {
+        for (uint64_t i = 0; i < size; ++i)
+          slist.push_back(i); },
+      steardown);
+  }
+}
+
+void
+bench_compare_main(bench_context_t *context)
+{
+  bench_vectors(context);
+  bench_maps(context);
+  bench_lists(context);
+}
\ No newline at end of file
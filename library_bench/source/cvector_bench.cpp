@@ -0,0 +1,113 @@
+/**
+ * @file cvector_bench.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <cstdint>
+#include <cstring>
+#include <bench.h>
+#include <library/allocator/allocator.h>
+#include <library/containers/cvector.h>
+
+
+static
+void
+fill(cvector_t *vec, uint64_t count)
+{
+  for (uint64_t i = 0; i < count; ++i)
+    cvector_push_back(vec, (uint32_t)i, uint32_t);
+}
+
+void
+bench_cvector_main(bench_context_t *context, const allocator_t *allocator)
+{
+  cvector_t vec;
+  auto setup = [&]() {
+    cvector_def(&vec);
+    cvector_setup(&vec, get_type_data(uint32_t), 0, allocator); };
+  auto teardown = [&]() { cvector_cleanup(&vec, NULL); };
+
+  for (uint64_t size : bench_sizes(context, { 1000, 100000, 1000000 })) {
+    bench_run(
+      context, "cvector", "push_back", size, size, 0,
+      setup, [&]() { fill(&vec, size); }, teardown);
+
+    bench_run(
+      context, "cvector", "push_back_reserved", size, size, 0,
+      [&]() { setup(); cvector_reserve(&vec, size); },
+      [&]() { fill(&vec, size); }, teardown);
+
+    bench_run(
+      context, "cvector", "pop_back", size, size, 0,
+      [&]() { setup(); fill(&vec, size); },
+      [&]() {
+        for (uint64_t i = 0; i < size; ++i)
+          cvector_pop_back(&vec); },
+      teardown);
+
+    bench_run(
+      context, "cvector", "iterate", size, size, 0,
+      [&]() { setup(); fill(&vec, size); },
+      [&]() {
+        uint64_t sum = 0;
+        for (uint64_t i = 0; i < size; ++i)
+          sum += *cvector_as(&vec, i, uint32_t);
+        bench_sink(sum); },
+      teardown);
+
+    bench_run(
+      context, "cvector", "random_access", size, size, 0,
+      [&]() { setup(); fill(&vec, size); },
+      [&]() {
+        bench_rng_t rng;
+        uint64_t sum = 0;
+        bench_rng_seed(&rng, BENCH_SEED);
+        for (uint64_t i = 0; i < size; ++i)
+          sum += *cvector_as(&vec, bench_random(&rng) % size, uint32_t);
+        bench_sink(sum); },
+      teardown);
+  }
+
+  // front and middle inserts/erases move everything after them, quadratic.
+  for (uint64_t size : bench_sizes(context, { 1000, 10000, 50000 })) {
+    bench_run(
+      context, "cvector", "insert_front", size, size, 0,
+      setup,
+      [&]() {
+        for (uint64_t i = 0; i < size; ++i)
+          cvector_insert(&vec, 0, (uint32_t)i, uint32_t); },
+      teardown);
+
+    bench_run(
+      context, "cvector", "insert_middle", size, size, 0,
+      setup,
+      [&]() {
+        for (uint64_t i = 0; i < size; ++i)
+          cvector_insert(&vec, cvector_size(&vec) / 2, (uint32_t)i, uint32_t);
+      },
+      teardown);
+
+    bench_run(
+      context, "cvector", "erase_front", size, size, 0,
+      [&]() { setup(); fill(&vec, size); },
+      [&]() {
+        for (uint64_t i = 0; i < size; ++i)
+          cvector_erase(&vec, 0); },
+      teardown);
+
+    bench_run(
+      context, "cvector", "erase_random", size, size, 0,
+      [&]() { setup(); fill(&vec, size); },
+      [&]() {
+        bench_rng_t rng;
+        bench_rng_seed(&rng, BENCH_SEED);
+        for (uint64_t i = 0; i < size; ++i)
+          cvector_erase(&vec, bench_random(&rng) % cvector_size(&vec)); },
+      teardown);
+  }
+}
\ No newline at end of file
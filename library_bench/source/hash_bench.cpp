@@ -0,0 +1,54 @@
+/**
+ * @file hash_bench.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <cstdint>
+#include <vector>
+#include <bench.h>
+#include <library/allocator/allocator.h>
+#include <library/hash/fnv.h>
+
+
+void
+bench_hash_main(bench_context_t *context, const allocator_t *allocator)
+{
+  (void)allocator;
+
+  // about 16 MB hashed per repetition whatever the length.
+  const uint64_t total = context->options.smoke ? 1 << 16 : 1 << 24;
+  for (uint64_t length : std::vector<uint64_t>{ 4, 8, 16, 64, 256, 4096 }) {
+    uint64_t count = total / length;
+    std::vector<uint8_t> data(length + 64);
+    bench_rng_t rng;
+    bench_rng_seed(&rng, BENCH_SEED);
+    for (uint8_t &byte : data)
+      byte = (uint8_t)bench_random(&rng);
+
+    // the start moves so the hash cannot be folded across calls.
+    bench_run(
+      context, "hash", "fnv1a_32", length, count, length * count,
+      nullptr,
+      [&]() {
+        uint64_t sum = 0;
+        for (uint64_t i = 0; i < count; ++i)
+          sum += hash_fnv1a_32(data.data() + (i & 63), length);
+        bench_sink(sum); },
+      nullptr);
+
+    bench_run(
+      context, "hash", "fnv1a_64", length, count, length * count,
+      nullptr,
+      [&]() {
+        uint64_t sum = 0;
+        for (uint64_t i = 0; i < count; ++i)
+          sum += hash_fnv1a_64(data.data() + (i & 63), length);
+        bench_sink(sum); },
+      nullptr);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,129 @@
+/**
+ * @file main.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <bench.h>
+#include <library/allocator/allocator.h>
+
+
+void
+bench_cvector_main(bench_context_t *context, const allocator_t *allocator);
+
+void
+bench_chashmap_main(bench_context_t *context, const allocator_t *allocator);
+
+void
+bench_clist_main(bench_context_t *context, const allocator_t *allocator);
+
+void
+bench_hash_main(bench_context_t *context, const allocator_t *allocator);
+
+void
+bench_binary_stream_main(
+  bench_context_t *context,
+  const allocator_t *allocator);
+
+void
+bench_allocator_main(bench_context_t *context, const allocator_t *allocator);
+
+void
+bench_compare_main(bench_context_t *context);
+
+void
+bench_workload_main(bench_context_t *context);
+
+uint32_t
+bench_replay_main(bench_context_t *context, const char *path);
+
+static
+void
+print_usage(const char *program)
+{
+  std::cerr << "usage: " << program << " [options]\n"
+    "  --format csv|json   report format (csv)\n"
+    "  --out <path>        report file (stdout)\n"
+    "  --filter <text>     runs what 'suite/name' contains text\n"
+    "  --warmup <n>        untimed repetitions (1)\n"
+    "  --reps <n>          timed repetitions (5)\n"
+    "  --max-size <n>      skips the sizes above n\n"
+    "  --perf              hardware counters, linux perf_event_open\n"
+    "  --replay <path>     times a recorded workload trace, nothing else\n"
+    "  --smoke             smallest sizes, a single repetition\n";
+}
+
+int
+main(int argc, char *argv[])
+{
+  bench_options_t options;
+  const char *replay = NULL;
+  for (int i = 1; i < argc; ++i) {
+    const char *arg = argv[i];
+    const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+    if (!strcmp(arg, "--smoke"))
+      options.smoke = 1;
+    else if (!strcmp(arg, "--perf"))
+      options.perf = 1;
+    else if (!strcmp(arg, "--format") && value)
+      options.format = argv[++i];
+    else if (!strcmp(arg, "--out") && value)
+      options.out = argv[++i];
+    else if (!strcmp(arg, "--filter") && value)
+      options.filter = argv[++i];
+    else if (!strcmp(arg, "--warmup") && value)
+      options.warmup = (uint32_t)strtoul(argv[++i], NULL, 10);
+    else if (!strcmp(arg, "--reps") && value)
+      options.repetitions = (uint32_t)strtoul(argv[++i], NULL, 10);
+    else if (!strcmp(arg, "--max-size") && value)
+      options.max_size = strtoull(argv[++i], NULL, 10);
+    else if (!strcmp(arg, "--replay") && value)
+      replay = argv[++i];
+    else {
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (
+    !options.repetitions ||
+    (options.format != "csv" && options.format != "json")) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  bench_context_t context;
+  bench_setup(&context, options);
+  if (replay) {
+    if (!bench_replay_main(&context, replay)) {
+      std::cerr << "could not load the trace " << replay << std::endl;
+      bench_cleanup(&context);
+      return 1;
+    }
+  } else {
+    // the containers allocate through the counting allocator, the allocator
+    // benchmarks time the library's own.
+    bench_cvector_main(&context, bench_allocator());
+    bench_chashmap_main(&context, bench_allocator());
+    bench_clist_main(&context, bench_allocator());
+    bench_hash_main(&context, bench_allocator());
+    bench_binary_stream_main(&context, bench_allocator());
+    bench_allocator_main(&context, &g_default_allocator);
+    bench_compare_main(&context);
+    bench_workload_main(&context);
+  }
+
+  bench_cleanup(&context);
+  if (!bench_report(&context)) {
+    std::cerr << "could not write " << options.out << std::endl;
+    return 1;
+  }
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+/**
+ * @file workload_bench.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief generated traces replayed against the containers, and --replay
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <cstdint>
+#include <string>
+#include <bench.h>
+#include <library/allocator/allocator.h>
+#include <library/workload/workload.h>
+
+// names are '<target>/<distribution>', the size is the number of operations.
+// the traces are generated outside the timings, a replay sets up and cleans
+// up its container inside them.
+
+
+static
+workload_mix_t
+make_mix(workload_target_t target, uint64_t size)
+{
+  workload_mix_t mix = {};
+  mix.weights[WORKLOAD_OP_FIND] = 6000;
+  mix.weights[WORKLOAD_OP_INSERT] = 3000;
+  mix.weights[WORKLOAD_OP_ITERATE] = 1;
+  if (target == WORKLOAD_TARGET_CHASHMAP) {
+    mix.weights[WORKLOAD_OP_ERASE] = 50;
+    return mix;
+  }
+
+  // churn at the ends, fewer of the inserts/erases that move or walk.
+  mix.weights[WORKLOAD_OP_INSERT] = 100;
+  mix.weights[WORKLOAD_OP_ERASE] = 100;
+  mix.weights[WORKLOAD_OP_PUSH_BACK] = 3000;
+  mix.weights[WORKLOAD_OP_POP_BACK] = 1500;
+  if (target == WORKLOAD_TARGET_CLIST) {
+    mix.weights[WORKLOAD_OP_PUSH_FRONT] = 3000;
+    mix.weights[WORKLOAD_OP_POP_FRONT] = 1500;
+  }
+  return mix;
+}
+
+static
+void
+bench_trace(
+  bench_context_t *context,
+  const char *name,
+  const workload_trace_t *trace)
+{
+  uint64_t ops = cvector_size(&trace->ops);
+  bench_run(
+    context, "workload", name, ops, ops, 0,
+    nullptr,
+    [&]() { bench_sink(workload_replay(trace, bench_allocator())); },
+    nullptr);
+}
+
+static
+void
+bench_target(
+  bench_context_t *context,
+  workload_target_t target,
+  const std::vector<uint64_t> &sizes)
+{
+  for (uint64_t size : bench_sizes(context, sizes)) {
+    for (uint32_t d = 0; d < WORKLOAD_DISTRIBUTION_COUNT; ++d) {
+      workload_distribution_t distribution = (workload_distribution_t)d;
+      workload_key_params_t params;
+      workload_mix_t mix = make_mix(target, size);
+      workload_keys_t keys;
+      workload_trace_t trace;
+      std::string name =
+        std::string(workload_target_name(target)) + "/" +
+        workload_distribution_name(distribution);
+
+      // colliding keys never repeat and pile into one probe chain, every
+      // insert and find walks it.
+      if (
+        distribution == WORKLOAD_FNV_COLLISIONS &&
+        target == WORKLOAD_TARGET_CHASHMAP && size > 10000)
+        continue;
+
+      params.distribution = distribution;
+      params.universe = size / 4 ? size / 4 : 1;
+      params.zipf_exponent = 0.99;
+      params.collision_bits = 12;
+      params.seed = BENCH_SEED;
+      workload_keys_setup(&keys, &params);
+      workload_trace_setup(&trace, target, &g_default_allocator);
+      workload_trace_generate(&trace, &keys, &mix, size, BENCH_SEED);
+      bench_trace(context, name.c_str(), &trace);
+      workload_trace_cleanup(&trace);
+    }
+  }
+}
+
+void
+bench_workload_main(bench_context_t *context)
+{
+  bench_target(context, WORKLOAD_TARGET_CHASHMAP, { 10000, 100000, 1000000 });
+  bench_target(context, WORKLOAD_TARGET_CVECTOR, { 10000, 100000 });
+  // finds, inserts and erases walk the list, and so does push_back.
+  bench_target(context, WORKLOAD_TARGET_CLIST, { 1000, 10000 });
+}
+
+uint32_t
+bench_replay_main(bench_context_t *context, const char *path)
+{
+  workload_trace_t trace;
+  if (!workload_trace_load(&trace, path, &g_default_allocator))
+    return 0;
+
+  bench_trace(
+    context,
+    (std::string(workload_target_name(trace.target)) + "/replay").c_str(),
+    &trace);
+  workload_trace_cleanup(&trace);
+  return 1;
+}
\ No newline at end of file
@@ -10,7 +10,13 @@
  */
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
 #include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
 
 #ifndef __FUNCTION_NAME__
     #ifdef WIN32   //WINDOWS
@@ -22,9 +28,26 @@
 
 #define TABS std::string(tabs, '\t')
 #define CTABS std::cout << TABS
-#define PRINT_FUNCTION CTABS << "-------[" __FUNCTION_NAME__ "]-------" \
+#define PRINT_FUNCTION CTABS << "-------[" << __FUNCTION_NAME__ << "]-------" \
   << std::endl
 #define PRINT_DESC(x) CTABS << ">>>>>>> " << x << " <<<<<<<" << std::endl
 #define PRINT_BOOL(x) #x << " = " << (x ? "true" : "false")
 #define PRINT(x) #x << " = " << x
 #define NEWLINE std::cout << std::endl
+
+// a fixture file or directory of its own for every process, so several test
+// processes can run at once.
+inline
+std::filesystem::path
+unique_temp_path(const std::string &name)
+{
+  std::filesystem::path path(name);
+  std::ostringstream unique;
+  uint64_t seed =
+    ((uint64_t)std::random_device{}() << 32) ^
+    (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+  // the suffix goes before the extension, 'name.bin' -> 'name_<hex>.bin'.
+  unique << path.stem().string() << "_" << std::hex << seed <<
+    path.extension().string();
+  return std::filesystem::temp_directory_path() / unique.str();
+}
\ No newline at end of file
@@ -0,0 +1,295 @@
+/**
+ * @file asset_cache_test.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <common.h>
+#include <library/allocator/allocator.h>
+#include <library/asset/asset_cache.h>
+#include <library/core/core.h>
+#include <library/type_registry/type_registry.h>
+
+
+typedef
+struct test_texture_t {
+  uint32_t id;
+} test_texture_t;
+
+// a material references the textures 'id' and 'id + 1'.
+typedef
+struct test_material_t {
+  asset_ref_t textures[2];
+} test_material_t;
+
+static std::atomic<uint32_t> s_texture_loads(0);
+static std::atomic<uint32_t> s_texture_deloads(0);
+static std::atomic<uint32_t> s_material_loads(0);
+static std::atomic<uint32_t> s_material_deloads(0);
+
+static
+uint32_t
+id_from_path(const asset_ref_t *ref)
+{
+  return (uint32_t)atoi(strchr(ref->path.str, '_') + 1);
+}
+
+static
+void
+texture_load(void **out, const asset_ref_t *ref, const allocator_t *allocator)
+{
+  test_texture_t *texture =
+    (test_texture_t *)allocator->mem_alloc(sizeof(test_texture_t));
+  texture->id = id_from_path(ref);
+  *out = texture;
+  ++s_texture_loads;
+}
+
+static
+void
+texture_deload(void **ptr, const asset_ref_t *ref, const allocator_t *allocator)
+{
+  assert(((test_texture_t *)*ptr)->id == id_from_path(ref));
+  allocator->mem_free(*ptr);
+  *ptr = NULL;
+  ++s_texture_deloads;
+}
+
+static
+void
+material_load(void **out, const asset_ref_t *ref, const allocator_t *allocator)
+{
+  uint32_t id = id_from_path(ref);
+  test_material_t *material =
+    (test_material_t *)allocator->mem_alloc(sizeof(test_material_t));
+  for (uint32_t i = 0; i < 2; ++i) {
+    std::string path = "tex_" + std::to_string(id + i);
+    asset_ref_def(material->textures + i);
+    cstring_setup(&material->textures[i].path, path.c_str(), allocator);
+    material->textures[i].type_id = get_type_id(test_texture_t);
+  }
+  *out = material;
+  ++s_material_loads;
+}
+
+static
+void
+material_deload(void **ptr, const asset_ref_t *ref, const allocator_t *allocator)
+{
+  test_material_t *material = (test_material_t *)*ptr;
+  asset_ref_cleanup(material->textures + 0, allocator);
+  asset_ref_cleanup(material->textures + 1, allocator);
+  allocator->mem_free(material);
+  *ptr = NULL;
+  ++s_material_deloads;
+}
+
+static loader_t texture_get_loader(void) { return texture_load; }
+static deloader_t texture_get_deloader(void) { return texture_deload; }
+static loader_t material_get_loader(void) { return material_load; }
+static deloader_t material_get_deloader(void) { return material_deload; }
+static uint32_t material_asset_count(const void *src) { return 2; }
+static uint32_t is_asset_type(void) { return 1; }
+
+static
+void
+material_get_assets(const void *src, const asset_ref_t *refs[])
+{
+  const test_material_t *material = (const test_material_t *)src;
+  refs[0] = material->textures + 0;
+  refs[1] = material->textures + 1;
+}
+
+INITIALIZER(register_test_asset_types)
+{
+  vtable_t vtable;
+  memset(&vtable, 0, sizeof(vtable_t));
+  vtable.fn_get_loader = texture_get_loader;
+  vtable.fn_get_deloader = texture_get_deloader;
+  vtable.fn_is_asset_type = is_asset_type;
+  register_type(get_type_id(test_texture_t), &vtable);
+
+  memset(&vtable, 0, sizeof(vtable_t));
+  vtable.fn_get_loader = material_get_loader;
+  vtable.fn_get_deloader = material_get_deloader;
+  vtable.fn_type_asset_count = material_asset_count;
+  vtable.fn_type_get_assets = material_get_assets;
+  vtable.fn_is_asset_type = is_asset_type;
+  register_type(get_type_id(test_material_t), &vtable);
+}
+
+static
+uint64_t
+asset_size(const asset_ref_t *ref, const void *asset)
+{
+  return ref->type_id == get_type_id(test_texture_t) ? 100 : 10;
+}
+
+static
+asset_ref_t
+make_ref(const std::string &path, uint32_t type_id)
+{
+  asset_ref_t ref;
+  asset_ref_def(&ref);
+  cstring_setup(&ref.path, path.c_str(), &g_default_allocator);
+  ref.type_id = type_id;
+  return ref;
+}
+
+static
+void
+reset_counters(void)
+{
+  s_texture_loads = s_texture_deloads = 0;
+  s_material_loads = s_material_deloads = 0;
+}
+
+static
+void
+test_asset_cache_inline(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  reset_counters();
+  uint32_t texture = get_type_id(test_texture_t);
+  asset_cache_t cache;
+  asset_cache_stats_t stats;
+  asset_cache_setup(&cache, 250, 0, asset_size, allocator);
+
+  // the same texture referenced a thousand times loads once.
+  asset_ref_t ref = make_ref("tex_1", texture);
+  std::vector<asset_handle_t *> handles;
+  for (uint32_t i = 0; i < 1000; ++i)
+    handles.push_back(asset_cache_acquire(&cache, &ref));
+  for (uint32_t i = 1; i < 1000; ++i)
+    assert(handles[i] == handles[0]);
+  test_texture_t *loaded =
+    (test_texture_t *)asset_cache_wait(&cache, handles[0]);
+  assert(loaded && loaded->id == 1 && asset_cache_get(handles[0]) == loaded);
+  asset_cache_get_stats(&cache, &stats);
+  CTABS << PRINT(stats.loads) << ", " << PRINT(stats.hits) << std::endl;
+  assert(s_texture_loads == 1 && stats.hits == 999 && stats.resident == 100);
+  for (uint32_t i = 0; i < 1000; ++i)
+    asset_cache_release(&cache, handles[i]);
+  asset_ref_cleanup(&ref, &g_default_allocator);
+
+  // released assets stay cached until the budget is exceeded, oldest first.
+  for (uint32_t i = 2; i <= 3; ++i) {
+    ref = make_ref("tex_" + std::to_string(i), texture);
+    asset_cache_release(&cache, asset_cache_acquire(&cache, &ref));
+    asset_ref_cleanup(&ref, &g_default_allocator);
+  }
+  asset_cache_get_stats(&cache, &stats);
+  assert(stats.evictions == 1 && stats.resident == 200);
+  assert(s_texture_loads == 3 && s_texture_deloads == 1);
+
+  ref = make_ref("tex_3", texture);
+  asset_handle_t *handle = asset_cache_acquire(&cache, &ref);
+  assert(s_texture_loads == 3);
+  asset_cache_release(&cache, handle);
+  asset_ref_cleanup(&ref, &g_default_allocator);
+
+  // a material pins its textures, they are preloaded with it.
+  ref = make_ref("mat_5", get_type_id(test_material_t));
+  handle = asset_cache_acquire(&cache, &ref);
+  test_material_t *material = (test_material_t *)asset_cache_wait(&cache, handle);
+  assert(material && s_material_loads == 1 && s_texture_loads == 5);
+  asset_handle_t *dependency =
+    asset_cache_acquire(&cache, material->textures + 1);
+  assert(asset_cache_state(dependency) == ASSET_STATE_READY);
+  assert(((test_texture_t *)asset_cache_get(dependency))->id == 6);
+  asset_cache_release(&cache, dependency);
+  asset_cache_get_stats(&cache, &stats);
+  CTABS << PRINT(stats.resident) << ", " << PRINT(stats.evictions) << std::endl;
+  assert(stats.resident == 210 && s_texture_loads == 5);
+
+  // evicting the material releases its textures which can then go too.
+  asset_cache_release(&cache, handle);
+  asset_ref_cleanup(&ref, &g_default_allocator);
+  ref = make_ref("tex_9", texture);
+  asset_cache_release(&cache, asset_cache_acquire(&cache, &ref));
+  asset_ref_cleanup(&ref, &g_default_allocator);
+  asset_cache_get_stats(&cache, &stats);
+  assert(s_material_deloads == 1 && stats.resident <= 250);
+
+  // unknown types fail without a load.
+  ref = make_ref("missing_0", get_type_id(asset_cache_t));
+  handle = asset_cache_acquire(&cache, &ref);
+  void *missing = asset_cache_wait(&cache, handle);
+  assert(!missing);
+  assert(asset_cache_state(handle) == ASSET_STATE_FAILED);
+  asset_cache_release(&cache, handle);
+
+  // the failure went with the last release, the next acquire tries again.
+  asset_cache_get_stats(&cache, &stats);
+  uint64_t hits = stats.hits;
+  handle = asset_cache_acquire(&cache, &ref);
+  missing = asset_cache_wait(&cache, handle);
+  asset_cache_get_stats(&cache, &stats);
+  assert(!missing && stats.hits == hits && stats.failures == 2);
+  asset_cache_release(&cache, handle);
+  asset_ref_cleanup(&ref, &g_default_allocator);
+
+  asset_cache_cleanup(&cache);
+  assert(s_texture_loads == s_texture_deloads);
+  assert(s_material_loads == s_material_deloads);
+}
+
+static
+void
+test_asset_cache_workers(const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  reset_counters();
+  const uint32_t count = 64, repeat = 16;
+  asset_cache_t cache;
+  asset_cache_stats_t stats;
+  asset_cache_setup(&cache, 1 << 20, 4, asset_size, &g_default_allocator);
+
+  std::vector<asset_ref_t> refs;
+  std::vector<asset_handle_t *> handles;
+  for (uint32_t i = 0; i < count; ++i)
+    refs.push_back(make_ref("tex_" + std::to_string(i), get_type_id(test_texture_t)));
+  for (uint32_t r = 0; r < repeat; ++r)
+    for (uint32_t i = 0; i < count; ++i)
+      handles.push_back(asset_cache_acquire(&cache, &refs[i]));
+
+  for (uint32_t i = 0; i < count * repeat; ++i) {
+    test_texture_t *texture =
+      (test_texture_t *)asset_cache_wait(&cache, handles[i]);
+    assert(texture && texture->id == i % count);
+  }
+
+  asset_cache_get_stats(&cache, &stats);
+  CTABS << PRINT(stats.loads) << ", " << PRINT(stats.hits) << std::endl;
+  assert(s_texture_loads == count && stats.loads == count);
+  assert(stats.hits == count * (repeat - 1));
+
+  for (asset_handle_t *handle : handles)
+    asset_cache_release(&cache, handle);
+  for (asset_ref_t &ref : refs)
+    asset_ref_cleanup(&ref, &g_default_allocator);
+  asset_cache_cleanup(&cache);
+  assert(s_texture_deloads == count);
+}
+
+void
+test_asset_cache_main(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  test_asset_cache_inline(allocator, tabs + 1);   NEWLINE;
+  test_asset_cache_workers(tabs + 1);             NEWLINE;
+}
\ No newline at end of file
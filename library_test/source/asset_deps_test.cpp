@@ -0,0 +1,295 @@
+/**
+ * @file asset_deps_test.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <common.h>
+#include <library/allocator/allocator.h>
+#include <library/asset/asset_cache.h>
+#include <library/asset/asset_deps.h>
+#include <library/containers/chashmap.h>
+#include <library/containers/cvector.h>
+#include <library/core/core.h>
+#include <library/type_registry/type_registry.h>
+
+
+typedef
+struct deps_texture_t {
+  uint32_t id;
+} deps_texture_t;
+
+// material 'k' references the textures 'k' and 'k + 1'.
+typedef
+struct deps_material_t {
+  asset_ref_t textures[2];
+} deps_material_t;
+
+typedef
+struct deps_entity_t {
+  asset_ref_t material;
+  float position[3];
+} deps_entity_t;
+
+static std::atomic<uint32_t> s_loads(0);
+static std::atomic<uint32_t> s_deloads(0);
+
+static
+uint32_t
+id_from_path(const asset_ref_t *ref)
+{
+  return (uint32_t)atoi(strchr(ref->path.str, '_') + 1);
+}
+
+static
+void
+setup_ref(
+  asset_ref_t *ref,
+  const std::string &path,
+  uint32_t type_id,
+  const allocator_t *allocator)
+{
+  asset_ref_def(ref);
+  cstring_setup(&ref->path, path.c_str(), allocator);
+  ref->type_id = type_id;
+}
+
+static
+void
+texture_load(void **out, const asset_ref_t *ref, const allocator_t *allocator)
+{
+  deps_texture_t *texture =
+    (deps_texture_t *)allocator->mem_alloc(sizeof(deps_texture_t));
+  texture->id = id_from_path(ref);
+  *out = texture;
+  ++s_loads;
+}
+
+static
+void
+texture_deload(void **ptr, const asset_ref_t *ref, const allocator_t *allocator)
+{
+  allocator->mem_free(*ptr);
+  *ptr = NULL;
+  ++s_deloads;
+}
+
+static
+void
+material_load(void **out, const asset_ref_t *ref, const allocator_t *allocator)
+{
+  uint32_t id = id_from_path(ref);
+  deps_material_t *material =
+    (deps_material_t *)allocator->mem_alloc(sizeof(deps_material_t));
+  for (uint32_t i = 0; i < 2; ++i)
+    setup_ref(
+      material->textures + i, "tex_" + std::to_string(id + i),
+      get_type_id(deps_texture_t), allocator);
+  *out = material;
+  ++s_loads;
+}
+
+static
+void
+material_deload(void **ptr, const asset_ref_t *ref, const allocator_t *allocator)
+{
+  deps_material_t *material = (deps_material_t *)*ptr;
+  asset_ref_cleanup(material->textures + 0, allocator);
+  asset_ref_cleanup(material->textures + 1, allocator);
+  allocator->mem_free(material);
+  *ptr = NULL;
+  ++s_deloads;
+}
+
+static loader_t texture_get_loader(void) { return texture_load; }
+static deloader_t texture_get_deloader(void) { return texture_deload; }
+static loader_t material_get_loader(void) { return material_load; }
+static deloader_t material_get_deloader(void) { return material_deload; }
+static uint32_t material_asset_count(const void *src) { return 2; }
+static uint32_t entity_asset_count(const void *src) { return 1; }
+static size_t entity_type_size(void) { return sizeof(deps_entity_t); }
+
+static
+void
+material_get_assets(const void *src, const asset_ref_t *refs[])
+{
+  const deps_material_t *material = (const deps_material_t *)src;
+  refs[0] = material->textures + 0;
+  refs[1] = material->textures + 1;
+}
+
+static
+void
+entity_get_assets(const void *src, const asset_ref_t *refs[])
+{
+  refs[0] = &((const deps_entity_t *)src)->material;
+}
+
+INITIALIZER(register_deps_types)
+{
+  vtable_t vtable;
+  memset(&vtable, 0, sizeof(vtable_t));
+  vtable.fn_get_loader = texture_get_loader;
+  vtable.fn_get_deloader = texture_get_deloader;
+  register_type(get_type_id(deps_texture_t), &vtable);
+
+  memset(&vtable, 0, sizeof(vtable_t));
+  vtable.fn_get_loader = material_get_loader;
+  vtable.fn_get_deloader = material_get_deloader;
+  vtable.fn_type_asset_count = material_asset_count;
+  vtable.fn_type_get_assets = material_get_assets;
+  register_type(get_type_id(deps_material_t), &vtable);
+
+  memset(&vtable, 0, sizeof(vtable_t));
+  vtable.fn_type_size = entity_type_size;
+  vtable.fn_type_asset_count = entity_asset_count;
+  vtable.fn_type_get_assets = entity_get_assets;
+  register_type(get_type_id(deps_entity_t), &vtable);
+}
+
+static
+void
+count_ref(const asset_ref_t *ref, void *user_data)
+{
+  ++*(uint32_t *)user_data;
+}
+
+// 8 entities over 4 materials, which share 5 textures.
+static
+void
+make_level(cvector_t *level, const allocator_t *allocator)
+{
+  cvector_setup(level, get_type_data(deps_entity_t), 8, allocator);
+  for (uint32_t i = 0; i < 8; ++i) {
+    deps_entity_t entity;
+    memset(&entity, 0, sizeof(deps_entity_t));
+    setup_ref(
+      &entity.material, "mat_" + std::to_string(i % 4),
+      get_type_id(deps_material_t), allocator);
+    cvector_push_back(level, entity, deps_entity_t);
+  }
+}
+
+static
+void
+free_level(cvector_t *level, const allocator_t *allocator)
+{
+  for (uint32_t i = 0; i < 8; ++i)
+    asset_ref_cleanup(
+      &(cvector_as(level, i, deps_entity_t))->material, allocator);
+  cvector_cleanup(level, NULL);
+}
+
+static
+void
+test_asset_deps_visit(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  cvector_t level;
+  uint32_t count = 0;
+  make_level(&level, allocator);
+  asset_deps_visit(&level, get_type_id(cvector_t), count_ref, &count);
+  CTABS << PRINT(count) << std::endl;
+  assert(count == 8);
+  free_level(&level, allocator);
+
+  // refs stored directly as hashmap values.
+  chashmap_t map;
+  chashmap_def(&map);
+  chashmap_setup(
+    &map, get_type_data(uint32_t), get_type_data(asset_ref_t),
+    allocator, 0.6f);
+  for (uint32_t i = 0; i < 5; ++i) {
+    asset_ref_t ref;
+    setup_ref(&ref, "tex_" + std::to_string(i),
+      get_type_id(deps_texture_t), allocator);
+    chashmap_insert(&map, i, uint32_t, ref, asset_ref_t);
+  }
+  count = 0;
+  asset_deps_visit(&map, get_type_id(chashmap_t), count_ref, &count);
+  assert(count == 5);
+  chashmap_cleanup(&map, NULL);
+
+  // plain data has no refs.
+  cvector_t numbers;
+  cvector_setup(&numbers, get_type_data(uint32_t), 4, allocator);
+  cvector_resize(&numbers, 4);
+  count = 0;
+  asset_deps_visit(&numbers, get_type_id(cvector_t), count_ref, &count);
+  assert(count == 0);
+  cvector_cleanup(&numbers, NULL);
+}
+
+static
+void
+test_asset_deps_prefetch(
+  const allocator_t *allocator,
+  uint32_t worker_count,
+  uint32_t max_inflight,
+  const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  s_loads = s_deloads = 0;
+  asset_cache_t cache;
+  asset_cache_setup(&cache, 1 << 20, worker_count, NULL, allocator);
+
+  cvector_t level, handles;
+  make_level(&level, allocator);
+  cvector_setup(&handles, get_type_data(asset_handle_t *), 0, allocator);
+  uint32_t failed = asset_deps_prefetch(
+    &cache, &level, get_type_id(cvector_t), max_inflight, &handles);
+  CTABS << PRINT(worker_count) << ", " << PRINT(max_inflight) << ", " <<
+    PRINT(handles.size) << std::endl;
+  assert(!failed && handles.size == 9 && s_loads == 9);
+
+  // every material comes after both of its textures.
+  auto position = [&](const std::string &path, uint32_t type_id) {
+    asset_ref_t ref;
+    setup_ref(&ref, path, type_id, allocator);
+    asset_handle_t *handle = asset_cache_acquire(&cache, &ref);
+    uint32_t index = 0;
+    while (*cvector_as(&handles, index, asset_handle_t *) != handle)
+      ++index;
+    assert(asset_cache_state(handle) == ASSET_STATE_READY);
+    asset_cache_release(&cache, handle);
+    asset_ref_cleanup(&ref, allocator);
+    return index;
+  };
+  for (uint32_t k = 0; k < 4; ++k) {
+    uint32_t material =
+      position("mat_" + std::to_string(k), get_type_id(deps_material_t));
+    for (uint32_t t = 0; t < 2; ++t)
+      assert(material > position(
+        "tex_" + std::to_string(k + t), get_type_id(deps_texture_t)));
+  }
+
+  for (uint32_t i = 0; i < handles.size; ++i)
+    asset_cache_release(&cache, *cvector_as(&handles, i, asset_handle_t *));
+  cvector_cleanup(&handles, NULL);
+  free_level(&level, allocator);
+  asset_cache_cleanup(&cache);
+  assert(s_loads == s_deloads);
+}
+
+void
+test_asset_deps_main(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  test_asset_deps_visit(allocator, tabs + 1);                       NEWLINE;
+  test_asset_deps_prefetch(allocator, 0, 2, tabs + 1);              NEWLINE;
+  test_asset_deps_prefetch(allocator, 0, 1, tabs + 1);              NEWLINE;
+  test_asset_deps_prefetch(&g_default_allocator, 4, 3, tabs + 1);   NEWLINE;
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+/**
+ * @file asset_index_test.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <common.h>
+#include <library/allocator/allocator.h>
+#include <library/asset/asset_index.h>
+#include <library/string/cstring.h>
+
+
+namespace fs = std::filesystem;
+
+// the type is inferred from the top level directory, anything else is skipped.
+static
+uint32_t
+classify(const char *path, void *user_data)
+{
+  (void)user_data;
+  if (!strncmp(path, "textures/", 9))
+    return 1;
+  if (!strncmp(path, "meshes/", 7))
+    return 2;
+  return 0;
+}
+
+static
+void
+write_file(const fs::path &path, const std::string &content)
+{
+  std::ofstream(path, std::ios::binary) << content;
+}
+
+static
+void
+make_assets(const fs::path &root)
+{
+  fs::remove_all(root);
+  fs::create_directories(root / "textures" / "ui");
+  fs::create_directories(root / "meshes");
+  fs::create_directories(root / "scratch");
+  for (uint32_t i = 0; i < 8; ++i) {
+    write_file(
+      root / "textures" / ("tex_" + std::to_string(i) + ".png"),
+      std::string(100 + i, (char)('a' + i)));
+    write_file(
+      root / "meshes" / ("mesh_" + std::to_string(i) + ".obj"),
+      std::string(200 + i, (char)('A' + i)));
+  }
+  write_file(root / "textures" / "ui" / "button.png", "button");
+  write_file(root / "scratch" / "notes.txt", "not an asset");
+}
+
+static
+void
+test_asset_index_build(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  fs::path root = unique_temp_path("library_asset_index_test");
+  std::string index_path = unique_temp_path("asset_index.bin").string();
+  make_assets(root);
+
+  asset_index_t index;
+  asset_index_stats_t stats;
+  asset_index_setup(&index, allocator);
+  asset_index_refresh(
+    &index, root.string().c_str(), classify, NULL, 1, &stats);
+  CTABS << PRINT(stats.scanned) << ", " << PRINT(stats.added) << std::endl;
+  assert(stats.scanned == 17 && stats.added == 17 && stats.hashed == 17);
+  assert(!stats.updated && !stats.removed);
+  assert(asset_index_size(&index) == 17);
+
+  const asset_index_entry_t *entry =
+    asset_index_find(&index, "textures/ui/button.png");
+  assert(entry && entry->type_id == 1 && entry->size == 6 && entry->mtime);
+  assert(entry->hash == hash_fnv1a_64("button", 6));
+  entry = asset_index_find(&index, "meshes/mesh_3.obj");
+  assert(entry && entry->type_id == 2 && entry->size == 203);
+  assert(!asset_index_find(&index, "scratch/notes.txt"));
+
+  // nothing changed on disk, nothing is rehashed.
+  asset_index_refresh(
+    &index, root.string().c_str(), classify, NULL, 1, &stats);
+  assert(stats.scanned == 17 && !stats.hashed && !stats.added);
+  uint32_t done = asset_index_save(&index, index_path.c_str());
+  assert(done);
+
+  asset_index_t loaded;
+  asset_index_setup(&loaded, allocator);
+  done = asset_index_load(&loaded, index_path.c_str());
+  assert(done);
+  assert(asset_index_size(&loaded) == 17);
+  entry = asset_index_find(&loaded, "textures/ui/button.png");
+  assert(entry && !memcmp(
+    entry, asset_index_find(&index, "textures/ui/button.png"),
+    sizeof(asset_index_entry_t)));
+
+  // one file edited, one touched without changes, one deleted, one added.
+  fs::path edited = root / "textures" / "tex_0.png";
+  fs::path touched = root / "meshes" / "mesh_0.obj";
+  write_file(edited, "edited");
+  fs::last_write_time(
+    edited, fs::last_write_time(edited) + std::chrono::seconds(5));
+  fs::last_write_time(
+    touched, fs::last_write_time(touched) + std::chrono::seconds(5));
+  fs::remove(root / "meshes" / "mesh_7.obj");
+  write_file(root / "meshes" / "mesh_8.obj", "new mesh");
+
+  asset_index_refresh(
+    &loaded, root.string().c_str(), classify, NULL, 1, &stats);
+  CTABS << PRINT(stats.hashed) << ", " << PRINT(stats.updated) << ", " <<
+    PRINT(stats.removed) << std::endl;
+  assert(stats.scanned == 17 && stats.hashed == 3);
+  assert(stats.added == 1 && stats.updated == 1 && stats.removed == 1);
+  assert(asset_index_size(&loaded) == 17);
+  assert(!asset_index_find(&loaded, "meshes/mesh_7.obj"));
+  assert(asset_index_find(&loaded, "meshes/mesh_8.obj"));
+  assert(asset_index_find(&loaded, "textures/tex_0.png")->hash ==
+    hash_fnv1a_64("edited", 6));
+  for (uint32_t i = 1; i < 7; ++i) {
+    std::string name = "meshes/mesh_" + std::to_string(i) + ".obj";
+    assert(asset_index_find(&loaded, name.c_str()));
+  }
+
+  // a parallel rebuild from scratch agrees with the incremental one.
+  asset_index_t parallel;
+  asset_index_setup(&parallel, &g_default_allocator);
+  asset_index_refresh(
+    &parallel, root.string().c_str(), classify, NULL, 4, &stats);
+  assert(stats.added == 17 && asset_index_size(&parallel) == 17);
+  chashmap_iterator_t iter = chashmap_begin(&loaded.entries);
+  chashmap_iterator_t end = chashmap_end(&loaded.entries);
+  for (; !chashmap_iter_equal(iter, end); chashmap_advance(&iter)) {
+    const char *path = chashmap_key(&iter, cstring_t)->str;
+    entry = asset_index_find(&parallel, path);
+    assert(entry && !memcmp(
+      entry, chashmap_value(&iter, asset_index_entry_t),
+      sizeof(asset_index_entry_t)));
+  }
+  asset_index_cleanup(&parallel);
+
+  // a damaged file is refused and leaves the index as it was.
+  {
+    std::fstream file(
+      index_path, std::ios::in | std::ios::out | std::ios::binary);
+    char byte = 0;
+    file.seekg(40).get(byte);
+    file.seekp(40).put((char)~byte);
+  }
+  done = asset_index_load(&loaded, index_path.c_str());
+  assert(!done);
+  done = asset_index_load(&loaded, (root / "missing.bin").string().c_str());
+  assert(!done);
+  assert(asset_index_size(&loaded) == 17);
+
+  asset_index_cleanup(&loaded);
+  asset_index_cleanup(&index);
+  fs::remove(index_path);
+  fs::remove_all(root);
+}
+
+void
+test_asset_index_main(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  test_asset_index_build(allocator, tabs + 1);  NEWLINE;
+}
\ No newline at end of file
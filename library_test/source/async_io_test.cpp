@@ -0,0 +1,116 @@
+/**
+ * @file async_io_test.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <common.h>
+#include <library/allocator/allocator.h>
+#include <library/filesystem/async_io.h>
+#include <library/filesystem/io.h>
+
+
+static constexpr uint32_t request_count = 16;
+static constexpr size_t chunk_size = 64 * 1024;
+
+static
+void
+on_complete(async_io_request_t *request)
+{
+  ((std::atomic<uint32_t> *)request->user_data)->fetch_add(1);
+}
+
+static
+void
+test_async_io_backend(
+  const allocator_t *allocator,
+  async_io_backend_t requested,
+  const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  std::string file_path = unique_temp_path("async_io_test.bin").string();
+  const char *path = file_path.c_str();
+  async_io_t io;
+  async_io_backend_t backend = async_io_setup(&io, requested, 4, allocator);
+  CTABS << PRINT(requested) << ", " << PRINT(backend) << std::endl;
+
+  uint8_t *data = (uint8_t *)allocator->mem_alloc(request_count * chunk_size);
+  uint8_t *loaded = (uint8_t *)allocator->mem_alloc(request_count * chunk_size);
+  for (size_t i = 0; i < request_count * chunk_size; ++i)
+    data[i] = (uint8_t)(i * 31 + i / 4096);
+  memset(loaded, 0, request_count * chunk_size);
+
+  async_io_request_t requests[request_count];
+  std::atomic<uint32_t> completed(0);
+
+  // writes are submitted back to front, they land at their offsets.
+  file_handle_t file = open_file(
+    path, (file_open_flags_t)(FILE_OPEN_MODE_WRITE | FILE_OPEN_MODE_BINARY));
+  for (uint32_t i = 0; i < request_count; ++i) {
+    uint32_t index = request_count - 1 - i;
+    async_io_request_write(
+      requests + index, file,
+      data + index * chunk_size, chunk_size, index * chunk_size,
+      on_complete, &completed);
+    async_io_submit(&io, requests + index);
+  }
+  for (uint32_t i = 0; i < request_count; ++i) {
+    uint32_t status = async_io_wait(&io, requests + i);
+    assert(status == ASYNC_IO_STATUS_DONE);
+    assert(requests[i].transferred == chunk_size);
+  }
+  close_file(file);
+  assert(completed == request_count);
+
+  file = open_file(
+    path, (file_open_flags_t)(FILE_OPEN_MODE_READ | FILE_OPEN_MODE_BINARY));
+  completed = 0;
+  for (uint32_t i = 0; i < request_count; ++i) {
+    async_io_request_read(
+      requests + i, file,
+      loaded + i * chunk_size, chunk_size, i * chunk_size,
+      on_complete, &completed);
+    async_io_submit(&io, requests + i);
+  }
+  for (uint32_t i = 0; i < request_count; ++i) {
+    uint32_t status = async_io_wait(&io, requests + i);
+    assert(status == ASYNC_IO_STATUS_DONE);
+  }
+  assert(completed == request_count);
+  assert(!memcmp(data, loaded, request_count * chunk_size));
+
+  // a read straddling the end of the file comes back short.
+  async_io_request_t tail;
+  async_io_request_read(
+    &tail, file, loaded, chunk_size,
+    request_count * chunk_size - 100, NULL, NULL);
+  async_io_submit(&io, &tail);
+  while (async_io_poll(&tail) == ASYNC_IO_STATUS_PENDING);
+  assert(async_io_poll(&tail) == ASYNC_IO_STATUS_DONE);
+  assert(tail.transferred == 100);
+  close_file(file);
+
+  async_io_cleanup(&io);
+  allocator->mem_free(data);
+  allocator->mem_free(loaded);
+  remove(path);
+}
+
+void
+test_async_io_main(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  test_async_io_backend(allocator, ASYNC_IO_BACKEND_THREADS, tabs + 1); NEWLINE;
+  test_async_io_backend(allocator, ASYNC_IO_BACKEND_AUTO, tabs + 1);    NEWLINE;
+}
\ No newline at end of file
@@ -0,0 +1,251 @@
+/**
+ * @file binary_archive_test.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <classroom.h>
+#include <common.h>
+#include <library/allocator/allocator.h>
+#include <library/containers/chashmap.h>
+#include <library/containers/cvector.h>
+#include <library/streams/binary_archive.h>
+#include <library/streams/binary_stream.h>
+#include <library/string/cstring.h>
+
+
+static
+void
+write_archive(
+  binary_stream_t *stream,
+  const allocator_t *allocator,
+  uint32_t flags)
+{
+  cvector_t vec;
+  cvector_def(&vec);
+  cvector_setup(&vec, get_type_data(uint32_t), 64, allocator);
+  for (uint32_t i = 0; i < 10; ++i)
+    cvector_push_back(&vec, i * 3, uint32_t);
+
+  cstring_t str;
+  cstring_def(&str);
+  cstring_setup(&str, "framed archive", allocator);
+
+  chashmap_t map;
+  chashmap_def(&map);
+  chashmap_setup(
+    &map, get_type_data(uint32_t), get_type_data(float), allocator, 0.6f);
+  for (uint32_t i = 0; i < 20; ++i)
+    chashmap_insert(&map, i, uint32_t, i * 0.5f, float);
+
+  binary_archive_write_header(stream, flags);
+  binary_archive_write_block(stream, get_type_id(cvector_t), &vec);
+  binary_archive_write_block(stream, get_type_id(cstring_t), &str);
+  binary_archive_write_block(stream, get_type_id(chashmap_t), &map);
+
+  cvector_cleanup(&vec, NULL);
+  cstring_cleanup(&str, NULL);
+  chashmap_cleanup(&map, NULL);
+}
+
+static
+void
+test_archive_roundtrip(
+  const allocator_t *allocator,
+  uint32_t flags,
+  const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  binary_stream_t stream;
+  binary_stream_def(&stream);
+  binary_stream_setup(&stream, allocator);
+  write_archive(&stream, allocator, flags);
+  CTABS << PRINT(flags) << ", " << PRINT(binary_stream_size(&stream)) <<
+    std::endl;
+
+  archive_header_t header;
+  archive_block_t block;
+  archive_result_t result = binary_archive_read_header(&stream, &header);
+  assert(result == ARCHIVE_OK);
+  assert(header.flags == flags);
+
+  cvector_t vec; cvector_def(&vec);
+  result = binary_archive_read_block_header(&stream, &block);
+  assert(result == ARCHIVE_OK);
+  assert(block.type_id == get_type_id(cvector_t));
+  result = binary_archive_read_block(&stream, &block, &vec, allocator);
+  assert(result == ARCHIVE_OK);
+  assert(vec.size == 10);
+  assert(vec.capacity == ((flags & STREAM_FLAG_OMIT_CAPACITY) ? 10 : 64));
+  for (uint32_t i = 0; i < 10; ++i)
+    assert(*cvector_as(&vec, i, uint32_t) == i * 3);
+
+  cstring_t str; cstring_def(&str);
+  result = binary_archive_read_block_header(&stream, &block);
+  assert(result == ARCHIVE_OK);
+  result = binary_archive_read_block(&stream, &block, &str, allocator);
+  assert(result == ARCHIVE_OK);
+  assert(!strcmp(str.str, "framed archive"));
+
+  chashmap_t map; chashmap_def(&map);
+  result = binary_archive_read_block_header(&stream, &block);
+  assert(result == ARCHIVE_OK);
+  result = binary_archive_read_block(&stream, &block, &map, allocator);
+  assert(result == ARCHIVE_OK);
+  assert(chashmap_size(&map) == 20);
+  for (uint32_t i = 0; i < 20; ++i) {
+    float *value = NULL;
+    chashmap_at(&map, i, uint32_t, float, value);
+    assert(value && *value == i * 0.5f);
+  }
+  chashmap_insert(&map, 100u, uint32_t, 1.f, float);
+  assert(chashmap_size(&map) == 21);
+
+  result = binary_archive_read_block_header(&stream, &block);
+  assert(result == ARCHIVE_ERROR_EOF);
+
+  cvector_cleanup(&vec, NULL);
+  cstring_cleanup(&str, NULL);
+  chashmap_cleanup(&map, NULL);
+  binary_stream_cleanup(&stream);
+}
+
+static
+void
+test_archive_validation(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  binary_stream_t stream;
+  binary_stream_def(&stream);
+  binary_stream_setup(&stream, allocator);
+  write_archive(&stream, allocator, STREAM_FLAG_NONE);
+
+  uint8_t *data = (uint8_t *)stream.data->data;
+  size_t first_block = sizeof(archive_header_t);
+  archive_block_t block;
+  memcpy(&block, data + first_block, sizeof(archive_block_t));
+
+  // corrupt the first payload, and rename the second block's type.
+  data[first_block + sizeof(archive_block_t)] ^= 0xff;
+  size_t second_block =
+    first_block + sizeof(archive_block_t) + (size_t)block.length;
+  type_id_t unknown = get_type_id(unknown_type_t);
+  memcpy(data + second_block, &unknown, sizeof(type_id_t));
+
+  archive_header_t header;
+  cvector_t vec; cvector_def(&vec);
+  cstring_t str; cstring_def(&str);
+  chashmap_t map; chashmap_def(&map);
+  archive_result_t result = binary_archive_read_header(&stream, &header);
+  assert(result == ARCHIVE_OK);
+
+  result = binary_archive_read_block_header(&stream, &block);
+  assert(result == ARCHIVE_OK);
+  result = binary_archive_read_block(&stream, &block, &vec, allocator);
+  CTABS << binary_archive_result_str(result) << std::endl;
+  assert(result == ARCHIVE_ERROR_CHECKSUM && cvector_is_def(&vec));
+
+  result = binary_archive_read_block_header(&stream, &block);
+  assert(result == ARCHIVE_OK);
+  result = binary_archive_read_block(&stream, &block, &str, allocator);
+  CTABS << binary_archive_result_str(result) << std::endl;
+  assert(result == ARCHIVE_ERROR_UNKNOWN_TYPE && cstring_is_def(&str));
+
+  // the remaining blocks are still reachable.
+  result = binary_archive_read_block_header(&stream, &block);
+  assert(result == ARCHIVE_OK);
+  result = binary_archive_read_block(&stream, &block, &map, allocator);
+  assert(result == ARCHIVE_OK);
+  assert(chashmap_size(&map) == 20);
+  chashmap_cleanup(&map, NULL);
+
+  // a header written on a host of the other endianness is rejected.
+  binary_stream_seek(&stream, 0);
+  for (size_t i = 0; i < sizeof(archive_header_t); i += sizeof(uint32_t)) {
+    std::swap(data[i], data[i + 3]);
+    std::swap(data[i + 1], data[i + 2]);
+  }
+  result = binary_archive_read_header(&stream, &header);
+  CTABS << binary_archive_result_str(result) << std::endl;
+  assert(result == ARCHIVE_ERROR_ENDIANNESS);
+  assert(header.endian_tag == ARCHIVE_ENDIAN_SWAPPED);
+
+  binary_stream_cleanup(&stream);
+}
+
+static
+void
+test_archive_load_parallel(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  const uint32_t block_count = 64;
+  const uint32_t worker_count = 4;
+
+  binary_stream_t stream;
+  binary_stream_def(&stream);
+  binary_stream_setup(&stream, allocator);
+  binary_archive_write_header(&stream, STREAM_FLAG_COMPACT);
+  for (uint32_t i = 0; i < block_count; ++i) {
+    cvector_t vec;
+    cvector_def(&vec);
+    cvector_setup(&vec, get_type_data(uint32_t), 0, allocator);
+    for (uint32_t j = 0; j < 1000 + i; ++j)
+      cvector_push_back(&vec, i * j, uint32_t);
+    binary_archive_write_block(&stream, get_type_id(cvector_t), &vec);
+    cvector_cleanup(&vec, NULL);
+  }
+
+  archive_header_t header;
+  archive_result_t result = binary_archive_read_header(&stream, &header);
+  assert(result == ARCHIVE_OK);
+  archive_load_t loads[64];
+  uint32_t count = binary_archive_scan_blocks(&stream, loads, block_count);
+  assert(count == block_count);
+
+  // the test allocator is not thread safe, workers get the default one.
+  const allocator_t *allocators[4] = {
+    allocator, &g_default_allocator, &g_default_allocator,
+    &g_default_allocator };
+  uint32_t failed = binary_archive_load_parallel(
+    &stream, loads, count, allocators, worker_count);
+  CTABS << PRINT(count) << ", " << PRINT(failed) << std::endl;
+  assert(failed == 0);
+
+  for (uint32_t i = 0; i < count; ++i) {
+    cvector_t *vec = (cvector_t *)loads[i].dst;
+    assert(loads[i].result == ARCHIVE_OK && vec);
+    assert(vec->size == 1000 + i);
+    for (uint32_t j = 0; j < vec->size; ++j)
+      assert(*cvector_as(vec, j, uint32_t) == i * j);
+  }
+
+  binary_archive_load_cleanup(loads, count);
+  binary_stream_cleanup(&stream);
+}
+
+void
+test_binaryarchive_main(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  test_archive_roundtrip(allocator, STREAM_FLAG_NONE, tabs + 1);    NEWLINE;
+  test_archive_roundtrip(
+    allocator, STREAM_FLAG_OMIT_CAPACITY, tabs + 1);                NEWLINE;
+  test_archive_roundtrip(allocator, STREAM_FLAG_COMPACT, tabs + 1); NEWLINE;
+  test_archive_roundtrip(
+    allocator,
+    STREAM_FLAG_COMPACT | STREAM_FLAG_OMIT_CAPACITY, tabs + 1);     NEWLINE;
+  test_archive_validation(allocator, tabs + 1);                     NEWLINE;
+  test_archive_load_parallel(allocator, tabs + 1);                  NEWLINE;
+}
\ No newline at end of file
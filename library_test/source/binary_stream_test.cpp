@@ -11,8 +11,14 @@
 #include <cassert>
 #include <common.h>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <library/allocator/allocator.h>
+#include <library/containers/cvector.h>
+#include <library/filesystem/io.h>
 #include <library/streams/binary_stream.h>
+#include <library/streams/stream_codec.h>
+#include <library/streams/stream_file.h>
 
 
 typedef
@@ -136,6 +142,160 @@ test_binarystream_large(const allocator_t* allocator, const int32_t tabs)
   binary_stream_cleanup(&stream);
 }
 
+static
+void
+test_binarystream_varint(const allocator_t* allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  binary_stream_t stream;
+  binary_stream_def(&stream);
+  binary_stream_setup(&stream, allocator);
+
+  const uint64_t values[] = {
+    0, 1, 127, 128, 300, 16383, 16384, (1ull << 32) - 1, ~0ull };
+  const size_t count = sizeof(values) / sizeof(values[0]);
+  for (size_t i = 0; i < count; ++i)
+    binary_stream_write_varint(&stream, values[i]);
+
+  // 1 + 1 + 1 + 2 + 2 + 2 + 3 + 5 + 10 bytes.
+  CTABS << PRINT(binary_stream_size(&stream)) << std::endl;
+  assert(binary_stream_size(&stream) == 27);
+
+  for (size_t i = 0; i < count; ++i) {
+    uint64_t value = binary_stream_read_varint(&stream);
+    assert(value == values[i]);
+  }
+
+  assert(stream.pos == STREAM_EOF);
+  uint64_t value = binary_stream_read_varint(&stream);
+  assert(value == 0 && stream.pos == STREAM_EOF);
+
+  // the last varint cut short, its final byte still has the continuation bit.
+  cvector_resize(stream.data, 26);
+  binary_stream_seek(&stream, 0);
+  for (size_t i = 0; i < count - 1; ++i)
+    binary_stream_read_varint(&stream);
+  value = binary_stream_read_varint(&stream);
+  assert(value == 0 && stream.pos == STREAM_EOF);
+
+  // more continuation bits than 64 bits need.
+  uint8_t overlong[11];
+  memset(overlong, 0xff, sizeof(overlong));
+  cvector_resize(stream.data, 0);
+  binary_stream_write(&stream, overlong, sizeof(overlong));
+  binary_stream_seek(&stream, 0);
+  value = binary_stream_read_varint(&stream);
+  assert(value == 0 && stream.pos == STREAM_EOF);
+
+  binary_stream_cleanup(&stream);
+}
+
+static
+void
+test_binarystream_codec(const allocator_t* allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  const size_t sizes[] = { 0, 1, 5, 16, 1000, 70000 };
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+    size_t size = sizes[s];
+    size_t bound = g_lz_codec.fn_bound(size);
+    uint8_t *src = (uint8_t *)allocator->mem_alloc(size + 1);
+    uint8_t *encoded = (uint8_t *)allocator->mem_alloc(bound);
+    uint8_t *decoded = (uint8_t *)allocator->mem_alloc(size + 1);
+
+    // compressible text followed by noise.
+    uint32_t seed = 1234;
+    for (size_t i = 0; i < size; ++i) {
+      seed = seed * 1103515245u + 12345u;
+      src[i] = i < size / 2 ? "serialized"[i % 10] : (uint8_t)(seed >> 16);
+    }
+
+    size_t encoded_size = g_lz_codec.fn_encode(src, size, encoded, bound);
+    assert(encoded_size && encoded_size <= bound);
+    size_t decoded_size =
+      g_lz_codec.fn_decode(encoded, encoded_size, decoded, size);
+    assert(decoded_size == size);
+    assert(!size || !memcmp(src, decoded, size));
+    CTABS << PRINT(size) << ", " << PRINT(encoded_size) << std::endl;
+
+    // truncated input is rejected rather than overrunning.
+    if (encoded_size > 1) {
+      decoded_size =
+        g_lz_codec.fn_decode(encoded, encoded_size - 1, decoded, size);
+      assert(decoded_size != size);
+    }
+
+    allocator->mem_free(src);
+    allocator->mem_free(encoded);
+    allocator->mem_free(decoded);
+  }
+}
+
+static
+void
+test_binarystream_file(const allocator_t* allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  std::string raw_name = unique_temp_path("binary_stream_test.bin").string();
+  std::string lz_name = unique_temp_path("binary_stream_test.clz").string();
+  const char *raw_path = raw_name.c_str();
+  const char *lz_path = lz_name.c_str();
+
+  binary_stream_t stream;
+  binary_stream_def(&stream);
+  binary_stream_setup(&stream, allocator);
+  for (uint32_t i = 0; i < 100000; ++i) {
+    uint32_t value = i / 7;
+    binary_stream_write(&stream, &value, sizeof(uint32_t));
+  }
+
+  uint32_t written = binary_stream_to_file(&stream, raw_path, NULL);
+  assert(written);
+  written = binary_stream_to_file(&stream, lz_path, &g_lz_codec);
+  assert(written);
+  assert(!stream_file_is_compressed(raw_path));
+  assert(stream_file_is_compressed(lz_path));
+
+  const char *paths[] = { raw_path, lz_path };
+  for (uint32_t p = 0; p < 2; ++p) {
+    binary_stream_t *loaded = binary_stream_from_file(paths[p], allocator);
+    assert(loaded);
+    CTABS << paths[p] << ": " <<
+      PRINT(binary_stream_size(loaded)) << std::endl;
+    assert(binary_stream_size(loaded) == binary_stream_size(&stream));
+    assert(!memcmp(
+      loaded->data->data, stream.data->data, binary_stream_size(&stream)));
+    binary_stream_cleanup(loaded);
+    allocator->mem_free(loaded);
+  }
+
+  // a corrupted block header fails the load instead of crashing.
+  {
+    FILE *file = fopen(lz_path, "r+b");
+    uint32_t garbage = 0x7fffffff;
+    fseek(file, sizeof(stream_file_header_t), SEEK_SET);
+    fwrite(&garbage, sizeof(uint32_t), 1, file);
+    fclose(file);
+    binary_stream_t *corrupted = binary_stream_from_file(lz_path, allocator);
+    assert(corrupted == NULL);
+  }
+
+  // a full device takes the open but not the writes, both report them.
+  if (file_exists("/dev/full")) {
+    written = binary_stream_to_file(&stream, "/dev/full", NULL);
+    assert(!written);
+    written = binary_stream_to_file(&stream, "/dev/full", &g_lz_codec);
+    assert(!written);
+  }
+
+  remove(raw_path);
+  remove(lz_path);
+  binary_stream_cleanup(&stream);
+}
+
 void
 test_binarystream_main(const allocator_t* allocator, const int32_t tabs)
 {
@@ -143,4 +303,7 @@ test_binarystream_main(const allocator_t* allocator, const int32_t tabs)
 
   test_binarystream(allocator, tabs + 1);          NEWLINE;
   test_binarystream_large(allocator, tabs + 1);    NEWLINE;
+  test_binarystream_varint(allocator, tabs + 1);   NEWLINE;
+  test_binarystream_codec(allocator, tabs + 1);    NEWLINE;
+  test_binarystream_file(allocator, tabs + 1);     NEWLINE;
 }
\ No newline at end of file
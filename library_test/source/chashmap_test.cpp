@@ -10,13 +10,18 @@
  */
 #include <cassert>
 #include <cstdint>
+#include <cstring>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include <classroom.h>
 #include <common.h>
 #include <library/allocator/allocator.h>
 #include <library/containers/chashmap.h>
 #include <library/core/core.h>
 #include <library/hash/fnv.h>
+#include <library/string/cstring.h>
+#include <library/workload/workload.h>
 
 
 typedef uint64_t u64;
@@ -274,6 +279,45 @@ test_chashmap_def_basics_with_macros(
   }
 }
 
+void
+test_chashmap_erase_cluster(const allocator_t* allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+  PRINT_DESC("erasing from the middle of a collision cluster...");
+
+  chashmap_t map; chashmap_def(&map);
+  chashmap_setup(
+    &map, get_type_data(u64), get_type_data(u64), allocator, 0.6f);
+
+  // six keys hashing to bucket 0 of the first table, it holds all of them.
+  const size_t buckets = CHASHTABLE_INIT_SIZE;
+  u64 cluster[6];
+  for (u64 key = 0, found = 0; found < 6; ++key)
+    if (chashmap_hash_calc(&map)(&key) % buckets == 0)
+      cluster[found++] = key;
+  for (u64 i = 0; i < 6; ++i)
+    chashmap_insert(&map, cluster[i], u64, i, u64);
+  assert(cvector_size(&map.indices) == buckets);
+
+  // the keys past the erased one are still reachable.
+  chashmap_erase(&map, cluster[2], u64);
+  CTABS << PRINT(chashmap_size(&map)) << ", " << PRINT(buckets) << std::endl;
+  for (u64 i = 0; i < 6; ++i) {
+    u64 *value;
+    chashmap_at(&map, cluster[i], u64, u64, value);
+    assert(i == 2 ? value == NULL : value && *value == i);
+  }
+
+  chashmap_insert(&map, cluster[2], u64, 2, u64);
+  for (u64 i = 0; i < 6; ++i) {
+    u64 *value;
+    chashmap_at(&map, cluster[i], u64, u64, value);
+    assert(value && *value == i);
+  }
+  assert(chashmap_size(&map) == 6);
+  chashmap_cleanup(&map, NULL);
+}
+
 void
 test_chashmap_ops(const allocator_t* allocator, const int32_t tabs)
 {
@@ -618,6 +662,194 @@ test_chashmap_serialize(const allocator_t* allocator, const int32_t tabs)
   binary_stream_cleanup(&stream);
 }
 
+static
+void
+test_chashmap_batch(const allocator_t* allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+  PRINT_DESC("batch inserts and finds match the single key macros");
+
+  const u64 total = 5000, distinct = 3000;
+  std::vector<u64> keys(total), values(total), probes(2 * distinct);
+  std::vector<void*> found(probes.size());
+  for (u64 i = 0; i < total; ++i) {
+    // repeats in the batch, the last value of a key wins.
+    keys[i] = (i % distinct) * 7919;
+    values[i] = i;
+  }
+  for (u64 i = 0; i < probes.size(); ++i)
+    probes[i] = i * 7919 + (i >= distinct);
+
+  chashmap_t batch, single;
+  chashmap_def(&batch);
+  chashmap_def(&single);
+  chashmap_setup(
+    &batch, get_type_data(u64), get_type_data(u64), allocator, 0.6f);
+  chashmap_setup(
+    &single, get_type_data(u64), get_type_data(u64), allocator, 0.6f);
+
+  // nothing inserted yet, every key misses.
+  chashmap_find_batch(&batch, probes.data(), probes.size(), found.data());
+  for (void *value : found)
+    assert(value == NULL);
+
+  chashmap_insert_batch(&batch, keys.data(), values.data(), total);
+  for (u64 i = 0; i < total; ++i)
+    chashmap_insert(&single, keys[i], u64, values[i], u64);
+  CTABS << PRINT(chashmap_size(&batch)) << ", " <<
+    PRINT(chashmap_capacity(&batch)) << ", " <<
+    PRINT(chashmap_capacity(&single)) << std::endl;
+  assert(chashmap_size(&batch) == distinct);
+  assert(chashmap_size(&single) == distinct);
+
+  chashmap_find_batch(&batch, probes.data(), probes.size(), found.data());
+  for (u64 i = 0; i < probes.size(); ++i) {
+    u64 *expected;
+    chashmap_at(&single, probes[i], u64, u64, expected);
+    assert((found[i] == NULL) == (expected == NULL));
+    assert(!expected || *(u64*)found[i] == *expected);
+    assert(!expected || *expected >= total - distinct);
+  }
+  chashmap_cleanup(&batch, NULL);
+  chashmap_cleanup(&single, NULL);
+
+  // replicated keys, overwritten and new ones.
+  {
+    const char *names[] = { "khalil", "aline", "simone", "khalil" };
+    const char *missing[] = { "naji", "aline" };
+    cstring_t strings[4], lookups[2];
+    int32_t ages[] = { 15, 71, 80, 16 };
+    void *ptrs[2];
+    for (uint32_t i = 0; i < 4; ++i) {
+      cstring_def(strings + i);
+      cstring_setup(strings + i, names[i], allocator);
+    }
+    for (uint32_t i = 0; i < 2; ++i) {
+      cstring_def(lookups + i);
+      cstring_setup(lookups + i, missing[i], allocator);
+    }
+
+    chashmap_setup(
+      &batch, get_type_data(cstring_t), get_type_data(int32_t),
+      allocator, 0.6f);
+    chashmap_insert_batch(&batch, strings, ages, 4);
+    chashmap_find_batch(&batch, lookups, 2, ptrs);
+    CTABS << PRINT(chashmap_size(&batch)) << std::endl;
+    assert(chashmap_size(&batch) == 3);
+    assert(ptrs[0] == NULL && *(int32_t*)ptrs[1] == 71);
+    chashmap_find_batch(&batch, strings, 1, ptrs);
+    assert(*(int32_t*)ptrs[0] == 16);
+    chashmap_cleanup(&batch, NULL);
+
+    for (uint32_t i = 0; i < 4; ++i)
+      cstring_cleanup(strings + i, NULL);
+    for (uint32_t i = 0; i < 2; ++i)
+      cstring_cleanup(lookups + i, NULL);
+  }
+}
+
+/**
+ * every stored distance is the true one, and no bucket is further from home
+ * than the one before it by more than a step (the robin hood invariant).
+ */
+static
+void
+check_probe_distances(const chashmap_t& map)
+{
+  const size_t buckets = cvector_size(&map.indices);
+  const uint32_t *indices = (const uint32_t *)map.indices.data;
+  size_t occupied = 0;
+  for (size_t b = 0; b < buckets; ++b) {
+    if (indices[b] == CHASHTABLE_INVALID_INDEX)
+      continue;
+    ++occupied;
+    size_t home = chashmap_hash_calc(&map)(
+      cvector_at((cvector_t *)&map.keys, indices[b])) % buckets;
+    uint32_t distance = (uint32_t)((b + buckets - home) % buckets);
+    assert(chashmap_bucket_distance(&map, b) == distance);
+
+    size_t prev = (b + buckets - 1) % buckets;
+    assert(
+      !distance || (
+      indices[prev] != CHASHTABLE_INVALID_INDEX &&
+      chashmap_bucket_distance(&map, prev) + 1 >= distance));
+  }
+  assert(occupied == chashmap_size(&map));
+}
+
+static
+void
+test_chashmap_robin_hood(const allocator_t* allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+  PRINT_DESC("probe distances, backward shift erases, high load factors");
+
+  // random inserts and erases at a 0.9 max load factor, against std.
+  {
+    std::unordered_map<u64, u64> reference;
+    chashmap_t map;
+    u64 state = 0x9e3779b97f4a7c15ull;
+    chashmap_def(&map);
+    chashmap_setup(
+      &map, get_type_data(u64), get_type_data(u64), allocator, 0.9f);
+    for (u64 i = 0; i < 40000; ++i) {
+      state = state * 6364136223846793005ull + 1442695040888963407ull;
+      u64 key = (state >> 33) % 8000;
+      if ((state >> 20) % 3) {
+        chashmap_insert(&map, key, u64, i, u64);
+        reference[key] = i;
+      } else {
+        chashmap_erase(&map, key, u64);
+        reference.erase(key);
+      }
+    }
+    CTABS << PRINT(chashmap_size(&map)) << ", " <<
+      PRINT(chashmap_load_factor(&map)) << std::endl;
+    assert(chashmap_size(&map) == reference.size());
+    check_probe_distances(map);
+    for (u64 key = 0; key < 8000; ++key) {
+      u64 *value;
+      auto found = reference.find(key);
+      chashmap_at(&map, key, u64, u64, value);
+      assert((value == NULL) == (found == reference.end()));
+      assert(!value || *value == found->second);
+    }
+    chashmap_cleanup(&map, NULL);
+  }
+
+  // one long probe, the distances saturate and are recomputed from the keys.
+  {
+    workload_key_params_t params = {};
+    workload_keys_t stream;
+    std::vector<u64> keys(600);
+    chashmap_t map;
+    params.distribution = WORKLOAD_FNV_COLLISIONS;
+    params.collision_bits = 12;
+    params.seed = 7;
+    workload_keys_setup(&stream, &params);
+    for (u64 &key : keys)
+      key = workload_keys_next(&stream);
+
+    chashmap_def(&map);
+    chashmap_setup(
+      &map, get_type_data(u64), get_type_data(u64), allocator, 0.9f);
+    for (u64 i = 0; i < keys.size(); ++i)
+      chashmap_insert(&map, keys[i], u64, i, u64);
+    check_probe_distances(map);
+    for (u64 i = 0; i < keys.size(); i += 2)
+      chashmap_erase(&map, keys[i], u64);
+    check_probe_distances(map);
+    CTABS << PRINT(chashmap_size(&map)) << std::endl;
+    assert(chashmap_size(&map) == keys.size() / 2);
+    for (u64 i = 0; i < keys.size(); ++i) {
+      u64 *value;
+      chashmap_at(&map, keys[i], u64, u64, value);
+      assert((i % 2) ? value && *value == i : value == NULL);
+    }
+    chashmap_cleanup(&map, NULL);
+  }
+}
+
 void
 test_chashmap_main(const allocator_t* allocator, const int32_t tabs)
 {
@@ -627,10 +859,13 @@ test_chashmap_main(const allocator_t* allocator, const int32_t tabs)
   // test_chashmap_basics(allocator, tabs + 1);                  NEWLINE;
   test_chashmap_def_basics(allocator, tabs + 1);              NEWLINE;
   test_chashmap_def_basics_with_macros(allocator, tabs + 1);  NEWLINE;
+  test_chashmap_batch(allocator, tabs + 1);                   NEWLINE;
+  test_chashmap_robin_hood(allocator, tabs + 1);              NEWLINE;
   // test_chashmap_ops(allocator, tabs + 1);                     NEWLINE;
   // test_chashmap_misc(allocator, tabs + 1);                    NEWLINE;
   // test_chashmap_mem(allocator, tabs + 1);                     NEWLINE;
   // test_chashmap_iterators(allocator, tabs + 1);               NEWLINE;
   // test_chashmap_custom(allocator, tabs + 1);                  NEWLINE;
   // test_chashmap_serialize(allocator, tabs + 1);               NEWLINE;
+  test_chashmap_erase_cluster(allocator, tabs + 1);           NEWLINE;
 }
\ No newline at end of file
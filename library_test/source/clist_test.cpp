@@ -10,6 +10,7 @@
  */
 #include <cassert>
 #include <cstdint>
+#include <cstring>
 #include <string>
 #include <classroom.h>
 #include <common.h>
@@ -0,0 +1,271 @@
+/**
+ * @file cqueue_test.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <common.h>
+#include <library/allocator/allocator.h>
+#include <library/containers/clist.h>
+#include <library/containers/cqueue.h>
+#include <library/core/core.h>
+#include <library/string/cstring.h>
+#include <library/threading/mutex.h>
+#include <library/threading/thread.h>
+
+
+static
+void
+test_cqueue_basics(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  cqueue_t queue;
+  cqueue_def(&queue);
+  assert(cqueue_is_def(&queue));
+  cqueue_setup(&queue, get_type_data(uint32_t), 5, allocator);
+  CTABS << PRINT(cqueue_capacity(&queue)) << std::endl;
+  assert(cqueue_capacity(&queue) == 8);
+
+  // several laps around the cells.
+  uint32_t next_push = 0, next_pop = 0, value, done;
+  for (uint32_t lap = 0; lap < 5; ++lap) {
+    while (cqueue_push(&queue, &next_push))
+      ++next_push;
+    assert(cqueue_size(&queue) == 8);
+    for (uint32_t i = 0; i < 5; ++i) {
+      done = cqueue_pop(&queue, &value);
+      assert(done && value == next_pop);
+      ++next_pop;
+    }
+  }
+  while (cqueue_pop(&queue, &value)) {
+    assert(value == next_pop);
+    ++next_pop;
+  }
+  assert(next_pop == next_push && cqueue_size(&queue) == 0);
+  cqueue_cleanup(&queue, NULL);
+  assert(cqueue_is_def(&queue));
+
+  // strings still queued are released with the queue.
+  cqueue_setup(&queue, get_type_data(cstring_t), 4, allocator);
+  for (uint32_t i = 0; i < 3; ++i) {
+    cstring_t str;
+    cstring_def(&str);
+    cstring_setup(&str, "queued", allocator);
+    done = cqueue_push(&queue, &str);
+    assert(done);
+  }
+  cstring_t str;
+  done = cqueue_pop(&queue, &str);
+  assert(done && !strcmp(str.str, "queued"));
+  cstring_cleanup(&str, NULL);
+  cqueue_cleanup(&queue, NULL);
+
+  const vtable_t *vtable = get_vtable(get_type_id(cqueue_t));
+  assert(vtable && vtable->fn_type_size() == sizeof(cqueue_t));
+}
+
+typedef
+struct mpmc_context_t {
+  cqueue_t *queue;
+  uint32_t per_producer;
+  uint32_t producer;
+  std::atomic<uint32_t> *popped;
+  std::vector<std::atomic<uint8_t>> *seen;
+  uint32_t total;
+} mpmc_context_t;
+
+static
+void
+mpmc_producer(void *arg)
+{
+  mpmc_context_t *context = (mpmc_context_t *)arg;
+  uint32_t first = context->producer * context->per_producer;
+  for (uint32_t i = 0; i < context->per_producer; ++i) {
+    uint32_t value = first + i;
+    while (!cqueue_push(context->queue, &value))
+      thread_yield();
+  }
+}
+
+static
+void
+mpmc_consumer(void *arg)
+{
+  mpmc_context_t *context = (mpmc_context_t *)arg;
+  uint32_t value;
+  while (*context->popped < context->total) {
+    if (cqueue_pop(context->queue, &value)) {
+      ++(*context->seen)[value];
+      ++*context->popped;
+    } else
+      thread_yield();
+  }
+}
+
+static
+void
+test_cqueue_threads(
+  const allocator_t *allocator,
+  uint32_t producers,
+  uint32_t consumers,
+  const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  const uint32_t per_producer = 50000;
+  uint32_t total = producers * per_producer;
+  cqueue_t queue;
+  cqueue_def(&queue);
+  cqueue_setup(&queue, get_type_data(uint32_t), 1024, allocator);
+
+  std::atomic<uint32_t> popped(0);
+  std::vector<std::atomic<uint8_t>> seen(total);
+  for (auto &flag : seen)
+    flag = 0;
+
+  std::vector<mpmc_context_t> contexts(producers + consumers);
+  std::vector<thread_handle_t> threads(producers + consumers);
+  for (uint32_t i = 0; i < producers + consumers; ++i) {
+    contexts[i] = { &queue, per_producer, i, &popped, &seen, total };
+    threads[i] = thread_create(
+      i < producers ? mpmc_producer : mpmc_consumer, &contexts[i]);
+    assert(threads[i] != INVALID_THREAD);
+  }
+  for (uint32_t i = 0; i < producers + consumers; ++i)
+    thread_join(threads[i]);
+
+  CTABS << PRINT(producers) << ", " << PRINT(consumers) << ", " <<
+    PRINT(popped) << std::endl;
+  assert(popped == total);
+  for (uint32_t i = 0; i < total; ++i)
+    assert(seen[i] == 1);
+  assert(cqueue_size(&queue) == 0);
+  cqueue_cleanup(&queue, NULL);
+}
+
+// the baseline: a clist behind a mutex, the way work queues used to be done.
+typedef
+struct locked_list_t {
+  clist_t list;
+  mutex_t mutex;
+} locked_list_t;
+
+typedef
+struct bench_context_t {
+  cqueue_t *queue;
+  locked_list_t *locked;
+  uint32_t count;
+  uint32_t producer;
+} bench_context_t;
+
+static
+void
+bench_queue_thread(void *arg)
+{
+  bench_context_t *context = (bench_context_t *)arg;
+  uint32_t value = 0;
+  for (uint32_t i = 0; i < context->count; ++i) {
+    if (context->producer) {
+      while (!cqueue_push(context->queue, &i))
+        thread_yield();
+    } else {
+      while (!cqueue_pop(context->queue, &value))
+        thread_yield();
+    }
+  }
+}
+
+static
+void
+bench_locked_thread(void *arg)
+{
+  bench_context_t *context = (bench_context_t *)arg;
+  locked_list_t *locked = context->locked;
+  for (uint32_t i = 0; i < context->count; ++i) {
+    for (;;) {
+      uint32_t done = 0;
+      mutex_lock(&locked->mutex);
+      if (context->producer) {
+        clist_push_back(&locked->list, i, uint32_t);
+        done = 1;
+      } else if (clist_size(&locked->list)) {
+        clist_erase(&locked->list, 0);
+        done = 1;
+      }
+      mutex_unlock(&locked->mutex);
+      if (done)
+        break;
+      thread_yield();
+    }
+  }
+}
+
+static
+void
+test_cqueue_benchmark(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  typedef std::chrono::steady_clock clock;
+  const uint32_t count = 200000, pairs = 2;
+  std::vector<bench_context_t> contexts(pairs * 2);
+  std::vector<thread_handle_t> threads(pairs * 2);
+
+  cqueue_t queue;
+  cqueue_def(&queue);
+  cqueue_setup(&queue, get_type_data(uint32_t), 4096, allocator);
+  auto start = clock::now();
+  for (uint32_t i = 0; i < pairs * 2; ++i) {
+    contexts[i] = { &queue, NULL, count, i & 1 };
+    threads[i] = thread_create(bench_queue_thread, &contexts[i]);
+  }
+  for (uint32_t i = 0; i < pairs * 2; ++i)
+    thread_join(threads[i]);
+  double queue_ms =
+    std::chrono::duration<double, std::milli>(clock::now() - start).count();
+  cqueue_cleanup(&queue, NULL);
+
+  locked_list_t locked;
+  clist_def(&locked.list);
+  clist_setup(&locked.list, get_type_data(uint32_t), &g_default_allocator);
+  mutex_setup(&locked.mutex);
+  start = clock::now();
+  for (uint32_t i = 0; i < pairs * 2; ++i) {
+    contexts[i] = { NULL, &locked, count, i & 1 };
+    threads[i] = thread_create(bench_locked_thread, &contexts[i]);
+  }
+  for (uint32_t i = 0; i < pairs * 2; ++i)
+    thread_join(threads[i]);
+  double locked_ms =
+    std::chrono::duration<double, std::milli>(clock::now() - start).count();
+  mutex_cleanup(&locked.mutex);
+  clist_cleanup(&locked.list, NULL);
+
+  CTABS << PRINT(count) << ", " << PRINT(pairs) << std::endl;
+  CTABS << PRINT(queue_ms) << ", " << PRINT(locked_ms) << std::endl;
+}
+
+void
+test_cqueue_main(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  // the threads only push and pop, nothing allocates past setup.
+  test_cqueue_basics(allocator, tabs + 1);                    NEWLINE;
+  test_cqueue_threads(allocator, 1, 1, tabs + 1);             NEWLINE;
+  test_cqueue_threads(allocator, 4, 4, tabs + 1);             NEWLINE;
+  test_cqueue_threads(allocator, 2, 6, tabs + 1);             NEWLINE;
+  test_cqueue_benchmark(allocator, tabs + 1);                 NEWLINE;
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+/**
+ * @file cring_test.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <common.h>
+#include <library/allocator/allocator.h>
+#include <library/containers/cring.h>
+#include <library/core/core.h>
+#include <library/string/cstring.h>
+#include <library/threading/thread.h>
+
+
+static
+void
+test_cring_basics(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  cring_t ring;
+  cring_def(&ring);
+  assert(cring_is_def(&ring));
+  cring_setup(&ring, get_type_data(uint64_t), 3, allocator);
+  CTABS << PRINT(cring_capacity(&ring)) << std::endl;
+  assert(cring_capacity(&ring) == 4);
+
+  uint64_t next_push = 0, next_pop = 0, value;
+  uint32_t done;
+  for (uint32_t lap = 0; lap < 6; ++lap) {
+    while (cring_push(&ring, &next_push))
+      ++next_push;
+    assert(cring_size(&ring) == 4);
+    for (uint32_t i = 0; i < 2; ++i) {
+      done = cring_pop(&ring, &value);
+      assert(done && value == next_pop);
+      ++next_pop;
+    }
+  }
+  while (cring_pop(&ring, &value)) {
+    assert(value == next_pop);
+    ++next_pop;
+  }
+  assert(next_pop == next_push && cring_size(&ring) == 0);
+  cring_cleanup(&ring, NULL);
+  assert(cring_is_def(&ring));
+
+  cring_setup(&ring, get_type_data(cstring_t), 2, allocator);
+  cstring_t str;
+  cstring_def(&str);
+  cstring_setup(&str, "left behind", allocator);
+  done = cring_push(&ring, &str);
+  assert(done);
+  cring_cleanup(&ring, NULL);
+
+  const vtable_t *vtable = get_vtable(get_type_id(cring_t));
+  assert(vtable && vtable->fn_type_size() == sizeof(cring_t));
+}
+
+typedef
+struct spsc_context_t {
+  cring_t *ring;
+  uint32_t count;
+  uint32_t in_order;
+} spsc_context_t;
+
+static
+void
+spsc_producer(void *arg)
+{
+  spsc_context_t *context = (spsc_context_t *)arg;
+  for (uint32_t i = 0; i < context->count; ++i)
+    while (!cring_push(context->ring, &i))
+      thread_yield();
+}
+
+static
+void
+spsc_consumer(void *arg)
+{
+  spsc_context_t *context = (spsc_context_t *)arg;
+  uint32_t value;
+  context->in_order = 1;
+  for (uint32_t i = 0; i < context->count; ++i) {
+    while (!cring_pop(context->ring, &value))
+      thread_yield();
+    context->in_order = context->in_order && value == i;
+  }
+}
+
+static
+void
+test_cring_threads(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  typedef std::chrono::steady_clock clock;
+  cring_t ring;
+  cring_def(&ring);
+  cring_setup(&ring, get_type_data(uint32_t), 1024, allocator);
+
+  spsc_context_t context = { &ring, 1000000, 0 };
+  auto start = clock::now();
+  thread_handle_t consumer = thread_create(spsc_consumer, &context);
+  thread_handle_t producer = thread_create(spsc_producer, &context);
+  assert(consumer != INVALID_THREAD && producer != INVALID_THREAD);
+  thread_join(producer);
+  thread_join(consumer);
+  double ms =
+    std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+  CTABS << PRINT(context.count) << ", " << PRINT(ms) << std::endl;
+  assert(context.in_order && cring_size(&ring) == 0);
+  cring_cleanup(&ring, NULL);
+}
+
+void
+test_cring_main(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  test_cring_basics(allocator, tabs + 1);                     NEWLINE;
+  test_cring_threads(allocator, tabs + 1);                    NEWLINE;
+}
\ No newline at end of file
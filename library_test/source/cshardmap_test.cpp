@@ -0,0 +1,326 @@
+/**
+ * @file cshardmap_test.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <common.h>
+#include <library/allocator/allocator.h>
+#include <library/containers/chashmap.h>
+#include <library/containers/cshardmap.h>
+#include <library/core/core.h>
+#include <library/string/cstring.h>
+#include <library/threading/mutex.h>
+#include <library/threading/thread.h>
+
+
+static
+void
+test_cshardmap_basics(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  cshardmap_t map;
+  cshardmap_def(&map);
+  assert(cshardmap_is_def(&map));
+  cshardmap_setup(
+    &map, get_type_data(uint32_t), get_type_data(uint64_t), 5, allocator);
+  CTABS << PRINT(map.shard_count) << std::endl;
+  assert(map.shard_count == 8);
+
+  // enough keys for every shard to grow a few times.
+  const uint32_t count = 5000;
+  uint32_t done;
+  for (uint32_t i = 0; i < count; ++i) {
+    uint64_t value = (uint64_t)i * 3;
+    done = cshardmap_insert(&map, &i, &value);
+    assert(done);
+  }
+  assert(cshardmap_size(&map) == count);
+
+  uint64_t value = 0;
+  for (uint32_t i = 0; i < count; ++i) {
+    done = cshardmap_find(&map, &i, &value);
+    assert(done && value == (uint64_t)i * 3);
+  }
+  uint32_t missing = count;
+  assert(!cshardmap_find(&map, &missing, NULL));
+
+  // replacing keeps the size, try_insert leaves the value alone.
+  uint32_t key = 7;
+  value = 70;
+  done = cshardmap_insert(&map, &key, &value);
+  assert(!done);
+  value = 700;
+  done = cshardmap_try_insert(&map, &key, &value);
+  assert(!done);
+  done = cshardmap_find(&map, &key, &value);
+  assert(done && value == 70);
+
+  // erasing every other key must keep the rest reachable.
+  for (uint32_t i = 0; i < count; i += 2) {
+    done = cshardmap_erase(&map, &i);
+    assert(done);
+  }
+  for (uint32_t i = 0; i < count; ++i)
+    assert(cshardmap_find(&map, &i, NULL) == (i & 1));
+  done = cshardmap_erase(&map, &key);
+  assert(done);
+  done = cshardmap_erase(&map, &key);
+  assert(!done);
+  CTABS << PRINT(cshardmap_size(&map)) << std::endl;
+  assert(cshardmap_size(&map) == count / 2 - 1);
+  cshardmap_cleanup(&map, NULL);
+  assert(cshardmap_is_def(&map));
+
+  const vtable_t *vtable = get_vtable(get_type_id(cshardmap_t));
+  assert(vtable && vtable->fn_type_size() == sizeof(cshardmap_t));
+}
+
+static
+void
+sum_reader(const void *value, void *user_data)
+{
+  *(uint32_t *)user_data += *(const uint32_t *)value;
+}
+
+static
+void
+test_cshardmap_strings(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  // interning: the first id handed out for a string is the one that sticks.
+  const char *words[] = { "mesh", "texture", "mesh", "font", "texture" };
+  cshardmap_t map;
+  cshardmap_def(&map);
+  cshardmap_setup(
+    &map, get_type_data(cstring_t), get_type_data(uint32_t), 0, allocator);
+
+  uint32_t next_id = 0;
+  for (uint32_t i = 0; i < 5; ++i) {
+    cstring_t word;
+    cstring_def(&word);
+    cstring_setup(&word, words[i], allocator);
+    if (cshardmap_try_insert(&map, &word, &next_id))
+      ++next_id;
+    cstring_cleanup(&word, NULL);
+  }
+  CTABS << PRINT(next_id) << std::endl;
+  assert(next_id == 3 && cshardmap_size(&map) == 3);
+
+  cstring_t word;
+  cstring_def(&word);
+  cstring_setup(&word, "texture", allocator);
+  uint32_t sum = 0;
+  uint32_t done = cshardmap_read(&map, &word, sum_reader, &sum);
+  assert(done && sum == 1);
+  done = cshardmap_erase(&map, &word);
+  assert(done);
+  done = cshardmap_read(&map, &word, sum_reader, &sum);
+  assert(!done);
+  cstring_cleanup(&word, NULL);
+
+  // the keys left in the map are released with it.
+  cshardmap_cleanup(&map, NULL);
+
+  // string values are replicated out of find.
+  cshardmap_setup(
+    &map, get_type_data(uint32_t), get_type_data(cstring_t), 4, allocator);
+  uint32_t key = 1;
+  cstring_t value;
+  cstring_def(&value);
+  cstring_setup(&value, "shared", allocator);
+  done = cshardmap_insert(&map, &key, &value);
+  assert(done);
+  cstring_t copy;
+  done = cshardmap_find(&map, &key, &copy);
+  assert(done);
+  assert(copy.str != value.str && !strcmp(copy.str, "shared"));
+  cstring_cleanup(&copy, NULL);
+  cshardmap_cleanup(&map, NULL);
+}
+
+typedef
+struct mixed_context_t {
+  cshardmap_t *map;
+  uint32_t first;
+  uint32_t count;
+  uint32_t writer;
+  uint32_t found;
+} mixed_context_t;
+
+static
+void
+mixed_thread(void *arg)
+{
+  mixed_context_t *context = (mixed_context_t *)arg;
+  uint32_t i, key, value;
+  for (i = 0; i < context->count; ++i) {
+    key = context->first + i;
+    if (context->writer) {
+      value = key * 2;
+      cshardmap_insert(context->map, &key, &value);
+      if (i & 1)
+        cshardmap_erase(context->map, &key);
+    } else {
+      // readers race the writers, a hit must carry the right value.
+      key = i % (context->count * 4);
+      if (cshardmap_find(context->map, &key, &value)) {
+        assert(value == key * 2);
+        ++context->found;
+      }
+    }
+  }
+}
+
+static
+void
+test_cshardmap_threads(const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  // the writers grow shards, the test allocator is not thread safe.
+  const uint32_t writers = 4, readers = 4, count = 20000;
+  cshardmap_t map;
+  cshardmap_def(&map);
+  cshardmap_setup(
+    &map, get_type_data(uint32_t), get_type_data(uint32_t), 16,
+    &g_default_allocator);
+
+  std::vector<mixed_context_t> contexts(writers + readers);
+  std::vector<thread_handle_t> threads(writers + readers);
+  for (uint32_t i = 0; i < writers + readers; ++i) {
+    contexts[i] = { &map, (i % writers) * count, count, i < writers, 0 };
+    threads[i] = thread_create(mixed_thread, &contexts[i]);
+    assert(threads[i] != INVALID_THREAD);
+  }
+  for (uint32_t i = 0; i < writers + readers; ++i)
+    thread_join(threads[i]);
+
+  CTABS << PRINT(cshardmap_size(&map)) << std::endl;
+  assert(cshardmap_size(&map) == writers * count / 2);
+  for (uint32_t key = 0; key < writers * count; ++key)
+    assert(cshardmap_find(&map, &key, NULL) == !(key & 1));
+  cshardmap_cleanup(&map, NULL);
+}
+
+// the baseline: one chashmap_t behind one mutex.
+typedef
+struct locked_map_t {
+  chashmap_t map;
+  mutex_t mutex;
+} locked_map_t;
+
+typedef
+struct lookup_context_t {
+  cshardmap_t *map;
+  locked_map_t *locked;
+  uint32_t keys;
+  uint32_t lookups;
+  uint32_t seed;
+  uint32_t found;
+} lookup_context_t;
+
+static
+void
+lookup_thread(void *arg)
+{
+  lookup_context_t *context = (lookup_context_t *)arg;
+  uint32_t i, key, value, seed = context->seed;
+  for (i = 0; i < context->lookups; ++i) {
+    seed = seed * 1664525 + 1013904223;
+    key = (seed >> 8) % context->keys;
+    if (context->map)
+      context->found += cshardmap_find(context->map, &key, &value);
+    else {
+      uint32_t *found;
+      mutex_lock(&context->locked->mutex);
+      chashmap_at(&context->locked->map, key, uint32_t, uint32_t, found);
+      context->found += found != NULL;
+      mutex_unlock(&context->locked->mutex);
+    }
+  }
+}
+
+static
+double
+run_lookups(
+  cshardmap_t *map,
+  locked_map_t *locked,
+  uint32_t keys,
+  uint32_t thread_count,
+  uint32_t lookups)
+{
+  typedef std::chrono::steady_clock clock;
+  std::vector<lookup_context_t> contexts(thread_count);
+  std::vector<thread_handle_t> threads(thread_count);
+  auto start = clock::now();
+  for (uint32_t i = 0; i < thread_count; ++i) {
+    contexts[i] = { map, locked, keys, lookups, i + 1, 0 };
+    threads[i] = thread_create(lookup_thread, &contexts[i]);
+  }
+  for (uint32_t i = 0; i < thread_count; ++i) {
+    thread_join(threads[i]);
+    assert(contexts[i].found == lookups);
+  }
+  return
+    std::chrono::duration<double, std::milli>(clock::now() - start).count();
+}
+
+static
+void
+test_cshardmap_benchmark(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  // every thread does the same number of lookups, flat times mean linear
+  // scaling (given that many cores).
+  const uint32_t keys = 1 << 14, lookups = 200000;
+  cshardmap_t map;
+  cshardmap_def(&map);
+  cshardmap_setup(
+    &map, get_type_data(uint32_t), get_type_data(uint32_t), 0, allocator);
+  locked_map_t locked;
+  chashmap_def(&locked.map);
+  chashmap_setup(
+    &locked.map, get_type_data(uint32_t), get_type_data(uint32_t),
+    allocator, 0.6f);
+  mutex_setup(&locked.mutex);
+  for (uint32_t key = 0; key < keys; ++key) {
+    cshardmap_insert(&map, &key, &key);
+    chashmap_insert(&locked.map, key, uint32_t, key, uint32_t);
+  }
+
+  CTABS << PRINT(thread_hardware_concurrency()) << std::endl;
+  for (uint32_t threads = 1; threads <= 8; threads *= 2) {
+    double sharded_ms = run_lookups(&map, NULL, keys, threads, lookups);
+    double locked_ms = run_lookups(NULL, &locked, keys, threads, lookups);
+    CTABS << PRINT(threads) << ", " << PRINT(sharded_ms) << ", " <<
+      PRINT(locked_ms) << std::endl;
+  }
+
+  mutex_cleanup(&locked.mutex);
+  chashmap_cleanup(&locked.map, NULL);
+  cshardmap_cleanup(&map, NULL);
+}
+
+void
+test_cshardmap_main(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  test_cshardmap_basics(allocator, tabs + 1);                 NEWLINE;
+  test_cshardmap_strings(allocator, tabs + 1);                NEWLINE;
+  test_cshardmap_threads(tabs + 1);                           NEWLINE;
+  test_cshardmap_benchmark(allocator, tabs + 1);              NEWLINE;
+}
\ No newline at end of file
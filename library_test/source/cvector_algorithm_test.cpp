@@ -0,0 +1,359 @@
+/**
+ * @file cvector_algorithm_test.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include <common.h>
+#include <library/allocator/allocator.h>
+#include <library/containers/cvector.h>
+#include <library/containers/cvector_algorithm.h>
+#include <library/core/core.h>
+#include <library/string/cstring.h>
+#include <library/threading/job.h>
+
+
+typedef
+struct sort_record_t {
+  uint32_t key;
+  uint32_t sequence;
+  float payload[6];
+} sort_record_t;
+
+static
+int32_t
+compare_record(const void *lhs, const void *rhs)
+{
+  uint32_t left = ((const sort_record_t *)lhs)->key;
+  uint32_t right = ((const sort_record_t *)rhs)->key;
+  return (left > right) - (left < right);
+}
+
+static
+int32_t
+compare_descending(const void *lhs, const void *rhs)
+{
+  return -get_vtable(get_type_id(int32_t))->fn_compare(lhs, rhs);
+}
+
+// sorts random values of 'T' and checks them against std::sort with the
+// registered order.
+template<typename T>
+static
+void
+check_sort(
+  type_data_t type_data,
+  uint32_t count,
+  uint32_t stable,
+  job_system_t *jobs,
+  const allocator_t *allocator)
+{
+  std::mt19937_64 rng(count);
+  std::vector<T> expected(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    uint64_t bits = rng();
+    T value;
+    memcpy(&value, &bits, sizeof(T));
+    if (std::is_floating_point<T>::value) {
+      value = (T)((int64_t)(bits % 20001) - 10000) / (T)7;
+      value = i % 97 == 0 ? (T)-0.0 : value;
+    }
+    expected[i] = value;
+  }
+
+  cvector_t vec;
+  cvector_def(&vec);
+  cvector_setup(&vec, type_data, count, allocator);
+  cvector_resize(&vec, count);
+  if (count)
+    memcpy(vec.data, expected.data(), sizeof(T) * count);
+
+  fn_compare_t compare = elem_data_get_compare_fn(&vec.elem_data);
+  std::stable_sort(expected.begin(), expected.end(),
+    [&](const T &lhs, const T &rhs) { return compare(&lhs, &rhs) < 0; });
+
+  if (stable)
+    cvector_stable_sort(&vec, NULL, jobs);
+  else
+    cvector_sort(&vec, NULL, jobs);
+  assert(!count || !memcmp(vec.data, expected.data(), sizeof(T) * count));
+  cvector_cleanup(&vec, NULL);
+}
+
+static
+void
+test_cvector_sort_primitives(
+  const allocator_t *allocator,
+  job_system_t *jobs,
+  const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  uint32_t counts[] = { 0, 1, 2, 17, 63, 64, 1000, 100000 };
+  for (uint32_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c) {
+    for (uint32_t stable = 0; stable < 2; ++stable) {
+      check_sort<uint8_t>(
+        get_type_data(uint8_t), counts[c], stable, jobs, allocator);
+      check_sort<int8_t>(
+        get_type_data(int8_t), counts[c], stable, jobs, allocator);
+      check_sort<int16_t>(
+        get_type_data(int16_t), counts[c], stable, jobs, allocator);
+      check_sort<uint32_t>(
+        get_type_data(uint32_t), counts[c], stable, jobs, allocator);
+      check_sort<int32_t>(
+        get_type_data(int32_t), counts[c], stable, jobs, allocator);
+      check_sort<uint64_t>(
+        get_type_data(uint64_t), counts[c], stable, jobs, allocator);
+      check_sort<int64_t>(
+        get_type_data(int64_t), counts[c], stable, jobs, allocator);
+      check_sort<float>(
+        get_type_data(float), counts[c], stable, jobs, allocator);
+      check_sort<double>(
+        get_type_data(double), counts[c], stable, jobs, allocator);
+    }
+  }
+  CTABS << "jobs = " << (jobs ? jobs->worker_count : 0) << std::endl;
+
+  // -0 sorts before +0.
+  cvector_t vec;
+  cvector_def(&vec);
+  cvector_setup(&vec, get_type_data(float), 0, allocator);
+  float values[] = { 1.f, 0.f, -0.f, -1.f };
+  for (uint32_t i = 0; i < 4; ++i)
+    cvector_push_back(&vec, values[i], float);
+  cvector_sort(&vec, NULL, NULL);
+  assert(std::signbit(*cvector_as(&vec, 1, float)));
+  assert(!std::signbit(*cvector_as(&vec, 2, float)));
+  cvector_cleanup(&vec, NULL);
+}
+
+static
+void
+test_cvector_sort_custom(
+  const allocator_t *allocator,
+  job_system_t *jobs,
+  uint32_t count,
+  const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  std::mt19937 rng(count);
+  cvector_t vec;
+  cvector_def(&vec);
+  cvector_setup(&vec, get_type_data(sort_record_t), count, allocator);
+  for (uint32_t i = 0; i < count; ++i) {
+    sort_record_t record;
+    memset(&record, 0, sizeof(sort_record_t));
+    record.key = rng() % 1000;
+    record.sequence = i;
+    cvector_push_back(&vec, record, sort_record_t);
+  }
+
+  // equal keys keep their order.
+  cvector_stable_sort(&vec, compare_record, jobs);
+  for (uint32_t i = 1; i < count; ++i) {
+    const sort_record_t *prev = cvector_as(&vec, i - 1, sort_record_t);
+    const sort_record_t *curr = cvector_as(&vec, i, sort_record_t);
+    assert(
+      prev->key < curr->key ||
+      (prev->key == curr->key && prev->sequence < curr->sequence));
+  }
+
+  // every record is still there.
+  for (uint32_t i = 0; i < count; ++i)
+    (cvector_as(&vec, i, sort_record_t))->key = rng() % 1000;
+  cvector_sort(&vec, compare_record, jobs);
+  std::vector<uint32_t> seen(count, 0);
+  for (uint32_t i = 0; i < count; ++i) {
+    const sort_record_t *curr = cvector_as(&vec, i, sort_record_t);
+    assert(!i || (curr - 1)->key <= curr->key);
+    ++seen[curr->sequence];
+  }
+  assert(std::count(seen.begin(), seen.end(), 1u) == (ptrdiff_t)count);
+  CTABS << PRINT(count) << std::endl;
+  cvector_cleanup(&vec, NULL);
+
+  // a custom order on a registered type does not take the radix path.
+  cvector_setup(&vec, get_type_data(int32_t), count, allocator);
+  for (uint32_t i = 0; i < count; ++i)
+    cvector_push_back(&vec, (int32_t)(rng() % 2001) - 1000, int32_t);
+  cvector_sort(&vec, compare_descending, jobs);
+  for (uint32_t i = 1; i < count; ++i)
+    assert(
+      *cvector_as(&vec, i - 1, int32_t) >= *cvector_as(&vec, i, int32_t));
+  cvector_cleanup(&vec, NULL);
+}
+
+static
+void
+test_cvector_unique(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  const char *words[] = {
+    "pear", "apple", "fig", "apple", "kiwi", "fig", "apple", "pear" };
+  cvector_t vec;
+  cvector_def(&vec);
+  cvector_setup(&vec, get_type_data(cstring_t), 0, allocator);
+  for (uint32_t i = 0; i < 8; ++i) {
+    cstring_t word;
+    cstring_def(&word);
+    cstring_setup(&word, words[i], allocator);
+    cvector_push_back(&vec, word, cstring_t);
+  }
+
+  cvector_sort(&vec, NULL, NULL);
+  size_t size = cvector_unique(&vec, NULL);
+  CTABS << PRINT(size) << std::endl;
+  assert(size == 4 && vec.size == 4);
+  const char *expected[] = { "apple", "fig", "kiwi", "pear" };
+  for (uint32_t i = 0; i < 4; ++i)
+    assert(!strcmp((cvector_as(&vec, i, cstring_t))->str, expected[i]));
+
+  size_t index =
+    cvector_lower_bound(&vec, cvector_as(&vec, 2, cstring_t), NULL);
+  assert(index == 2);
+  cvector_cleanup(&vec, NULL);
+
+  cvector_setup(&vec, get_type_data(uint32_t), 0, allocator);
+  size_t unique = cvector_unique(&vec, NULL);
+  assert(unique == 0);
+  cvector_cleanup(&vec, NULL);
+}
+
+static
+uint32_t
+is_even(const void *elem, void *user_data)
+{
+  return !(*(const uint32_t *)elem & 1);
+}
+
+static
+void
+test_cvector_partition_lower_bound(
+  const allocator_t *allocator,
+  const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  cvector_t vec;
+  cvector_def(&vec);
+  cvector_setup(&vec, get_type_data(uint32_t), 0, allocator);
+  for (uint32_t i = 0; i < 101; ++i)
+    cvector_push_back(&vec, (i * 37) % 101, uint32_t);
+
+  size_t split = cvector_partition(&vec, is_even, NULL);
+  CTABS << PRINT(split) << std::endl;
+  assert(split == 51);
+  for (uint32_t i = 0; i < 101; ++i)
+    assert(is_even(cvector_as(&vec, i, uint32_t), NULL) == (i < split));
+
+  cvector_sort(&vec, NULL, NULL);
+  for (uint32_t key = 0; key <= 101; ++key)
+    assert(cvector_lower_bound(&vec, &key, NULL) == key);
+  cvector_cleanup(&vec, NULL);
+}
+
+static
+int
+qsort_compare(const void *lhs, const void *rhs)
+{
+  uint32_t left = *(const uint32_t *)lhs, right = *(const uint32_t *)rhs;
+  return (left > right) - (left < right);
+}
+
+// not the registered function, forces the comparison based sort.
+static
+int32_t
+compare_u32(const void *lhs, const void *rhs)
+{
+  return (int32_t)qsort_compare(lhs, rhs);
+}
+
+static
+void
+test_cvector_sort_benchmark(
+  const allocator_t *allocator,
+  job_system_t *jobs,
+  const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  typedef std::chrono::steady_clock clock;
+  auto elapsed = [](clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(
+      clock::now() - start).count();
+  };
+
+  const uint32_t count = 1 << 22;
+  std::vector<uint32_t> source(count);
+  std::mt19937 rng(7);
+  for (uint32_t i = 0; i < count; ++i)
+    source[i] = rng();
+
+  std::vector<uint32_t> values(source);
+  auto start = clock::now();
+  qsort(values.data(), count, sizeof(uint32_t), qsort_compare);
+  double qsort_ms = elapsed(start);
+
+  cvector_t vec;
+  cvector_def(&vec);
+  cvector_setup(&vec, get_type_data(uint32_t), count, allocator);
+  cvector_resize(&vec, count);
+  memcpy(vec.data, source.data(), sizeof(uint32_t) * count);
+  start = clock::now();
+  cvector_sort(&vec, NULL, NULL);
+  double radix_ms = elapsed(start);
+  assert(!memcmp(vec.data, values.data(), sizeof(uint32_t) * count));
+
+  memcpy(vec.data, source.data(), sizeof(uint32_t) * count);
+  start = clock::now();
+  cvector_sort(&vec, NULL, jobs);
+  double parallel_ms = elapsed(start);
+  assert(!memcmp(vec.data, values.data(), sizeof(uint32_t) * count));
+
+  memcpy(vec.data, source.data(), sizeof(uint32_t) * count);
+  start = clock::now();
+  cvector_sort(&vec, compare_u32, NULL);
+  double intro_ms = elapsed(start);
+  assert(!memcmp(vec.data, values.data(), sizeof(uint32_t) * count));
+  cvector_cleanup(&vec, NULL);
+
+  CTABS << PRINT(count) << ", workers = " << jobs->worker_count << std::endl;
+  CTABS << PRINT(qsort_ms) << ", " << PRINT(intro_ms) << std::endl;
+  CTABS << PRINT(radix_ms) << ", " << PRINT(parallel_ms) << std::endl;
+}
+
+void
+test_cvector_algorithm_main(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  // only the calling thread allocates, the workers just sort.
+  job_system_t jobs;
+  job_system_setup(&jobs, 4, &g_default_allocator);
+
+  test_cvector_sort_primitives(allocator, NULL, tabs + 1);            NEWLINE;
+  test_cvector_sort_primitives(allocator, &jobs, tabs + 1);           NEWLINE;
+  test_cvector_sort_custom(allocator, NULL, 5000, tabs + 1);          NEWLINE;
+  test_cvector_sort_custom(allocator, &jobs, 300000, tabs + 1);       NEWLINE;
+  test_cvector_unique(allocator, tabs + 1);                           NEWLINE;
+  test_cvector_partition_lower_bound(allocator, tabs + 1);            NEWLINE;
+  test_cvector_sort_benchmark(allocator, &jobs, tabs + 1);            NEWLINE;
+
+  job_system_cleanup(&jobs);
+}
\ No newline at end of file
@@ -10,6 +10,7 @@
  */
 #include <cassert>
 #include <cstdint>
+#include <cstring>
 #include <string>
 #include <classroom.h>
 #include <common.h>
@@ -407,6 +408,52 @@ test_cvector_serialize(const allocator_t* allocator, const int32_t tabs)
   binary_stream_cleanup(&stream);
 }
 
+static
+void
+test_cvector_serialize_delta(const allocator_t* allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  cvector_t sorted, copy;
+  cvector_def(&sorted);
+  cvector_def(&copy);
+  cvector_setup(&sorted, get_type_data(uint32_t), 1000, allocator);
+  for (uint32_t i = 0; i < 1000; ++i)
+    cvector_push_back(&sorted, 100000 + i * 7, uint32_t);
+  // a descending tail and a wrap-around both stay valid, only larger.
+  cvector_push_back(&sorted, 5, uint32_t);
+  cvector_push_back(&sorted, 0xffffffff, uint32_t);
+
+  binary_stream_t stream;
+  binary_stream_def(&stream);
+  binary_stream_setup(&stream, allocator);
+
+  cvector_serialize_delta(&sorted, &stream);
+  CTABS << "raw: " << sorted.size * sizeof(uint32_t) << " bytes, delta: " <<
+    binary_stream_size(&stream) << " bytes" << std::endl;
+  assert(binary_stream_size(&stream) < sorted.size * sizeof(uint32_t) / 3);
+
+  cvector_deserialize_delta(&copy, allocator, &stream);
+  assert(copy.size == sorted.size && copy.capacity == copy.size);
+  assert(!memcmp(copy.data, sorted.data, sorted.size * sizeof(uint32_t)));
+  assert(stream.pos == STREAM_EOF);
+  cvector_cleanup(&copy, NULL);
+
+  // a truncated stream reads 0 deltas past the cut, never past the buffer.
+  cvector_def(&copy);
+  cvector_resize(stream.data, binary_stream_size(&stream) / 2 + 1);
+  binary_stream_seek(&stream, 0);
+  cvector_deserialize_delta(&copy, allocator, &stream);
+  assert(copy.size == sorted.size && stream.pos == STREAM_EOF);
+  assert(
+    *cvector_as(&copy, copy.size - 1, uint32_t) ==
+    *cvector_as(&copy, copy.size - 2, uint32_t));
+
+  cvector_cleanup(&sorted, NULL);
+  cvector_cleanup(&copy, NULL);
+  binary_stream_cleanup(&stream);
+}
+
 void
 test_cvector_main(const allocator_t* allocator, const int32_t tabs)
 {
@@ -420,4 +467,5 @@ test_cvector_main(const allocator_t* allocator, const int32_t tabs)
   test_cvector_mem(allocator, tabs + 1);                    NEWLINE;
   test_cvector_custom(allocator, tabs + 1);                 NEWLINE;
   test_cvector_serialize(allocator, tabs + 1);              NEWLINE;
+  test_cvector_serialize_delta(allocator, tabs + 1);        NEWLINE;
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
  * @copyright Copyright (c) 2025
  *
  */
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <vector>
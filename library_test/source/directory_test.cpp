@@ -0,0 +1,174 @@
+/**
+ * @file directory_test.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <common.h>
+#include <library/allocator/allocator.h>
+#include <library/filesystem/directory.h>
+
+
+namespace fs = std::filesystem;
+
+// 'depth' levels of 'fanout' directories, each holding 'fanout' files.
+static
+uint32_t
+make_tree(const fs::path &root, uint32_t depth, uint32_t fanout)
+{
+  uint32_t files = 0;
+  fs::create_directories(root);
+  for (uint32_t i = 0; i < fanout; ++i) {
+    std::ofstream(root / ("file_" + std::to_string(i) + ".bin")) <<
+      std::string(i + 1, 'x');
+    ++files;
+  }
+
+  if (depth) {
+    for (uint32_t i = 0; i < fanout; ++i)
+      files += make_tree(
+        root / ("dir_" + std::to_string(i)), depth - 1, fanout);
+  }
+
+  return files;
+}
+
+static
+void
+test_dir_iterator(const fs::path &root, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  dir_iterator_t iterator;
+  dir_entry_t entry;
+  uint32_t files = 0, directories = 0;
+  uint64_t bytes = 0;
+
+  uint32_t opened =
+    dir_iterator_open(&iterator, root.string().c_str(), DIR_FLAG_STAT);
+  assert(opened);
+  while (dir_iterator_next(&iterator, &entry)) {
+    assert(entry.name_length == strlen(entry.name));
+    if (entry.type == DIR_ENTRY_DIRECTORY)
+      ++directories;
+    else {
+      assert(entry.type == DIR_ENTRY_FILE && entry.mtime);
+      ++files;
+      bytes += entry.size;
+    }
+  }
+  dir_iterator_close(&iterator);
+
+  CTABS << PRINT(directories) << ", " << PRINT(files) << ", " <<
+    PRINT(bytes) << std::endl;
+  assert(directories == 4 && files == 4 && bytes == 1 + 2 + 3 + 4);
+
+  opened = dir_iterator_open(
+    &iterator, (root / "missing").string().c_str(), DIR_FLAG_NONE);
+  assert(!opened);
+}
+
+typedef
+struct walk_counts_t {
+  std::atomic<uint32_t> files;
+  std::atomic<uint32_t> directories;
+  std::atomic<uint32_t> max_worker;
+} walk_counts_t;
+
+static
+uint32_t
+count_entry(
+  const char *path,
+  const dir_entry_t *entry,
+  uint32_t worker,
+  void *user_data)
+{
+  walk_counts_t *counts = (walk_counts_t *)user_data;
+  assert(strstr(path, entry->name));
+  if (entry->type == DIR_ENTRY_DIRECTORY)
+    ++counts->directories;
+  else
+    ++counts->files;
+
+  uint32_t max = counts->max_worker;
+  while (worker > max && !counts->max_worker.compare_exchange_weak(max, worker));
+  return 1;
+}
+
+static
+uint32_t
+prune_entry(
+  const char *path,
+  const dir_entry_t *entry,
+  uint32_t worker,
+  void *user_data)
+{
+  // only descend into the first directory of every level.
+  return entry->type != DIR_ENTRY_DIRECTORY || !strcmp(entry->name, "dir_0");
+}
+
+static
+void
+test_dir_walk(
+  const allocator_t *allocator,
+  const fs::path &root,
+  uint32_t expected_files,
+  const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  for (uint32_t workers = 1; workers <= 4; workers *= 2) {
+    walk_counts_t counts;
+    counts.files = counts.directories = counts.max_worker = 0;
+    dir_walk_stats_t stats;
+    dir_walk(
+      root.string().c_str(), DIR_FLAG_NONE, workers,
+      count_entry, &counts, allocator, &stats);
+
+    CTABS << PRINT(workers) << ", " << PRINT(stats.directories) << ", " <<
+      PRINT(stats.files) << std::endl;
+    assert(counts.files == expected_files && stats.files == expected_files);
+    assert(stats.directories == counts.directories + 1);
+    assert(counts.max_worker < workers && stats.skipped == 0);
+  }
+
+  // the root and dir_0 on each of the 3 levels below it, 4 files apiece.
+  dir_walk_stats_t stats;
+  dir_walk(
+    root.string().c_str(), DIR_FLAG_NONE, 2,
+    prune_entry, NULL, allocator, &stats);
+  assert(stats.directories == 4 && stats.files == 4 * 4);
+
+  // a root too long to join a child path to is skipped, not walked.
+  std::string deep = root.string();
+  while (deep.size() < MAX_PATH_LENGTH + 64)
+    deep += "/dir_0";
+  dir_walk(
+    deep.c_str(), DIR_FLAG_NONE, 1, count_entry, NULL, allocator, &stats);
+  assert(stats.directories == 0 && stats.files == 0 && stats.skipped == 1);
+}
+
+void
+test_directory_main(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  fs::path root = unique_temp_path("library_directory_test");
+  uint32_t files = make_tree(root, 3, 4);
+
+  test_dir_iterator(root, tabs + 1);                      NEWLINE;
+  test_dir_walk(allocator, root, files, tabs + 1);        NEWLINE;
+
+  fs::remove_all(root);
+}
\ No newline at end of file
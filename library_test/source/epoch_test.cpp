@@ -0,0 +1,186 @@
+/**
+ * @file epoch_test.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <common.h>
+#include <library/allocator/allocator.h>
+#include <library/threading/atomic.h>
+#include <library/threading/epoch.h>
+#include <library/threading/thread.h>
+
+
+// counts what the domain hands back, on top of malloc (thread safe).
+static std::atomic<int32_t> s_live(0);
+
+static
+void *
+counted_alloc(size_t size)
+{
+  ++s_live;
+  return malloc(size);
+}
+
+static
+void
+counted_free(void *ptr)
+{
+  --s_live;
+  free(ptr);
+}
+
+static const allocator_t s_counted = {
+  counted_alloc, counted_free, NULL, NULL, NULL };
+
+static
+void
+test_epoch_basics(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  epoch_domain_t *domain =
+    (epoch_domain_t *)allocator->mem_alloc(sizeof(epoch_domain_t));
+  epoch_domain_setup(domain, allocator);
+  epoch_record_t *reader = epoch_register(domain);
+  epoch_record_t *writer = epoch_register(domain);
+  assert(reader && writer && reader != writer);
+
+  // a pinned reader holds every free back, however often the writer collects.
+  epoch_enter(reader);
+  epoch_enter(reader);
+  for (uint32_t i = 0; i < 3; ++i)
+    epoch_retire(writer, counted_alloc(16), &s_counted);
+  size_t pending;
+  for (uint32_t i = 0; i < 4; ++i) {
+    pending = epoch_collect(writer);
+    assert(pending == 3);
+  }
+  CTABS << PRINT(domain->global) << ", " << PRINT(s_live) << std::endl;
+  assert(s_live == 3);
+
+  // only the outer exit unpins.
+  epoch_exit(reader);
+  pending = epoch_collect(writer);
+  assert(pending == 3);
+  epoch_exit(reader);
+  epoch_barrier(writer);
+  CTABS << PRINT(domain->global) << ", " << PRINT(s_live) << std::endl;
+  assert(s_live == 0);
+
+  // what is still pending at cleanup is freed with the domain.
+  for (uint32_t i = 0; i < 5; ++i)
+    epoch_retire(writer, counted_alloc(16), &s_counted);
+  epoch_unregister(writer);
+  epoch_unregister(reader);
+  epoch_domain_cleanup(domain);
+  assert(s_live == 0);
+  allocator->mem_free(domain);
+}
+
+typedef
+struct node_t {
+  uint64_t value;
+  uint64_t check;
+} node_t;
+
+typedef
+struct swap_context_t {
+  epoch_domain_t *domain;
+  void *volatile *slot;
+  uint32_t count;
+  volatile uint32_t *done;
+  uint32_t reads;
+} swap_context_t;
+
+static
+void
+swap_writer(void *arg)
+{
+  swap_context_t *context = (swap_context_t *)arg;
+  epoch_record_t *record = epoch_register(context->domain);
+  for (uint32_t i = 1; i <= context->count; ++i) {
+    node_t *node = (node_t *)counted_alloc(sizeof(node_t));
+    node->value = i;
+    node->check = ~(uint64_t)i;
+    epoch_retire(
+      record, atomic_exchange_ptr(context->slot, node), &s_counted);
+  }
+  atomic_store_u32(context->done, 1);
+  epoch_barrier(record);
+  epoch_unregister(record);
+}
+
+static
+void
+swap_reader(void *arg)
+{
+  swap_context_t *context = (swap_context_t *)arg;
+  epoch_record_t *record = epoch_register(context->domain);
+  while (!atomic_load_u32(context->done)) {
+    epoch_enter(record);
+    node_t *node = (node_t *)atomic_load_ptr(context->slot);
+    // a node freed under the reader would fail here (or under asan).
+    if (node) {
+      assert(node->check == ~node->value);
+      ++context->reads;
+    }
+    epoch_exit(record);
+    thread_yield();
+  }
+  epoch_unregister(record);
+}
+
+static
+void
+test_epoch_threads(const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  // the limbo lists grow on the worker threads, needs a thread safe allocator.
+  const uint32_t readers = 3;
+  epoch_domain_t *domain =
+    (epoch_domain_t *)g_default_allocator.mem_alloc(sizeof(epoch_domain_t));
+  epoch_domain_setup(domain, &g_default_allocator);
+
+  void *volatile slot = NULL;
+  volatile uint32_t done = 0;
+  std::vector<swap_context_t> contexts(readers + 1);
+  std::vector<thread_handle_t> threads(readers + 1);
+  for (uint32_t i = 0; i <= readers; ++i) {
+    contexts[i] = { domain, &slot, 100000, &done, 0 };
+    threads[i] = thread_create(i ? swap_reader : swap_writer, &contexts[i]);
+    assert(threads[i] != INVALID_THREAD);
+  }
+  uint32_t reads = 0;
+  for (uint32_t i = 0; i <= readers; ++i) {
+    thread_join(threads[i]);
+    reads += contexts[i].reads;
+  }
+
+  CTABS << PRINT(domain->global) << ", " << PRINT(reads) << ", " <<
+    PRINT(s_live) << std::endl;
+  // only the node left in the slot is alive.
+  assert(s_live == 1);
+  counted_free(slot);
+  epoch_domain_cleanup(domain);
+  g_default_allocator.mem_free(domain);
+}
+
+void
+test_epoch_main(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  test_epoch_basics(allocator, tabs + 1);                     NEWLINE;
+  test_epoch_threads(tabs + 1);                               NEWLINE;
+}
\ No newline at end of file
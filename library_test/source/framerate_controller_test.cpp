@@ -0,0 +1,238 @@
+/**
+ * @file framerate_controller_test.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <common.h>
+#include <library/allocator/allocator.h>
+#include <library/framerate_controller/framerate_controller.h>
+
+
+// simulated time in nanoseconds. a read costs a microsecond and a sleep runs a
+// tenth of a millisecond over, so the spin and the sleep estimate both work.
+typedef
+struct fake_clock_t {
+  uint64_t ns;
+  uint64_t ticks_per_second;
+} fake_clock_t;
+
+static
+uint64_t
+fake_ticks(void *user_data)
+{
+  fake_clock_t *fake = (fake_clock_t *)user_data;
+  fake->ns += 1000;
+  return fake->ns / (1000000000ull / fake->ticks_per_second);
+}
+
+static
+void
+fake_sleep(void *user_data, uint32_t ms)
+{
+  ((fake_clock_t *)user_data)->ns += ms * 1000000ull + 100000ull;
+}
+
+static
+void
+use_fake_clock(framerate_controller_t *controller, fake_clock_t *fake)
+{
+  framerate_clock_t clock = {
+    fake_ticks, fake_sleep, fake->ticks_per_second, fake };
+  controller_set_clock(controller, &clock);
+}
+
+static
+void
+test_framerate_pacing(
+  const allocator_t *allocator,
+  uint64_t target_fps,
+  const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  // a millisecond clock, the period is not a whole number of ticks.
+  const uint32_t frames = 60;
+  fake_clock_t fake = { 0, 1000 };
+  framerate_controller_t *controller =
+    controller_allocate(allocator, target_fps, 1);
+  use_fake_clock(controller, &fake);
+  double target_ms = 1000. / target_fps;
+
+  // the first frame only lines up the schedule.
+  controller_start(controller);
+  controller_end(controller);
+  uint64_t start = fake.ns;
+  for (uint32_t i = 0; i < frames; ++i) {
+    controller_start(controller);
+    controller_end(controller);
+  }
+  double frame_ms = (double)(fake.ns - start) / 1000000. / frames;
+  double error = fabs(frame_ms - target_ms) / target_ms;
+
+  CTABS << PRINT(target_fps) << ", " << PRINT(target_ms) << ", " <<
+    PRINT(frame_ms) << ", " << PRINT(error) << std::endl;
+  // 1000 / 144 used to truncate to 6 ms, 13.6% off.
+  assert(error < 0.01);
+  controller_free(controller, allocator);
+}
+
+static
+void
+test_framerate_pacing_os(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  // the real clock, a loaded machine only makes frames late. the schedule
+  // can run up to a period behind before it restarts, hence the slack.
+  typedef std::chrono::steady_clock clock;
+  const uint64_t target_fps = 60;
+  const uint32_t frames = 30;
+  framerate_controller_t *controller =
+    controller_allocate(allocator, target_fps, 1);
+  double target_ms = 1000. / target_fps;
+
+  controller_start(controller);
+  controller_end(controller);
+  auto start = clock::now();
+  for (uint32_t i = 0; i < frames; ++i) {
+    controller_start(controller);
+    controller_end(controller);
+  }
+  double frame_ms =
+    std::chrono::duration<double, std::milli>(
+      clock::now() - start).count() / frames;
+
+  CTABS << PRINT(target_ms) << ", " << PRINT(frame_ms) << std::endl;
+  assert(frame_ms >= target_ms * 0.9);
+  controller_free(controller, allocator);
+}
+
+static
+void
+test_framerate_stats(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  const uint64_t target_fps = 240;
+  const double target_ms = 1000. / target_fps;
+  fake_clock_t fake = { 0, 1000000 };
+  framerate_controller_t *controller =
+    controller_allocate(allocator, target_fps, 1);
+  use_fake_clock(controller, &fake);
+  framerate_stats_t stats;
+  controller_get_stats(controller, &stats);
+  assert(stats.frames == 0);
+  assert(controller_frame_percentile(controller, 50.) == 0.);
+
+  // 60 paced frames with one 20 ms hitch in the middle.
+  for (uint32_t i = 0; i <= 60; ++i) {
+    controller_start(controller);
+    if (i == 30)
+      fake.ns += 20000000ull;
+    controller_end(controller);
+  }
+  controller_get_stats(controller, &stats);
+
+  CTABS << PRINT(stats.frames) << ", " << PRINT(stats.dropped_frames) <<
+    ", " << PRINT(stats.smoothed_fps) << std::endl;
+  CTABS << PRINT(stats.min_ms) << ", " << PRINT(stats.avg_ms) << ", " <<
+    PRINT(stats.max_ms) << std::endl;
+  CTABS << PRINT(stats.p50_ms) << ", " << PRINT(stats.p95_ms) << ", " <<
+    PRINT(stats.p99_ms) << ", " << PRINT(stats.p999_ms) << std::endl;
+
+  // the first start only opens the first frame.
+  assert(stats.frames == 60 && stats.total_frames == 60);
+  assert(fabs(stats.p50_ms - target_ms) < target_ms * 0.05);
+  assert(stats.max_ms >= 20. && stats.p99_ms >= 20. * 0.97);
+  assert(stats.min_ms <= stats.p50_ms && stats.p50_ms <= stats.p95_ms);
+  assert(stats.p95_ms <= stats.p99_ms && stats.p99_ms <= stats.p999_ms);
+  // 20 ms spans ~5 periods at 240 fps.
+  assert(stats.dropped_frames >= 4);
+
+  controller_reset_stats(controller);
+  controller_get_stats(controller, &stats);
+  assert(stats.frames == 0 && stats.dropped_frames == 0);
+  controller_free(controller, allocator);
+}
+
+static
+void
+test_framerate_fixed_step(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  // a 100 hz simulation under 60 fps rendering, 1 or 2 steps a frame.
+  const uint64_t rate = 100;
+  fake_clock_t fake = { 0, 1000000 };
+  framerate_controller_t *controller = controller_allocate(allocator, 60, 1);
+  use_fake_clock(controller, &fake);
+  controller_set_fixed_step(controller, rate, 5);
+  assert(controller_fixed_dt(controller) == 0.01);
+
+  double elapsed = 0.;
+  uint64_t steps = 0;
+  uint32_t hitch_steps = 0, min_steps = 100, max_steps = 0;
+  controller_start(controller);
+  controller_end(controller);
+  for (uint32_t i = 0; i < 60; ++i) {
+    elapsed += controller_start(controller);
+    uint32_t frame_steps = controller_fixed_steps(controller);
+    double alpha = controller_fixed_alpha(controller);
+    assert(alpha >= 0. && alpha < 1.);
+    steps += frame_steps;
+    min_steps = frame_steps < min_steps ? frame_steps : min_steps;
+    max_steps = frame_steps > max_steps ? frame_steps : max_steps;
+    controller_end(controller);
+  }
+
+  // what was not stepped yet is the alpha, no time is lost between frames.
+  double simulated = (double)steps + controller_fixed_alpha(controller);
+  CTABS << PRINT(elapsed) << ", " << PRINT(steps) << ", " <<
+    PRINT(simulated) << ", " << PRINT(min_steps) << ", " <<
+    PRINT(max_steps) << std::endl;
+  assert(fabs(simulated - elapsed * rate) < 0.01);
+  assert(min_steps >= 1 && max_steps <= 2);
+  assert(controller_fixed_skipped(controller) == 0);
+
+  // a 100 ms hitch is 10 steps behind, only 5 run and the rest is dropped.
+  controller_start(controller);
+  fake.ns += 100000000ull;
+  controller_end(controller);
+  controller_start(controller);
+  hitch_steps = controller_fixed_steps(controller);
+  CTABS << PRINT(hitch_steps) << ", " <<
+    PRINT(controller_fixed_skipped(controller)) << std::endl;
+  assert(hitch_steps == 5 && controller_fixed_skipped(controller) >= 5);
+  controller_end(controller);
+
+  // off, no steps are handed out.
+  controller_set_fixed_step(controller, 0, 0);
+  controller_start(controller);
+  assert(controller_fixed_steps(controller) == 0);
+  controller_end(controller);
+  controller_free(controller, allocator);
+}
+
+void
+test_framerate_controller_main(
+  const allocator_t *allocator,
+  const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  test_framerate_pacing(allocator, 60, tabs + 1);            NEWLINE;
+  test_framerate_pacing(allocator, 144, tabs + 1);           NEWLINE;
+  test_framerate_pacing(allocator, 240, tabs + 1);           NEWLINE;
+  test_framerate_pacing_os(allocator, tabs + 1);              NEWLINE;
+  test_framerate_stats(allocator, tabs + 1);                  NEWLINE;
+  test_framerate_fixed_step(allocator, tabs + 1);             NEWLINE;
+}
\ No newline at end of file
@@ -0,0 +1,258 @@
+/**
+ * @file job_test.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <common.h>
+#include <library/allocator/allocator.h>
+#include <library/core/core.h>
+#include <library/threading/job.h>
+#include <library/threading/thread.h>
+
+
+static
+void
+sum_range(uint32_t begin, uint32_t end, void *user_data)
+{
+  std::atomic<uint64_t> *sum = (std::atomic<uint64_t> *)user_data;
+  uint64_t local = 0;
+  for (uint32_t i = begin; i < end; ++i)
+    local += i;
+  *sum += local;
+}
+
+static
+void
+test_job_parallel_for(
+  const allocator_t *allocator,
+  uint32_t worker_count,
+  const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  job_system_t system;
+  job_system_setup(&system, worker_count, allocator);
+  CTABS << PRINT(worker_count) << ", " << PRINT(system.worker_count) <<
+    std::endl;
+  assert(job_worker_index() == 0);
+
+  uint32_t counts[] = { 1, 7, 1000, 1 << 20 };
+  uint32_t grains[] = { 1, 3, 64, 4096 };
+  for (uint32_t c = 0; c < 4; ++c) {
+    for (uint32_t g = 0; g < 4; ++g) {
+      std::atomic<uint64_t> sum(0);
+      uint64_t count = counts[c];
+      job_parallel_for(&system, counts[c], grains[g], sum_range, &sum);
+      assert(sum == count * (count - 1) / 2);
+    }
+  }
+
+  job_system_cleanup(&system);
+  assert(job_worker_index() == (uint32_t)-1);
+}
+
+typedef
+struct tree_context_t {
+  job_system_t *system;
+  std::atomic<uint32_t> visited;
+} tree_context_t;
+
+typedef
+struct tree_node_t {
+  uint32_t depth;
+  tree_context_t *context;
+} tree_node_t;
+
+// every node spawns two children until depth runs out.
+static
+void
+tree_job(job_t *job, void *data)
+{
+  tree_node_t node = *(tree_node_t *)data;
+  job_system_t *system = node.context->system;
+  ++node.context->visited;
+  if (node.depth) {
+    tree_node_t child = { node.depth - 1, node.context };
+    job_run(system, job_create(system, tree_job, &child, sizeof(child), job));
+    job_run(system, job_create(system, tree_job, &child, sizeof(child), job));
+  }
+}
+
+static
+void
+test_job_children(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  job_system_t system;
+  job_system_setup(&system, 4, allocator);
+
+  tree_context_t context;
+  context.system = &system;
+  context.visited = 0;
+  const uint32_t depth = 10;
+  tree_node_t root = { depth, &context };
+  job_t *job = job_create(&system, tree_job, &root, sizeof(root), NULL);
+  job_run(&system, job);
+  job_wait(&system, job);
+  CTABS << PRINT(context.visited) << std::endl;
+  assert(job_is_finished(job));
+  assert(context.visited == (1u << (depth + 1)) - 1);
+
+  job_system_cleanup(&system);
+}
+
+typedef
+struct scratch_data_t {
+  job_system_t *system;
+  uint32_t count;
+  std::atomic<uint32_t> *failures;
+} scratch_data_t;
+
+static
+void
+scratch_job(job_t *job, void *data)
+{
+  scratch_data_t *scratch = (scratch_data_t *)data;
+  const allocator_t *allocator = job_scratch_allocator();
+  uint32_t *values =
+    (uint32_t *)allocator->mem_alloc(sizeof(uint32_t) * scratch->count);
+  for (uint32_t i = 0; i < scratch->count; ++i)
+    values[i] = i;
+
+  values = (uint32_t *)allocator->mem_realloc(
+    values, sizeof(uint32_t) * scratch->count * 2);
+  uint8_t *zeroes = (uint8_t *)allocator->mem_cont_alloc(64, 1);
+  uint8_t *aligned = (uint8_t *)allocator->mem_alloc_alligned(256, 32);
+
+  bool ok = ((uintptr_t)aligned & 255) == 0;
+  for (uint32_t i = 0; i < scratch->count; ++i)
+    ok = ok && values[i] == i;
+  for (uint32_t i = 0; i < 64; ++i)
+    ok = ok && zeroes[i] == 0;
+  allocator->mem_free(values);
+  if (!ok)
+    ++*scratch->failures;
+}
+
+static
+void
+scratch_spawn(job_t *job, void *data)
+{
+  scratch_data_t *scratch = (scratch_data_t *)data;
+  for (uint32_t i = 0; i < 256; ++i)
+    job_run(scratch->system, job_create(
+      scratch->system, scratch_job, scratch, sizeof(scratch_data_t), job));
+}
+
+static
+void
+test_job_scratch(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  job_system_t system;
+  job_system_setup(&system, 4, allocator);
+
+  // the jobs allocate far more than the arenas hold over the whole run, it
+  // only works if the arena is reset after each one.
+  std::atomic<uint32_t> failures(0);
+  scratch_data_t data = { &system, 16 * 1024, &failures };
+  job_t *root = job_create(&system, scratch_spawn, &data, sizeof(data), NULL);
+  job_run(&system, root);
+  job_wait(&system, root);
+  CTABS << PRINT(failures) << std::endl;
+  assert(failures == 0);
+
+  job_system_cleanup(&system);
+}
+
+static
+void
+spin_work(uint32_t begin, uint32_t end, void *user_data)
+{
+  std::atomic<uint64_t> *sink = (std::atomic<uint64_t> *)user_data;
+  uint64_t value = begin;
+  for (uint32_t i = begin; i < end; ++i)
+    for (uint32_t k = 0; k < 2000; ++k)
+      value = value * 6364136223846793005ull + 1442695040888963407ull;
+  *sink += value;
+}
+
+struct thread_task_t {
+  uint32_t begin;
+  uint32_t end;
+  std::atomic<uint64_t> *sink;
+};
+
+static
+void
+thread_task(void *arg)
+{
+  thread_task_t *task = (thread_task_t *)arg;
+  spin_work(task->begin, task->end, task->sink);
+}
+
+// small tasks, spawning a thread for each one is the baseline.
+static
+void
+test_job_benchmark(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  typedef std::chrono::steady_clock clock;
+  const uint32_t tasks = 4096, grain = 4;
+  std::atomic<uint64_t> sink(0);
+
+  job_system_t system;
+  job_system_setup(&system, 0, allocator);
+  auto start = clock::now();
+  job_parallel_for(&system, tasks * grain, grain, spin_work, &sink);
+  double job_ms =
+    std::chrono::duration<double, std::milli>(clock::now() - start).count();
+  uint32_t workers = system.worker_count;
+  job_system_cleanup(&system);
+
+  std::vector<thread_task_t> descs(tasks);
+  std::vector<thread_handle_t> threads(workers);
+  start = clock::now();
+  for (uint32_t i = 0; i < tasks; i += workers) {
+    uint32_t batch = tasks - i < workers ? tasks - i : workers;
+    for (uint32_t t = 0; t < batch; ++t) {
+      descs[i + t] = { (i + t) * grain, (i + t + 1) * grain, &sink };
+      threads[t] = thread_create(thread_task, &descs[i + t]);
+      assert(threads[t] != INVALID_THREAD);
+    }
+    for (uint32_t t = 0; t < batch; ++t)
+      thread_join(threads[t]);
+  }
+  double thread_ms =
+    std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+  CTABS << PRINT(workers) << ", " << PRINT(tasks) << std::endl;
+  CTABS << PRINT(job_ms) << ", " << PRINT(thread_ms) << std::endl;
+}
+
+void
+test_job_main(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  // the workers allocate concurrently, the test allocator is not thread safe.
+  test_job_parallel_for(&g_default_allocator, 1, tabs + 1);        NEWLINE;
+  test_job_parallel_for(&g_default_allocator, 4, tabs + 1);        NEWLINE;
+  test_job_children(&g_default_allocator, tabs + 1);               NEWLINE;
+  test_job_scratch(&g_default_allocator, tabs + 1);                NEWLINE;
+  test_job_benchmark(&g_default_allocator, tabs + 1);              NEWLINE;
+}
\ No newline at end of file
@@ -70,6 +70,15 @@ free_block(void* block)
 void
 test_cvector_main(const allocator_t *allocator, const int32_t tabs = 0);
 
+void
+test_cvector_algorithm_main(const allocator_t *allocator, const int32_t tabs = 0);
+
+void
+test_cqueue_main(const allocator_t *allocator, const int32_t tabs = 0);
+
+void
+test_cring_main(const allocator_t *allocator, const int32_t tabs = 0);
+
 void
 test_clist_main(const allocator_t *allocator, const int32_t tabs = 0);
 
@@ -79,9 +88,42 @@ test_hash_main(const allocator_t *allocator, const int32_t tabs = 0);
 void
 test_chashmap_main(const allocator_t *allocator, const int32_t tabs = 0);
 
+void
+test_cshardmap_main(const allocator_t *allocator, const int32_t tabs = 0);
+
 void
 test_binarystream_main(const allocator_t *allocator, const int32_t tabs = 0);
 
+void
+test_binaryarchive_main(const allocator_t *allocator, const int32_t tabs = 0);
+
+void
+test_async_io_main(const allocator_t *allocator, const int32_t tabs = 0);
+
+void
+test_directory_main(const allocator_t *allocator, const int32_t tabs = 0);
+
+void
+test_asset_index_main(const allocator_t *allocator, const int32_t tabs = 0);
+
+void
+test_asset_cache_main(const allocator_t *allocator, const int32_t tabs = 0);
+
+void
+test_asset_deps_main(const allocator_t *allocator, const int32_t tabs = 0);
+
+void
+test_job_main(const allocator_t *allocator, const int32_t tabs = 0);
+
+void
+test_epoch_main(const allocator_t *allocator, const int32_t tabs = 0);
+
+void
+test_profiler_main(const allocator_t *allocator, const int32_t tabs = 0);
+
+void
+test_workload_main(const allocator_t *allocator, const int32_t tabs = 0);
+
 void
 test_registry_main(const allocator_t *allocator, const int32_t tabs = 0);
 
@@ -94,6 +136,14 @@ test_memory_main(const int32_t tabs = 0);
 void
 test_default_allocator_main(const int32_t tabs = 0);
 
+void
+test_framerate_controller_main(
+  const allocator_t *allocator,
+  const int32_t tabs = 0);
+
+void
+test_os_main(const int32_t tabs = 0);
+
 int
 main(int argc, char *argv[])
 {
@@ -105,17 +155,33 @@ main(int argc, char *argv[])
   allocator.mem_realloc = reallocate;
 
   test_binarystream_main(&allocator);
+  test_binaryarchive_main(&allocator);
+  test_async_io_main(&allocator);
+  test_directory_main(&allocator);
+  test_asset_index_main(&allocator);
+  test_asset_cache_main(&allocator);
+  test_asset_deps_main(&allocator);
+  test_job_main(&allocator);
+  test_epoch_main(&allocator);
+  test_profiler_main(&allocator);
+  test_workload_main(&allocator);
   test_registry_main(&allocator);
   test_cvector_main(&allocator);
+  test_cvector_algorithm_main(&allocator);
   test_clist_main(&allocator);
+  test_cqueue_main(&allocator);
+  test_cring_main(&allocator);
   test_hash_main(&allocator);
   test_chashmap_main(&allocator);
+  test_cshardmap_main(&allocator);
   test_cstring_main(&allocator);
   test_memory_main();
   test_default_allocator_main();
+  test_os_main();
+  test_framerate_controller_main(&allocator);
 
   std::cout << "allocation remaining: " << allocated.size() << std::endl;
   assert(allocated.size() == 0);
 
   return 0;
-}
+}
\ No newline at end of file
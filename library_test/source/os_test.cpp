@@ -0,0 +1,100 @@
+/**
+ * @file os_test.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <common.h>
+#include <library/filesystem/filesystem.h>
+#include <library/os/os.h>
+
+
+static
+void
+test_os_timers(const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  uint64_t frequency = 0, start = 0, end = 0;
+  int32_t done = get_performance_frequency(&frequency);
+  assert(done && frequency);
+  done = get_performance_counter(&start);
+  assert(done);
+
+  os_sleep(20);
+
+  done = get_performance_counter(&end);
+  assert(done);
+  double elapsed_ms = (end - start) * 1000.0 / frequency;
+  CTABS << PRINT(frequency) << ", " << PRINT(elapsed_ms) << std::endl;
+  assert(elapsed_ms >= 19.0);
+}
+
+static
+void
+test_os_find_files(const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  namespace fs = std::filesystem;
+  fs::path root = unique_temp_path("library_os_test");
+  fs::create_directories(root / "alpha");
+  fs::create_directories(root / "beta");
+  std::ofstream(root / "gamma.txt") << "file";
+
+  std::string pattern = (root / "*").string();
+  uint32_t files = 0, directories = 0;
+  file_find_data_t data;
+  file_handle_t handle = find_first_file(pattern.c_str(), &data);
+  assert(handle != INVALID_HANDLE);
+  do {
+    if (!strcmp(data.name, ".") || !strcmp(data.name, ".."))
+      continue;
+    if (data.file_attributes & FILE_IS_DIRECTORY)
+      ++directories;
+    else
+      ++files;
+  } while (find_next_file(handle, &data));
+  assert(get_last_error() == LIBRARY_ERROR_NO_MORE_FILES);
+  find_close(handle);
+  CTABS << PRINT(directories) << ", " << PRINT(files) << std::endl;
+  assert(directories == 2 && files == 1);
+
+  // the pattern applies to the last component only.
+  pattern = (root / "*.txt").string();
+  handle = find_first_file(pattern.c_str(), &data);
+  assert(handle != INVALID_HANDLE && !strcmp(data.name, "gamma.txt"));
+  int32_t found = find_next_file(handle, &data);
+  assert(!found);
+  find_close(handle);
+
+  pattern = (root / "*.none").string();
+  handle = find_first_file(pattern.c_str(), &data);
+  assert(handle == INVALID_HANDLE);
+
+  dir_entries_t *entries = new dir_entries_t;
+  pattern = (root / "*").string();
+  get_subdirectories(pattern.c_str(), entries);
+  assert(entries->used == 2);
+  delete entries;
+
+  fs::remove_all(root);
+}
+
+void
+test_os_main(const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  test_os_timers(tabs + 1);       NEWLINE;
+  test_os_find_files(tabs + 1);   NEWLINE;
+}
\ No newline at end of file
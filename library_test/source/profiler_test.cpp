@@ -0,0 +1,275 @@
+/**
+ * @file profiler_test.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#define LIBRARY_PROFILE
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <common.h>
+#include <library/allocator/allocator.h>
+#include <library/profiler/profiler.h>
+#include <library/threading/thread.h>
+
+
+static
+void
+busy(uint32_t count)
+{
+  volatile uint32_t sink = 0;
+  for (uint32_t i = 0; i < count; ++i)
+    sink += i;
+}
+
+static
+const profiler_node_t *
+find_node(const char *name, uint32_t parent)
+{
+  uint32_t count;
+  const profiler_node_t *nodes = profiler_frame_nodes(&count);
+  for (uint32_t i = 0; i < count; ++i)
+    if (!strcmp(nodes[i].name, name) && nodes[i].parent == parent)
+      return nodes + i;
+  return NULL;
+}
+
+static
+uint32_t
+node_index(const profiler_node_t *node)
+{
+  uint32_t count;
+  return (uint32_t)(node - profiler_frame_nodes(&count));
+}
+
+static
+void
+print_tree(const int32_t tabs)
+{
+  uint32_t count;
+  const profiler_node_t *nodes = profiler_frame_nodes(&count);
+  for (uint32_t i = 0; i < count; ++i)
+    CTABS << std::string(nodes[i].depth * 2, ' ') << nodes[i].name <<
+      " [" << nodes[i].thread << "] calls: " << nodes[i].calls <<
+      ", total: " << nodes[i].total_ms << "ms, self: " <<
+      nodes[i].self_ms << "ms" << std::endl;
+}
+
+static
+void
+simulate_frame(void)
+{
+  PROFILE_SCOPE("frame");
+  for (uint32_t i = 0; i < 3; ++i) {
+    PROFILE_SCOPE("update");
+    {
+      PROFILE_SCOPE("physics");
+      busy(20000);
+    }
+    busy(5000);
+  }
+  {
+    PROFILE_SCOPE("render");
+    busy(10000);
+  }
+}
+
+static
+void
+test_profiler_tree(const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  profiler_setup(&g_default_allocator);
+  for (uint32_t frame = 0; frame < 3; ++frame) {
+    simulate_frame();
+    profiler_frame_end();
+  }
+  print_tree(tabs);
+
+  // the tree only holds the last frame.
+  uint32_t count;
+  profiler_frame_nodes(&count);
+  assert(count == 4);
+  const profiler_node_t *frame = find_node("frame", PROFILER_INVALID_NODE);
+  assert(frame && frame->calls == 1 && frame->depth == 0);
+  const profiler_node_t *update = find_node("update", node_index(frame));
+  assert(update && update->calls == 3 && update->depth == 1);
+  const profiler_node_t *physics = find_node("physics", node_index(update));
+  assert(physics && physics->calls == 3 && physics->depth == 2);
+  const profiler_node_t *render = find_node("render", node_index(frame));
+  assert(render && render->calls == 1);
+  assert(physics->self_ms == physics->total_ms);
+  assert(update->total_ms >= physics->total_ms);
+  assert(frame->total_ms >= update->total_ms + render->total_ms);
+  assert(frame->self_ms >= 0. && frame->self_ms <= frame->total_ms);
+
+  // a scope left open at frame end is counted in the frame it closes in.
+  PROFILE_BEGIN("load");
+  PROFILE_BEGIN("parse");
+  PROFILE_END();
+  profiler_frame_end();
+  const profiler_node_t *load = find_node("load", PROFILER_INVALID_NODE);
+  assert(load && load->calls == 0);
+  assert(find_node("parse", node_index(load))->calls == 1);
+  PROFILE_END();
+  profiler_frame_end();
+  load = find_node("load", PROFILER_INVALID_NODE);
+  assert(load && load->calls == 1 && load->child_ticks == 0);
+  profiler_frame_nodes(&count);
+  assert(count == 1);
+
+  assert(profiler_dropped_events() == 0);
+  profiler_cleanup();
+
+  // nothing is recorded without a setup.
+  simulate_frame();
+  profiler_frame_end();
+  assert(!profiler_frame_nodes(&count) && count == 0);
+}
+
+static
+void
+test_profiler_overflow(const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  // twice the ring's worth of events without a drain, the overflow is dropped
+  // and the nesting survives it.
+  const uint32_t pairs = PROFILER_RING_CAPACITY;
+  profiler_setup(&g_default_allocator);
+  PROFILE_BEGIN("outer");
+  for (uint32_t i = 0; i < pairs; ++i) {
+    PROFILE_BEGIN("inner");
+    PROFILE_END();
+  }
+  PROFILE_END();
+  profiler_frame_end();
+
+  uint64_t dropped = profiler_dropped_events();
+  const profiler_node_t *outer = find_node("outer", PROFILER_INVALID_NODE);
+  assert(outer && outer->calls == 1);
+  const profiler_node_t *inner = find_node("inner", node_index(outer));
+  CTABS << PRINT(inner->calls) << ", " << PRINT(dropped) << std::endl;
+  assert(dropped && inner->calls + dropped == pairs);
+
+  // drained, the ring takes everything again.
+  for (uint32_t i = 0; i < 100; ++i) {
+    PROFILE_BEGIN("inner");
+    PROFILE_END();
+  }
+  profiler_frame_end();
+  assert(profiler_dropped_events() == dropped);
+  assert(find_node("inner", PROFILER_INVALID_NODE)->calls == 100);
+  profiler_cleanup();
+}
+
+static
+void
+profiled_worker(void *arg)
+{
+  uint32_t count = *(uint32_t *)arg;
+  for (uint32_t i = 0; i < count; ++i) {
+    PROFILE_SCOPE("job");
+    {
+      PROFILE_SCOPE("work");
+      busy(100);
+    }
+  }
+}
+
+static
+void
+test_profiler_threads(const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  const uint32_t workers = 4;
+  uint32_t count = 1000;
+  profiler_setup(&g_default_allocator);
+  PROFILE_BEGIN("main");
+  std::vector<thread_handle_t> threads(workers);
+  for (uint32_t i = 0; i < workers; ++i) {
+    threads[i] = thread_create(profiled_worker, &count);
+    assert(threads[i] != INVALID_THREAD);
+  }
+  for (uint32_t i = 0; i < workers; ++i)
+    thread_join(threads[i]);
+  PROFILE_END();
+  profiler_frame_end();
+
+  // one tree per thread, the workers' roots are their own.
+  uint32_t total = 0, jobs = 0, works = 0;
+  const profiler_node_t *nodes = profiler_frame_nodes(&total);
+  for (uint32_t i = 0; i < total; ++i) {
+    if (!strcmp(nodes[i].name, "job")) {
+      assert(nodes[i].parent == PROFILER_INVALID_NODE);
+      assert(nodes[i].calls == count);
+      ++jobs;
+    } else if (!strcmp(nodes[i].name, "work")) {
+      assert(nodes[nodes[i].parent].thread == nodes[i].thread);
+      works += nodes[i].calls;
+    }
+  }
+  CTABS << PRINT(total) << ", " << PRINT(jobs) << ", " << PRINT(works) <<
+    std::endl;
+  assert(jobs == workers && works == workers * count);
+  assert(find_node("main", PROFILER_INVALID_NODE)->calls == 1);
+
+  // every span goes to the trace, complete events under the right thread.
+  std::string file_path = unique_temp_path("profiler_test.json").string();
+  const char *path = file_path.c_str();
+  uint32_t written = profiler_write_chrome_trace(path);
+  assert(written);
+  std::ifstream file(path, std::ios::binary);
+  std::stringstream stream;
+  stream << file.rdbuf();
+  file.close();
+  std::string json = stream.str();
+  uint32_t events = 0;
+  for (size_t at = json.find("\"ph\":\"X\""); at != std::string::npos;
+    at = json.find("\"ph\":\"X\"", at + 1))
+    ++events;
+  CTABS << PRINT(json.size()) << ", " << PRINT(events) << std::endl;
+  assert(json.rfind("{\"traceEvents\":[", 0) == 0);
+  assert(json.find("]}") != std::string::npos);
+  assert(json.find("\"name\":\"work\"") != std::string::npos);
+  assert(events == 2 * workers * count + 1);
+  assert(json.find(",\n]") == std::string::npos);
+
+  // the spans went with the first export, the threads are still named.
+  written = profiler_write_chrome_trace(path);
+  assert(written);
+  file.open(path, std::ios::binary);
+  stream.str("");
+  stream << file.rdbuf();
+  file.close();
+  json = stream.str();
+  assert(json.find("\"ph\":\"M\"") != std::string::npos);
+  assert(json.find("\"ph\":\"X\"") == std::string::npos);
+  assert(json.find(",\n]") == std::string::npos);
+  remove(path);
+
+  profiler_cleanup();
+}
+
+void
+test_profiler_main(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  (void)allocator;
+  test_profiler_tree(tabs + 1);                               NEWLINE;
+  test_profiler_overflow(tabs + 1);                           NEWLINE;
+  test_profiler_threads(tabs + 1);                            NEWLINE;
+}
\ No newline at end of file
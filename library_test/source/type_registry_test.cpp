@@ -10,6 +10,7 @@
  */
 #include <cassert>
 #include <cstdint>
+#include <cstring>
 #include <classroom.h>
 #include <common.h>
 #include <library/allocator/allocator.h>
@@ -0,0 +1,372 @@
+/**
+ * @file workload_test.cpp
+ * @author khalilhenoud@gmail.com
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <common.h>
+#include <library/allocator/allocator.h>
+#include <library/hash/fnv.h>
+#include <library/workload/workload.h>
+
+
+static
+workload_key_params_t
+make_params(workload_distribution_t distribution, uint64_t seed)
+{
+  workload_key_params_t params;
+  params.distribution = distribution;
+  params.universe = 1000;
+  params.zipf_exponent = 1.0;
+  params.collision_bits = 12;
+  params.seed = seed;
+  return params;
+}
+
+static
+std::vector<uint64_t>
+draw(const workload_key_params_t &params, uint32_t count)
+{
+  std::vector<uint64_t> keys;
+  workload_keys_t stream;
+  workload_keys_setup(&stream, &params);
+  for (uint32_t i = 0; i < count; ++i)
+    keys.push_back(workload_keys_next(&stream));
+  return keys;
+}
+
+static
+void
+test_workload_keys(const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  for (uint32_t d = 0; d < WORKLOAD_DISTRIBUTION_COUNT; ++d) {
+    workload_distribution_t distribution = (workload_distribution_t)d;
+    std::vector<uint64_t> first = draw(make_params(distribution, 7), 1000);
+    std::vector<uint64_t> again = draw(make_params(distribution, 7), 1000);
+    std::vector<uint64_t> other = draw(make_params(distribution, 8), 1000);
+    std::unordered_set<uint64_t> distinct(first.begin(), first.end());
+    CTABS << workload_distribution_name(distribution) << ": " <<
+      PRINT(distinct.size()) << std::endl;
+    assert(first == again);
+    assert(
+      distribution == WORKLOAD_SEQUENTIAL ? first == other : first != other);
+    if (distribution == WORKLOAD_UNIFORM || distribution == WORKLOAD_ZIPF)
+      assert(distinct.size() <= 1000);
+    else
+      assert(distinct.size() == 1000);
+  }
+
+  // sequential counts up.
+  {
+    std::vector<uint64_t> keys = draw(make_params(WORKLOAD_SEQUENTIAL, 0), 64);
+    for (uint64_t i = 0; i < keys.size(); ++i)
+      assert(keys[i] == i);
+  }
+
+  // uniform and zipf draw from the same 'universe' keys.
+  {
+    std::vector<uint64_t> uniform =
+      draw(make_params(WORKLOAD_UNIFORM, 3), 100000);
+    std::vector<uint64_t> zipf = draw(make_params(WORKLOAD_ZIPF, 3), 100000);
+    std::unordered_set<uint64_t> universe(uniform.begin(), uniform.end());
+    CTABS << PRINT(universe.size()) << std::endl;
+    assert(universe.size() == 1000);
+    for (uint64_t key : zipf)
+      assert(universe.count(key));
+  }
+
+  // with an exponent of 1 the top rank's probability is 1 / H(1000), ~0.134,
+  // the next one half of that.
+  {
+    std::unordered_map<uint64_t, uint32_t> counts;
+    uint32_t top = 0, second = 0;
+    for (uint64_t key : draw(make_params(WORKLOAD_ZIPF, 11), 100000))
+      ++counts[key];
+    for (auto &entry : counts) {
+      if (entry.second > top) {
+        second = top;
+        top = entry.second;
+      } else if (entry.second > second)
+        second = entry.second;
+    }
+    CTABS << PRINT(top) << ", " << PRINT(second) << std::endl;
+    assert(top > 12400 && top < 14400);
+    assert(second > 6000 && second < 7400);
+  }
+
+  // every collision key shares the low bits of its fnv1a hash.
+  for (uint32_t bits = 4; bits <= 16; bits += 6) {
+    workload_key_params_t params = make_params(WORKLOAD_FNV_COLLISIONS, 5);
+    params.collision_bits = bits;
+    std::vector<uint64_t> keys = draw(params, 500);
+    std::unordered_set<uint64_t> distinct(keys.begin(), keys.end());
+    uint32_t mask = (1u << bits) - 1;
+    uint32_t shared = hash_fnv1a_32(&keys[0], sizeof(uint64_t)) & mask;
+    CTABS << PRINT(bits) << ", " << PRINT(shared) << std::endl;
+    assert(distinct.size() == keys.size());
+    for (uint64_t key : keys)
+      assert((hash_fnv1a_32(&key, sizeof(uint64_t)) & mask) == shared);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// the same operations against the std containers, the checksums must agree.
+
+static
+uint64_t
+reference_chashmap(const workload_trace_t *trace)
+{
+  std::unordered_map<uint64_t, uint64_t> map;
+  uint64_t checksum = WORKLOAD_CHECKSUM_INIT;
+  const workload_op_t *op = cvector_begin(&trace->ops, workload_op_t);
+  const workload_op_t *end = cvector_end(&trace->ops, workload_op_t);
+  for (; op != end; ++op) {
+    uint64_t observed = map.size(), sum = 0;
+    switch (op->type) {
+      case WORKLOAD_OP_INSERT:
+        observed = map.insert_or_assign(op->key, op->value).second;
+        break;
+      case WORKLOAD_OP_ERASE:
+        observed = map.erase(op->key);
+        break;
+      case WORKLOAD_OP_FIND:
+        observed = map.count(op->key) ? map[op->key] : WORKLOAD_MISS;
+        break;
+      case WORKLOAD_OP_ITERATE:
+        for (auto &entry : map)
+          sum += entry.second;
+        checksum = workload_checksum(checksum, sum);
+        break;
+      case WORKLOAD_OP_CLEAR:
+        map.clear();
+        break;
+    }
+    checksum = workload_checksum(checksum, observed);
+  }
+  return workload_checksum(checksum, map.size());
+}
+
+template<typename T>
+static
+uint64_t
+reference_sequence(const workload_trace_t *trace)
+{
+  T sequence;
+  uint64_t checksum = WORKLOAD_CHECKSUM_INIT;
+  const workload_op_t *op = cvector_begin(&trace->ops, workload_op_t);
+  const workload_op_t *end = cvector_end(&trace->ops, workload_op_t);
+  for (; op != end; ++op) {
+    uint64_t size = sequence.size(), observed = WORKLOAD_MISS, sum = 0;
+    auto at = [&]() {
+      auto iter = sequence.begin();
+      std::advance(iter, op->key % size);
+      return iter; };
+    switch (op->type) {
+      case WORKLOAD_OP_INSERT: {
+        auto iter = sequence.begin();
+        std::advance(iter, op->key % (size + 1));
+        sequence.insert(iter, op->value);
+        observed = sequence.size();
+      } break;
+      case WORKLOAD_OP_ERASE:
+        if (size) {
+          auto iter = at();
+          observed = *iter;
+          sequence.erase(iter);
+        }
+        break;
+      case WORKLOAD_OP_FIND:
+        if (size)
+          observed = *at();
+        break;
+      case WORKLOAD_OP_ITERATE:
+        for (uint64_t value : sequence)
+          sum += value;
+        checksum = workload_checksum(checksum, sum);
+        observed = size;
+        break;
+      case WORKLOAD_OP_CLEAR:
+        sequence.clear();
+        observed = size;
+        break;
+      case WORKLOAD_OP_PUSH_BACK:
+        sequence.push_back(op->value);
+        observed = sequence.size();
+        break;
+      case WORKLOAD_OP_PUSH_FRONT:
+        sequence.insert(sequence.begin(), op->value);
+        observed = sequence.size();
+        break;
+      case WORKLOAD_OP_POP_BACK:
+        if (size) {
+          observed = sequence.back();
+          sequence.pop_back();
+        }
+        break;
+      case WORKLOAD_OP_POP_FRONT:
+        if (size) {
+          observed = sequence.front();
+          sequence.erase(sequence.begin());
+        }
+        break;
+    }
+    checksum = workload_checksum(checksum, observed);
+  }
+  return workload_checksum(checksum, sequence.size());
+}
+
+static
+uint64_t
+reference(const workload_trace_t *trace)
+{
+  switch (trace->target) {
+    case WORKLOAD_TARGET_CHASHMAP:
+      return reference_chashmap(trace);
+    case WORKLOAD_TARGET_CVECTOR:
+      return reference_sequence<std::vector<uint64_t>>(trace);
+    default:
+      return reference_sequence<std::list<uint64_t>>(trace);
+  }
+}
+
+static
+workload_mix_t
+make_mix(workload_target_t target)
+{
+  workload_mix_t mix = {};
+  mix.weights[WORKLOAD_OP_INSERT] = 30;
+  mix.weights[WORKLOAD_OP_ERASE] = 10;
+  mix.weights[WORKLOAD_OP_FIND] = 50;
+  mix.weights[WORKLOAD_OP_ITERATE] = 1;
+  mix.weights[WORKLOAD_OP_CLEAR] = 1;
+  if (target != WORKLOAD_TARGET_CHASHMAP) {
+    mix.weights[WORKLOAD_OP_PUSH_BACK] = 20;
+    mix.weights[WORKLOAD_OP_POP_BACK] = 5;
+  }
+  if (target == WORKLOAD_TARGET_CLIST) {
+    mix.weights[WORKLOAD_OP_PUSH_FRONT] = 20;
+    mix.weights[WORKLOAD_OP_POP_FRONT] = 5;
+  }
+  return mix;
+}
+
+static
+void
+test_workload_replay(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  for (uint32_t t = 0; t < WORKLOAD_TARGET_COUNT; ++t) {
+    for (uint32_t d = 0; d < WORKLOAD_DISTRIBUTION_COUNT; ++d) {
+      workload_target_t target = (workload_target_t)t;
+      workload_key_params_t params =
+        make_params((workload_distribution_t)d, 17);
+      workload_mix_t mix = make_mix(target);
+      workload_keys_t keys;
+      workload_trace_t trace;
+      params.universe = 200;
+      workload_keys_setup(&keys, &params);
+      workload_trace_setup(&trace, target, allocator);
+      workload_trace_generate(&trace, &keys, &mix, 3000, 23);
+
+      uint64_t checksum = workload_replay(&trace, allocator);
+      CTABS << workload_target_name(target) << "/" <<
+        workload_distribution_name((workload_distribution_t)d) << ": " <<
+        std::hex << checksum << std::dec << std::endl;
+      assert(checksum == workload_replay(&trace, allocator));
+      assert(checksum == reference(&trace));
+      workload_trace_cleanup(&trace);
+    }
+  }
+
+  // the ops a target does not support are rejected.
+  assert(workload_op_valid(WORKLOAD_TARGET_CHASHMAP, WORKLOAD_OP_CLEAR));
+  assert(!workload_op_valid(WORKLOAD_TARGET_CHASHMAP, WORKLOAD_OP_PUSH_BACK));
+  assert(workload_op_valid(WORKLOAD_TARGET_CVECTOR, WORKLOAD_OP_POP_BACK));
+  assert(!workload_op_valid(WORKLOAD_TARGET_CVECTOR, WORKLOAD_OP_PUSH_FRONT));
+  assert(workload_op_valid(WORKLOAD_TARGET_CLIST, WORKLOAD_OP_POP_FRONT));
+}
+
+static
+void
+test_workload_trace_file(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  std::string file_path = unique_temp_path("workload_test.trace").string();
+  const char *path = file_path.c_str();
+  workload_trace_t trace, loaded;
+  workload_key_params_t params = make_params(WORKLOAD_ZIPF, 29);
+  workload_mix_t mix = make_mix(WORKLOAD_TARGET_CHASHMAP);
+  workload_keys_t keys;
+  workload_keys_setup(&keys, &params);
+  workload_trace_setup(&trace, WORKLOAD_TARGET_CHASHMAP, allocator);
+
+  // recorded by hand, as production code would, then generated.
+  workload_trace_record(&trace, WORKLOAD_OP_INSERT, 1, 10);
+  workload_trace_record(&trace, WORKLOAD_OP_FIND, 1, 0);
+  workload_trace_record(&trace, WORKLOAD_OP_ERASE, 1, 0);
+  workload_trace_record(&trace, WORKLOAD_OP_FIND, 1, 0);
+  workload_trace_generate(&trace, &keys, &mix, 1000, 31);
+
+  uint32_t done = workload_trace_save(&trace, path);
+  assert(done);
+  done = workload_trace_load(&loaded, path, allocator);
+  assert(done);
+  CTABS << PRINT(cvector_size(&loaded.ops)) << std::endl;
+  assert(loaded.target == trace.target);
+  assert(cvector_size(&loaded.ops) == cvector_size(&trace.ops));
+  for (size_t i = 0; i < cvector_size(&trace.ops); ++i) {
+    workload_op_t *lhs = cvector_as(&trace.ops, i, workload_op_t);
+    workload_op_t *rhs = cvector_as(&loaded.ops, i, workload_op_t);
+    assert(
+      lhs->type == rhs->type && lhs->key == rhs->key &&
+      lhs->value == rhs->value);
+  }
+  assert(
+    workload_replay(&trace, allocator) == workload_replay(&loaded, allocator));
+  workload_trace_cleanup(&loaded);
+
+  // a truncated file is rejected, and so is a missing one.
+  {
+    FILE *file = fopen(path, "rb");
+    std::vector<char> bytes;
+    int c;
+    while ((c = fgetc(file)) != EOF)
+      bytes.push_back((char)c);
+    fclose(file);
+    file = fopen(path, "wb");
+    fwrite(bytes.data(), 1, bytes.size() - 3, file);
+    fclose(file);
+  }
+  done = workload_trace_load(&loaded, path, allocator);
+  assert(!done);
+  remove(path);
+  done = workload_trace_load(&loaded, path, allocator);
+  assert(!done);
+
+  workload_trace_cleanup(&trace);
+}
+
+void
+test_workload_main(const allocator_t *allocator, const int32_t tabs)
+{
+  PRINT_FUNCTION;
+
+  test_workload_keys(tabs + 1);                               NEWLINE;
+  test_workload_replay(allocator, tabs + 1);                  NEWLINE;
+  test_workload_trace_file(allocator, tabs + 1);              NEWLINE;
+}
\ No newline at end of file